@@ -41,6 +41,7 @@
 #define $GUARD
 
 #include "transport-runtime/transport.h"
+#include "transport-runtime/models/aligned_workspace.h"
 
 #include "$CORE"
 
@@ -351,7 +352,11 @@ namespace transport
           {
             $IF{!fast}
               $RESOURCE_RELEASE
-              this->__u2 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
+              $IF{vectorize}
+                this->__u2 = allocate_aligned_workspace<number>(2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS);
+              $ELSE
+                this->__u2 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
+              $ENDIF
 
               this->__dV = new number[$NUMBER_FIELDS];
               this->__ddV = new number[$NUMBER_FIELDS * $NUMBER_FIELDS];
@@ -366,7 +371,11 @@ namespace transport
         void close_down_workspace()
           {
             $IF{!fast}
-              delete[] this->__u2;
+              $IF{vectorize}
+                release_aligned_workspace(this->__u2);
+              $ELSE
+                delete[] this->__u2;
+              $ENDIF
 
               delete[] this->__dV;
               delete[] this->__ddV;
@@ -509,13 +518,23 @@ namespace transport
           {
             $IF{!fast}
               $RESOURCE_RELEASE
-              this->__u2_k1 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
-              this->__u2_k2 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
-              this->__u2_k3 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
-
-              this->__u3_k1k2k3 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
-              this->__u3_k2k1k3 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
-              this->__u3_k3k1k2 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
+              $IF{vectorize}
+                this->__u2_k1 = allocate_aligned_workspace<number>(2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS);
+                this->__u2_k2 = allocate_aligned_workspace<number>(2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS);
+                this->__u2_k3 = allocate_aligned_workspace<number>(2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS);
+
+                this->__u3_k1k2k3 = allocate_aligned_workspace<number>(2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS);
+                this->__u3_k2k1k3 = allocate_aligned_workspace<number>(2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS);
+                this->__u3_k3k1k2 = allocate_aligned_workspace<number>(2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS);
+              $ELSE
+                this->__u2_k1 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
+                this->__u2_k2 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
+                this->__u2_k3 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
+
+                this->__u3_k1k2k3 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
+                this->__u3_k2k1k3 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
+                this->__u3_k3k1k2 = new number[2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS * 2*$NUMBER_FIELDS];
+              $ENDIF
 
               this->__dV = new number[$NUMBER_FIELDS];
               this->__ddV = new number[$NUMBER_FIELDS * $NUMBER_FIELDS];
@@ -531,13 +550,23 @@ namespace transport
         void close_down_workspace()
           {
             $IF{!fast}
-              delete[] this->__u2_k1;
-              delete[] this->__u2_k2;
-              delete[] this->__u2_k3;
-
-              delete[] this->__u3_k1k2k3;
-              delete[] this->__u3_k2k1k3;
-              delete[] this->__u3_k3k1k2;
+              $IF{vectorize}
+                release_aligned_workspace(this->__u2_k1);
+                release_aligned_workspace(this->__u2_k2);
+                release_aligned_workspace(this->__u2_k3);
+
+                release_aligned_workspace(this->__u3_k1k2k3);
+                release_aligned_workspace(this->__u3_k2k1k3);
+                release_aligned_workspace(this->__u3_k3k1k2);
+              $ELSE
+                delete[] this->__u2_k1;
+                delete[] this->__u2_k2;
+                delete[] this->__u2_k3;
+
+                delete[] this->__u3_k1k2k3;
+                delete[] this->__u3_k2k1k3;
+                delete[] this->__u3_k3k1k2;
+              $ENDIF
 
               delete[] this->__dV;
               delete[] this->__ddV;
@@ -1032,12 +1061,15 @@ namespace transport
 
         // calculation of dV, ddV, dddV has to occur above the temporary pool
         $IF{!fast}
-          $MODEL_compute_dV(__raw_params, __x, __Mp, __dV);
-          $MODEL_compute_ddV(__raw_params, __x, __Mp, __ddV);
-
-          // capture resources for transport tensors
-          $RESOURCE_DV{__dV}
-          $RESOURCE_DDV{__ddV}
+          // in hybrid mode no resources are captured, so tensor coefficients are unrolled and can be constant-folded
+          $IF{!hybrid}
+            $MODEL_compute_dV(__raw_params, __x, __Mp, __dV);
+            $MODEL_compute_ddV(__raw_params, __x, __Mp, __ddV);
+
+            // capture resources for transport tensors
+            $RESOURCE_DV{__dV}
+            $RESOURCE_DDV{__ddV}
+          $ENDIF
         $ENDIF
 
 #ifdef CPPTRANSPORT_INSTRUMENT
@@ -1057,15 +1089,24 @@ namespace transport
         const auto __tensor_twopf_pf = __x[$MODEL_pool::tensor_start + TENSOR_FLATTEN(1,0)];
         const auto __tensor_twopf_pp = __x[$MODEL_pool::tensor_start + TENSOR_FLATTEN(1,1)];
 
+        $IF{vectorize}
+          // restrict-qualified views of the state allow the compiler to assume __x and __dxdt do not alias
+          const number* __restrict __x_view = __x.data();
+          number* __restrict __dxdt_view = __dxdt.data();
+        $ELSE
+          const auto& __x_view = __x;
+          auto& __dxdt_view = __dxdt;
+        $ENDIF
+
 #undef __twopf
-#define __twopf(a,b) __x[$MODEL_pool::twopf_start + FLATTEN(a,b)]
+#define __twopf(a,b) __x_view[$MODEL_pool::twopf_start + FLATTEN(a,b)]
 
 #undef __background
 #undef __dtwopf
 #undef __dtwopf_tensor
-#define __background(a)      __dxdt[$MODEL_pool::backg_start + FLATTEN(a)]
-#define __dtwopf_tensor(a,b) __dxdt[$MODEL_pool::tensor_start + TENSOR_FLATTEN(a,b)]
-#define __dtwopf(a,b)        __dxdt[$MODEL_pool::twopf_start + FLATTEN(a,b)]
+#define __background(a)      __dxdt_view[$MODEL_pool::backg_start + FLATTEN(a)]
+#define __dtwopf_tensor(a,b) __dxdt_view[$MODEL_pool::tensor_start + TENSOR_FLATTEN(a,b)]
+#define __dtwopf(a,b)        __dxdt_view[$MODEL_pool::twopf_start + FLATTEN(a,b)]
 
 #ifdef CPPTRANSPORT_INSTRUMENT
         __setup_timer.stop();
@@ -1169,14 +1210,17 @@ namespace transport
 
         // calculation of dV, ddV, dddV has to occur above the temporary pool
         $IF{!fast}
-          $MODEL_compute_dV(__raw_params, __x, __Mp, __dV);
-          $MODEL_compute_ddV(__raw_params, __x, __Mp, __ddV);
-          $MODEL_compute_dddV(__raw_params, __x, __Mp, __dddV);
-
-          // capture resources for transport tensors
-          $RESOURCE_DV{__dV}
-          $RESOURCE_DDV{__ddV}
-          $RESOURCE_DDDV{__dddV}
+          // in hybrid mode no resources are captured, so tensor coefficients are unrolled and can be constant-folded
+          $IF{!hybrid}
+            $MODEL_compute_dV(__raw_params, __x, __Mp, __dV);
+            $MODEL_compute_ddV(__raw_params, __x, __Mp, __ddV);
+            $MODEL_compute_dddV(__raw_params, __x, __Mp, __dddV);
+
+            // capture resources for transport tensors
+            $RESOURCE_DV{__dV}
+            $RESOURCE_DDV{__ddV}
+            $RESOURCE_DDDV{__dddV}
+          $ENDIF
         $ENDIF
 
 #ifdef CPPTRANSPORT_INSTRUMENT
@@ -1206,6 +1250,15 @@ namespace transport
         const auto __tensor_k3_twopf_pf = __x[$MODEL_pool::tensor_k3_start + TENSOR_FLATTEN(1,0)];
         const auto __tensor_k3_twopf_pp = __x[$MODEL_pool::tensor_k3_start + TENSOR_FLATTEN(1,1)];
 
+        $IF{vectorize}
+          // restrict-qualified views of the state allow the compiler to assume __x and __dxdt do not alias
+          const number* __restrict __x_view = __x.data();
+          number* __restrict __dxdt_view = __dxdt.data();
+        $ELSE
+          const auto& __x_view = __x;
+          auto& __dxdt_view = __dxdt;
+        $ENDIF
+
 #undef __twopf_re_k1
 #undef __twopf_re_k2
 #undef __twopf_re_k3
@@ -1215,14 +1268,14 @@ namespace transport
 
 #undef __threepf
 
-#define __twopf_re_k1(a,b) __x[$MODEL_pool::twopf_re_k1_start + FLATTEN(a,b)]
-#define __twopf_im_k1(a,b) __x[$MODEL_pool::twopf_im_k1_start + FLATTEN(a,b)]
-#define __twopf_re_k2(a,b) __x[$MODEL_pool::twopf_re_k2_start + FLATTEN(a,b)]
-#define __twopf_im_k2(a,b) __x[$MODEL_pool::twopf_im_k2_start + FLATTEN(a,b)]
-#define __twopf_re_k3(a,b) __x[$MODEL_pool::twopf_re_k3_start + FLATTEN(a,b)]
-#define __twopf_im_k3(a,b) __x[$MODEL_pool::twopf_im_k3_start + FLATTEN(a,b)]
+#define __twopf_re_k1(a,b) __x_view[$MODEL_pool::twopf_re_k1_start + FLATTEN(a,b)]
+#define __twopf_im_k1(a,b) __x_view[$MODEL_pool::twopf_im_k1_start + FLATTEN(a,b)]
+#define __twopf_re_k2(a,b) __x_view[$MODEL_pool::twopf_re_k2_start + FLATTEN(a,b)]
+#define __twopf_im_k2(a,b) __x_view[$MODEL_pool::twopf_im_k2_start + FLATTEN(a,b)]
+#define __twopf_re_k3(a,b) __x_view[$MODEL_pool::twopf_re_k3_start + FLATTEN(a,b)]
+#define __twopf_im_k3(a,b) __x_view[$MODEL_pool::twopf_im_k3_start + FLATTEN(a,b)]
 
-#define __threepf(a,b,c)	 __x[$MODEL_pool::threepf_start  + FLATTEN(a,b,c)]
+#define __threepf(a,b,c)	 __x_view[$MODEL_pool::threepf_start  + FLATTEN(a,b,c)]
 
 #undef __background
 #undef __dtwopf_k1_tensor
@@ -1235,17 +1288,17 @@ namespace transport
 #undef __dtwopf_re_k3
 #undef __dtwopf_im_k3
 #undef __dthreepf
-#define __background(a)         __dxdt[$MODEL_pool::backg_start       + FLATTEN(a)]
-#define __dtwopf_k1_tensor(a,b) __dxdt[$MODEL_pool::tensor_k1_start   + TENSOR_FLATTEN(a,b)]
-#define __dtwopf_k2_tensor(a,b) __dxdt[$MODEL_pool::tensor_k2_start   + TENSOR_FLATTEN(a,b)]
-#define __dtwopf_k3_tensor(a,b) __dxdt[$MODEL_pool::tensor_k3_start   + TENSOR_FLATTEN(a,b)]
-#define __dtwopf_re_k1(a,b)     __dxdt[$MODEL_pool::twopf_re_k1_start + FLATTEN(a,b)]
-#define __dtwopf_im_k1(a,b)     __dxdt[$MODEL_pool::twopf_im_k1_start + FLATTEN(a,b)]
-#define __dtwopf_re_k2(a,b)     __dxdt[$MODEL_pool::twopf_re_k2_start + FLATTEN(a,b)]
-#define __dtwopf_im_k2(a,b)     __dxdt[$MODEL_pool::twopf_im_k2_start + FLATTEN(a,b)]
-#define __dtwopf_re_k3(a,b)     __dxdt[$MODEL_pool::twopf_re_k3_start + FLATTEN(a,b)]
-#define __dtwopf_im_k3(a,b)     __dxdt[$MODEL_pool::twopf_im_k3_start + FLATTEN(a,b)]
-#define __dthreepf(a,b,c)       __dxdt[$MODEL_pool::threepf_start     + FLATTEN(a,b,c)]
+#define __background(a)         __dxdt_view[$MODEL_pool::backg_start       + FLATTEN(a)]
+#define __dtwopf_k1_tensor(a,b) __dxdt_view[$MODEL_pool::tensor_k1_start   + TENSOR_FLATTEN(a,b)]
+#define __dtwopf_k2_tensor(a,b) __dxdt_view[$MODEL_pool::tensor_k2_start   + TENSOR_FLATTEN(a,b)]
+#define __dtwopf_k3_tensor(a,b) __dxdt_view[$MODEL_pool::tensor_k3_start   + TENSOR_FLATTEN(a,b)]
+#define __dtwopf_re_k1(a,b)     __dxdt_view[$MODEL_pool::twopf_re_k1_start + FLATTEN(a,b)]
+#define __dtwopf_im_k1(a,b)     __dxdt_view[$MODEL_pool::twopf_im_k1_start + FLATTEN(a,b)]
+#define __dtwopf_re_k2(a,b)     __dxdt_view[$MODEL_pool::twopf_re_k2_start + FLATTEN(a,b)]
+#define __dtwopf_im_k2(a,b)     __dxdt_view[$MODEL_pool::twopf_im_k2_start + FLATTEN(a,b)]
+#define __dtwopf_re_k3(a,b)     __dxdt_view[$MODEL_pool::twopf_re_k3_start + FLATTEN(a,b)]
+#define __dtwopf_im_k3(a,b)     __dxdt_view[$MODEL_pool::twopf_im_k3_start + FLATTEN(a,b)]
+#define __dthreepf(a,b,c)       __dxdt_view[$MODEL_pool::threepf_start     + FLATTEN(a,b,c)]
 
 #ifdef CPPTRANSPORT_INSTRUMENT
         __setup_timer.stop();
@@ -0,0 +1,160 @@
+//
+// Created by David Seery on 19/10/2026.
+// --@@
+// Copyright (c) 2017 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+#include <cmath>
+#include <limits>
+
+#include "transport-runtime/transport.h"
+
+#include "catch/catch.hpp"
+
+
+using DataType = double;
+using namespace transport;
+using namespace transport::derived_data;
+
+
+namespace
+  {
+
+    // only one MPI environment can be created per process, so it is shared between scenarios
+    boost::mpi::environment& get_mpi_environment()
+      {
+        static boost::mpi::environment env;
+        return env;
+      }
+
+
+    // compare sample values, treating NaNs as equal
+    bool sample_match(double a, double b)
+      {
+        if(std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+        return a == b;
+      }
+
+  }   // namespace
+
+
+SCENARIO( "Derived-line cache entries survive a round trip through disk", "[derived-line-cache]" )
+  {
+    boost::mpi::environment& env = get_mpi_environment();
+    boost::mpi::communicator world;
+    slave_message_buffer messages(env, world, [](const std::string&) -> void {});
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    data_line<DataType>::point_list points{ {0.0, 1.0/3.0}, {1.0, nan}, {2.0, inf}, {3.0, -inf}, {4.0, -1.5E-300}, {nan, 2.0} };
+
+    std::list< data_line<DataType> > lines;
+    lines.emplace_back(std::list<std::string>{ "group-a", "group-b" }, axis_value::efolds, value_type::correlation_function, points,
+                       data_line_type::continuous_data, "\\Sigma", "Sigma", messages);
+    lines.emplace_back(std::list<std::string>{ "group-a" }, axis_value::k, value_type::fNL,
+                       data_line<DataType>::point_list{}, data_line_type::scattered_data, "", "empty", messages);
+
+    const std::set<unsigned int> covered{ 0, 3, 7 };
+    const std::string key = "test-key\nline";
+
+    boost::filesystem::path dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("cpptransport-%%%%-%%%%");
+    boost::filesystem::path entry = dir / CPPTRANSPORT_DERIVED_LINE_CACHE_LEAF / "entry.json";
+
+    GIVEN( "an entry stored on disk" )
+      {
+        REQUIRE( derived_line_cache_impl::write_entry(derived_line_cache_impl::encode_entry(key, lines, covered), entry) );
+
+        // no temporary files should be left behind
+        unsigned int count = 0;
+        for(boost::filesystem::directory_iterator t(entry.parent_path()); t != boost::filesystem::directory_iterator(); ++t)
+          {
+            ++count;
+          }
+        REQUIRE( count == 1 );
+
+        Json::Value root;
+        REQUIRE( derived_line_cache_impl::read_entry(entry, root) );
+
+        WHEN( "it is reloaded using the same key" )
+          {
+            std::list< data_line<DataType> > restored;
+            std::set<unsigned int> restored_covered;
+            REQUIRE( derived_line_cache_impl::decode_entry(root, key, true, restored, restored_covered, messages) );
+
+            THEN( "the lines and k-configurations match those stored" )
+              {
+                REQUIRE( restored_covered == covered );
+                REQUIRE( restored.size() == lines.size() );
+
+                auto r = restored.cbegin();
+                for(auto l = lines.cbegin(); l != lines.cend(); ++l, ++r)
+                  {
+                    REQUIRE( r->get_parent_groups() == l->get_parent_groups() );
+                    REQUIRE( r->get_axis_value() == l->get_axis_value() );
+                    REQUIRE( r->get_value_type() == l->get_value_type() );
+                    REQUIRE( r->get_data_line_type() == l->get_data_line_type() );
+                    REQUIRE( r->get_LaTeX_label() == l->get_LaTeX_label() );
+                    REQUIRE( r->get_non_LaTeX_label() == l->get_non_LaTeX_label() );
+
+                    const data_line<DataType>::point_list& a = l->get_data_points();
+                    const data_line<DataType>::point_list& b = r->get_data_points();
+                    REQUIRE( a.size() == b.size() );
+                    for(size_t i = 0; i < a.size(); ++i)
+                      {
+                        REQUIRE( sample_match(a[i].first, b[i].first) );
+                        REQUIRE( sample_match(a[i].second, b[i].second) );
+                      }
+                  }
+              }
+          }
+
+        WHEN( "it is reloaded using a different key" )
+          {
+            std::list< data_line<DataType> > restored;
+            std::set<unsigned int> restored_covered;
+
+            THEN( "nothing is restored" )
+              {
+                REQUIRE_FALSE( derived_line_cache_impl::decode_entry(root, "other-key", false, restored, restored_covered, messages) );
+                REQUIRE( restored.empty() );
+              }
+          }
+
+        WHEN( "a sample value is damaged" )
+          {
+            root[CPPTRANSPORT_NODE_LINE_CACHE_LINES][0][CPPTRANSPORT_NODE_LINE_CACHE_Y_VALUES][1] = "not-a-number";
+
+            std::list< data_line<DataType> > restored;
+            std::set<unsigned int> restored_covered;
+
+            THEN( "the entry is rejected" )
+              {
+                REQUIRE_THROWS( derived_line_cache_impl::decode_entry(root, key, false, restored, restored_covered, messages) );
+                REQUIRE( restored.empty() );
+              }
+          }
+      }
+
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(dir, ec);
+  }
@@ -38,21 +38,26 @@
 #include "translator.h"
 
 #include "boost/algorithm/string.hpp"
+#include "boost/filesystem/operations.hpp"
 
 
 #define BUFFER_MAGIC_TAG "MAGIC_TAG"
+#define BUFFER_TEMPORARY_EXTENSION ".tmp"
 
 
 buffer::buffer(boost::filesystem::path fn, unsigned int cp)
 	: in_memory(false),
 	  filename(std::move(fn)),
+    temporary(filename.string() + BUFFER_TEMPORARY_EXTENSION),
+    committed(false),
 		capacity(cp),
 		size(0)
   {
     tag = buf.insert(buf.end(), BUFFER_MAGIC_TAG);
 
-		// connect output stream to the destination file
-		out_stream.open(filename.string());
+		// connect output stream to a temporary file; it replaces the destination file only when committed,
+		// and only if the content has changed
+		out_stream.open(temporary.string());
 
 		if(!out_stream.is_open() || out_stream.fail())
 			{
@@ -66,6 +71,7 @@ buffer::buffer(boost::filesystem::path fn, unsigned int cp)
 
 buffer::buffer()
 	: in_memory(true),
+    committed(false),
     capacity(0),
     size(0)
 	{
@@ -76,28 +82,108 @@ buffer::buffer()
 
 buffer::~buffer()
 	{
+    this->commit();
+	}
+
+
+commit_status buffer::commit()
+  {
+    if(this->in_memory || this->committed) return commit_status::unchanged;
+    this->committed = true;
+
 		// remove magic tag, if it is still present (we expect it should be)
 		if(*(this->tag) == BUFFER_MAGIC_TAG)
 			{
 				this->buf.erase(this->tag);
 			}
 
-		// write any remaining lines to file, if required
-		if(!this->in_memory)
-			{
-		    // check if safe to write, but don't raise an error if not
-		    // presumably this was flagged on construction
-				if(this->out_stream.is_open())
-					{
-						for(const auto& str : this->buf)
-							{
-								this->out_stream << str << '\n';
-							}
-
-						this->out_stream.close();
-					}
-			}
-	}
+    // check if safe to write, but don't raise an error if not
+    // presumably this was flagged on construction
+    if(!this->out_stream.is_open()) return commit_status::failed;
+
+    // write any remaining lines to the temporary file
+    for(const auto& str : this->buf)
+      {
+        this->out_stream << str << '\n';
+      }
+    this->buf.clear();
+    this->tag = this->buf.end();
+
+    this->out_stream.close();
+
+    boost::system::error_code ec;
+
+    // leave the existing file untouched if the temporary could not be written, or if nothing has changed
+    if(this->out_stream.fail())
+      {
+        boost::filesystem::remove(this->temporary, ec);
+        return commit_status::failed;
+      }
+
+    if(this->matches_existing())
+      {
+        boost::filesystem::remove(this->temporary, ec);
+        return commit_status::unchanged;
+      }
+
+    boost::filesystem::rename(this->temporary, this->filename, ec);
+    if(!ec) return commit_status::written;
+
+    // rename can fail on some network filesystems, so fall back to copying
+    std::ifstream in(this->temporary.string(), std::ios::in | std::ios::binary);
+    std::ofstream out(this->filename.string(), std::ios::out | std::ios::trunc | std::ios::binary);
+
+    bool copied = in.is_open() && out.is_open();
+    if(copied)
+      {
+        out << in.rdbuf();
+        out.close();
+        copied = !out.fail() && !in.bad();
+      }
+    in.close();
+
+    boost::filesystem::remove(this->temporary, ec);
+    return(copied ? commit_status::written : commit_status::failed);
+  }
+
+
+bool buffer::matches_existing() const
+  {
+    std::ifstream new_file(this->temporary.string());
+    std::ifstream old_file(this->filename.string());
+
+    if(!new_file.is_open() || !old_file.is_open()) return false;
+
+    std::string new_line;
+    std::string old_line;
+
+    while(std::getline(new_file, new_line))
+      {
+        if(!std::getline(old_file, old_line)) return false;
+        if(!this->matches_line(new_line, old_line)) return false;
+      }
+
+    // files match only if the existing file has no further content
+    return(!std::getline(old_file, old_line));
+  }
+
+
+bool buffer::matches_line(const std::string& new_line, const std::string& old_line) const
+  {
+    if(new_line == old_line) return true;
+    if(this->volatile_text.empty()) return false;
+
+    size_t pos = new_line.find(this->volatile_text);
+    if(pos == std::string::npos) return false;
+
+    // the lines match if they agree either side of the volatile text
+    std::string prefix = new_line.substr(0, pos);
+    std::string suffix = new_line.substr(pos + this->volatile_text.length());
+
+    return(old_line.length() >= prefix.length() + suffix.length()
+           && boost::algorithm::starts_with(old_line, prefix)
+           && boost::algorithm::ends_with(old_line, suffix));
+  }
 
 
 void buffer::write(std::string& line, std::list<std::string>::iterator insertion_point)
@@ -43,6 +43,11 @@
 
 class translator;
 
+
+//! outcome of committing a buffer to its output file
+enum class commit_status { written, unchanged, failed };
+
+
 class buffer
   {
 
@@ -69,6 +74,22 @@ class buffer
 		~buffer();
 
 
+    // INTERFACE - COMMIT
+
+  public:
+
+    //! commit the buffer to its output file, which is replaced only if its content has changed, so that
+    //! its timestamp does not trigger needless recompilation. If the output could not be written, the
+    //! existing file is left in place and commit_status::failed is returned.
+    //! Called automatically on destruction if not called explicitly; subsequent calls,
+    //! and calls on in-memory buffers, report commit_status::unchanged
+    commit_status commit();
+
+    //! set text which may differ between otherwise identical translations, such as the translation time;
+    //! differences confined to this text are ignored when deciding whether the output has changed
+    void set_volatile_text(std::string text) { this->volatile_text = std::move(text); }
+
+
     // INTERFACE
 
   public:
@@ -134,6 +155,13 @@ class buffer
     //! write a line at a specified insertion point
     void write(std::string& line, std::list<std::string>::iterator insertion_point);
 
+    //! determine whether the content written to the temporary file matches the existing output file
+    bool matches_existing() const;
+
+    //! determine whether a newly-written line matches a line of the existing output file,
+    //! discounting any volatile text
+    bool matches_line(const std::string& new_line, const std::string& old_line) const;
+
 
 		// INTERNAL DATA
 
@@ -146,6 +174,15 @@ class buffer
 		//! filename of output
 		const boost::filesystem::path filename;
 
+    //! temporary file to which output is written before being committed
+    const boost::filesystem::path temporary;
+
+    //! has the buffer been committed?
+    bool committed;
+
+    //! text to be discounted when comparing with existing output
+    std::string volatile_text;
+
 		//! current size
 		unsigned size;
 
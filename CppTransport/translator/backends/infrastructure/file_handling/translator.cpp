@@ -27,12 +27,19 @@
 #include <assert.h>
 
 #include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <fstream>
 
 #include "translator.h"
 #include "buffer.h"
+#include "core.h"
 
 #include "formatter.h"
 
+#include "build_data.h"
+
 
 class TemplateJanitor
   {
@@ -95,7 +102,8 @@ class TemplateJanitor
 
 
 translator::translator(translator_data& payload)
-  : data_payload(payload)
+  : data_payload(payload),
+    cache_attached(false)
   {
     cache = std::make_unique<expression_cache>();
   }
@@ -103,6 +111,14 @@ translator::translator(translator_data& payload)
 
 translator::~translator()
 	{
+    // write back any expressions computed during this run
+    if(!this->cache->flush())
+      {
+        std::ostringstream msg;
+        msg << WARNING_EXPRESSION_CACHE_WRITE;
+        this->print_advisory(msg.str());
+      }
+
 	  if(!this->data_payload.get_argument_cache().show_profiling()) return;
 
     auto hits = this->cache->get_hits();
@@ -117,6 +133,10 @@ translator::~translator()
     expr_cache_msg.precision(3);
     expr_cache_msg << " (" << 100.0*hit_rate << "%)";
     expr_cache_msg.precision(prec);
+    if(this->cache->is_persistent())
+      {
+        expr_cache_msg << ", " << this->cache->get_persistent_hits() << " " << MESSAGE_EXPRESSION_CACHE_FROM_DISK;
+      }
     expr_cache_msg << " (" << MESSAGE_EXPRESSION_CACHE_QUERY_TIME << " " << format_time(this->cache->get_query_time())
                    << ", " << MESSAGE_EXPRESSION_CACHE_INSERT_TIME << " " << format_time(this->cache->get_insert_time())
                    << ")";
@@ -135,8 +155,27 @@ unsigned int translator::translate(const std::string& in, const error_context& c
   {
 		buffer buf(out);
 
+    // the translation time appears in the output, but shouldn't cause it to be regarded as changed
+    buf.set_volatile_text(this->data_payload.get_timestamp());
+
     unsigned int rval = this->translate(in, ctx, buf, type, filter);
 
+    // replace the output file only if its content has changed, so downstream builds are not invalidated
+    commit_status status = buf.commit();
+
+    if(status == commit_status::unchanged)
+      {
+        std::ostringstream msg;
+        msg << MESSAGE_OUTPUT_UNCHANGED << " '" << out.string() << "'";
+        this->print_advisory(msg.str());
+      }
+    else if(status == commit_status::failed)
+      {
+        std::ostringstream msg;
+        msg << ERROR_OUTPUT_WRITE << " '" << out.string() << "'";
+        ctx.error(msg.str());
+      }
+
     return(rval);
   }
 
@@ -215,6 +254,21 @@ unsigned int translator::process(const boost::filesystem::path& in, buffer& buf,
     finished_msg << MESSAGE_TRANSLATION_RESULT << " " << replacements << " " << MESSAGE_REPLACEMENT_RULE_EXPANSIONS;
     this->data_payload.message(finished_msg.str());
 
+    if(agent.get_omitted_terms() > 0)
+      {
+        std::ostringstream omitted_msg;
+        omitted_msg << MESSAGE_OMITTED_TERMS_A << " " << agent.get_omitted_terms() << " " << MESSAGE_OMITTED_TERMS_B;
+        this->data_payload.message(omitted_msg.str());
+      }
+
+    // report estimated code size, to help tune the unroll policy
+    std::ostringstream size_msg;
+    size_msg << MESSAGE_CODE_SIZE_A << " " << agent.get_unrolled_statements() << " " << MESSAGE_CODE_SIZE_B
+             << " " << agent.get_rolled_statements() << " " << MESSAGE_CODE_SIZE_C;
+    this->data_payload.message(size_msg.str());
+
+    if(this->data_payload.operation_report()) this->write_operation_report(buf, *package, agent);
+
     // report time spent doing macro replacement
     // package will also report on time and memory use when it goes out of scope and is destroyed
     package->report_macro_metadata(agent.get_total_work_time(), agent.get_tokenization_time());
@@ -226,6 +280,79 @@ unsigned int translator::process(const boost::filesystem::path& in, buffer& buf,
   }
 
 
+
+void translator::write_operation_report(const buffer& buf, const package_group& package, const macro_agent& agent)
+  {
+    // in-memory buffers have no associated file, so there is nowhere to put the report
+    if(buf.get_filename().empty()) return;
+
+    boost::filesystem::path report_path = buf.get_filename();
+    report_path.replace_extension(".ops.json");
+
+    std::ofstream out(report_path.string(), std::ios::out | std::ios::trunc);
+
+    operation_count before;
+    operation_count after;
+
+    out << "{" << '\n';
+    out << "  \"output\": \"" << buf.get_filename().filename().string() << "\"," << '\n';
+
+    // operation counts for each tensor, before and after common subexpression elimination
+    out << "  \"tensors\": [";
+    bool first = true;
+    for(const auto& item : package.get_cse_worker().get_tensor_statistics())
+      {
+        const cse_impl::tensor_statistics& stats = item.second;
+        if(stats.before.total() == 0) continue;
+
+        out << (first ? "" : ",") << '\n' << "    { \"name\": \"" << item.first << "\", \"before_cse\": ";
+        stats.before.write_json(out);
+        out << ", \"after_cse\": ";
+        stats.after.write_json(out);
+        out << " }";
+
+        before += stats.before;
+        after += stats.after;
+        first = false;
+      }
+    out << '\n' << "  ]," << '\n';
+
+    // operation counts for each index contraction, scaled by loop trip counts where it was planted as a for-loop
+    operation_count contracted;
+
+    out << "  \"contractions\": [";
+    first = true;
+    for(const macro_impl::contraction_record& record : agent.get_contractions())
+      {
+        out << (first ? "" : ",") << '\n' << "    { \"line\": " << record.line
+            << ", \"rolled\": " << (record.rolled ? "true" : "false") << ", \"operations\": ";
+        record.ops.write_json(out);
+        out << " }";
+
+        contracted += record.ops;
+        first = false;
+      }
+    out << '\n' << "  ]," << '\n';
+
+    out << "  \"totals\": { \"before_cse\": ";
+    before.write_json(out);
+    out << ", \"after_cse\": ";
+    after.write_json(out);
+    out << ", \"contractions\": ";
+    contracted.write_json(out);
+    out << " }" << '\n';
+    out << "}" << '\n';
+
+    out.close();
+
+    if(out.fail())
+      {
+        std::ostringstream msg;
+        msg << WARNING_OPERATION_REPORT_WRITE << " '" << report_path.string() << "'";
+        this->print_advisory(msg.str());
+      }
+  }
+
 std::tuple< std::unique_ptr<backend_data>, std::unique_ptr<tensor_factory>, std::unique_ptr<package_group> >
 translator::build_agents(const boost::filesystem::path& in)
   {
@@ -246,6 +373,9 @@ translator::build_agents(const boost::filesystem::path& in)
 
     // from here on, can assume that template exists and can be read and handled by this version of CppTransport
 
+    // the model has been parsed by this point, so the persistent expression cache can be keyed on it
+    this->attach_persistent_cache();
+
     // Generate an appropriate tensor_factory instance
 
     // A backend consists of a set of macro replacement rules that collectively comprise a 'package group'.
@@ -275,6 +405,93 @@ translator::build_agents(const boost::filesystem::path& in)
   }
 
 
+void translator::attach_persistent_cache()
+  {
+    if(this->cache_attached) return;
+    this->cache_attached = true;
+
+    argument_cache& args = this->data_payload.get_argument_cache();
+    if(!args.expression_cache()) return;
+
+    std::string fingerprint = this->model_fingerprint();
+
+    // 64-bit FNV-1a hash of the fingerprint names the cache file; the full fingerprint is stored in the
+    // file and checked on load, so a collision produces a miss rather than wrong expressions
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for(unsigned char c : fingerprint)
+      {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+      }
+
+    std::ostringstream leaf;
+    leaf << std::hex << std::setw(16) << std::setfill('0') << hash << EXPRESSION_CACHE_EXTENSION;
+
+    boost::filesystem::path dir = args.cache_dir();
+    if(dir.empty()) dir = this->data_payload.get_core_filename().parent_path() / EXPRESSION_CACHE_LOCATION;
+
+    if(!this->cache->attach(dir / leaf.str(), fingerprint, this->data_payload.get_symbol_factory()))
+      {
+        std::ostringstream msg;
+        msg << WARNING_EXPRESSION_CACHE_READ << " '" << (dir / leaf.str()).string() << "'";
+        this->print_advisory(msg.str());
+        return;
+      }
+
+    if(this->cache->get_persistent_loaded() > 0)
+      {
+        std::ostringstream msg;
+        msg << this->cache->get_persistent_loaded() << " " << MESSAGE_EXPRESSION_CACHE_LOADED;
+        this->print_advisory(msg.str());
+      }
+  }
+
+
+std::string translator::model_fingerprint() const
+  {
+    const lagrangian_block& model = this->data_payload.model;
+
+    // cached expressions depend on the translator version and build, the cache format, the Lagrangian type,
+    // the declared fields and parameters (whose names identify the symbols used in each expression),
+    // the potential and the metric; all are written on a single line.
+    // The build timestamp changes whenever the translator is configured afresh, so a development build
+    // doesn't reuse expressions computed by tensor code that has since been edited
+    std::ostringstream fp;
+    fp << CPPTRANSPORT_NUMERIC_VERSION << "|" << EXPRESSION_CACHE_FORMAT << "|" << build_data::config_timestamp
+       << "|" << format(model.get_lagrangian_type()) << "|" << model.get_Mp_symbol().get_name();
+
+    std::vector<std::string> fields = model.get_field_name_list();
+    fp << "|fields:";
+    for(const std::string& f : fields) fp << f << ",";
+
+    fp << "|params:";
+    for(const std::string& p : model.get_param_name_list()) fp << p << ",";
+
+    auto pot = model.get_potential();
+    fp << "|V:";
+    if(pot) fp << **(pot.get());
+
+    auto metric = model.get_metric();
+    if(metric)
+      {
+        auto& G = **(metric.get());
+
+        fp << "|G:";
+        for(const std::string& fi : fields)
+          {
+            for(const std::string& fj : fields)
+              {
+                fp << G(std::make_pair(fi, fj)) << ",";
+              }
+          }
+      }
+
+    std::string rval = fp.str();
+    std::replace(rval.begin(), rval.end(), '\n', ' ');
+    return rval;
+  }
+
+
 std::unique_ptr<std::ifstream> translator::open_template(const boost::filesystem::path& in, buffer& buf)
   {
     auto inf = std::make_unique<std::ifstream>();
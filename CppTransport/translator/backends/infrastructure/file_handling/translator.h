@@ -93,6 +93,16 @@ class translator
     //! open a template file
     std::unique_ptr<std::ifstream> open_template(const boost::filesystem::path& in, buffer& buf);
 
+    //! attach the expression cache to its persistent file, if this has not already been done
+    void attach_persistent_cache();
+
+    //! build a fingerprint identifying the physics of the model: everything on which
+    //! cached symbolic expressions depend
+    std::string model_fingerprint() const;
+
+    //! write a report of estimated operation counts for a translated file
+    void write_operation_report(const buffer& buf, const package_group& package, const macro_agent& agent);
+
     //! process a single line from a template
     unsigned int process_line(std::ifstream& inf, package_group& package, macro_agent& agent, buffer& buf, output_stack& os,
                                   filter_function* filter, bool annotate);
@@ -108,6 +118,9 @@ class translator
 		//! expression cache for this translator; has to be a pointer because we use it in the destructor
 		std::unique_ptr<expression_cache> cache;
 
+    //! has the expression cache been attached to its persistent file?
+    bool cache_attached;
+
   };
 
 
@@ -26,6 +26,8 @@
 
 #include "translator_data.h"
 
+#include "boost/date_time/posix_time/posix_time.hpp"
+
 
 translator_data::translator_data(const boost::filesystem::path& file, error_context::error_handler e,
                                  error_context::warning_handler w, message_handler m, finder& f, output_stack& os, symbol_factory& s,
@@ -43,7 +45,8 @@ translator_data::translator_data(const boost::filesystem::path& file, error_cont
     templates(desc.templates),
     misc(desc.misc),
     cache(c),
-    policy(vp)
+    policy(vp),
+    timestamp(boost::posix_time::to_simple_string(boost::posix_time::second_clock::universal_time()))
   {
   }
 
@@ -72,6 +75,37 @@ bool translator_data::fast() const
   }
 
 
+bool translator_data::vectorize() const
+  {
+    return(this->cache.vectorize());
+  }
+
+
+bool translator_data::hybrid() const
+  {
+    // '--fast' unrolls everything, so takes precedence
+    return(this->cache.hybrid() && !this->cache.fast());
+  }
+
+
+bool translator_data::operation_report() const
+  {
+    return(this->cache.operation_report());
+  }
+
+
+bool translator_data::horner() const
+  {
+    return(this->cache.horner());
+  }
+
+
+unsigned int translator_data::jobs() const
+  {
+    return(this->cache.jobs());
+  }
+
+
 void translator_data::set_core_implementation(const boost::filesystem::path& co, const std::string& cg,
                                               const boost::filesystem::path& io, const std::string& ig)
   {
@@ -105,6 +105,10 @@ class translator_data
     //! get header guard for translated implementation
     const std::string& get_implementation_guard() const { return(this->implementation_guard); }
 
+    //! get time at which translation began; a single value is used for every output file, so that
+    //! it can be discounted when checking whether an output file has changed
+    const std::string& get_timestamp() const { return(this->timestamp); }
+
 
     // GET CONFIGURATION OPTIONS
 
@@ -122,6 +126,21 @@ class translator_data
     //! get fast option
     bool fast() const;
 
+    //! get vectorize option
+    bool vectorize() const;
+
+    //! get hybrid unrolling option; has no effect if the fast option is set
+    bool hybrid() const;
+
+    //! get operation report option
+    bool operation_report() const;
+
+    //! get Horner form option
+    bool horner() const;
+
+    //! get number of worker processes used to build tensor components
+    unsigned int jobs() const;
+
     
     // PASS-THROUGH TO UNDERLYING MODEL DESCRIPTOR
     
@@ -223,6 +242,12 @@ class translator_data
     //! implementation header guard
     std::string implementation_guard;
 
+
+    // TIMESTAMP
+
+    //! time at which translation began
+    std::string timestamp;
+
   };
 
 
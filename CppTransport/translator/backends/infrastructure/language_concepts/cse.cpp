@@ -83,13 +83,47 @@ void cse::clear()
   }
 
 
-void cse::deposit(cse_impl::symbol_record& record)
+void cse::deposit(const GiNaC::ex& expr, cse_impl::symbol_record& record)
   {
-    if(!record.is_written())
+    if(record.is_written()) return;
+
+    // printing with use counting deposits any temporaries this expression depends on, so declarations
+    // are emitted in dependency order; each distinct subexpression is printed only once
+    std::string target = this->print(expr, true);
+
+    this->decls.emplace_back(record.get_symbol(), target);
+    record.mark_written(std::move(target));
+  }
+
+
+cse_impl::symbol_record& cse::insert(const GiNaC::ex& expr, const boost::optional<std::string>& name)
+  {
+    ++this->node_count;
+
+    // if this subexpression is already in the table then so are all of its own subexpressions,
+    // so there is no need to traverse them again
+    auto t = this->symbols.find(expr);
+    if(t != this->symbols.end()) return t->second;
+
+    // insert subexpressions first, so that temporaries are numbered from the leaves upwards
+    for(size_t i = 0; i < expr.nops(); ++i)
       {
-        this->decls.emplace_back(record.get_symbol(), record.get_target());
-        record.mark_written();
+        this->insert(expr.op(i), boost::none);
       }
+
+    ++this->unique_count;
+    this->unique_operations += count_node_operations(expr);
+
+    // if a name was supplied then use it, otherwise set up a label for a new temporary object
+    std::string symbol_name{name ? *name : this->make_symbol()};
+
+    auto result = this->symbols.emplace(expr, cse_impl::symbol_record{symbol_name});
+
+    // check whether insertion took place; failure would indicate an inconsistent symbol table,
+    // so take no risks and raise an exception
+    if(!result.second) throw cse_exception(symbol_name);
+
+    return result.first->second;
   }
 
 
@@ -101,70 +135,29 @@ void cse::parse(const GiNaC::ex& expr, const boost::optional<std::string> name)
     // enable parsing timer
     timing_instrument instrument(timer);
 
-    // loop over all subexpressions in the tree, beginning with the leaves and building up to
-    // more complex expressions
-    for(auto t = expr.postorder_begin(); t != expr.postorder_end(); ++t)
-      {
-        // print this subexpression *without* use counting
-        // (false means that print will use get_symbol_without_use_count)
-        std::string target_string = this->print(*t, false);
-
-        // does this subexpression already exist in the lookup table?
-        auto u = this->symbols.find(target_string);
+    cse_impl::symbol_record& rec = this->insert(expr, name);
 
-        // if not, insert a new subexpression
+    // if a name was supplied, we automatically deposit the expression and everything it depends on to the pool,
+    // because typically clients further up the stack will only get a GiNaC symbol corresponding to this name;
+    // they won't have an explicit expression to print which would cause these temporaries to be deposited
+    if(!name) return;
 
-        // if a name was supplied, we automatically deposit everything to the pool, because typically clients
-        // further up the stack will only get a GiNaC symbol corresponding to this name;
-        // they won't have an explicit expression to print which would cause these temporaries to be deposited
+    this->deposit(expr, rec);
 
-        // work out whether we are looking at the total expression, or just one of the component subexpressions
-        auto w = t;
-        ++w;
-        bool last_subexpr = (w == expr.postorder_end());
+    // if the expression was already present, check whether the record we've matched has the assigned name
+    if(rec.get_symbol() != *name)
+      {
+        // check whether we've emitted a declaration for this named symbol before
+        auto v = this->named_symbols.find(*name);
 
-        if(u == this->symbols.end())
+        if(v == this->named_symbols.end())
           {
-            // Assign a name for this subexpression.
-            // If it is the top-level expression and a name was supplied then we use it,
-            // otherwise we set up a label for a new temporary object
-            std::string symbol_name{name && last_subexpr ? *name : this->make_symbol()};
+            // if not, then assign the temporary we've matched to the intended name
 
-            // perform insertion
-            auto result = this->symbols.emplace(target_string, cse_impl::symbol_record{target_string, symbol_name});
-
-            // check whether insertion took place; failure could be due to aliasing, so take no risks and
-            // raise an exception
-            if(!result.second) throw cse_exception(*name);
-
-            if(name) deposit(result.first->second);
-          }
-        else
-          {
-            // otherwise, no need to insert, but we should check whether the write flag needs to be set
-            // and we should also check
-            if(name)
-              {
-                cse_impl::symbol_record& rec = u->second;
-                deposit(rec);
-
-                // if this is the total subexpression, check whether the record we've matched has the assigned name
-                if(last_subexpr && rec.get_symbol() != *name)
-                  {
-                    // check whether we've emitted a declaration for this named symbol before
-                    auto v = this->named_symbols.find(*name);
-
-                    if(v == this->named_symbols.end())
-                      {
-                        // if not, then assign the temporary we've matched to the intended name
-
-                        // *don't* inject into the symbol table, though, otherwise we'll end up with *two*
-                        // entries that match the same subexpression -- this is inconsistent
-                        this->decls.emplace_back(*name, rec.get_symbol());
-                        this->named_symbols.insert(*name);
-                      }
-                  }
-              }
+            // *don't* inject into the symbol table, though, otherwise we'll end up with *two*
+            // entries that match the same subexpression -- this is inconsistent
+            this->decls.emplace_back(*name, rec.get_symbol());
+            this->named_symbols.insert(*name);
           }
       }
   }
@@ -197,14 +190,16 @@ std::string cse::get_symbol_without_use_count(const GiNaC::ex& expr)
     // if CSE disabled, return raw expression
     if(!this->data_payload.do_cse()) return this->printer.ginac(expr);
 
-    // print expression using ourselves as the lookup function (false means that print doesn't count uses via recursively calling ourselves)
-    std::string e = this->print(expr, false);
+    // vanishing expressions are printed as a literal rather than assigned to a temporary, so that
+    // the macro agent can recognize them and omit terms they multiply
+    if(expr.is_zero()) return this->printer.ginac(expr);
 
     // search for this expression in the lookup table
-    auto t = this->symbols.find(e);
+    auto t = this->symbols.find(expr);
 
     // was it present? if not, return the plain expression
-    if(t == this->symbols.end()) return e;
+    // (false means that print doesn't count uses via recursively calling ourselves)
+    if(t == this->symbols.end()) return this->print(expr, false);
 
     // otherwise, return whatever the expression resolves to
     return t->second.get_symbol();
@@ -216,28 +211,36 @@ std::string cse::get_symbol_with_use_count(const GiNaC::ex& expr)
     // if CSE disabled, return raw expression
     if(!this->data_payload.do_cse()) return this->printer.ginac(expr);
 
-    // print expression using ourselves as the lookup function (true means that print will count uses via recursively calling ourselves)
-    std::string e = this->print(expr, true);
+    // vanishing expressions are printed as a literal rather than assigned to a temporary, so that
+    // the macro agent can recognize them and omit terms they multiply
+    if(expr.is_zero()) return this->printer.ginac(expr);
+
+    timing_instrument instrument(timer);
 
     // search for this expression in the lookup table
-    auto t = this->symbols.find(e);
+    auto t = this->symbols.find(expr);
 
     // was it present? if not, return the plain expression
-    if(t == this->symbols.end()) return e;
-    
+    // (true means that print will count uses via recursively calling ourselves)
+    if(t == this->symbols.end()) return this->print(expr, true);
+
     // if it was present, check whether this symbol has been written into the list
     // of declarations
-
-    if(!t->second.is_written())
-      {
-        this->decls.emplace_back(t->second.get_symbol(), t->second.get_target());
-        t->second.mark_written();
-      }
+    this->deposit(t->first, t->second);
 
     return t->second.get_symbol();
   }
 
 
+std::string cse::get_auxiliary_symbol(const GiNaC::ex& expr, bool use_count)
+  {
+    if(!use_count || !this->data_payload.do_cse()) return this->get_symbol_without_use_count(expr);
+
+    this->insert(expr, boost::none);
+    return this->get_symbol_with_use_count(expr);
+  }
+
+
 std::string cse::make_symbol()
   {
     std::string s{this->temporary_name_kernel};
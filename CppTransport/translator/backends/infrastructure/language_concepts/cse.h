@@ -66,6 +66,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <map>
 #include <set>
 #include <utility>
 #include <stdexcept>
@@ -74,6 +75,7 @@
 #include "ginac/ginac.h"
 
 #include "language_printer.h"
+#include "operation_count.h"
 #include "translator_data.h"
 #include "msg_en.h"
 
@@ -92,9 +94,8 @@ namespace cse_impl
       public:
 
         //! constructor
-        symbol_record(std::string t, std::string s)
-          : target(std::move(t)),
-            symbol(std::move(s))
+        symbol_record(std::string s)
+          : symbol(std::move(s))
           {
           }
 
@@ -104,17 +105,17 @@ namespace cse_impl
 
       public:
 
-        //! return printed expression that this symbol resolves to
-        const std::string get_target() const { return(this->target); }
+        //! return printed expression that this symbol resolves to; empty until the symbol has been written
+        const std::string& get_target() const { return(this->target); }
 
         //! return symbol name
-        const std::string get_symbol() const { return(this->symbol); }
+        const std::string& get_symbol() const { return(this->symbol); }
 
         //! has this symbol record been written to the declaration stream?
         bool is_written() const { return(this->written); }
 
-        //! mark this symbol as written
-        void mark_written() { this->written = true; }
+        //! mark this symbol as written, recording the printed expression it resolves to
+        void mark_written(std::string t) { this->target = std::move(t); this->written = true; }
 
 
         // INTERNAL DATA
@@ -132,6 +133,46 @@ namespace cse_impl
 
       };
 
+
+    //! hash GiNaC expressions structurally; GiNaC caches hash values, so this is cheap for expressions
+    //! which have already been hashed
+    struct ex_hash
+      {
+        size_t operator()(const GiNaC::ex& e) const { return(static_cast<size_t>(e.gethash())); }
+      };
+
+
+    //! compare GiNaC expressions structurally; subexpressions shared by reference compare equal
+    //! without being traversed
+    struct ex_equal
+      {
+        bool operator()(const GiNaC::ex& a, const GiNaC::ex& b) const { return(a.is_equal(b)); }
+      };
+
+
+    //! CSE statistics for a single tensor
+    class tensor_statistics
+      {
+
+      public:
+
+        //! number of expression nodes examined
+        unsigned int nodes{0};
+
+        //! number of nodes which were not already in the symbol table
+        unsigned int unique{0};
+
+        //! time spent parsing and emitting
+        boost::timer::nanosecond_type time{0};
+
+        //! operations needed to evaluate the tensor components without CSE
+        operation_count before;
+
+        //! operations needed to evaluate the temporaries introduced by CSE
+        operation_count after;
+
+      };
+
   }   // namespace cse_impl
 
 
@@ -152,7 +193,9 @@ class cse
         printer(p),
         temporary_name_kernel(std::move(k)),
         symbol_counter(0),
-        data_payload(pd)
+        data_payload(pd),
+        node_count(0),
+        unique_count(0)
       {
 		    // pause timer
 		    timer.stop();
@@ -166,8 +209,10 @@ class cse
 
   public:
 
-    //! parse a given GiNaC expression, building up a list of temporaries as we go.
-    //! Nothing is marked as requiring deposition in a temporary pool, though, until
+    //! parse a given GiNaC expression, building up a table of temporaries as we go.
+    //! The table is keyed on the structure of each subexpression, so subexpressions which are already
+    //! present are recognized without traversing them again.
+    //! Nothing is printed, or marked as requiring deposition in a temporary pool, though, until
     //! it is tagged using get_symbol_with_use_count()
     //! the second argument is optional and can be used to assign a fixed temporary
     //! name to the entire expression, if desired
@@ -189,8 +234,13 @@ class cse
 
   protected:
 
-    //! deposit a symbol record to the declaration list
-    void deposit(cse_impl::symbol_record& record);
+    //! insert an expression and its subexpressions into the symbol table, if they are not already present,
+    //! and return the record for the expression
+    cse_impl::symbol_record& insert(const GiNaC::ex& expr, const boost::optional<std::string>& name);
+
+    //! deposit a symbol record to the declaration list; its expression is printed at this point,
+    //! which deposits any temporaries it depends on first
+    void deposit(const GiNaC::ex& expr, cse_impl::symbol_record& record);
 
 
 		// INTERFACE - GET/SET NAME USED FOR TEMPORARIES
@@ -222,6 +272,27 @@ class cse
 		// get cumulative time spent performing CSE
 		boost::timer::nanosecond_type get_cse_time() const { return(this->timer.elapsed().wall); }
 
+    // get cumulative number of expression nodes examined
+    unsigned int get_node_count() const { return(this->node_count); }
+
+    // get cumulative number of nodes inserted into the symbol table
+    unsigned int get_unique_count() const { return(this->unique_count); }
+
+    // get cumulative operations needed to evaluate the nodes inserted into the symbol table
+    const operation_count& get_unique_operations() const { return(this->unique_operations); }
+
+    // should operations be counted before CSE? this requires an extra traversal of each expression
+    bool report_operations() const { return(this->data_payload.operation_report()); }
+
+    // should polynomials be rewritten in Horner form before parsing?
+    bool horner() const { return(this->data_payload.horner()); }
+
+    // get statistics record for a named tensor; records persist for the lifetime of this CSE worker
+    cse_impl::tensor_statistics& get_tensor_statistics(const std::string& name) { return(this->tensor_stats[name]); }
+
+    // get statistics records for all tensors
+    const std::map< std::string, cse_impl::tensor_statistics >& get_tensor_statistics() const { return(this->tensor_stats); }
+
 
 		// INTERNAL API
 
@@ -245,6 +316,11 @@ class cse
     //! for deposition
     std::string get_symbol_without_use_count(const GiNaC::ex& expr);
 
+    //! get symbol corresponding to an auxiliary expression introduced while printing, such as a square root
+    //! or a lower power used to build up a power by multiplication; these may not have been seen by parse(),
+    //! so they are inserted into the symbol table where necessary so that they are shared between all their uses
+    std::string get_auxiliary_symbol(const GiNaC::ex& expr, bool use_count);
+
 		// !make a temporary symbol
     std::string make_symbol();
 
@@ -268,8 +344,9 @@ class cse
     //! current kernel for making names of temporaries
     std::string temporary_name_kernel;
 
-    //! symbol table type
-    using symbol_table = std::unordered_map< std::string, cse_impl::symbol_record >;
+    //! symbol table type; GiNaC expressions are hash-consed on their structure, so each distinct
+    //! subexpression has exactly one entry
+    using symbol_table = std::unordered_map< GiNaC::ex, cse_impl::symbol_record, cse_impl::ex_hash, cse_impl::ex_equal >;
 
     //! declaration list type (note we use a vector because we want to preserve insertion order)
     using declaration_table = std::vector< std::pair<std::string, std::string> >;
@@ -277,7 +354,7 @@ class cse
     //! named symbol list type
     using named_symbol_table = std::set< std::string >;
 
-    //! symbol table: maps printed GiNaC expressions to temporary definitions
+    //! symbol table: maps GiNaC expressions to temporary definitions
     symbol_table symbols;
 
     //! declaration table: maps temporary names to printed GiNaC expressions
@@ -290,6 +367,18 @@ class cse
 		// work timer
 		boost::timer::cpu_timer timer;
 
+    //! number of expression nodes examined
+    unsigned int node_count;
+
+    //! number of nodes inserted into the symbol table
+    unsigned int unique_count;
+
+    //! operations needed to evaluate the nodes inserted into the symbol table
+    operation_count unique_operations;
+
+    //! per-tensor statistics
+    std::map< std::string, cse_impl::tensor_statistics > tensor_stats;
+
   };
 
 
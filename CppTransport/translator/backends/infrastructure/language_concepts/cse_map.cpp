@@ -27,16 +27,130 @@
 #include "msg_en.h"
 
 
-cse_map::cse_map(std::unique_ptr< std::vector<GiNaC::ex> > l, cse& c)
+namespace cse_map_impl
+  {
+
+    //! collect the symbols appearing in an expression
+    void collect_symbols(const GiNaC::ex& expr, GiNaC::exset& symbols)
+      {
+        if(GiNaC::is_a<GiNaC::symbol>(expr))
+          {
+            symbols.insert(expr);
+            return;
+          }
+
+        for(size_t i = 0; i < expr.nops(); ++i)
+          {
+            collect_symbols(expr.op(i), symbols);
+          }
+      }
+
+
+    // forward declaration
+    GiNaC::ex horner_form(const GiNaC::ex& expr);
+
+
+    //! apply horner_form() to each operand of an expression
+    class horner_map: public GiNaC::map_function
+      {
+
+      public:
+
+        GiNaC::ex operator()(const GiNaC::ex& expr) override { return horner_form(expr); }
+
+      };
+
+
+    //! rewrite polynomial subexpressions in Horner form, so that a polynomial of degree n in x is evaluated
+    //! using n multiplications and additions which map onto fused multiply-add instructions.
+    //! Multivariate polynomials are nested in the variable of highest degree, and non-polynomial
+    //! subexpressions are left alone apart from rewriting their operands
+    GiNaC::ex horner_form(const GiNaC::ex& expr)
+      {
+        if(!GiNaC::is_a<GiNaC::add>(expr))
+          {
+            if(expr.nops() == 0) return expr;
+
+            horner_map rewrite_operands;
+            return expr.map(rewrite_operands);
+          }
+
+        GiNaC::exset symbols;
+        collect_symbols(expr, symbols);
+
+        // find the symbol in which this sum is a polynomial of highest degree
+        GiNaC::ex var;
+        int degree = 1;
+        for(const GiNaC::ex& s : symbols)
+          {
+            if(!expr.is_polynomial(s)) continue;
+
+            int d = GiNaC::collect(expr, s).degree(s);
+            if(d > degree)
+              {
+                var = s;
+                degree = d;
+              }
+          }
+
+        // nothing to gain unless some variable appears with degree at least 2
+        if(degree < 2)
+          {
+            GiNaC::ex rval = 0;
+            for(size_t i = 0; i < expr.nops(); ++i)
+              {
+                rval += horner_form(expr.op(i));
+              }
+            return rval;
+          }
+
+        GiNaC::ex collected = GiNaC::collect(expr, var);
+        GiNaC::ex rval = horner_form(collected.coeff(var, degree));
+
+        for(int k = degree-1; k >= 0; --k)
+          {
+            rval = rval*var + horner_form(collected.coeff(var, k));
+          }
+
+        return rval;
+      }
+
+  }   // namespace cse_map_impl
+
+
+cse_map::cse_map(std::unique_ptr< std::vector<GiNaC::ex> > l, cse& c, const std::string& n)
   : list(std::move(l)),
-    cse_worker(c)
+    cse_worker(c),
+    stats(c.get_tensor_statistics(n))
   {
+    boost::timer::cpu_timer timer;
+    unsigned int nodes = cse_worker.get_node_count();
+    unsigned int unique = cse_worker.get_unique_count();
+    operation_count operations = cse_worker.get_unique_operations();
+
+    if(cse_worker.horner())
+      {
+        for(GiNaC::ex& expr : *list)
+          {
+            expr = cse_map_impl::horner_form(expr);
+          }
+      }
+
     // parse the whole vector of expressions;
     // if CSE is disabled, will have no effect
     for(const GiNaC::ex& expr: *list)
       {
         cse_worker.parse(expr);
+        if(cse_worker.report_operations()) this->stats.before += count_operations(expr);
       }
+
+    this->stats.nodes += cse_worker.get_node_count() - nodes;
+    this->stats.unique += cse_worker.get_unique_count() - unique;
+
+    // without CSE each expression is printed in full, so there is no saving
+    if(cse_worker.do_cse()) this->stats.after += cse_worker.get_unique_operations() - operations;
+    else                    this->stats.after = this->stats.before;
+    this->stats.time += timer.elapsed().wall;
   }
 
 
@@ -47,7 +161,13 @@ std::string cse_map::operator[](unsigned int index)
     // check whether subscripting is within bounds;
     // if so, return appropriate symbol
     // if CSE is disabled this will be just the raw expression
-    if(index < this->list->size()) return this->cse_worker.get_symbol_with_use_count((*this->list)[index]);
+    if(index < this->list->size())
+      {
+        boost::timer::cpu_timer timer;
+        rval = this->cse_worker.get_symbol_with_use_count((*this->list)[index]);
+        this->stats.time += timer.elapsed().wall;
+        return rval;
+      }
 
     throw std::out_of_range(ERROR_OUT_OF_BOUNDS_CSE_MAP);
   }
@@ -32,7 +32,8 @@
 
 // utility class to make using CSE easier.
 // On construction it takes a vector of GiNaC expressions.
-// The resulting object can be subscripted in the same order as the input to produce the equivalent CSE get_symbol
+// The resulting object can be subscripted in the same order as the input to produce the equivalent CSE get_symbol.
+// Work done for the map is accumulated in the CSE worker's statistics for the named tensor
 class cse_map
   {
 
@@ -42,7 +43,8 @@ class cse_map
 
     //! constructor; takes ownership of a std::unique_ptr<> to a list of GiNaC expressions
     //! and uses them to set up CSE
-    cse_map(std::unique_ptr< std::vector<GiNaC::ex> > l, cse& c);
+    //! n = name of the tensor, used to report statistics
+    cse_map(std::unique_ptr< std::vector<GiNaC::ex> > l, cse& c, const std::string& n);
 
     //! destructor is default
     ~cse_map() = default;
@@ -67,6 +69,9 @@ class cse_map
     //! and it is destroyed when this object goes out of scope
     std::unique_ptr< std::vector<GiNaC::ex> > list;
 
+    //! statistics record for this tensor, owned by the CSE worker
+    cse_impl::tensor_statistics& stats;
+
   };
 
 
@@ -99,6 +99,10 @@ class language_printer
     //! generate a 'for' loop appropriate for this backend; should be supplied by a concrete class
     virtual std::string for_loop(const std::string& loop_variable, unsigned int min, unsigned int max) const = 0;
 
+    //! return annotation to be planted before a 'for' loop whose iterations are independent,
+    //! allowing it to be vectorized, if supported by this backend
+    virtual boost::optional< std::string > get_simd_annotation() const = 0;
+
 
     // INTERFACE -- ARRAY SUBSCRIPTING
 
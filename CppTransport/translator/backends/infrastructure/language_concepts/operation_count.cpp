@@ -0,0 +1,205 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+#include <cstdlib>
+#include <unordered_map>
+
+#include "operation_count.h"
+
+
+namespace operation_count_impl
+  {
+
+    struct ex_hash
+      {
+        size_t operator()(const GiNaC::ex& e) const { return(static_cast<size_t>(e.gethash())); }
+      };
+
+    struct ex_equal
+      {
+        bool operator()(const GiNaC::ex& a, const GiNaC::ex& b) const { return(a.is_equal(b)); }
+      };
+
+    using count_table = std::unordered_map< GiNaC::ex, operation_count, ex_hash, ex_equal >;
+
+
+    //! count the multiplications needed to compute an integer power n >= 1 by repeated squaring
+    unsigned long count_power_multiplies(unsigned int n)
+      {
+        unsigned long multiplies = 0;
+
+        while(n > 1)
+          {
+            multiplies += (n % 2 == 0) ? 1 : 2;
+            n /= 2;
+          }
+
+        return(multiplies);
+      }
+
+
+    //! count operations for a power with numeric exponent, following the way powers are printed
+    void count_numeric_power(const GiNaC::numeric& exponent, operation_count& count)
+      {
+        if(exponent.is_negative()) ++count.divides;
+
+        if(exponent.is_integer())
+          {
+            count.multiplies += count_power_multiplies(static_cast<unsigned int>(std::abs(exponent.to_int())));
+            return;
+          }
+
+        GiNaC::numeric doubled = GiNaC::abs(exponent) * GiNaC::numeric(2);
+        if(doubled.is_integer())
+          {
+            // half-integer powers are a square root multiplied by an integer power
+            ++count.sqrts;
+
+            unsigned int whole = static_cast<unsigned int>(doubled.to_int()) / 2;
+            if(whole > 0) count.multiplies += count_power_multiplies(whole) + 1;
+            return;
+          }
+
+        ++count.pows;
+      }
+
+
+    const operation_count& count_tree(const GiNaC::ex& expr, count_table& table)
+      {
+        auto t = table.find(expr);
+        if(t != table.end()) return t->second;
+
+        operation_count count = count_node_operations(expr);
+        for(size_t i = 0; i < expr.nops(); ++i)
+          {
+            count += count_tree(expr.op(i), table);
+          }
+
+        return table.emplace(expr, count).first->second;
+      }
+
+  }   // namespace operation_count_impl
+
+
+operation_count& operation_count::operator+=(const operation_count& obj)
+  {
+    this->adds            += obj.adds;
+    this->multiplies      += obj.multiplies;
+    this->divides         += obj.divides;
+    this->pows            += obj.pows;
+    this->exps            += obj.exps;
+    this->sqrts           += obj.sqrts;
+    this->transcendentals += obj.transcendentals;
+
+    return(*this);
+  }
+
+
+operation_count& operation_count::operator-=(const operation_count& obj)
+  {
+    this->adds            -= obj.adds;
+    this->multiplies      -= obj.multiplies;
+    this->divides         -= obj.divides;
+    this->pows            -= obj.pows;
+    this->exps            -= obj.exps;
+    this->sqrts           -= obj.sqrts;
+    this->transcendentals -= obj.transcendentals;
+
+    return(*this);
+  }
+
+
+operation_count& operation_count::operator*=(unsigned long n)
+  {
+    this->adds            *= n;
+    this->multiplies      *= n;
+    this->divides         *= n;
+    this->pows            *= n;
+    this->exps            *= n;
+    this->sqrts           *= n;
+    this->transcendentals *= n;
+
+    return(*this);
+  }
+
+
+unsigned long operation_count::total() const
+  {
+    return(this->adds + this->multiplies + this->divides + this->pows + this->exps + this->sqrts + this->transcendentals);
+  }
+
+
+void operation_count::write_json(std::ostream& out) const
+  {
+    out << "{ \"add\": " << this->adds
+        << ", \"mul\": " << this->multiplies
+        << ", \"div\": " << this->divides
+        << ", \"pow\": " << this->pows
+        << ", \"exp\": " << this->exps
+        << ", \"sqrt\": " << this->sqrts
+        << ", \"transcendental\": " << this->transcendentals
+        << ", \"total\": " << this->total() << " }";
+  }
+
+
+operation_count count_operations(const GiNaC::ex& expr)
+  {
+    operation_count_impl::count_table table;
+    return operation_count_impl::count_tree(expr, table);
+  }
+
+
+operation_count count_node_operations(const GiNaC::ex& expr)
+  {
+    operation_count count;
+
+    if(GiNaC::is_a<GiNaC::add>(expr))
+      {
+        count.adds += expr.nops() - 1;
+      }
+    else if(GiNaC::is_a<GiNaC::mul>(expr))
+      {
+        count.multiplies += expr.nops() - 1;
+      }
+    else if(GiNaC::is_a<GiNaC::power>(expr))
+      {
+        const GiNaC::ex& exponent = expr.op(1);
+
+        if(GiNaC::is_a<GiNaC::numeric>(exponent)) operation_count_impl::count_numeric_power(GiNaC::ex_to<GiNaC::numeric>(exponent), count);
+        else                                      ++count.pows;
+      }
+    else if(GiNaC::is_a<GiNaC::function>(expr))
+      {
+        const std::string& name = GiNaC::ex_to<GiNaC::function>(expr).get_name();
+
+        if     (name == "exp")  ++count.exps;
+        else if(name == "sqrt") ++count.sqrts;
+        else if(name == "pow")  ++count.pows;
+        else if(name != "abs")  ++count.transcendentals;
+      }
+
+    // symbols, numbers and indexed objects cost nothing to evaluate
+    return(count);
+  }
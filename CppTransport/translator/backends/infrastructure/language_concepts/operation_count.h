@@ -0,0 +1,107 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+#ifndef CPPTRANSPORT_OPERATION_COUNT_H
+#define CPPTRANSPORT_OPERATION_COUNT_H
+
+
+#include <iostream>
+#include <string>
+
+#include "disable_warnings.h"
+#include "ginac/ginac.h"
+
+
+//! operation_count tallies the arithmetic operations needed to evaluate emitted code.
+//! Counters are 64-bit because counts for whole expression trees, in which shared subexpressions are
+//! counted each time they appear, can be very large
+class operation_count
+  {
+
+    // INTERFACE
+
+  public:
+
+    //! accumulate another count
+    operation_count& operator+=(const operation_count& obj);
+
+    //! remove another count
+    operation_count& operator-=(const operation_count& obj);
+
+    //! scale by a number of evaluations, eg. the trip count of a loop
+    operation_count& operator*=(unsigned long n);
+
+    //! total number of operations of all kinds
+    unsigned long total() const;
+
+    //! write as a JSON object
+    void write_json(std::ostream& out) const;
+
+
+    // DATA
+
+  public:
+
+    //! additions and subtractions
+    unsigned long adds{0};
+
+    //! multiplications
+    unsigned long multiplies{0};
+
+    //! divisions
+    unsigned long divides{0};
+
+    //! calls to pow()
+    unsigned long pows{0};
+
+    //! calls to exp()
+    unsigned long exps{0};
+
+    //! square roots
+    unsigned long sqrts{0};
+
+    //! calls to other special functions
+    unsigned long transcendentals{0};
+
+  };
+
+
+inline operation_count operator-(operation_count a, const operation_count& b)
+  {
+    a -= b;
+    return(a);
+  }
+
+
+//! count the operations needed to evaluate a GiNaC expression as a tree, as if it were printed without CSE;
+//! shared subexpressions are counted each time they appear, but each distinct subexpression is traversed only once
+operation_count count_operations(const GiNaC::ex& expr);
+
+//! count the operations needed to evaluate the top-level node of a GiNaC expression, assuming its
+//! operands are already available; this is the cost of a single CSE temporary
+operation_count count_node_operations(const GiNaC::ex& expr);
+
+
+#endif //CPPTRANSPORT_OPERATION_COUNT_H
@@ -26,6 +26,8 @@
 
 #include <assert.h>
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 #include "macro.h"
 #include "timing_instrument.h"
@@ -44,7 +46,10 @@ macro_agent::macro_agent(translator_data& p, package_group& pkg, std::string pf,
     recursion_max(dm),
     recursion_depth(0),
     package(pkg),
-    output_enabled(true)
+    output_enabled(true),
+    omitted_terms(0),
+    unrolled_statements(0),
+    rolled_statements(0)
   {
     assert(recursion_max > 0);
 
@@ -171,11 +176,26 @@ std::unique_ptr< std::list<std::string> > macro_agent::apply_line(const std::str
       {
         this->unroll_index_assignment(*left_tokens, *right_tokens, LHS_assignments, RHS_assignments, counter,
                                       split_result, ctx, *r_list);
+        this->unrolled_statements += r_list->size();
+        if(this->data_payload.operation_report()) this->record_contraction(*r_list, false, 1);
+
+        // report code size for unrolled assignments which exceed the unroll policy, since these
+        // dominate the size of the translated output
+        if(r_list->size() > this->data_payload.unroll_policy())
+          {
+            std::ostringstream msg;
+            msg << MESSAGE_CODE_SIZE_LINE << " " << this->data_payload.get_stack().get_line() << ": "
+                << MESSAGE_CODE_SIZE_UNROLLED << " " << r_list->size() << " " << MESSAGE_CODE_SIZE_STATEMENTS;
+            this->data_payload.message(msg.str());
+          }
       }
     else
       {
         this->forloop_index_assignment(*left_tokens, *right_tokens, LHS_assignments, RHS_assignments, counter,
                                        split_result, ctx, *r_list);
+        this->rolled_statements += r_list->size();
+        if(this->data_payload.operation_report())
+          this->record_contraction(*r_list, true, LHS_assignments.size() * RHS_assignments.size());
       }
 
     replacements = counter;
@@ -301,6 +321,13 @@ void macro_agent::unroll_index_assignment(token_list& left_tokens, token_list& r
     // compute raw indent for LHS
     std::string raw_indent = this->compute_prefix(split_result);
 
+    // terms of an index sum may be omitted if their coefficient is known to vanish
+    const bool is_sum = split_result.get_split_type() != macro_impl::split_type::none && left_tokens.size() > 0;
+
+    // count vanishing components assigned by this line, for reporting the sparsity pattern
+    unsigned int assigned = 0;
+    unsigned int vanishing_assigned = 0;
+
     for(std::unique_ptr<indices_assignment> LHS_assign : LHS_assignments)
       {
         // evaluate LHS macros on this index assignment;
@@ -310,16 +337,9 @@ void macro_agent::unroll_index_assignment(token_list& left_tokens, token_list& r
 
         if(RHS_assignments.size() > 1)   // multiple RHS assignments
           {
-            // push the LHS evaluated on this assignment into the output list, if it is non-empty
-            if(left_tokens.size() > 0)
-              {
-                std::string lhs = left_tokens.to_string();
-                if(split_result.get_split_type() == macro_impl::split_type::sum) lhs += " = ";
-                if(split_result.get_split_type() == macro_impl::split_type::sum_equal) lhs += " += ";
-                r_list.push_back(lhs);
-              }
+            std::list<std::string> terms;
 
-            // now generate a set of RHS evaluations for this LHS evaluation
+            // generate a set of RHS evaluations for this LHS evaluation
             for(std::unique_ptr<indices_assignment> RHS_assign : RHS_assignments)
               {
                 indices_assignment total_assignment;
@@ -345,24 +365,55 @@ void macro_agent::unroll_index_assignment(token_list& left_tokens, token_list& r
                 if(left_tokens.size() ==
                    0)   // no need to format for indentation if no LHS; RHS will already include indentation
                   {
+                    ++assigned;
+                    if(this->note_assignment(this_line)) ++vanishing_assigned;
                     r_list.push_back(this_line);
                   }
+                else if(is_sum && this->is_vanishing_term(this_line))
+                  {
+                    ++this->omitted_terms;
+                  }
                 else
                   {
-                    r_list.push_back(this->dress(this_line, raw_indent, 3));
+                    terms.push_back(this->dress(this_line, raw_indent, 3));
                   }
               }
 
-            // add a trailing ; and , if the LHS is nonempty
-            if(left_tokens.size() > 0 && r_list.size() > 0)
+            if(left_tokens.size() > 0)
               {
-                if(split_result.has_trailing_semicolon())
+                if(terms.empty())
                   {
-                    r_list.back() += ";";
+                    // every term vanished; an assignment becomes an assignment to zero, and an accumulation
+                    // can be dropped entirely
+                    if(split_result.get_split_type() == macro_impl::split_type::sum)
+                      {
+                        std::string zero_line = left_tokens.to_string() + " = 0" +
+                                                (split_result.has_trailing_semicolon() ? ";" : "") +
+                                                (split_result.has_trailing_comma() ? "," : "");
+                        this->note_assignment(zero_line);
+                        r_list.push_back(zero_line);
+                      }
                   }
-                if(split_result.has_trailing_comma())
+                else
                   {
-                    r_list.back() += ",";
+                    // push the LHS evaluated on this assignment into the output list
+                    std::string lhs = left_tokens.to_string();
+                    this->vanishing.erase(macro_impl::assignment_target(lhs));
+                    if(split_result.get_split_type() == macro_impl::split_type::sum) lhs += " = ";
+                    if(split_result.get_split_type() == macro_impl::split_type::sum_equal) lhs += " += ";
+                    r_list.push_back(lhs);
+
+                    r_list.splice(r_list.end(), terms);
+
+                    // add a trailing ; and , if the LHS is nonempty
+                    if(split_result.has_trailing_semicolon())
+                      {
+                        r_list.back() += ";";
+                      }
+                    if(split_result.has_trailing_comma())
+                      {
+                        r_list.back() += ",";
+                      }
                   }
               }
           }
@@ -385,39 +436,149 @@ void macro_agent::unroll_index_assignment(token_list& left_tokens, token_list& r
             counter += right_tokens.evaluate_macros(total_assignment);
             counter += right_tokens.evaluate_macros(simple_macro_type::post);
 
+            std::string rhs = right_tokens.to_string();
+            bool vanishing_rhs = is_sum && this->is_vanishing_term(rhs);
+
+            if(vanishing_rhs)
+              {
+                ++this->omitted_terms;
+
+                // an accumulation of a vanishing term can be dropped entirely
+                if(split_result.get_split_type() == macro_impl::split_type::sum_equal) continue;
+                rhs = "0";
+              }
+
             // set up line with macro replacements, and add trailing ; and , if necessary;
             // since the line includes the full LHS it needs no special formatting to account for indentation
             std::string full_line = left_tokens.to_string();
             if(split_result.get_split_type() == macro_impl::split_type::sum) full_line += " =";
             if(split_result.get_split_type() == macro_impl::split_type::sum_equal) full_line += " +=";
 
-            full_line += (left_tokens.size() > 0 ? " " : "") + right_tokens.to_string() +
+            full_line += (left_tokens.size() > 0 ? " " : "") + rhs +
                          (split_result.has_trailing_semicolon() ? ";" : "") +
                          (split_result.has_trailing_comma() ? "," : "");
+
+            if(is_sum)
+              {
+                if(vanishing_rhs) this->note_assignment(full_line);
+                else              this->vanishing.erase(macro_impl::assignment_target(left_tokens.to_string()));
+              }
+            else
+              {
+                ++assigned;
+                if(this->note_assignment(full_line)) ++vanishing_assigned;
+              }
+
             r_list.push_back(full_line);
           }
       }
+
+    // report sparsity pattern of tensors assigned by this line
+    if(vanishing_assigned > 0)
+      {
+        std::ostringstream msg;
+        msg << MESSAGE_SPARSITY_LINE << " " << this->data_payload.get_stack().get_line() << ": "
+            << vanishing_assigned << " " << MESSAGE_SPARSITY_OF << " " << assigned << " " << MESSAGE_SPARSITY_VANISH;
+        this->data_payload.message(msg.str());
+      }
 	}
 
 
+bool macro_agent::note_assignment(const std::string& line)
+  {
+    bool assigned_zero = false;
+
+    for(const macro_impl::assignment_record& rec : macro_impl::split_assignments(line))
+      {
+        if(!rec.compound && macro_impl::is_vanishing_literal(rec.value))
+          {
+            this->vanishing.insert(rec.target);
+            assigned_zero = true;
+          }
+        else
+          {
+            this->vanishing.erase(rec.target);
+          }
+      }
+
+    return assigned_zero;
+  }
+
+
+bool macro_agent::is_vanishing_term(const std::string& term) const
+  {
+    // a term vanishes if it is a product, one of whose factors is a literal zero or an identifier known
+    // to have been assigned zero; anything more complicated is conservatively assumed not to vanish
+    size_t pos = term.find_first_not_of(" \t");
+    if(pos == std::string::npos) return false;
+    if(term[pos] == '+' || term[pos] == '-') ++pos;
+
+    std::list<std::string> factors;
+    std::string current;
+    int depth = 0;
+
+    for(; pos < term.length(); ++pos)
+      {
+        char c = term[pos];
+
+        if(c == '(' || c == '[') ++depth;
+        if(c == ')' || c == ']') --depth;
+
+        if(depth == 0)
+          {
+            if(c == '*')
+              {
+                factors.push_back(current);
+                current.clear();
+                continue;
+              }
+
+            if(std::strchr("+-/%<>=?:,&|!", c) != nullptr) return false;
+          }
+
+        current += c;
+      }
+    factors.push_back(current);
+
+    for(std::string& factor : factors)
+      {
+        boost::algorithm::erase_all(factor, " ");
+        boost::algorithm::erase_all(factor, "\t");
+        if(macro_impl::is_vanishing_literal(factor) || this->vanishing.count(factor) > 0) return true;
+      }
+
+    return false;
+  }
+
+
 void macro_agent::forloop_index_assignment(token_list& left_tokens, token_list& right_tokens,
                                            assignment_set& LHS_assignments, assignment_set& RHS_assignments,
                                            unsigned int& counter, macro_impl::split_string& split_result,
                                            error_context& ctx, std::list<std::string>& r_list)
   {
+    // assignments made inside a loop can't be tracked component by component, so forget anything
+    // previously known to vanish
+    this->vanishing.clear();
+
     std::string raw_indent = this->compute_prefix(split_result);
     unsigned int current_indent = 0;
 
+    language_printer& prn = this->package.get_language_printer();
+
     if(LHS_assignments.size() == 0)
       {
-        language_printer& prn = this->package.get_language_printer();
         r_list.push_back(prn.comment("Skipped: empty index range (LHS index set is empty)"));
       return;
       }
 
+    // loops can be arranged for vectorization only if the backend can annotate them, and the
+    // line is an assignment to an indexed LHS (so that iterations of the innermost loop are independent)
+    const bool vectorize = this->data_payload.vectorize() && prn.get_simd_annotation()
+                           && left_tokens.size() > 0 && split_result.get_split_type() != macro_impl::split_type::none;
+
     this->plant_LHS_forloop(LHS_assignments.idx_set_begin(), LHS_assignments.idx_set_end(),
                             RHS_assignments, left_tokens, right_tokens, counter, split_result,
-                            ctx, r_list, raw_indent, current_indent);
+                            ctx, r_list, raw_indent, current_indent, vectorize);
   }
 
 
@@ -446,8 +607,11 @@ void macro_agent::plant_LHS_forloop(index_database<abstract_index>::const_iterat
                                     assignment_set& RHS_assignments, token_list& left_tokens, token_list& right_tokens,
                                     unsigned int& counter, macro_impl::split_string& split_result, error_context& ctx,
                                     std::list<std::string>& r_list, const std::string& raw_indent,
-                                    unsigned int current_indent)
+                                    unsigned int current_indent, bool vectorize)
   {
+    index_database<abstract_index>::const_iterator next = current;
+    if(current != end) ++next;
+
     if(current == end)
       {
         // evaluate macros, converting indices to abstract 'for' loop variables
@@ -467,6 +631,11 @@ void macro_agent::plant_LHS_forloop(index_database<abstract_index>::const_iterat
         this->plant_RHS_forloop(RHS_assignments.idx_set_begin(), RHS_assignments.idx_set_end(), left_tokens,
                                 right_tokens, counter, split_result, ctx, r_list, raw_indent, current_indent, RHS_assignments.size() == 1);
       }
+    else if(vectorize && next == end)
+      {
+        this->plant_vectorized_forloop(*current, RHS_assignments, left_tokens, right_tokens, counter, split_result, ctx,
+                                       r_list, raw_indent, current_indent);
+      }
     else
       {
         language_printer& printer = this->package.get_language_printer();
@@ -479,8 +648,8 @@ void macro_agent::plant_LHS_forloop(index_database<abstract_index>::const_iterat
         for(unsigned int i = 0; i < printer.get_block_delimiter_indent(); ++i) brace_indent << " ";
 
         if(start_delimiter) r_list.push_back(this->dress(brace_indent.str() + *start_delimiter, raw_indent, current_indent));
-        this->plant_LHS_forloop(++current, end, RHS_assignments, left_tokens, right_tokens, counter, split_result, ctx,
-                                r_list, raw_indent, current_indent + printer.get_block_indent());
+        this->plant_LHS_forloop(next, end, RHS_assignments, left_tokens, right_tokens, counter, split_result, ctx,
+                                r_list, raw_indent, current_indent + printer.get_block_indent(), vectorize);
         if(end_delimiter) r_list.push_back(this->dress(brace_indent.str() + *end_delimiter, raw_indent, current_indent));
       }
   }
@@ -491,7 +660,8 @@ void macro_agent::plant_RHS_forloop(index_database<abstract_index>::const_iterat
                                     token_list& left_tokens, token_list& right_tokens, unsigned int& counter,
                                     macro_impl::split_string& split_result, error_context& ctx,
                                     std::list<std::string>& r_list, const std::string& raw_indent,
-                                    unsigned int current_indent, bool coalesce)
+                                    unsigned int current_indent, bool coalesce,
+                                    boost::optional<const abstract_index&> inner)
   {
     if(current == end)
       {
@@ -519,7 +689,8 @@ void macro_agent::plant_RHS_forloop(index_database<abstract_index>::const_iterat
         total_line += right_line;
         if(left_tokens.size() == 0) boost::algorithm::trim_left(total_line);
 
-        r_list.push_back(this->dress(total_line, raw_indent, current_indent));
+        if(inner) this->plant_simd_forloop(*inner, total_line, r_list, raw_indent, current_indent);
+        else      r_list.push_back(this->dress(total_line, raw_indent, current_indent));
       }
     else
       {
@@ -534,12 +705,59 @@ void macro_agent::plant_RHS_forloop(index_database<abstract_index>::const_iterat
 
         if(start_delimiter) r_list.push_back(this->dress(brace_indent.str() + *start_delimiter, raw_indent, current_indent));
         this->plant_RHS_forloop(++current, end, left_tokens, right_tokens, counter, split_result, ctx, r_list,
-                                raw_indent, current_indent + printer.get_block_indent(), coalesce);
+                                raw_indent, current_indent + printer.get_block_indent(), coalesce, inner);
         if(end_delimiter) r_list.push_back(this->dress(brace_indent.str() + *end_delimiter, raw_indent, current_indent));
       }
   }
 
 
+void macro_agent::plant_vectorized_forloop(const abstract_index& inner, assignment_set& RHS_assignments,
+                                           token_list& left_tokens, token_list& right_tokens, unsigned int& counter,
+                                           macro_impl::split_string& split_result, error_context& ctx,
+                                           std::list<std::string>& r_list, const std::string& raw_indent,
+                                           unsigned int current_indent)
+  {
+    // evaluate macros, converting indices to abstract 'for' loop variables
+    counter += left_tokens.evaluate_macros();
+    counter += left_tokens.evaluate_macros(simple_macro_type::post);
+
+    // zero the accumulator in a loop of its own, so the RHS loops can be planted outside the inner loop;
+    // as in plant_LHS_forloop(), this is not needed if there are no RHS assignments
+    if(RHS_assignments.size() > 1 && split_result.get_split_type() == macro_impl::split_type::sum)
+      {
+        std::string zero_stmt = left_tokens.to_string() + " = 0;";
+        boost::algorithm::trim_left(zero_stmt);
+        this->plant_simd_forloop(inner, zero_stmt, r_list, raw_indent, current_indent);
+      }
+
+    // summation order for each component is unchanged, so the result is identical to the
+    // unvectorized loop nest
+    this->plant_RHS_forloop(RHS_assignments.idx_set_begin(), RHS_assignments.idx_set_end(), left_tokens,
+                            right_tokens, counter, split_result, ctx, r_list, raw_indent, current_indent,
+                            RHS_assignments.size() == 1, inner);
+  }
+
+
+void macro_agent::plant_simd_forloop(const abstract_index& idx, const std::string& stmt, std::list<std::string>& r_list,
+                                     const std::string& raw_indent, unsigned int current_indent)
+  {
+    language_printer& printer = this->package.get_language_printer();
+    boost::optional< std::string > annotation = printer.get_simd_annotation();
+    boost::optional< std::string > start_delimiter = printer.get_start_block_delimiter();
+    boost::optional< std::string > end_delimiter = printer.get_end_block_delimiter();
+
+    if(annotation) r_list.push_back(this->dress(*annotation, raw_indent, current_indent));
+    r_list.push_back(this->dress(printer.for_loop(idx.get_loop_variable(), 0, idx.numeric_range()), raw_indent, current_indent));
+
+    std::ostringstream brace_indent;
+    for(unsigned int i = 0; i < printer.get_block_delimiter_indent(); ++i) brace_indent << " ";
+
+    if(start_delimiter) r_list.push_back(this->dress(brace_indent.str() + *start_delimiter, raw_indent, current_indent));
+    r_list.push_back(this->dress(stmt, raw_indent, current_indent + printer.get_block_indent()));
+    if(end_delimiter) r_list.push_back(this->dress(brace_indent.str() + *end_delimiter, raw_indent, current_indent));
+  }
+
+
 std::string macro_agent::dress(std::string out_str, const std::string& raw_indent, unsigned int current_indent)
   {
     std::ostringstream out;
@@ -777,3 +995,263 @@ macro_impl::split_string::split_string(const std::string& line, const std::strin
         right.pop_back();
       }
   }
+
+
+
+void macro_agent::record_contraction(const std::list<std::string>& lines, bool rolled, unsigned int evaluations)
+  {
+    operation_count ops = macro_impl::count_statement_operations(lines);
+    if(ops.total() == 0) return;
+
+    ops *= evaluations;
+    this->contractions.push_back(macro_impl::contraction_record{ this->data_payload.get_stack().get_line(), rolled, ops });
+  }
+
+std::string macro_impl::assignment_target(const std::string& lhs)
+  {
+    std::string target = boost::algorithm::trim_copy(lhs);
+
+    // the target is the final word of the left-hand side, which may be preceded by a type declaration;
+    // whitespace inside brackets belongs to a subscript such as x[FLATTEN(0, 1)], so only a break at the
+    // outermost level separates the target from the declaration
+    int depth = 0;
+    for(size_t pos = target.length(); pos > 0; --pos)
+      {
+        char c = target[pos-1];
+
+        if(c == ')' || c == ']') ++depth;
+        if(c == '(' || c == '[') --depth;
+
+        if(depth == 0 && (c == ' ' || c == '\t'))
+          {
+            target.erase(0, pos);
+            break;
+          }
+      }
+
+    // a reference or pointer declarator belongs to the declaration, not the target
+    size_t start = target.find_first_not_of("&*");
+    target.erase(0, start == std::string::npos ? target.length() : start);
+
+    boost::algorithm::erase_all(target, " ");
+    boost::algorithm::erase_all(target, "\t");
+
+    return target;
+  }
+
+
+namespace macro_impl
+  {
+
+    //! determine whether the '=' at position pos completes a <<= or >>= operator
+    static bool is_shift_assignment(const std::string& statement, size_t pos)
+      {
+        return pos > 1 && (statement[pos-1] == '<' || statement[pos-1] == '>') && statement[pos-2] == statement[pos-1];
+      }
+
+  }
+
+
+std::list<macro_impl::assignment_record> macro_impl::split_assignments(const std::string& line)
+  {
+    std::list<assignment_record> records;
+
+    // break the line into statements at top-level semicolons
+    std::list<std::string> statements;
+    std::string current;
+    int depth = 0;
+
+    for(char c : line)
+      {
+        if(c == '(' || c == '[' || c == '{') ++depth;
+        if(c == ')' || c == ']' || c == '}') --depth;
+
+        if(depth == 0 && c == ';')
+          {
+            statements.push_back(current);
+            current.clear();
+            continue;
+          }
+
+        current += c;
+      }
+    statements.push_back(current);
+
+    for(const std::string& statement : statements)
+      {
+        // locate the assignment operators at top level; in a chained assignment such as a = b = 0
+        // every operand but the last is a target
+        std::vector<size_t> ops;
+        depth = 0;
+
+        for(size_t pos = 0; pos < statement.length(); ++pos)
+          {
+            char c = statement[pos];
+
+            if(c == '(' || c == '[' || c == '{') ++depth;
+            if(c == ')' || c == ']' || c == '}') --depth;
+
+            if(depth != 0 || c != '=') continue;
+
+            // exclude comparisons
+            if(pos+1 < statement.length() && statement[pos+1] == '=')
+              {
+                ++pos;
+                continue;
+              }
+            if(pos > 0 && std::strchr("=!<>", statement[pos-1]) != nullptr && !is_shift_assignment(statement, pos)) continue;
+
+            ops.push_back(pos);
+          }
+
+        if(ops.empty())
+          {
+            // an increment or decrement also modifies its operand
+            std::string s = boost::algorithm::trim_copy(statement);
+            while(!s.empty() && s.back() == ',')
+              {
+                s.pop_back();
+                boost::algorithm::trim_right(s);
+              }
+
+            if(s.length() > 2 && (boost::algorithm::starts_with(s, "++") || boost::algorithm::starts_with(s, "--")))
+              {
+                records.push_back(assignment_record{ assignment_target(s.substr(2)), std::string(), true });
+              }
+            else if(s.length() > 2 && (boost::algorithm::ends_with(s, "++") || boost::algorithm::ends_with(s, "--")))
+              {
+                records.push_back(assignment_record{ assignment_target(s.substr(0, s.length()-2)), std::string(), true });
+              }
+
+            continue;
+          }
+
+        std::string value = statement.substr(ops.back()+1);
+        boost::algorithm::trim(value);
+        while(!value.empty() && value.back() == ',')
+          {
+            value.pop_back();
+            boost::algorithm::trim_right(value);
+          }
+
+        size_t begin = 0;
+        for(size_t op : ops)
+          {
+            std::string lhs = statement.substr(begin, op - begin);
+            bool compound = op > begin && std::strchr("+-*/%&|^", statement[op-1]) != nullptr;
+            if(compound) lhs.pop_back();
+
+            // shift operators <<= and >>= have a two-character prefix
+            if(is_shift_assignment(statement, op))
+              {
+                compound = true;
+                lhs.erase(lhs.length()-2);
+              }
+
+            std::string target = assignment_target(lhs);
+            if(!target.empty()) records.push_back(assignment_record{ target, value, compound });
+
+            begin = op+1;
+          }
+      }
+
+    return records;
+  }
+
+
+bool macro_impl::is_vanishing_literal(const std::string& value)
+  {
+    std::string v = boost::algorithm::trim_copy(value);
+    if(v.empty()) return false;
+
+    // strip enclosing brackets
+    while(v.length() > 2 && v.front() == '(' && v.back() == ')')
+      {
+        v = boost::algorithm::trim_copy(v.substr(1, v.length()-2));
+      }
+
+    char* end = nullptr;
+    double d = std::strtod(v.c_str(), &end);
+
+    return end != v.c_str() && *end == '\0' && d == 0.0;
+  }
+
+
+operation_count macro_impl::count_statement_operations(const std::list<std::string>& lines)
+  {
+    operation_count ops;
+
+    std::string text;
+    for(const std::string& line : lines)
+      {
+        text += line;
+        text += '\n';
+      }
+
+    std::vector<std::string> statements;
+    boost::algorithm::split(statements, text, boost::algorithm::is_any_of(";"));
+
+    for(const std::string& statement : statements)
+      {
+        // locate the assignment operator, if there is one; only the right-hand side is evaluated
+        size_t eq = std::string::npos;
+        for(size_t pos = 0; pos < statement.length(); ++pos)
+          {
+            if(statement[pos] != '=') continue;
+            if(pos+1 < statement.length() && statement[pos+1] == '=') { ++pos; continue; }
+            if(pos > 0 && std::strchr("=!<>", statement[pos-1]) != nullptr) continue;
+
+            eq = pos;
+            break;
+          }
+
+        if(eq == std::string::npos) continue;
+        if(eq > 0 && statement[eq-1] == '+') ++ops.adds;
+        if(eq > 0 && statement[eq-1] == '-') ++ops.adds;
+        if(eq > 0 && statement[eq-1] == '*') ++ops.multiplies;
+        if(eq > 0 && statement[eq-1] == '/') ++ops.divides;
+
+        const std::string rhs = statement.substr(eq+1);
+        int subscript = 0;
+        char previous = '\0';
+
+        for(size_t pos = 0; pos < rhs.length(); ++pos)
+          {
+            char c = rhs[pos];
+
+            // arithmetic inside array subscripts is index computation, not evaluation of the expression
+            if(c == '[') { ++subscript; previous = c; continue; }
+            if(c == ']') { --subscript; previous = c; continue; }
+            if(subscript > 0) continue;
+
+            if(c == '*') ++ops.multiplies;
+            else if(c == '/') ++ops.divides;
+            else if((c == '+' || c == '-') && (pos+1 >= rhs.length() || rhs[pos+1] != '>'))
+              {
+                // count only binary operators; exclude unary signs and exponents of floating-point literals
+                bool binary = std::isalnum(previous) || previous == '_' || previous == ')' || previous == ']' || previous == '.';
+
+                if(binary && (previous == 'e' || previous == 'E'))
+                  {
+                    size_t start = rhs.find_last_not_of("0123456789.eE", pos-1);
+                    start = (start == std::string::npos) ? 0 : start+1;
+                    if(start < pos && std::isdigit(rhs[start])) binary = false;
+                  }
+
+                if(binary) ++ops.adds;
+              }
+            else if(c == 's' && rhs.compare(pos, 5, "std::") == 0)
+              {
+                if     (rhs.compare(pos, 9, "std::pow(") == 0)  ++ops.pows;
+                else if(rhs.compare(pos, 9, "std::exp(") == 0)  ++ops.exps;
+                else if(rhs.compare(pos, 10, "std::sqrt(") == 0) ++ops.sqrts;
+                else if(rhs.compare(pos, 9, "std::abs(") != 0)  ++ops.transcendentals;
+                pos += 4;
+              }
+
+            if(!std::isspace(c)) previous = c;
+          }
+      }
+
+    return ops;
+  }
@@ -33,6 +33,7 @@
 #include <list>
 #include <string>
 #include <functional>
+#include <unordered_set>
 
 #include "core.h"
 #include "index_assignment.h"
@@ -127,6 +128,56 @@ namespace macro_impl
 
       };
 
+
+    //! record of a single target modified by an emitted line
+    class assignment_record
+      {
+
+      public:
+
+        //! identifier or component assigned, with whitespace removed
+        std::string target;
+
+        //! value assigned; empty if the target is modified by an increment or decrement
+        std::string value;
+
+        //! is the assignment made by a compound operator such as +=?
+        bool compound;
+
+      };
+
+    //! extract the target of an assignment from its left-hand side, discarding any type declaration;
+    //! whitespace is removed so that targets compare equal however their subscripts were spaced
+    std::string assignment_target(const std::string& lhs);
+
+    //! break an emitted line into the targets it modifies, together with the values assigned to them;
+    //! every statement on the line and every link of a chained assignment is reported
+    std::list<assignment_record> split_assignments(const std::string& line);
+
+    //! determine whether a string is a numeric literal equal to zero
+    bool is_vanishing_literal(const std::string& value);
+
+    //! estimate the operations needed to evaluate a group of emitted statements, by inspecting their text
+    operation_count count_statement_operations(const std::list<std::string>& lines);
+
+
+    //! record of the operations emitted by a single template line containing an index assignment
+    class contraction_record
+      {
+
+      public:
+
+        //! line number in the template
+        unsigned int line;
+
+        //! was the assignment planted as a for-loop?
+        bool rolled;
+
+        //! estimated operations needed to evaluate the assignment, including loop trip counts
+        operation_count ops;
+
+      };
+
   }
 
 
@@ -172,6 +223,15 @@ class macro_agent
     bool is_enabled() const { return this->output_enabled; }
 
 
+    // INTERFACE -- SPARSITY
+
+  public:
+
+    //! forget identifiers known to have been assigned zero; called when a new temporary pool begins,
+    //! since the same identifiers may be reassigned in a new scope
+    void clear_vanishing() { this->vanishing.clear(); }
+
+
 		// INTERFACE - STATISTICS
 
   public:
@@ -182,6 +242,18 @@ class macro_agent
 		//! get time spent doing tokenization
 		boost::timer::nanosecond_type get_tokenization_time() const { return(this->tokenization_timer.elapsed().wall); }
 
+    //! get number of terms omitted from index sums because their coefficient vanishes
+    unsigned int get_omitted_terms() const { return(this->omitted_terms); }
+
+    //! get number of statements emitted by unrolled index assignments
+    unsigned int get_unrolled_statements() const { return(this->unrolled_statements); }
+
+    //! get number of lines emitted by index assignments planted as for-loops
+    unsigned int get_rolled_statements() const { return(this->rolled_statements); }
+
+    //! get operation counts for each index assignment; only populated if an operation report was requested
+    const std::vector<macro_impl::contraction_record>& get_contractions() const { return(this->contractions); }
+
 
 		// INTERNAL API
 
@@ -231,6 +303,26 @@ class macro_agent
                                  error_context& ctx, std::list<std::string>& r_list);
 
 
+    // INTERNAL API -- SPARSITY
+
+  protected:
+
+    //! record an emitted line, noting which of the targets it modifies are assigned zero
+    //! and forgetting any earlier record for the others; returns true if any target is assigned zero
+    bool note_assignment(const std::string& line);
+
+    //! determine whether a term in an index sum has a coefficient known to vanish
+    bool is_vanishing_term(const std::string& term) const;
+
+
+    // INTERNAL API -- OPERATION COUNTS
+
+  protected:
+
+    //! record the operations emitted for the current line, scaled by the number of times they are evaluated
+    void record_contraction(const std::list<std::string>& lines, bool rolled, unsigned int evaluations);
+
+
     // INTERNAL API -- HANDLE INDEX SET BY FOR-LOOP
 
   protected:
@@ -249,15 +341,29 @@ class macro_agent
                            index_database<abstract_index>::const_iterator end,
                            assignment_set& RHS_assignments, token_list& left_tokens, token_list& right_tokens,
                            unsigned int& counter, macro_impl::split_string& split_result, error_context& ctx,
-                           std::list<std::string>& r_list, const std::string& raw_indent, unsigned int current_indent);
+                           std::list<std::string>& r_list, const std::string& raw_indent, unsigned int current_indent,
+                           bool vectorize);
 
-    //! plant code representing RHS for-loops (recursive)
+    //! plant code representing RHS for-loops (recursive);
+    //! if 'inner' is supplied, the assignment is wrapped in a vectorizable loop over that LHS index
     void plant_RHS_forloop(index_database<abstract_index>::const_iterator current,
                            index_database<abstract_index>::const_iterator end,
                            token_list& left_tokens, token_list& right_tokens, unsigned int& counter,
                            macro_impl::split_string& split_result, error_context& ctx,
                            std::list<std::string>& r_list, const std::string& raw_indent, unsigned int current_indent,
-                           bool coalesce);
+                           bool coalesce, boost::optional<const abstract_index&> inner = boost::none);
+
+    //! plant code for the innermost LHS index when vectorizing: its loop is moved inside any
+    //! RHS loops, so that the vectorized loop runs over the last (contiguous) index of the LHS
+    void plant_vectorized_forloop(const abstract_index& inner, assignment_set& RHS_assignments,
+                                  token_list& left_tokens, token_list& right_tokens, unsigned int& counter,
+                                  macro_impl::split_string& split_result, error_context& ctx,
+                                  std::list<std::string>& r_list, const std::string& raw_indent,
+                                  unsigned int current_indent);
+
+    //! plant a single statement inside an annotated, vectorizable for-loop
+    void plant_simd_forloop(const abstract_index& idx, const std::string& stmt, std::list<std::string>& r_list,
+                            const std::string& raw_indent, unsigned int current_indent);
 
     //! format an output string with correct indents
     std::string dress(std::string out_str, const std::string& raw_indent, unsigned int current_indent);
@@ -306,6 +412,27 @@ class macro_agent
     index_ruleset local_index_rules;
 
 
+    // SPARSITY
+
+    //! identifiers known to have been assigned zero within the current temporary pool
+    std::unordered_set<std::string> vanishing;
+
+    //! number of terms omitted from index sums because their coefficient vanishes
+    unsigned int omitted_terms;
+
+
+    // CODE SIZE
+
+    //! number of statements emitted by unrolled index assignments
+    unsigned int unrolled_statements;
+
+    //! number of lines emitted by index assignments planted as for-loops
+    unsigned int rolled_statements;
+
+    //! operation counts for each index assignment
+    std::vector<macro_impl::contraction_record> contractions;
+
+
     // MACRO CONFIGURATION
 
     //! macro prefix string (usually '$')
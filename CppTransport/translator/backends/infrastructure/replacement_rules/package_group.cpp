@@ -45,6 +45,25 @@ package_group::~package_group()
 		    this->data_payload.message(msg.str());
 			}
 
+    // report CSE work for each tensor
+    for(const auto& item : this->cse_worker->get_tensor_statistics())
+      {
+        const cse_impl::tensor_statistics& stats = item.second;
+        if(stats.nodes == 0) continue;
+
+        double shared = 1.0 - static_cast<double>(stats.unique) / static_cast<double>(stats.nodes);
+
+        std::ostringstream cse_msg;
+        cse_msg << MESSAGE_CSE_TENSOR << " '" << item.first << "': " << stats.nodes << " " << MESSAGE_CSE_NODES
+                << ", " << stats.unique << " " << MESSAGE_CSE_UNIQUE;
+        auto prec = cse_msg.precision();
+        cse_msg.precision(3);
+        cse_msg << " (" << 100.0*shared << "% " << MESSAGE_CSE_SHARED << ")";
+        cse_msg.precision(prec);
+        cse_msg << ", " << format_time(stats.time);
+        this->data_payload.message(cse_msg.str());
+      }
+
     auto hits = this->lambda_mgr->get_hits();
     auto misses = this->lambda_mgr->get_misses();
 
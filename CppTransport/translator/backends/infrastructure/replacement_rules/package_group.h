@@ -140,6 +140,9 @@ class package_group
     //! return reference to language printer
     language_printer& get_language_printer() { return(*this->l_printer); }    // will throw exception if l_printer has not been set
 
+    //! return reference to CSE worker, eg. to query statistics for the tensors it has processed
+    const cse& get_cse_worker() const { return(*this->cse_worker); }
+
 
 		// INTERFACE - STATISTICS
 
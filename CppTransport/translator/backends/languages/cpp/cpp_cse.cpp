@@ -26,6 +26,8 @@
 
 #include <string>
 #include <sstream>
+#include <algorithm>
+#include <cctype>
 
 #include "cse.h"
 #include "cpp_cse.h"
@@ -131,32 +133,23 @@ namespace cpp
       }
 
 
-    // utility function to properly bracket the base of a power expression
-    static std::string unwrap_power(const std::string& base_str, const GiNaC::ex& base_expr, unsigned int factors)
+    // utility function to properly bracket a factor in a power expression;
+    // temporaries, symbols and unsigned literals can be used directly
+    static std::string bracket_factor(const std::string& factor)
       {
-        bool simple = GiNaC::is_a<GiNaC::symbol>(base_expr)
-                      || GiNaC::is_a<GiNaC::constant>(base_expr)
-                      || GiNaC::is_a<GiNaC::function>(base_expr);
+        bool simple = !factor.empty()
+                      && std::all_of(factor.begin(), factor.end(),
+                                     [](char c) -> bool { return std::isalnum(c) || c == '_' || c == '.'; });
 
-        std::ostringstream buf;
-
-        unsigned int count = 0;
-        while(factors > 0)
-          {
-            if(count > 0) buf << "*";
-            if(simple) buf << base_str;
-            else       buf << "(" << base_str << ")";
-
-            --factors;
-            ++count;
-          }
-
-        return buf.str();
+        if(simple) return factor;
+        return "(" + factor + ")";
       }
 
 
-    // treat powers specially, because it's better to unroll them and
-    // avoid a function call if we have an exact integral power
+    // treat powers specially, because it's better to avoid a function call where possible.
+    // Integer powers are built up by repeated squaring, and half-integer powers from a square root;
+    // the lower powers, square roots and positive powers whose reciprocals are needed are requested from
+    // the CSE worker as auxiliary symbols, so they are computed once and shared between all their uses
     std::string cpp_cse::print_power(const GiNaC::ex& expr, bool use_count)
       {
         std::ostringstream out;
@@ -180,39 +173,75 @@ namespace cpp
         if(use_count) exponent = this->get_symbol_with_use_count(exponent_expr);
         else exponent = this->get_symbol_without_use_count(exponent_expr);
 
-        if(GiNaC::is_a<GiNaC::numeric>(exponent_expr))
+        std::string base;
+        if(use_count) base = this->get_symbol_with_use_count(base_expr);
+        else base = this->get_symbol_without_use_count(base_expr);
+
+        if(!GiNaC::is_a<GiNaC::numeric>(exponent_expr))
           {
-            const auto& exp_numeric = GiNaC::ex_to<GiNaC::numeric>(exponent_expr);
-        
-            std::string base;
-            if(use_count) base = this->get_symbol_with_use_count(expr.op(0));
-            else base = this->get_symbol_without_use_count(expr.op(0));
+            out << "std::pow(" << base << "," << exponent << ")";
+            return(out.str());
+          }
+
+        const auto& exp_numeric = GiNaC::ex_to<GiNaC::numeric>(exponent_expr);
+        const bool half_integer = !GiNaC::is_integer(exp_numeric) && GiNaC::is_integer(exp_numeric*GiNaC::numeric(2));
+
+        if(!GiNaC::is_integer(exp_numeric) && !half_integer)
+          {
+            out << "std::pow(" << base << "," << exponent << ")";
+            return(out.str());
+          }
+
+        if(exp_numeric.is_zero())
+          {
+            out << "1.0";
+            return(out.str());
+          }
 
-            if(GiNaC::is_integer(exp_numeric))
+        // a negative power is the reciprocal of the corresponding positive power, which is shared with any
+        // other expressions that use it
+        if(exp_numeric.is_negative())
+          {
+            out << "1.0/" << bracket_factor(this->get_auxiliary_symbol(GiNaC::pow(base_expr, -exp_numeric), use_count));
+            return(out.str());
+          }
+
+        if(half_integer)
+          {
+            // x^(n+1/2) = x^n * sqrt(x)
+            GiNaC::numeric whole = exp_numeric - GiNaC::numeric(1,2);
+
+            if(whole.is_zero())
               {
-                if(GiNaC::is_nonneg_integer(exp_numeric))
-                  {
-                    if(exp_numeric.to_int() == 0) out << "1.0";
-                    else if(exp_numeric.to_int() == 1) out << unwrap_power(base, base_expr, 1);
-                    else if(exp_numeric.to_int() == 2) out << "(" << unwrap_power(base, base_expr, 2) << ")";
-                    else if(exp_numeric.to_int() == 3) out << "(" << unwrap_power(base, base_expr, 3) << ")";
-                    else if(exp_numeric.to_int() == 4) out << "(" << unwrap_power(base, base_expr, 4) << ")";
-                    else out << "std::pow(" << base << "," << exp_numeric.to_int() << ")";
-                  }
-                else  // negative integer
-                  {
-                    if(exp_numeric.to_int() == -0) out << "1.0";
-                    else if(exp_numeric.to_int() == -1) out << "1.0/" << unwrap_power(base, base_expr, 1);
-                    else if(exp_numeric.to_int() == -2) out << "1.0/" << "(" << unwrap_power(base, base_expr, 2) << ")";
-                    else if(exp_numeric.to_int() == -3) out << "1.0/" << "(" << unwrap_power(base, base_expr, 3) << ")";
-                    else if(exp_numeric.to_int() == -4) out << "1.0/" << "(" << unwrap_power(base, base_expr, 4) << ")";
-                    else out << "std::pow(" << base << "," << exp_numeric.to_int() << ")";
-                  }
+                out << "std::sqrt(" << base << ")";
               }
-            else  // not an integer
+            else
               {
-                out << "std::pow(" << base << "," << exponent << ")";
+                out << "(" << bracket_factor(this->get_auxiliary_symbol(GiNaC::pow(base_expr, whole), use_count))
+                    << "*" << bracket_factor(this->get_auxiliary_symbol(GiNaC::sqrt(base_expr), use_count)) << ")";
               }
+
+            return(out.str());
+          }
+
+        int power = exp_numeric.to_int();
+
+        if(power == 1)
+          {
+            out << bracket_factor(base);
+          }
+        else if(power % 2 == 0)
+          {
+            // x^(2n) = x^n * x^n
+            GiNaC::ex half = GiNaC::pow(base_expr, power/2);
+            std::string half_str = bracket_factor(this->get_auxiliary_symbol(half, use_count));
+            out << "(" << half_str << "*" << half_str << ")";
+          }
+        else
+          {
+            // x^(2n+1) = x^(2n) * x
+            GiNaC::ex even = GiNaC::pow(base_expr, power-1);
+            out << "(" << bracket_factor(this->get_auxiliary_symbol(even, use_count)) << "*" << bracket_factor(base) << ")";
           }
 
         return(out.str());
@@ -67,7 +67,7 @@ namespace cpp
         std::string print_operands(const GiNaC::ex& expr, std::string op, bool use_count) override;
     
         //! special implementation of print_operands() to print a power;
-        //! uses strength reduction to compute integer powers by multiplication for small enough exponents
+        //! uses strength reduction to compute integer and half-integer powers by multiplication and square roots
         std::string print_power(const GiNaC::ex& expr, bool use_count);
 
       };
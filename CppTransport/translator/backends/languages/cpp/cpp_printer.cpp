@@ -33,4 +33,10 @@
 namespace cpp
   {
 
+    boost::optional<std::string> cpp_printer::get_simd_annotation() const
+      {
+        // honoured when the model is compiled with -fopenmp-simd (or -fopenmp), and ignored otherwise
+        return std::string("#pragma omp simd");
+      }
+
   } // namespace cpp
@@ -49,7 +49,12 @@ namespace cpp
         virtual ~cpp_printer() = default;
 
 
-        // NO METHODS OVERRIDDEN
+        // INTERFACE -- CONTROL STRUCTURES
+
+      public:
+
+        //! return annotation for a vectorizable 'for' loop
+        virtual boost::optional< std::string > get_simd_annotation() const override;
 
       };
 
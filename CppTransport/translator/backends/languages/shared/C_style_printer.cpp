@@ -81,6 +81,12 @@ std::string C_style_printer::for_loop(const std::string& loop_variable, unsigned
   }
 
 
+boost::optional<std::string> C_style_printer::get_simd_annotation() const
+  {
+    return boost::none;
+  }
+
+
 std::string C_style_printer::initialization_list(const std::vector<std::string>& list, bool quote) const
   {
     std::ostringstream stmt;
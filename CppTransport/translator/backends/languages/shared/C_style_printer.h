@@ -165,6 +165,9 @@ class C_style_printer: public language_printer
     //! generate a 'for' loop
     virtual std::string for_loop(const std::string& loop_variable, unsigned int min, unsigned int max) const override;
 
+    //! return annotation for a vectorizable 'for' loop; none by default
+    virtual boost::optional< std::string > get_simd_annotation() const override;
+
 
     // INTERFACE -- ARRAY SUBSCRIPTING
   
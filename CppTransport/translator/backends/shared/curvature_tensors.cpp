@@ -76,7 +76,7 @@ namespace macro_packages
             container = this->Ginv->compute(indices);
           }
 
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
@@ -115,7 +115,7 @@ namespace macro_packages
         if(indices[2]->get_variance() != variance::covariant) throw rule_apply_fail(ERROR_CONNEXION_INDICES);
 
         std::unique_ptr<flattened_tensor> container = this->Gamma->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
@@ -133,7 +133,7 @@ namespace macro_packages
     void replace_Riemann_A2::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->A2->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
     
     
@@ -147,7 +147,7 @@ namespace macro_packages
     void replace_Riemann_A3::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->A3->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
     
     
@@ -161,7 +161,7 @@ namespace macro_packages
     void replace_Riemann_B3::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->B3->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
     
     
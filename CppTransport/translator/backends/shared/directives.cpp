@@ -143,14 +143,20 @@ namespace macro_packages
 
         macro_agent& ma = this->payload.get_stack().top_macro_package();
 
-        // currently we support only the "fast" condition, so we can bodge the job
+        // currently we support only the "fast", "vectorize" and "hybrid" conditions, so we can bodge the job
         // of evaluating the conditional clause; in general, this would require
         // tokenization, parsing, and the result would be a lot more complex
         if(condition == std::string("fast") && this->payload.fast()) truth = true;
         else if(condition == std::string("!fast") && !this->payload.fast()) truth = true;
-
-        // push a new clause onto the "if" stack, with the determined truth value
-        this->istack.emplace(condition, truth);
+        else if(condition == std::string("vectorize") && this->payload.vectorize()) truth = true;
+        else if(condition == std::string("!vectorize") && !this->payload.vectorize()) truth = true;
+        else if(condition == std::string("hybrid") && this->payload.hybrid()) truth = true;
+        else if(condition == std::string("!hybrid") && !this->payload.hybrid()) truth = true;
+
+        // push a new clause onto the "if" stack, with the determined truth value;
+        // clauses may be nested, so also record whether the enclosing clause is enabled
+        bool parent = this->istack.empty() || this->istack.top().is_enabled();
+        this->istack.emplace(condition, truth, parent);
 
         // enable or disable output, as appropriate
         if(this->istack.top().is_enabled())
@@ -126,12 +126,15 @@ namespace macro_packages
 
           public:
 
-            if_record(std::string c, bool v)
+            //! 'p' records whether output was enabled by the enclosing clause, if any;
+            //! neither branch of a nested clause is enabled if its parent is disabled
+            if_record(std::string c, bool v, bool p)
               : condition(std::move(c)),
                 value(v),
+                parent(p),
                 if_branch(true)
               {
-                if(value) enabled = true;
+                if(value) enabled = parent;
                 else      enabled = false;
               }
 
@@ -152,7 +155,7 @@ namespace macro_packages
             bool in_if_branch() const { return(this->if_branch); }
 
             //! mark as in else-branch
-            void mark_else_branch() { this->if_branch = false; if(value) enabled = false; else enabled = true; }
+            void mark_else_branch() { this->if_branch = false; if(value) enabled = false; else enabled = parent; }
 
             //! get current output-enabled status
             bool is_enabled() const { return(this->enabled); }
@@ -168,6 +171,9 @@ namespace macro_packages
             //! record truth value
             bool value;
 
+            //! was output enabled by the enclosing clause?
+            bool parent;
+
             //! which branch are we in?
             bool if_branch;
 
@@ -115,14 +115,14 @@ namespace macro_packages
         if(indices[0]->get_variance() == variance::covariant) throw rule_apply_fail(ERROR_FIELD_INDICES_ARE_CONTRAVARIANT);
         
         std::unique_ptr<flattened_tensor> container = this->field_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
     
     
     void replace_momenta::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->momenta_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
     
     
@@ -131,42 +131,42 @@ namespace macro_packages
         if(indices[0]->get_variance() == variance::covariant) throw rule_apply_fail(ERROR_COORD_INDICES_ARE_CONTRAVARIANT);
     
         std::unique_ptr<flattened_tensor> container = this->coordinate_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
     
     
     void replace_parameter::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->parameter_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
     
 
     void replace_SR_velocity::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->SR_velocity_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
     void replace_dV::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->dV_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
     void replace_ddV::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->ddV_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
     void replace_dddV::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->dddV_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
     
     
@@ -37,7 +37,6 @@
 #include "boost/uuid/uuid.hpp"
 #include "boost/uuid/string_generator.hpp"
 #include "boost/uuid/uuid_io.hpp"
-#include "boost/date_time/posix_time/posix_time.hpp"
 
 #include "openssl/md5.h"
 
@@ -137,9 +136,7 @@ namespace macro_packages
 
     std::string replace_date::evaluate(const macro_argument_list& args)
       {
-        boost::posix_time::ptime now = boost::posix_time::second_clock::universal_time();
-
-        return(boost::posix_time::to_simple_string(now));
+        return(this->data_payload.get_timestamp());
       }
 
 
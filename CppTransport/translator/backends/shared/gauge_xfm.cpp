@@ -88,7 +88,7 @@ namespace macro_packages
     void replace_zeta1::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->zeta1_tensor->compute(indices);
-        this->map =  std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map =  std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
@@ -100,21 +100,21 @@ namespace macro_packages
         auto  a = sym_factory.get_real_symbol(args[ZETA_XFM_2_A_ARGUMENT]);
 
         std::unique_ptr<flattened_tensor> container = this->zeta2_tensor->compute(indices, k, k1, k2, a);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
     void replace_dN1::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
 	    {
         std::unique_ptr<flattened_tensor> container = this->dN1_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
 	    }
 
 
     void replace_dN2::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
 	    {
         std::unique_ptr<flattened_tensor> container = this->dN2_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
 	    }
 
 
@@ -59,7 +59,7 @@ namespace macro_packages
         auto  a = sym_factory.get_real_symbol(args[A_A_ARGUMENT]);
 
         std::unique_ptr<flattened_tensor> container = this->A_tensor->compute(indices, k1, k2, k3, a);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
     
     
@@ -71,7 +71,7 @@ namespace macro_packages
         auto  a = sym_factory.get_real_symbol(args[ATILDE_A_ARGUMENT]);
         
         std::unique_ptr<flattened_tensor> container = this->Atilde_tensor->compute(indices, k1, k2, k3, a);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
@@ -83,7 +83,7 @@ namespace macro_packages
         auto  a = sym_factory.get_real_symbol(args[B_A_ARGUMENT]);
 
         std::unique_ptr<flattened_tensor> container = this->B_tensor->compute(indices, k1, k2, k3, a);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
@@ -95,14 +95,14 @@ namespace macro_packages
         auto  a = sym_factory.get_real_symbol(args[C_A_ARGUMENT]);
 
         std::unique_ptr<flattened_tensor> container = this->C_tensor->compute(indices, k1, k2, k3, a);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
     void replace_M::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->M_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
@@ -190,6 +190,9 @@ namespace macro_packages
         // flush any existing temporaries to the preceding pool, if one exists
         if(this->tag_set) this->deposit_temporaries();
 
+        // a new pool begins a new scope, in which identifiers known to vanish may be reassigned
+        this->data_payload.get_stack().top_macro_package().clear_vanishing();
+
         // remember new template
         this->templ = t;
 
@@ -53,7 +53,7 @@ namespace macro_packages
     void replace_U1::pre_hook(const macro_argument_list& args, const index_literal_list& indices)
       {
         std::unique_ptr<flattened_tensor> container = this->u1_tensor->compute(indices);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
@@ -63,7 +63,7 @@ namespace macro_packages
         auto a = sym_factory.get_real_symbol(args[U2_A_ARGUMENT]);
 
         std::unique_ptr<flattened_tensor> container = this->u2_tensor->compute(indices, k, a);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
@@ -75,7 +75,7 @@ namespace macro_packages
         auto  a = sym_factory.get_real_symbol(args[U3_A_ARGUMENT]);
 
         std::unique_ptr<flattened_tensor> container = this->u3_tensor->compute(indices, k1, k2, k3, a);
-        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker);
+        this->map = std::make_unique<cse_map>(std::move(container), this->cse_worker, this->get_name());
       }
 
 
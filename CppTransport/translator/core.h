@@ -60,7 +60,15 @@ constexpr auto HOME_ENV                              = "HOME";
 
 constexpr auto CONFIG_FILE_LOCATION                  = ".cpptransport";
 
+constexpr auto EXPRESSION_CACHE_LOCATION             = ".cpptransport-cache";
+constexpr auto EXPRESSION_CACHE_EXTENSION            = ".gar";
+
+// format of persistent expression caches; must be incremented whenever the expressions computed for any tensor
+// change, eg. because a tensor's definition or simplification strategy is altered, so stale caches are not reused
+constexpr auto EXPRESSION_CACHE_FORMAT               = 1;
+
 constexpr auto DEFAULT_UNROLL_MAX                    = 1000;
+constexpr auto DEFAULT_JOBS                          = 1;
 
 
 // macro strings
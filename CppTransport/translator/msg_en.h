@@ -80,6 +80,7 @@ constexpr auto ERROR_INCLUDE_DIRECTIVE               = "Expected filename follow
 constexpr auto ERROR_UNKNOWN_DIRECTIVE               = "Unknown directive";
 
 constexpr auto ERROR_CPP_BUFFER_WRITE                = "Error opening output file";
+constexpr auto ERROR_OUTPUT_WRITE                    = "Error writing output file";
 
 constexpr auto ERROR_CSE_POWER_ARGUMENTS             = "Unexpected number of arguments to pow() during common subexpression elimination";
 
@@ -320,6 +321,11 @@ constexpr auto MESSAGE_EXPRESSION_CACHE_HITS         = "total expression cache h
 constexpr auto MESSAGE_EXPRESSION_CACHE_MISSES       = "misses";
 constexpr auto MESSAGE_EXPRESSION_CACHE_QUERY_TIME   = "time spent performing queries";
 constexpr auto MESSAGE_EXPRESSION_CACHE_INSERT_TIME  = "inserts";
+constexpr auto MESSAGE_EXPRESSION_CACHE_LOADED       = "expressions loaded from persistent cache";
+constexpr auto MESSAGE_EXPRESSION_CACHE_FROM_DISK    = "of which from persistent cache";
+constexpr auto WARNING_EXPRESSION_CACHE_READ         = "Could not read persistent expression cache";
+constexpr auto WARNING_EXPRESSION_CACHE_WRITE        = "Could not write persistent expression cache";
+constexpr auto WARNING_OPERATION_REPORT_WRITE        = "Could not write operation count report";
 
 constexpr auto MESSAGE_LAMBDA_CACHE_HIT              = "lambda cache hit";
 constexpr auto MESSAGE_LAMBDA_CACHE_HITS             = "lambda cache hits";
@@ -329,6 +335,10 @@ constexpr auto MESSAGE_LAMBDA_CACHE_INSERT_TIME      = "inserts";
 
 constexpr auto MESSAGE_SYMBOLIC_COMPUTE_TIME         = "symbolic computation";
 constexpr auto MESSAGE_CSE_TIME                      = "common sub-expression elimination";
+constexpr auto MESSAGE_CSE_TENSOR                    = "common sub-expression elimination for";
+constexpr auto MESSAGE_CSE_NODES                     = "expression nodes";
+constexpr auto MESSAGE_CSE_UNIQUE                    = "unique";
+constexpr auto MESSAGE_CSE_SHARED                    = "shared";
 constexpr auto MESSAGE_MACRO_TIME                    = "replacement rule expansion took";
 constexpr auto MESSAGE_TOKENIZATION_TIME             = "of which time spent tokenizing";
 
@@ -342,7 +352,19 @@ constexpr auto MESSAGE_TRANSLATING_TO                = "into";
 constexpr auto ANNOTATE_EXPANSION_OF_LINE            = "expansion of template line";
 
 constexpr auto MESSAGE_TRANSLATION_RESULT            = "translation finished with";
+constexpr auto MESSAGE_OUTPUT_UNCHANGED              = "content unchanged; retained existing file";
 constexpr auto MESSAGE_REPLACEMENT_RULE_EXPANSIONS   = "replacement rule expansions";
+constexpr auto MESSAGE_OMITTED_TERMS_A               = "omitted";
+constexpr auto MESSAGE_OMITTED_TERMS_B               = "terms with vanishing coefficients from index sums";
+constexpr auto MESSAGE_SPARSITY_LINE                 = "template line";
+constexpr auto MESSAGE_SPARSITY_OF                   = "of";
+constexpr auto MESSAGE_SPARSITY_VANISH               = "assigned components vanish";
+constexpr auto MESSAGE_CODE_SIZE_LINE                = "template line";
+constexpr auto MESSAGE_CODE_SIZE_UNROLLED            = "unrolled into";
+constexpr auto MESSAGE_CODE_SIZE_STATEMENTS          = "statements";
+constexpr auto MESSAGE_CODE_SIZE_A                   = "emitted";
+constexpr auto MESSAGE_CODE_SIZE_B                   = "statements from unrolled index assignments and";
+constexpr auto MESSAGE_CODE_SIZE_C                   = "lines from for-loop index assignments";
 
 constexpr auto ERROR_UNKNOWN_STEPPER                 = "Unknown or unimplemented odeint-v2 stepper";
 constexpr auto ERROR_UNDEFINED_STEPPER               = "Stepper block not declared";
@@ -55,6 +55,15 @@
 #define IMPLEMENTATION_OUTPUT_SWITCH  "implementation-output"
 #define IMPLEMENTATION_OUTPUT_HELP    "specify name of implementation header"
 
+#define CACHE_DIR_SWITCH              "cache-dir"
+#define CACHE_DIR_HELP                "specify directory for the persistent expression cache"
+
+#define NO_EXPRESSION_CACHE_SWITCH    "no-expression-cache"
+#define NO_EXPRESSION_CACHE_HELP      "do not read or write the persistent expression cache"
+
+#define JOBS_SWITCH                   "jobs"
+#define JOBS_HELP                     "number of worker processes used to build tensor components"
+
 #define NO_CSE_SWITCH                 "no-cse"
 #define NO_CSE_HELP                   "disable common sub-expression elimination"
 
@@ -79,6 +88,18 @@
 #define FAST_SWITCH                   "fast"
 #define FAST_HELP                     "unroll all loops and optimize for speed"
 
+#define VECTORIZE_SWITCH              "vectorize"
+#define VECTORIZE_HELP                "arrange rolled loops for SIMD vectorization"
+
+#define HYBRID_SWITCH                 "hybrid"
+#define HYBRID_HELP                   "unroll tensor coefficients but roll state contractions into loops"
+
+#define OPERATION_REPORT_SWITCH       "report-operations"
+#define OPERATION_REPORT_HELP         "write a count of arithmetic operations alongside each output file"
+
+#define HORNER_SWITCH                 "horner"
+#define HORNER_HELP                   "rewrite polynomials in Horner form before common subexpression elimination"
+
 #define PROFILING_SWITCH              "profile"
 #define PROFILING_HELP                "display profiling information"
 
@@ -44,17 +44,23 @@ namespace canonical
         // set up a TensorJanitor to manage use of cache
         TensorJanitor J(*this, indices);
 
+        component_list work;
+
         for(field_index i = field_index(0, indices[0]->get_variance()); i < max_i; ++i)
           {
             for(field_index j = field_index(0, indices[1]->get_variance()); j < max_j; ++j)
               {
                 for(field_index k = field_index(0, indices[2]->get_variance()); k < max_k; ++k)
                   {
-                    (*result)[this->fl.flatten(i, j, k)] = this->compute_component(i, j, k, k1, k2, k3, a);
+                    work.emplace_back(this->fl.flatten(i, j, k), [this, i, j, k, &k1, &k2, &k3, &a]()
+                      { return this->compute_component(i, j, k, k1, k2, k3, a); });
                   }
               }
           }
 
+        // components are independent, so they can be evaluated by worker processes if these are enabled
+        this->shared.evaluate_components(work, *result);
+
         return(result);
       }
     
@@ -64,6 +70,10 @@ namespace canonical
       {
         if(!this->cached) throw tensor_exception("C cache not ready");
 
+        // C is invariant under exchange of the pairs (i,k1) and (j,k2), so components are only evaluated
+        // with these momenta in canonical order; see the corresponding comment in A
+        if(k2.get_name() < k1.get_name()) return this->compute_component(j, i, k, k2, k1, k3, a);
+
         unsigned int index = this->fl.flatten(i, j, k);
         auto args = this->res.generate_cache_arguments(0, this->printer);
         args += { k1, k2, k3, a };
@@ -44,17 +44,23 @@ namespace canonical
         // set up a TensorJanitor to manage use of cache
         TensorJanitor J(*this, indices);
 
+        component_list work;
+
         for(phase_index i = phase_index(0, indices[0]->get_variance()); i < max_i; ++i)
           {
             for(phase_index j = phase_index(0, indices[1]->get_variance()); j < max_j; ++j)
               {
                 for(phase_index k = phase_index(0, indices[2]->get_variance()); k < max_k; ++k)
                   {
-                    (*result)[this->fl.flatten(i, j, k)] = this->compute_component(i, j, k, k1, k2, k3, a);
+                    work.emplace_back(this->fl.flatten(i, j, k), [this, i, j, k, &k1, &k2, &k3, &a]()
+                      { return this->compute_component(i, j, k, k1, k2, k3, a); });
                   }
               }
           }
 
+        // components are independent, so they can be evaluated by worker processes if these are enabled
+        this->shared.evaluate_components(work, *result);
+
         return(result);
       }
     
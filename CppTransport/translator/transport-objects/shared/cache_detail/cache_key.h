@@ -69,6 +69,18 @@ class cache_key
     ~cache_key() = default;
 
 
+    // INTERFACE
+
+  public:
+
+    //! get a printable fingerprint for this key, used to identify persistent cache entries
+    std::string fingerprint() const
+      {
+        return std::to_string(static_cast<typename std::underlying_type<ItemClass>::type>(this->item_class))
+               + ":" + std::to_string(this->index) + ":" + this->tags.fingerprint();
+      }
+
+
     friend bool operator==<>(const cache_key<ItemClass>& A, const cache_key<ItemClass>& B);
 
     friend struct std::hash< cache_key<ItemClass> >;
@@ -23,6 +23,8 @@
 // --@@
 //
 
+#include <sstream>
+
 #include "cache_tags.h"
 
 
@@ -78,6 +80,29 @@ cache_tags& cache_tags::operator+=(std::initializer_list<GiNaC::idx> idxs)
   }
 
 
+std::string cache_tags::fingerprint() const
+  {
+    std::ostringstream out;
+
+    for(const auto& tag : this->symbols)
+      {
+        out << "s:" << tag->get_name() << ";";
+      }
+
+    for(const auto& tag : this->indices)
+      {
+        out << "i:" << tag->get_value() << "/" << tag->get_dim() << ";";
+      }
+
+    for(const auto& tag : this->var_indices)
+      {
+        out << "v:" << tag->get_value() << "/" << tag->get_dim() << (tag->is_covariant() ? "-" : "+") << ";";
+      }
+
+    return out.str();
+  }
+
+
 bool operator==(const cache_tags& A, const cache_tags& B)
   {
     if(A.symbols.size() != B.symbols.size()) return false;
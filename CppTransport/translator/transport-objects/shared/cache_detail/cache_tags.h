@@ -28,6 +28,7 @@
 
 
 #include <iostream>
+#include <string>
 #include <vector>
 #include <initializer_list>
 
@@ -103,6 +104,10 @@ class cache_tags
     //! determine whether empty
     bool empty() const { return this->symbols.empty() && this->indices.empty() && this->var_indices.empty(); }
 
+    //! get a printable fingerprint which identifies these tags by symbol name, rather than
+    //! by GiNaC symbol identity; used to key persistent cache entries
+    std::string fingerprint() const;
+
 
     // INTERNAL DATA
 
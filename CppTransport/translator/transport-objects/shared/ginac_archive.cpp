@@ -0,0 +1,95 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+#include "ginac_archive.h"
+
+
+namespace ginac_archive
+  {
+
+    void write(std::ostream& out, const std::map< std::string, GiNaC::ex >& items)
+      {
+        GiNaC::archive ar;
+
+        // collect the symbols used by all entries
+        std::map< std::string, GiNaC::ex > symbols;
+        for(const auto& item : items)
+          {
+            for(auto t = item.second.preorder_begin(); t != item.second.preorder_end(); ++t)
+              {
+                if(GiNaC::is_a<GiNaC::symbol>(*t)) symbols.emplace(GiNaC::ex_to<GiNaC::symbol>(*t).get_name(), *t);
+              }
+          }
+
+        GiNaC::lst names;
+        for(const auto& item : symbols)
+          {
+            names.append(item.second);
+          }
+        ar.archive_ex(names, CPPTRANSPORT_GINAC_ARCHIVE_SYMBOLS);
+
+        for(const auto& item : items)
+          {
+            ar.archive_ex(item.second, item.first.c_str());
+          }
+
+        out << ar;
+      }
+
+
+    bool read(std::istream& in, symbol_factory& sf, std::map< std::string, GiNaC::ex >& items)
+      {
+        try
+          {
+            GiNaC::archive ar;
+            in >> ar;
+            if(in.fail()) return false;
+
+            // first recover the names of all symbols used by the archive
+            GiNaC::ex names = ar.unarchive_ex(GiNaC::lst(), CPPTRANSPORT_GINAC_ARCHIVE_SYMBOLS);
+
+            GiNaC::lst symbols;
+            for(size_t i = 0; i < names.nops(); ++i)
+              {
+                if(!GiNaC::is_a<GiNaC::symbol>(names.op(i))) return false;
+                symbols.append(sf.get_real_symbol(GiNaC::ex_to<GiNaC::symbol>(names.op(i)).get_name()).get());
+              }
+
+            for(unsigned int i = 0; i < ar.num_expressions(); ++i)
+              {
+                std::string name;
+                GiNaC::ex e = ar.unarchive_ex(symbols, name, i);
+                if(name != CPPTRANSPORT_GINAC_ARCHIVE_SYMBOLS) items.emplace(std::move(name), std::move(e));
+              }
+          }
+        catch(std::exception& xe)
+          {
+            return false;
+          }
+
+        return true;
+      }
+
+  }   // namespace ginac_archive
@@ -0,0 +1,60 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+#ifndef CPPTRANSPORT_GINAC_ARCHIVE_H
+#define CPPTRANSPORT_GINAC_ARCHIVE_H
+
+
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "symbol_factory.h"
+
+#include "disable_warnings.h"
+#include "ginac/ginac.h"
+
+
+//! name of the archived expression listing the symbols used by the other entries
+constexpr auto CPPTRANSPORT_GINAC_ARCHIVE_SYMBOLS = "__symbols";
+
+
+namespace ginac_archive
+  {
+
+    //! write a set of named expressions to a stream as a GiNaC archive, together with a list of the
+    //! symbols they use
+    void write(std::ostream& out, const std::map< std::string, GiNaC::ex >& items);
+
+    //! read a set of named expressions from a stream written by write().
+    //! GiNaC resolves archived symbols by name against a supplied list, so symbols are obtained from the
+    //! symbol factory; this makes the result share symbols with expressions built in this process.
+    //! Returns false if the archive is damaged
+    bool read(std::istream& in, symbol_factory& sf, std::map< std::string, GiNaC::ex >& items);
+
+  }   // namespace ginac_archive
+
+
+#endif //CPPTRANSPORT_GINAC_ARCHIVE_H
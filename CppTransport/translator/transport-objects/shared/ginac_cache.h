@@ -29,14 +29,21 @@
 
 
 #include <unordered_map>
+#include <map>
+#include <string>
+#include <fstream>
 
 #include "cache_detail/cache_key.h"
+#include "symbol_factory.h"
+#include "ginac_archive.h"
 
 #include "timing_instrument.h"
 
 #include "disable_warnings.h"
 #include "ginac/ginac.h"
 
+#include "boost/filesystem/operations.hpp"
+
 
 template <typename ItemClass>
 class ginac_cache
@@ -49,7 +56,12 @@ class ginac_cache
 		//! construct a cache object
 		ginac_cache()
 			: hits(0),
-        misses(0)
+        misses(0),
+        persistent_hits(0),
+        persistent_loaded(0),
+        sym_factory(nullptr),
+        dirty(false),
+        journalling(false)
 			{
 				// pause timers
 				query_timer.stop();
@@ -78,6 +90,35 @@ class ginac_cache
 		void store(ItemClass c, unsigned int i, const GiNaC::ex& e);
 
 
+    // INTERFACE - PERSISTENCE
+
+  public:
+
+    //! attach a file which persists the cache between runs. Its contents are loaded if they were written
+    //! for the same fingerprint; otherwise the file will be replaced when the cache is flushed.
+    //! Symbols are resolved by name using the supplied symbol factory.
+    //! Returns false if an existing file could not be read
+    bool attach(boost::filesystem::path file, std::string fprint, symbol_factory& sf);
+
+    //! write the cache to its persistent file, if any entries have been added since it was loaded;
+    //! returns false if the file could not be written
+    bool flush();
+
+
+    // INTERFACE - EXCHANGE BETWEEN PROCESSES
+
+  public:
+
+    //! begin recording entries as they are stored, so that they can be passed to another process
+    void begin_journal();
+
+    //! stop recording, and return the entries stored since begin_journal() keyed by fingerprint
+    std::map< std::string, GiNaC::ex > end_journal();
+
+    //! merge entries recorded by a journal in another process
+    void merge(const std::map< std::string, GiNaC::ex >& entries);
+
+
 		// INTERFACE - CACHE STATISTICS
 
   public:
@@ -94,6 +135,26 @@ class ginac_cache
     //! get time spent performing insertions
     boost::timer::nanosecond_type get_insert_time() const { return(this->insert_timer.elapsed().wall); }
 
+    //! get number of hits satisfied from the persistent file
+    unsigned int get_persistent_hits() const { return(this->persistent_hits); }
+
+    //! get number of entries loaded from the persistent file
+    unsigned int get_persistent_loaded() const { return(this->persistent_loaded); }
+
+    //! is a persistent file attached?
+    bool is_persistent() const { return(!this->persistent_file.empty()); }
+
+
+		// INTERNAL API
+
+  private:
+
+    //! look up a key in the persistent and merged stores, and transfer it to the in-memory cache if found
+    bool query_persistent(const cache_key<ItemClass>& key, GiNaC::ex& e);
+
+    //! record a newly stored entry in the persistent store and journal, if they are active
+    void record(const cache_key<ItemClass>& key, const GiNaC::ex& e);
+
 
 		// INTERNAL DATA
 
@@ -114,6 +175,42 @@ class ginac_cache
     //! record time spent performing insertions
     boost::timer::cpu_timer insert_timer;
 
+
+    // PERSISTENT STORE
+
+    //! persistent entries, keyed by fingerprint; holds entries loaded from disk and those stored during this run
+    std::map< std::string, GiNaC::ex > persistent;
+
+    //! record number of hits from the persistent store
+    unsigned int persistent_hits;
+
+    //! record number of entries loaded from disk
+    unsigned int persistent_loaded;
+
+    //! file backing the persistent store, empty if none is attached
+    boost::filesystem::path persistent_file;
+
+    //! fingerprint identifying the content of the persistent file
+    std::string fingerprint;
+
+    //! symbol factory used to resolve symbols by name
+    symbol_factory* sym_factory;
+
+    //! have entries been added since the persistent file was loaded?
+    bool dirty;
+
+
+    // EXCHANGE BETWEEN PROCESSES
+
+    //! entries merged from other processes, keyed by fingerprint
+    std::map< std::string, GiNaC::ex > merged;
+
+    //! entries stored since the journal was started, keyed by fingerprint
+    std::map< std::string, GiNaC::ex > journal;
+
+    //! is the journal active?
+    bool journalling;
+
 	};
 
 
@@ -128,6 +225,8 @@ bool ginac_cache<ItemClass>::query(ItemClass c, unsigned int i, const cache_tags
     auto it = this->cache.find(key);
     if(it == this->cache.end())
       {
+        if(this->query_persistent(key, e)) return true;
+
         ++misses;
         return false;
       }
@@ -150,6 +249,8 @@ bool ginac_cache<ItemClass>::query(ItemClass c, unsigned int i, GiNaC::ex& e)
     auto it = this->cache.find(key);
     if(it == this->cache.end())
       {
+        if(this->query_persistent(key, e)) return true;
+
         ++misses;
         return false;
       }
@@ -165,7 +266,11 @@ template <typename ItemClass>
 void ginac_cache<ItemClass>::store(ItemClass c, unsigned int i, cache_tags t, const GiNaC::ex& e)
 	{
     timing_instrument timer(this->insert_timer);
-    auto res = this->cache.emplace(std::make_pair(cache_key<ItemClass>(c, i, t), e));
+    cache_key<ItemClass> key(c, i, t);
+
+    this->record(key, e);
+
+    auto res = this->cache.emplace(std::make_pair(std::move(key), e));
 	}
 
 
@@ -173,9 +278,181 @@ template <typename ItemClass>
 void ginac_cache<ItemClass>::store(ItemClass c, unsigned int i, const GiNaC::ex& e)
 	{
     timing_instrument timer(this->insert_timer);
-    auto res = this->cache.emplace(std::make_pair(cache_key<ItemClass>(c, i, cache_tags()), e));
+    cache_key<ItemClass> key(c, i, cache_tags());
+
+    this->record(key, e);
+
+    auto res = this->cache.emplace(std::make_pair(std::move(key), e));
 	}
 
 
+template <typename ItemClass>
+bool ginac_cache<ItemClass>::query_persistent(const cache_key<ItemClass>& key, GiNaC::ex& e)
+  {
+    if(this->persistent.empty() && this->merged.empty()) return false;
+
+    std::string fprint = key.fingerprint();
+
+    auto it = this->merged.find(fprint);
+    if(it != this->merged.end())
+      {
+        ++hits;
+        e = it->second;
+        this->cache.emplace(std::make_pair(key, it->second));
+        return true;
+      }
+
+    it = this->persistent.find(fprint);
+    if(it == this->persistent.end()) return false;
+
+    ++hits;
+    ++persistent_hits;
+    e = it->second;
+    this->cache.emplace(std::make_pair(key, it->second));
+    return true;
+  }
+
+
+template <typename ItemClass>
+void ginac_cache<ItemClass>::record(const cache_key<ItemClass>& key, const GiNaC::ex& e)
+  {
+    if(!this->is_persistent() && !this->journalling) return;
+
+    std::string fprint = key.fingerprint();
+
+    if(this->journalling) this->journal[fprint] = e;
+
+    if(this->is_persistent())
+      {
+        this->persistent[fprint] = e;
+        this->dirty = true;
+      }
+  }
+
+
+template <typename ItemClass>
+void ginac_cache<ItemClass>::begin_journal()
+  {
+    this->journal.clear();
+    this->journalling = true;
+  }
+
+
+template <typename ItemClass>
+std::map< std::string, GiNaC::ex > ginac_cache<ItemClass>::end_journal()
+  {
+    this->journalling = false;
+
+    std::map< std::string, GiNaC::ex > entries;
+    entries.swap(this->journal);
+    return entries;
+  }
+
+
+template <typename ItemClass>
+void ginac_cache<ItemClass>::merge(const std::map< std::string, GiNaC::ex >& entries)
+  {
+    timing_instrument timer(this->insert_timer);
+
+    for(const auto& item : entries)
+      {
+        this->merged[item.first] = item.second;
+
+        if(this->is_persistent())
+          {
+            this->persistent[item.first] = item.second;
+            this->dirty = true;
+          }
+      }
+  }
+
+
+template <typename ItemClass>
+bool ginac_cache<ItemClass>::attach(boost::filesystem::path file, std::string fprint, symbol_factory& sf)
+  {
+    this->persistent_file = std::move(file);
+    this->fingerprint = std::move(fprint);
+    this->sym_factory = &sf;
+
+    if(!boost::filesystem::is_regular_file(this->persistent_file)) return true;
+
+    std::map< std::string, GiNaC::ex > loaded;
+
+    try
+      {
+        std::ifstream in(this->persistent_file.string(), std::ios_base::in | std::ios_base::binary);
+        if(!in) return false;
+
+        // the file begins with the fingerprint it was written for; if this doesn't match, its contents
+        // belong to a different model and are ignored
+        std::string stored;
+        std::getline(in, stored);
+        if(stored != this->fingerprint) return true;
+
+        // a damaged file is treated as empty, and will be replaced
+        if(!ginac_archive::read(in, sf, loaded)) return false;
+      }
+    catch(std::exception& xe)
+      {
+        return false;
+      }
+
+    this->persistent_loaded = static_cast<unsigned int>(loaded.size());
+    this->persistent.swap(loaded);
+    return true;
+  }
+
+
+template <typename ItemClass>
+bool ginac_cache<ItemClass>::flush()
+  {
+    if(!this->is_persistent() || !this->dirty) return true;
+
+    // write to a temporary file and move it into place, so that a concurrent translation never sees a partial file
+    boost::filesystem::path temp;
+
+    try
+      {
+        boost::filesystem::path dir = this->persistent_file.parent_path();
+        if(!dir.empty()) boost::filesystem::create_directories(dir);
+
+        temp = dir / boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+
+        std::ofstream out(temp.string(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+
+        bool written = out.is_open() && !out.fail();
+        if(written)
+          {
+            out << this->fingerprint << '\n';
+            ginac_archive::write(out, this->persistent);
+            out.close();
+            written = !out.fail();
+          }
+
+        if(!written)
+          {
+            boost::system::error_code ec;
+            boost::filesystem::remove(temp, ec);
+            return false;
+          }
+
+        boost::filesystem::rename(temp, this->persistent_file);
+      }
+    catch(boost::filesystem::filesystem_error& xe)
+      {
+        // don't leave a partial file behind; remove() reports failure through ec rather than throwing
+        if(!temp.empty())
+          {
+            boost::system::error_code ec;
+            boost::filesystem::remove(temp, ec);
+          }
+        return false;
+      }
+
+    this->dirty = false;
+    return true;
+  }
+
+
 
 #endif //CPPTRANSPORT_GINAC_CACHE_H
@@ -41,7 +41,8 @@ shared_resources::shared_resources(translator_data& p, resource_manager& m, expr
     num_params(p.model.get_number_params()),
     num_fields(p.model.get_number_fields()),
     num_phase(2*p.model.get_number_fields()),
-    fl(p.model.get_number_params(), p.model.get_number_fields())
+    fl(p.model.get_number_params(), p.model.get_number_fields()),
+    pool(p.jobs(), c, p.get_symbol_factory())
   {
   }
 
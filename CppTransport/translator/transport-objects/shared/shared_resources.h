@@ -38,6 +38,7 @@
 #include "index_flatten.h"
 #include "abstract_index.h"
 #include "resource_failure.h"
+#include "worker_pool.h"
 
 #include "language_printer.h"
 
@@ -154,6 +155,14 @@ class shared_resources
     bool can_roll_coordinates() const;
 
 
+    // EVALUATE TENSOR COMPONENTS
+
+  public:
+
+    //! evaluate a list of components, using worker processes if they have been requested
+    void evaluate_components(const component_list& work, flattened_tensor& result) { this->pool.evaluate(work, result); }
+
+
     // MANUFACTURE GINAC INDICES
 
   public:
@@ -189,6 +198,9 @@ class shared_resources
     //! data payload provided by parent translation unit
     translator_data& payload;
 
+    //! worker pool for evaluating tensor components
+    worker_pool pool;
+
 
     // SYMBOL LISTS
 
@@ -0,0 +1,228 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "worker_pool.h"
+#include "ginac_archive.h"
+
+
+namespace worker_pool_impl
+  {
+
+    //! prefix for archived components
+    constexpr auto COMPONENT_PREFIX = "c:";
+
+    //! prefix for archived expression-cache entries
+    constexpr auto JOURNAL_PREFIX = "j:";
+
+
+    //! write a complete buffer to a file descriptor
+    bool write_all(int fd, const std::string& buf)
+      {
+        const char* p = buf.data();
+        size_t remain = buf.size();
+
+        while(remain > 0)
+          {
+            ssize_t n = ::write(fd, p, remain);
+            if(n < 0) return false;
+
+            p += n;
+            remain -= static_cast<size_t>(n);
+          }
+
+        return true;
+      }
+
+
+    //! read from a file descriptor until end-of-file
+    bool read_all(int fd, std::string& buf)
+      {
+        char chunk[65536];
+
+        while(true)
+          {
+            ssize_t n = ::read(fd, chunk, sizeof(chunk));
+            if(n < 0) return false;
+            if(n == 0) return true;
+
+            buf.append(chunk, static_cast<size_t>(n));
+          }
+      }
+
+  }   // namespace worker_pool_impl
+
+
+using namespace worker_pool_impl;
+
+
+worker_pool::worker_pool(unsigned int w, expression_cache& c, symbol_factory& sf)
+  : workers(w),
+    cache(c),
+    sym_factory(sf)
+  {
+  }
+
+
+void worker_pool::evaluate(const component_list& work, flattened_tensor& result)
+  {
+    const unsigned int stride = std::min(this->workers, static_cast<unsigned int>(work.size()));
+    std::vector<bool> done(work.size(), false);
+
+    if(stride > 1)
+      {
+        std::vector< std::pair<pid_t, int> > children;
+
+        // flush output streams, so that buffered content is not duplicated into the children
+        std::cout.flush();
+        std::cerr.flush();
+
+        for(unsigned int c = 0; c < stride; ++c)
+          {
+            int fd[2];
+            if(::pipe(fd) != 0) break;
+
+            pid_t pid = ::fork();
+            if(pid < 0)
+              {
+                ::close(fd[0]);
+                ::close(fd[1]);
+                break;
+              }
+
+            if(pid == 0)
+              {
+                ::close(fd[0]);
+                for(const auto& child : children)
+                  {
+                    ::close(child.second);
+                  }
+                this->run_worker(work, c, stride, fd[1]);
+              }
+
+            ::close(fd[1]);
+            children.emplace_back(pid, fd[0]);
+          }
+
+        // children block once their pipe is full, so results are read in turn; each child has completed
+        // its slice before it begins to write
+        for(const auto& child : children)
+          {
+            this->collect(child.second, work, result, done);
+            ::close(child.second);
+
+            int status;
+            ::waitpid(child.first, &status, 0);
+          }
+      }
+
+    // evaluate anything not returned by a worker
+    for(unsigned int t = 0; t < work.size(); ++t)
+      {
+        if(!done[t]) result[work[t].first] = work[t].second();
+      }
+  }
+
+
+void worker_pool::run_worker(const component_list& work, unsigned int slice, unsigned int stride, int fd)
+  {
+    int status = EXIT_SUCCESS;
+
+    try
+      {
+        this->cache.begin_journal();
+
+        std::map< std::string, GiNaC::ex > items;
+        for(unsigned int t = slice; t < work.size(); t += stride)
+          {
+            items.emplace(COMPONENT_PREFIX + std::to_string(t), work[t].second());
+          }
+
+        for(auto& entry : this->cache.end_journal())
+          {
+            items.emplace(JOURNAL_PREFIX + entry.first, std::move(entry.second));
+          }
+
+        std::ostringstream out;
+        ginac_archive::write(out, items);
+        if(!write_all(fd, out.str())) status = EXIT_FAILURE;
+      }
+    catch(...)
+      {
+        // the parent will evaluate this slice itself, and report any error
+        status = EXIT_FAILURE;
+      }
+
+    ::close(fd);
+
+    // _exit() avoids running destructors or flushing streams that belong to the parent
+    ::_exit(status);
+  }
+
+
+bool worker_pool::collect(int fd, const component_list& work, flattened_tensor& result, std::vector<bool>& done)
+  {
+    std::string buf;
+    if(!read_all(fd, buf) || buf.empty()) return false;
+
+    std::istringstream in(buf);
+    std::map< std::string, GiNaC::ex > items;
+    if(!ginac_archive::read(in, this->sym_factory, items)) return false;
+
+    const std::string component_prefix(COMPONENT_PREFIX);
+    const std::string journal_prefix(JOURNAL_PREFIX);
+
+    std::map< std::string, GiNaC::ex > entries;
+    for(auto& item : items)
+      {
+        const std::string& name = item.first;
+
+        if(name.compare(0, component_prefix.size(), component_prefix) == 0)
+          {
+            unsigned long t = std::stoul(name.substr(component_prefix.size()));
+            if(t >= work.size()) return false;
+
+            result[work[t].first] = item.second;
+            done[t] = true;
+          }
+        else if(name.compare(0, journal_prefix.size(), journal_prefix) == 0)
+          {
+            entries.emplace(name.substr(journal_prefix.size()), std::move(item.second));
+          }
+      }
+
+    this->cache.merge(entries);
+    return true;
+  }
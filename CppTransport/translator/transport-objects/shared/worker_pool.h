@@ -0,0 +1,104 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+#ifndef CPPTRANSPORT_WORKER_POOL_H
+#define CPPTRANSPORT_WORKER_POOL_H
+
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "concepts/flattened_tensor.h"
+#include "expression_cache.h"
+#include "symbol_factory.h"
+
+#include "disable_warnings.h"
+#include "ginac/ginac.h"
+
+
+//! a component of a flattened tensor awaiting evaluation: its flattened index, and a
+//! function which computes it
+using component_list = std::vector< std::pair< unsigned int, std::function<GiNaC::ex()> > >;
+
+
+//! worker_pool evaluates lists of tensor components using child processes.
+//! GiNaC is not thread-safe, so each worker is a forked copy of the translator which shares the
+//! resources already computed by the parent. Worker c evaluates every component whose position in
+//! the list is congruent to c modulo the number of workers, and returns them to the parent as a GiNaC
+//! archive together with any entries it stored in the expression cache.
+//! Components which a worker fails to return are evaluated serially by the parent, so errors are
+//! reported exactly as they would be without workers
+class worker_pool
+  {
+
+    // CONSTRUCTOR, DESTRUCTOR
+
+  public:
+
+    //! constructor
+    worker_pool(unsigned int w, expression_cache& c, symbol_factory& sf);
+
+    //! destructor is default
+    ~worker_pool() = default;
+
+
+    // INTERFACE
+
+  public:
+
+    //! evaluate a list of components, writing each into the flattened tensor
+    void evaluate(const component_list& work, flattened_tensor& result);
+
+
+    // INTERNAL API
+
+  private:
+
+    //! evaluate a slice of the component list in a child process, and write the results to a file
+    //! descriptor; never returns
+    [[noreturn]] void run_worker(const component_list& work, unsigned int slice, unsigned int stride, int fd);
+
+    //! collect results from a child process; returns false if they could not be recovered
+    bool collect(int fd, const component_list& work, flattened_tensor& result, std::vector<bool>& done);
+
+
+    // INTERNAL DATA
+
+  private:
+
+    //! number of worker processes
+    const unsigned int workers;
+
+    //! expression cache
+    expression_cache& cache;
+
+    //! symbol factory, used to resolve symbols returned by workers
+    symbol_factory& sym_factory;
+
+  };
+
+
+#endif //CPPTRANSPORT_WORKER_POOL_H
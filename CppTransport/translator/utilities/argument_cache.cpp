@@ -24,6 +24,7 @@
 //
 
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
@@ -92,9 +93,15 @@ argument_cache::argument_cache(int argc, const char** argv, local_environment& e
     colour_flag(true),
     cse_flag(true),
     no_search_environment(false),
+    expression_cache_flag(true),
     annotate_flag(false),
     unroll_policy_size(DEFAULT_UNROLL_MAX),
     fast_flag(false),
+    vectorize_flag(false),
+    hybrid_flag(false),
+    operation_report_flag(false),
+    horner_flag(false),
+    jobs_count(DEFAULT_JOBS),
     profile_flag(false),
     develop_warnings(false),
     unroll_warnings(false),
@@ -116,6 +123,8 @@ argument_cache::argument_cache(int argc, const char** argv, local_environment& e
       (NO_ENV_SEARCH_SWITCH,                                                                                   NO_ENV_SEARCH_HELP)
       (CORE_OUTPUT_SWITCH,           boost::program_options::value< std::string >()->default_value(""),        CORE_OUTPUT_HELP)
       (IMPLEMENTATION_OUTPUT_SWITCH, boost::program_options::value< std::string >()->default_value(""),        IMPLEMENTATION_OUTPUT_HELP)
+      (CACHE_DIR_SWITCH,             boost::program_options::value< std::string >()->default_value(""),        CACHE_DIR_HELP)
+      (NO_EXPRESSION_CACHE_SWITCH,                                                                             NO_EXPRESSION_CACHE_HELP)
       ;
 
     boost::program_options::options_description generation(GENERATION_OPTIONS);
@@ -124,6 +133,11 @@ argument_cache::argument_cache(int argc, const char** argv, local_environment& e
       (ANNOTATE_SWITCH,                                                                                          ANNOTATE_HELP)
       (UNROLL_POLICY_SWITCH, boost::program_options::value< unsigned int >()->default_value(DEFAULT_UNROLL_MAX), UNROLL_POLICY_HELP)
       (FAST_SWITCH,                                                                                              FAST_HELP)
+      (VECTORIZE_SWITCH,                                                                                         VECTORIZE_HELP)
+      (HYBRID_SWITCH,                                                                                            HYBRID_HELP)
+      (OPERATION_REPORT_SWITCH,                                                                                  OPERATION_REPORT_HELP)
+      (HORNER_SWITCH,                                                                                            HORNER_HELP)
+      (JOBS_SWITCH,          boost::program_options::value< unsigned int >()->default_value(DEFAULT_JOBS),         JOBS_HELP)
       ;
 
     boost::program_options::options_description warnings(WARNING_OPTIONS);
@@ -270,6 +284,11 @@ argument_cache::argument_cache(int argc, const char** argv, local_environment& e
     if(option_map.count(ANNOTATE_SWITCH)) this->annotate_flag = true;
     if(option_map.count(UNROLL_POLICY_SWITCH)) this->unroll_policy_size = option_map[UNROLL_POLICY_SWITCH].as<unsigned int>();
     if(option_map.count(FAST_SWITCH)) this->fast_flag = true;
+    if(option_map.count(VECTORIZE_SWITCH)) this->vectorize_flag = true;
+    if(option_map.count(HYBRID_SWITCH)) this->hybrid_flag = true;
+    if(option_map.count(OPERATION_REPORT_SWITCH)) this->operation_report_flag = true;
+    if(option_map.count(HORNER_SWITCH)) this->horner_flag = true;
+    if(option_map.count(JOBS_SWITCH)) this->jobs_count = std::max(option_map[JOBS_SWITCH].as<unsigned int>(), 1u);
 
     // CONFIGURATION OPTIONS
     if(option_map.count(VERBOSE_SWITCH_LONG)) this->verbose_flag = true;
@@ -277,6 +296,8 @@ argument_cache::argument_cache(int argc, const char** argv, local_environment& e
     if(option_map.count(CORE_OUTPUT_SWITCH) > 0) this->core_output = option_map[CORE_OUTPUT_SWITCH].as<std::string>();
     if(option_map.count(IMPLEMENTATION_OUTPUT_SWITCH) > 0) this->implementation_output = option_map[IMPLEMENTATION_OUTPUT_SWITCH].as<std::string>();
     if(option_map.count(NO_COLOUR_SWITCH) || option_map.count(NO_COLOR_SWITCH)) this->colour_flag = false;
+    if(option_map.count(CACHE_DIR_SWITCH) > 0) this->cache_directory = option_map[CACHE_DIR_SWITCH].as<std::string>();
+    if(option_map.count(NO_EXPRESSION_CACHE_SWITCH)) this->expression_cache_flag = false;
 
     if(option_map.count(INCLUDE_SWITCH_LONG) > 0)
       {
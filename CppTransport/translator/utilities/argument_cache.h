@@ -84,6 +84,12 @@ class argument_cache
     //! get search paths
     const std::list<boost::filesystem::path>& search_paths() const { return(this->search_path_list); }
 
+    //! use the persistent expression cache?
+    bool expression_cache() const { return(this->expression_cache_flag); }
+
+    //! get directory for the persistent expression cache; empty if none was specified
+    const std::string& cache_dir() const { return(this->cache_directory); }
+
 
     // CODE GENERATION OPTIONS
 
@@ -100,6 +106,21 @@ class argument_cache
 
     bool fast() const { return(this->fast_flag); }
 
+    //! get vectorization setting
+    bool vectorize() const { return(this->vectorize_flag); }
+
+    //! get hybrid unrolling setting
+    bool hybrid() const { return(this->hybrid_flag); }
+
+    //! get operation report setting
+    bool operation_report() const { return(this->operation_report_flag); }
+
+    //! get Horner form setting
+    bool horner() const { return(this->horner_flag); }
+
+    //! get number of worker processes used to build tensor components
+    unsigned int jobs() const { return(this->jobs_count); }
+
 
     // WARNINGS
 
@@ -163,6 +184,12 @@ class argument_cache
     //! list of search paths
     std::list< boost::filesystem::path > search_path_list;
 
+    //! use persistent expression cache
+    bool expression_cache_flag;
+
+    //! directory for persistent expression cache
+    std::string cache_directory;
+
 
     // CODE GENERATION OPTIONS
 
@@ -178,6 +205,21 @@ class argument_cache
     //! fast setting
     bool fast_flag;
 
+    //! vectorization setting
+    bool vectorize_flag;
+
+    //! hybrid unrolling setting
+    bool hybrid_flag;
+
+    //! operation report setting
+    bool operation_report_flag;
+
+    //! Horner form setting
+    bool horner_flag;
+
+    //! number of worker processes
+    unsigned int jobs_count;
+
 
     // WARNINGS
 
@@ -156,6 +156,12 @@ namespace transport
         //! Set flush mode
         virtual void set_flush_mode(flush_mode f) { this->mode = f; }
 
+        //! Get sorted-flush status; if set, each batch is written in ascending primary-key order
+        bool get_sorted_flush() const { return(this->sorted_flush); }
+
+        //! Set sorted-flush status
+        void set_sorted_flush(bool s) { this->sorted_flush = s; }
+
 
         // INTERNAL API
 
@@ -215,6 +221,9 @@ namespace transport
     
         //! Flushing mode
         flush_mode mode;
+
+        //! Write batches in ascending primary-key order?
+        bool sorted_flush;
     
         //! checkpoint interval in nanoseconds; 0 indicates that checkpointing is disabled
         boost::timer::nanosecond_type checkpoint_interval;
@@ -291,8 +300,9 @@ namespace transport
 	      worker_group(g),
 	      worker_number(w),
 	      manager_handle(static_cast<void*>(h)),
+	      flush_due(false),
 	      mode(flush_mode::flush_immediate),
-	      flush_due(false)
+	      sorted_flush(false)
 	    {
         // set up logging
 
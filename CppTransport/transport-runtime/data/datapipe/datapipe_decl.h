@@ -11,6 +11,15 @@
 #include <list>
 #include <functional>
 #include <memory>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <type_traits>
 
 #include "transport-runtime/defaults.h"
 #include "transport-runtime/enumerations.h"
@@ -19,6 +28,8 @@
 #include "transport-runtime/utilities/linecache.h"
 #include "transport-runtime/utilities/host_information.h"
 
+#include "transport-runtime/instruments/timing_instrument.h"
+
 // forward-declare tasks if needed
 #include "transport-runtime/tasks/tasks_forward_declare.h"
 
@@ -37,8 +48,11 @@
 
 #include "transport-runtime/data/batchers/integration_items.h"
 #include "transport-runtime/data/batchers/postintegration_items.h"
+#include "transport-runtime/data/storage_precision.h"
 
 #include "transport-runtime/data/datapipe/linecache_specializations.h"
+#include "transport-runtime/data/datapipe/node_cache.h"
+#include "transport-runtime/data/datapipe/thread_cache.h"
 #include "transport-runtime/data/datapipe/datapipe_dispatch_function.h"
 
 #include "boost/filesystem/operations.hpp"
@@ -117,13 +131,18 @@ namespace transport
 
       public:
 
-        //! Construct a datapipe
-        datapipe(unsigned int cap, const boost::filesystem::path& lp, const boost::filesystem::path& tp, unsigned int w,
-                 data_manager<number>& dm, utility_callbacks& u, bool no_log=false);
+        //! Construct a datapipe; 'nid' identifies the job's node-shared cache segment, and is used only if 'nc' is nonzero
+        datapipe(size_t cap, unsigned int rd, size_t nc, const boost::filesystem::path& lp, const boost::filesystem::path& tp, const std::string& nid,
+                 unsigned int w, data_manager<number>& dm, utility_callbacks& u, bool no_log=false);
 
         //! Destroy a datapipe
         ~datapipe();
 
+      protected:
+
+        //! Construct a view onto a parent datapipe; see new_view()
+        datapipe(datapipe<number>& parent, size_t cap);
+
 
         // PIPE MANAGEMENT
 
@@ -136,9 +155,11 @@ namespace transport
         template <typename handle_type>
         void set_manager_handle(handle_type h)  { this->manager_handle = static_cast<void*>(h); }
 
-        //! Return an implementation-dependent handle
+        //! Return an implementation-dependent handle.
+        //! If the calling thread holds a lease on one of the read-only reader handles, that handle is
+        //! returned instead of the principal one
         template <typename handle_type>
-        void get_manager_handle(handle_type* h) const { *h = static_cast<handle_type>(this->manager_handle); }
+        void get_manager_handle(handle_type* h) const { *h = static_cast<handle_type>(this->get_current_handle()); }
 
         //! Get worker numbers
         unsigned int get_worker_number() const { return(this->worker_number); }
@@ -151,6 +172,130 @@ namespace transport
         bool validate_unattached(void) const;
 
 
+        // VIEWS
+
+      public:
+
+        //! Create a view onto this datapipe: an independent datapipe, with its own private cache of capacity 'cap'
+        //! and its own database connexions, which another thread can attach and read while this one is in use.
+        //! Lines are shared between the parent and all of its views through a common second-level cache.
+        //! A view does not provision reader connexions or register a log sink; its log records are written
+        //! to the parent's log.
+        //! Views must be destroyed before their parent
+        std::unique_ptr< datapipe<number> > new_view(size_t cap);
+
+        //! Get mutex which must be held while evaluating a model.
+        //! Generated model code is not re-entrant, so a model may be used by only one view at a time
+        std::mutex& get_model_mutex() { return(*this->model_mutex); }
+
+        //! Get capacity of private data cache
+        size_t get_capacity() const { return(this->capacity); }
+
+
+        // READER POOL
+
+      public:
+
+        //! RAII object which leases a read-only reader handle to the current thread for its lifetime.
+        //! While the lease is held, get_manager_handle() called from this thread returns the leased handle
+        class reader_lease
+          {
+
+          public:
+
+            //! constructor blocks until a reader handle becomes available
+            reader_lease(datapipe<number>& p);
+
+            //! destructor returns the handle to the pool
+            ~reader_lease();
+
+          private:
+
+            //! parent datapipe
+            datapipe<number>& pipe;
+
+            //! leased handle
+            void* handle;
+
+          };
+
+        //! Get number of read-only reader handles which should be provisioned when a container is attached
+        unsigned int get_reader_count() const { return(this->reader_count); }
+
+        //! Add a read-only reader handle to the pool; used by the data_manager when attaching a container
+        template <typename handle_type>
+        void add_reader_handle(handle_type h);
+
+        //! Remove all reader handles from the pool and return them, so they can be closed by the data_manager.
+        //! Must not be called while any leases are outstanding
+        template <typename handle_type>
+        std::list<handle_type> drain_reader_handles();
+
+      protected:
+
+        //! Return handle appropriate for the calling thread
+        void* get_current_handle() const;
+
+        //! Run work(n) for each n in [0, count), sharing the items among threads which each lease a reader handle.
+        //! Runs serially on the calling thread if there is no pool, or only one item.
+        //! The first exception thrown by any item is rethrown once all threads have finished
+        template <typename WorkFunction>
+        void run_on_readers(size_t count, WorkFunction work);
+
+
+        // SHARD ROUTING
+
+      public:
+
+        //! Add a read-only handle to a shard of the attached content group, together with the k-configurations
+        //! it holds; used by the data_manager when attaching a sharded group
+        template <typename handle_type>
+        void add_shard_handle(handle_type h, const std::set<unsigned int>& twopf_serials, const std::set<unsigned int>& threepf_serials);
+
+        //! Is the attached content group sharded?
+        bool is_sharded() const { return(!this->shard_handles.empty()); }
+
+        //! Get handle for the shard holding a twopf k-configuration.
+        //! Returns false, leaving the handle unchanged, if the configuration is held in the principal container
+        template <typename handle_type>
+        bool get_twopf_shard_handle(unsigned int serial, handle_type* h);
+
+        //! Get handle for the shard holding a threepf k-configuration.
+        //! Returns false, leaving the handle unchanged, if the configuration is held in the principal container
+        template <typename handle_type>
+        bool get_threepf_shard_handle(unsigned int serial, handle_type* h);
+
+        //! Get number of shards
+        unsigned int get_shard_count() const { return(static_cast<unsigned int>(this->shard_handles.size())); }
+
+        //! Set the function which opens a further read-only connexion to a shard, by position in the manifest;
+        //! used by the data_manager when attaching a sharded group.
+        //! SQLite serializes access to each connexion, so a thread holding a reader lease is given its own
+        //! connexion to a shard the first time it pulls from it. At most CPPTRANSPORT_DEFAULT_SHARD_READER_CONNEXIONS
+        //! such connexions are opened per datapipe; beyond that, or if opening fails, the shared connexion is used
+        void set_shard_opener(std::function<void*(unsigned int)> opener) { this->shard_opener = std::move(opener); }
+
+        //! Get handle for a shard, by position in the manifest.
+        //! If the calling thread holds a lease on a reader handle, that reader's connexion to the shard is returned
+        template <typename handle_type>
+        handle_type get_shard_handle(unsigned int i) { return(static_cast<handle_type>(this->get_current_shard_handle(i))); }
+
+        //! Get position in the manifest of the shard holding a twopf or threepf k-configuration;
+        //! returns get_shard_count() if the configuration is held in the principal container
+        unsigned int find_twopf_shard(unsigned int serial) const;
+        unsigned int find_threepf_shard(unsigned int serial) const;
+
+        //! Remove all shard handles, including those opened for readers, and return them, so they can be
+        //! closed by the data_manager. Must not be called while any leases are outstanding
+        template <typename handle_type>
+        std::list<handle_type> drain_shard_handles();
+
+      protected:
+
+        //! Return handle to a shard appropriate for the calling thread, opening a connexion for its reader if needed
+        void* get_current_shard_handle(unsigned int i);
+
+
         // ABSOLUTE PATHS
 
       public:
@@ -194,6 +339,9 @@ namespace transport
         //! Get total data cache hits
         unsigned int get_data_cache_hits() const { return(this->data_cache.get_hits()); }
 
+        //! Get number of data cache lines supplied by the node-shared cache; zero if it is disabled
+        unsigned int get_node_cache_hits() const { return(this->shared_cache ? this->shared_cache->get_hits() : 0); }
+
         //! Get total statistics cache hits
         unsigned int get_stats_cache_hits() const { return(this->statistics_cache.get_hits()); }
 
@@ -240,6 +388,18 @@ namespace transport
         //! Detach a content group from the datapipe
         void detach(void);
 
+        //! Find the content group which attach() would select for a task, without attaching it.
+        //! On success, sets the group's name and the absolute path to its output directory.
+        //! Returns false if no suitable content group can be found
+        bool find_content_group(derivable_task<number>* tk, const std::list<std::string>& tags,
+                                std::string& name, boost::filesystem::path& output_path);
+
+        //! Find the content group from which a content group belonging to a task was seeded.
+        //! On success, sets the seed group's name and the absolute path to its output directory.
+        //! Returns false if the group was not seeded, or its seed can no longer be found
+        bool find_seed_group(derivable_task<number>* tk, const std::string& group,
+                             std::string& seed, boost::filesystem::path& seed_output_path);
+
         //! Is this datapipe attached to a content group?
         bool is_attached() const { return(this->type != attachment_type::none_attached); }
 
@@ -249,6 +409,22 @@ namespace transport
 		    //! Is this datapipe attached to a postintegration content group?
 		    bool is_postintegration_attached() const { return(this->type == attachment_type::postintegration_attached); }
 
+
+        // INCREMENTAL DERIVATION
+
+      public:
+
+        //! Begin recording the k-configurations for which derived lines generate output.
+        //! k-configurations in 'exclude' are already covered by stored lines, and will be skipped
+        void begin_kconfig_tracking(std::set<unsigned int> exclude);
+
+        //! Should a derived line generate output for a k-configuration? If tracking, the serial number is recorded.
+        //! Always true if tracking is not in progress
+        bool use_kconfig(unsigned int serial);
+
+        //! Stop recording, and return the serial numbers of k-configurations for which output was generated
+        std::set<unsigned int> end_kconfig_tracking();
+
       protected:
 
 		    //! set up cache tables for a newly-attached content group
@@ -264,6 +440,10 @@ namespace transport
         //! Output is meaningful only when a group is attached.
         unsigned int get_N_fields() const { return(this->N_fields); }
 
+        //! Get storage precision used for a class of value table in the currently attached group.
+        //! Postintegration groups are always stored at full precision
+        storage_precision get_storage_precision(storage_table t) const { return(this->storage.get(t)); }
+
 		    //! Get payload record if an integration group is attached; returns nullptr if an integration group is not attached
         //! Raw pointers are used because there is no notion of ownership transfer
 		    content_group_record<integration_payload>* get_attached_integration_record();
@@ -316,6 +496,66 @@ namespace transport
         kconfig_zeta_handle& new_kconfig_zeta_handle(const derived_data::SQL_twopf_query& query) const;
         kconfig_zeta_handle& new_kconfig_zeta_handle(const derived_data::SQL_threepf_query& query) const;
 
+
+        // CONCURRENT PULLS
+
+      public:
+
+        //! Pull a set of lines into the cache using the pool of read-only reader handles, so that
+        //! independent lookups overlap their database I/O.
+        //! Lines which are already cached are skipped. Afterwards, lookup_tag() on the same handle will hit
+        //! the cache for each tag, unless the set of lines is too large to fit within the cache capacity.
+        //! Falls back to serial pulls if no reader handles are available.
+        template <typename TagType>
+        void parallel_pull(time_data_handle& handle, std::vector<TagType>& tags);
+
+
+        // PREFETCH
+
+      public:
+
+        //! RAII object which announces a set of lines that a client is about to consume.
+        //! On construction, lines which are not already cached are grouped by batch key and each group is pulled
+        //! in a single bulk query; groups are pulled concurrently using the pool of reader handles.
+        //! Every line in the set is pinned in the cache until the prefetch is released, so lookup_tag()
+        //! on the same handle always hits while it is held
+        class line_prefetch
+          {
+
+          public:
+
+            //! constructor fills and pins the lines for a set of tags
+            template <typename TagType>
+            line_prefetch(datapipe<number>& p, time_data_handle& h, std::vector<TagType>& tags);
+
+            //! destructor releases any pins which are still held
+            ~line_prefetch() { this->release(); }
+
+            //! release all pins, making the lines evictable again
+            void release();
+
+          private:
+
+            //! handle owning the pinned lines
+            time_data_handle& handle;
+
+            //! copies of the tags whose lines are pinned
+            std::vector< std::unique_ptr< data_tag<number> > > pinned;
+
+          };
+
+
+        // STREAMING PULLS
+
+      public:
+
+        //! Pull the time history of every component of a correlation function at fixed k-configuration
+        //! in a single bulk read, bypassing the line cache. history is indexed by component and then by time sample.
+        //! Intended for consumers such as postintegration tasks, which visit each k-configuration once
+        void pull_time_history(const derived_data::SQL_time_query& query, cf_data_type type, unsigned int kserial,
+                               std::vector< std::vector<number> >& history);
+
+
 		    // TAG FACTORIES
 
       public:
@@ -435,7 +675,14 @@ namespace transport
         // PROPERTIES
 
         //! Maximum capacity to use (approximately--we don't try to do a detailed accounting of memory use)
-        unsigned int capacity;
+        size_t capacity;
+
+        //! Shared-memory cache shared with other datapipes on this node; null if disabled
+        std::unique_ptr< node_cache<number> > shared_cache;
+
+        //! In-process cache shared with views; null until the first view is created, and unused if
+        //! there is a node-shared cache
+        std::shared_ptr< thread_cache<number> > view_cache;
 
         //! Unique serial number identifying the worker process owning this datapipe
         const unsigned int worker_number;
@@ -444,6 +691,70 @@ namespace transport
         void* manager_handle;
 
 
+        // READER POOL
+
+        //! Number of read-only reader handles to provision for each attached container
+        const unsigned int reader_count;
+
+        //! Reader handles which are available for lease
+        std::list<void*> free_readers;
+
+        //! Reader handles currently leased, indexed by thread id
+        std::map<std::thread::id, void*> leased_readers;
+
+        //! Total number of reader handles in the pool (leased or free)
+        unsigned int pool_size;
+
+        //! Mutex protecting the reader pool
+        mutable std::mutex reader_mutex;
+
+        //! Condition variable used to wait for a reader handle to become free
+        std::condition_variable reader_available;
+
+
+        // VIEWS
+
+        //! Mutex serializing calls into the data_manager and repository; shared between a datapipe and its views
+        std::shared_ptr<std::mutex> manager_mutex;
+
+        //! Mutex serializing model evaluations; shared between a datapipe and its views
+        std::shared_ptr<std::mutex> model_mutex;
+
+
+        // INCREMENTAL DERIVATION
+
+        //! is k-configuration tracking in progress?
+        bool kconfig_tracking;
+
+        //! k-configurations to skip
+        std::set<unsigned int> kconfig_excluded;
+
+        //! k-configurations used
+        std::set<unsigned int> kconfig_used;
+
+
+        // SHARD ROUTING
+
+        //! Read-only handles to the shards of the attached content group, in manifest order
+        std::vector<void*> shard_handles;
+
+        //! Read-only handles to the shards for each reader, in manifest order, indexed by the reader handle;
+        //! null until the reader first pulls from a shard. Protected by the reader mutex
+        std::map<void*, std::vector<void*> > reader_shard_handles;
+
+        //! Number of connexions opened for readers; protected by the reader mutex
+        unsigned int reader_shard_connexions;
+
+        //! Function used to open a reader's connexion to a shard; empty if the attached group is not sharded
+        std::function<void*(unsigned int)> shard_opener;
+
+        //! Map from twopf k-configuration serial number to shard
+        std::unordered_map<unsigned int, unsigned int> twopf_shard_map;
+
+        //! Map from threepf k-configuration serial number to shard
+        std::unordered_map<unsigned int, unsigned int> threepf_shard_map;
+
+
         // CURRENTLY ATTACHED OUTPUT GROUP
 
 		    //! what sort of group is currently attached?
@@ -458,6 +769,9 @@ namespace transport
         //! Number of fields associated with currently attached group
         unsigned int N_fields;
 
+        //! Storage precision policy of currently attached group
+        storage_policy storage;
+
 
         // PATHS
 
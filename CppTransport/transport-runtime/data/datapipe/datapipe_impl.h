@@ -37,8 +37,8 @@ namespace transport
 
 
     template <typename number>
-    datapipe<number>::datapipe(unsigned int cap, const boost::filesystem::path& lp, const boost::filesystem::path& tp, unsigned int w,
-                               data_manager<number>& dm, utility_callbacks& u, bool no_log)
+    datapipe<number>::datapipe(size_t cap, unsigned int rd, size_t nc, const boost::filesystem::path& lp, const boost::filesystem::path& tp, const std::string& nid,
+                               unsigned int w, data_manager<number>& dm, utility_callbacks& u, bool no_log)
       : logdir_path(lp),
         temporary_path(tp),
         worker_number(w),
@@ -54,6 +54,13 @@ namespace transport
         threepf_kconfig_cache(CPPTRANSPORT_DEFAULT_CONFIGURATION_CACHE_SIZE),
         statistics_cache(CPPTRANSPORT_DEFAULT_CONFIGURATION_CACHE_SIZE),
         data_cache(cap),
+        capacity(cap),
+        reader_count(rd),
+        pool_size(0),
+        manager_mutex(std::make_shared<std::mutex>()),
+        model_mutex(std::make_shared<std::mutex>()),
+        kconfig_tracking(false),
+        reader_shard_connexions(0),
         type(attachment_type::none_attached),
         N_fields(0)
       {
@@ -90,7 +97,7 @@ namespace transport
           }
 
         BOOST_LOG_SEV(this->log_source, log_severity_level::normal)
-          << "** Instantiated datapipe (cache capacity " << format_memory(cap) << ")"
+          << "** Instantiated datapipe (cache capacity " << format_memory(cap) << ", " << rd << " reader connexions)"
           << " on MPI host " << host_info.get_host_name();
     
         BOOST_LOG_SEV(this->log_source, log_severity_level::normal)
@@ -114,6 +121,81 @@ namespace transport
               << host_info.get_architecture()
               << " | CPU vendor = " << host_info.get_cpu_vendor_id();
           }
+
+        // attach to the node-shared cache, if enabled; the master process supplies an identifier which is
+        // unique to this run of the job, and removes the segment when the job ends
+        if(nc > 0 && !nid.empty())
+          {
+            try
+              {
+                this->shared_cache = std::make_unique< node_cache<number> >(nid, nc);
+                this->data_cache.set_shared_store(this->shared_cache.get());
+
+                BOOST_LOG_SEV(this->log_source, log_severity_level::normal)
+                  << "** Attached node-shared cache '" << this->shared_cache->get_name() << "' (capacity " << format_memory(this->shared_cache->get_capacity()) << ")";
+              }
+            catch(boost::interprocess::interprocess_exception& xe)
+              {
+                this->shared_cache.reset();
+
+                BOOST_LOG_SEV(this->log_source, log_severity_level::warning)
+                  << "!! Could not attach node-shared cache (" << xe.what() << "); continuing with private cache only";
+              }
+          }
+      }
+
+
+    template <typename number>
+    datapipe<number>::datapipe(datapipe<number>& parent, size_t cap)
+      : logdir_path(parent.logdir_path),
+        temporary_path(parent.temporary_path),
+        worker_number(parent.worker_number),
+        utilities(parent.utilities),
+        data_mgr(parent.data_mgr),
+        time_config_cache_table(nullptr),
+        twopf_kconfig_cache_table(nullptr),
+        threepf_kconfig_cache_table(nullptr),
+        statistics_cache_table(nullptr),
+        data_cache_table(nullptr),
+        time_config_cache(CPPTRANSPORT_DEFAULT_CONFIGURATION_CACHE_SIZE),
+        twopf_kconfig_cache(CPPTRANSPORT_DEFAULT_CONFIGURATION_CACHE_SIZE),
+        threepf_kconfig_cache(CPPTRANSPORT_DEFAULT_CONFIGURATION_CACHE_SIZE),
+        statistics_cache(CPPTRANSPORT_DEFAULT_CONFIGURATION_CACHE_SIZE),
+        data_cache(cap),
+        capacity(cap),
+        view_cache(parent.view_cache),
+        reader_count(0),
+        pool_size(0),
+        manager_mutex(parent.manager_mutex),
+        model_mutex(parent.model_mutex),
+        kconfig_tracking(false),
+        reader_shard_connexions(0),
+        type(attachment_type::none_attached),
+        N_fields(0)
+      {
+        this->database_timer.stop();
+
+        // share lines with the parent through its second-level cache; new_view() guarantees that there is one
+        this->data_cache.set_shared_store(parent.data_cache.get_shared_store());
+
+        BOOST_LOG_SEV(this->log_source, log_severity_level::normal)
+          << "** Instantiated datapipe view (cache capacity " << format_memory(cap) << ")";
+      }
+
+
+    template <typename number>
+    std::unique_ptr< datapipe<number> > datapipe<number>::new_view(size_t cap)
+      {
+        // if lines are not already shared through the node-shared cache, share them through an in-process cache
+        // sized to match our own private cache
+        if(this->data_cache.get_shared_store() == nullptr)
+          {
+            this->view_cache = std::make_shared< thread_cache<number> >(this->capacity);
+            this->data_cache.set_shared_store(this->view_cache.get());
+          }
+
+        // constructor is protected, so std::make_unique cannot be used
+        return std::unique_ptr< datapipe<number> >(new datapipe<number>(*this, cap));
       }
 
 
@@ -135,6 +217,10 @@ namespace transport
         BOOST_LOG_SEV(this->log_source, log_severity_level::normal) << "--   threepf k-configuration cache hits = " << this->threepf_kconfig_cache.get_hits() << " | unloads = " << this->threepf_kconfig_cache.get_unloads();
         BOOST_LOG_SEV(this->log_source, log_severity_level::normal) << "--   statistics cache hits              = " << this->statistics_cache.get_hits() << " | unloads = " << this->statistics_cache.get_unloads();
         BOOST_LOG_SEV(this->log_source, log_severity_level::normal) << "--   data cache hits:                   = " << this->data_cache.get_hits() << " | unloads = " << this->data_cache.get_unloads();
+        if(this->shared_cache)
+          {
+            BOOST_LOG_SEV(this->log_source, log_severity_level::normal) << "--   node-shared cache hits             = " << this->shared_cache->get_hits() << " | stores = " << this->shared_cache->get_stores() << " | evictions = " << this->shared_cache->get_evictions();
+          }
         BOOST_LOG_SEV(this->log_source, log_severity_level::normal) << "";
         BOOST_LOG_SEV(this->log_source, log_severity_level::normal) << "--   time-configuration evictions       = " << format_time(this->time_config_cache.get_eviction_timer());
         BOOST_LOG_SEV(this->log_source, log_severity_level::normal) << "--   twopf k-configuration evictions    = " << format_time(this->twopf_kconfig_cache.get_eviction_timer());
@@ -189,6 +275,401 @@ namespace transport
       }
 
 
+    template <typename number>
+    template <typename handle_type>
+    void datapipe<number>::add_reader_handle(handle_type h)
+      {
+        std::lock_guard<std::mutex> lock(this->reader_mutex);
+
+        this->free_readers.push_back(static_cast<void*>(h));
+        ++this->pool_size;
+
+        this->reader_available.notify_one();
+      }
+
+
+    template <typename number>
+    template <typename handle_type>
+    std::list<handle_type> datapipe<number>::drain_reader_handles()
+      {
+        std::lock_guard<std::mutex> lock(this->reader_mutex);
+
+        assert(this->leased_readers.empty());
+
+        std::list<handle_type> handles;
+        for(void* h : this->free_readers)
+          {
+            handles.push_back(static_cast<handle_type>(h));
+          }
+
+        this->free_readers.clear();
+        this->pool_size = 0;
+
+        return handles;
+      }
+
+
+    template <typename number>
+    template <typename handle_type>
+    void datapipe<number>::add_shard_handle(handle_type h, const std::set<unsigned int>& twopf_serials, const std::set<unsigned int>& threepf_serials)
+      {
+        unsigned int index = static_cast<unsigned int>(this->shard_handles.size());
+        this->shard_handles.push_back(static_cast<void*>(h));
+
+        for(unsigned int serial : twopf_serials)   this->twopf_shard_map[serial] = index;
+        for(unsigned int serial : threepf_serials) this->threepf_shard_map[serial] = index;
+      }
+
+
+    template <typename number>
+    void* datapipe<number>::get_current_shard_handle(unsigned int i)
+      {
+        std::unique_lock<std::mutex> lock(this->reader_mutex);
+
+        if(this->leased_readers.empty() || !this->shard_opener) return(this->shard_handles[i]);
+
+        typename std::map<std::thread::id, void*>::const_iterator t = this->leased_readers.find(std::this_thread::get_id());
+        if(t == this->leased_readers.end()) return(this->shard_handles[i]);
+
+        // a reader is leased to one thread at a time, so no other thread can open a connexion for it meanwhile
+        void* reader = t->second;
+        std::vector<void*>& handles = this->reader_shard_handles[reader];
+        if(handles.size() < this->shard_handles.size()) handles.resize(this->shard_handles.size(), nullptr);
+        if(handles[i] != nullptr) return(handles[i]);
+
+        // limit the number of open files; once the limit is reached, readers share the connexion to the shard
+        if(this->reader_shard_connexions >= CPPTRANSPORT_DEFAULT_SHARD_READER_CONNEXIONS) return(this->shard_handles[i]);
+        ++this->reader_shard_connexions;
+
+        // opening a connexion is slow, so release the lock while doing it
+        lock.unlock();
+
+        void* h = nullptr;
+        try
+          {
+            h = this->shard_opener(i);
+          }
+        catch(runtime_exception&)
+          {
+          }
+
+        lock.lock();
+
+        if(h == nullptr)
+          {
+            // probably out of file descriptors; stop opening further connexions, and use the shared one
+            this->reader_shard_connexions = CPPTRANSPORT_DEFAULT_SHARD_READER_CONNEXIONS;
+            return(this->shard_handles[i]);
+          }
+
+        this->reader_shard_handles[reader][i] = h;
+        return(h);
+      }
+
+
+    template <typename number>
+    unsigned int datapipe<number>::find_twopf_shard(unsigned int serial) const
+      {
+        std::unordered_map<unsigned int, unsigned int>::const_iterator t = this->twopf_shard_map.find(serial);
+        return(t != this->twopf_shard_map.end() ? t->second : this->get_shard_count());
+      }
+
+
+    template <typename number>
+    unsigned int datapipe<number>::find_threepf_shard(unsigned int serial) const
+      {
+        std::unordered_map<unsigned int, unsigned int>::const_iterator t = this->threepf_shard_map.find(serial);
+        return(t != this->threepf_shard_map.end() ? t->second : this->get_shard_count());
+      }
+
+
+    template <typename number>
+    template <typename handle_type>
+    bool datapipe<number>::get_twopf_shard_handle(unsigned int serial, handle_type* h)
+      {
+        unsigned int index = this->find_twopf_shard(serial);
+        if(index >= this->get_shard_count()) return(false);
+
+        *h = static_cast<handle_type>(this->get_current_shard_handle(index));
+        return(true);
+      }
+
+
+    template <typename number>
+    template <typename handle_type>
+    bool datapipe<number>::get_threepf_shard_handle(unsigned int serial, handle_type* h)
+      {
+        unsigned int index = this->find_threepf_shard(serial);
+        if(index >= this->get_shard_count()) return(false);
+
+        *h = static_cast<handle_type>(this->get_current_shard_handle(index));
+        return(true);
+      }
+
+
+    template <typename number>
+    template <typename handle_type>
+    std::list<handle_type> datapipe<number>::drain_shard_handles()
+      {
+        std::lock_guard<std::mutex> lock(this->reader_mutex);
+
+        std::list<handle_type> handles;
+        for(void* h : this->shard_handles)
+          {
+            handles.push_back(static_cast<handle_type>(h));
+          }
+
+        for(const std::pair<void* const, std::vector<void*> >& reader : this->reader_shard_handles)
+          {
+            for(void* h : reader.second)
+              {
+                if(h != nullptr) handles.push_back(static_cast<handle_type>(h));
+              }
+          }
+
+        this->shard_handles.clear();
+        this->reader_shard_handles.clear();
+        this->reader_shard_connexions = 0;
+        this->shard_opener = nullptr;
+        this->twopf_shard_map.clear();
+        this->threepf_shard_map.clear();
+
+        return handles;
+      }
+
+
+    template <typename number>
+    void* datapipe<number>::get_current_handle() const
+      {
+        std::lock_guard<std::mutex> lock(this->reader_mutex);
+
+        if(this->leased_readers.empty()) return(this->manager_handle);
+
+        typename std::map<std::thread::id, void*>::const_iterator t = this->leased_readers.find(std::this_thread::get_id());
+        if(t != this->leased_readers.end()) return(t->second);
+
+        return(this->manager_handle);
+      }
+
+
+    template <typename number>
+    datapipe<number>::reader_lease::reader_lease(datapipe<number>& p)
+      : pipe(p),
+        handle(nullptr)
+      {
+        std::unique_lock<std::mutex> lock(pipe.reader_mutex);
+        pipe.reader_available.wait(lock, [&]() -> bool { return(!pipe.free_readers.empty()); });
+
+        handle = pipe.free_readers.front();
+        pipe.free_readers.pop_front();
+
+        pipe.leased_readers[std::this_thread::get_id()] = handle;
+      }
+
+
+    template <typename number>
+    datapipe<number>::reader_lease::~reader_lease()
+      {
+        std::lock_guard<std::mutex> lock(pipe.reader_mutex);
+
+        pipe.leased_readers.erase(std::this_thread::get_id());
+        pipe.free_readers.push_back(handle);
+
+        pipe.reader_available.notify_one();
+      }
+
+
+    template <typename number>
+    template <typename WorkFunction>
+    void datapipe<number>::run_on_readers(size_t count, WorkFunction work)
+      {
+        if(count == 0) return;
+
+        unsigned int threads = 0;
+        {
+          std::lock_guard<std::mutex> lock(this->reader_mutex);
+          threads = static_cast<unsigned int>(std::min(static_cast<size_t>(this->pool_size), count));
+        }
+
+        // if there is no pool, or only one item, there is nothing to be gained by starting threads
+        if(threads <= 1)
+          {
+            for(size_t n = 0; n < count; ++n)
+              {
+                work(n);
+              }
+            return;
+          }
+
+        // keep the database timer running for the duration of the batch; the timing instruments constructed
+        // by each pull() then find the timer already running and leave it alone, so the worker threads never
+        // modify it
+        timing_instrument timer(this->database_timer);
+
+        std::atomic<size_t> next(0);
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto worker = [&]() -> void
+          {
+            reader_lease lease(*this);
+
+            size_t n;
+            while((n = next++) < count)
+              {
+                try
+                  {
+                    work(n);
+                  }
+                catch(...)
+                  {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if(!error) error = std::current_exception();
+                    next = count;
+                  }
+              }
+          };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for(unsigned int i = 0; i < threads; ++i)
+          {
+            pool.emplace_back(worker);
+          }
+
+        for(std::thread& t : pool)
+          {
+            t.join();
+          }
+
+        if(error) std::rethrow_exception(error);
+      }
+
+
+    template <typename number>
+    template <typename TagType>
+    void datapipe<number>::parallel_pull(time_data_handle& handle, std::vector<TagType>& tags)
+      {
+        static_assert(std::is_base_of< data_tag<number>, TagType >::value, "parallel_pull() requires a data tag type");
+
+        assert(this->validate_attached());
+        if(!this->validate_attached()) throw runtime_exception(exception_type::DATAPIPE_ERROR, CPPTRANSPORT_DATAMGR_PIPE_NOT_ATTACHED);
+
+        // determine which lines actually need to be pulled
+        std::vector<TagType*> missing;
+        missing.reserve(tags.size());
+        for(TagType& tag : tags)
+          {
+            if(!handle.contains(tag)) missing.push_back(&tag);
+          }
+
+        this->run_on_readers(missing.size(), [&](size_t n) -> void { handle.fill_tag(*missing[n]); });
+      }
+
+
+    template <typename number>
+    template <typename TagType>
+    datapipe<number>::line_prefetch::line_prefetch(datapipe<number>& p, time_data_handle& h, std::vector<TagType>& tags)
+      : handle(h)
+      {
+        static_assert(std::is_base_of< data_tag<number>, TagType >::value, "line_prefetch requires a data tag type");
+
+        assert(p.validate_attached());
+        if(!p.validate_attached()) throw runtime_exception(exception_type::DATAPIPE_ERROR, CPPTRANSPORT_DATAMGR_PIPE_NOT_ATTACHED);
+
+        pinned.reserve(tags.size());
+
+        // pin lines which are already cached; group the remainder into batches which can be pulled together.
+        // Tags without a batch key form batches of one
+        std::map< std::string, std::vector< data_tag<number>* > > keyed;
+        std::vector< std::vector< data_tag<number>* > > batches;
+
+        for(TagType& tag : tags)
+          {
+            if(handle.pin_tag(tag))
+              {
+                pinned.emplace_back(tag.clone());
+                continue;
+              }
+
+            std::string key = tag.batch_key();
+            if(key.empty()) batches.push_back(std::vector< data_tag<number>* >(1, &tag));
+            else            keyed[key].push_back(&tag);
+          }
+
+        for(std::pair< const std::string, std::vector< data_tag<number>* > >& batch : keyed)
+          {
+            batches.push_back(std::move(batch.second));
+          }
+
+        p.run_on_readers(batches.size(), [&](size_t n) -> void { handle.fill_pinned(batches[n]); });
+
+        for(const std::vector< data_tag<number>* >& batch : batches)
+          {
+            for(data_tag<number>* tag : batch)
+              {
+                pinned.emplace_back(tag->clone());
+              }
+          }
+      }
+
+
+    template <typename number>
+    void datapipe<number>::line_prefetch::release()
+      {
+        for(std::unique_ptr< data_tag<number> >& tag : this->pinned)
+          {
+            this->handle.unpin_tag(*tag);
+          }
+
+        this->pinned.clear();
+      }
+
+
+    template <typename number>
+    void datapipe<number>::pull_time_history(const derived_data::SQL_time_query& query, cf_data_type type, unsigned int kserial,
+                                             std::vector< std::vector<number> >& history)
+      {
+        // check that we are attached to an integration content group
+        assert(this->validate_attached(attachment_type::integration_attached));
+        if(!this->validate_attached(attachment_type::integration_attached)) throw runtime_exception(exception_type::DATAPIPE_ERROR, CPPTRANSPORT_DATAMGR_PIPE_NOT_ATTACHED);
+
+        timing_instrument timer(this->database_timer);
+        switch(type)
+          {
+            case cf_data_type::cf_twopf_re:
+              {
+                this->data_mgr.pull_twopf_time_history(this, query, kserial, history, twopf_type::real);
+                break;
+              }
+
+            case cf_data_type::cf_twopf_im:
+              {
+                this->data_mgr.pull_twopf_time_history(this, query, kserial, history, twopf_type::imag);
+                break;
+              }
+
+            case cf_data_type::cf_threepf_momentum:
+              {
+                this->data_mgr.pull_threepf_time_history(this, query, kserial, history, threepf_type::momentum);
+                break;
+              }
+
+            case cf_data_type::cf_threepf_Nderiv:
+              {
+                this->data_mgr.pull_threepf_time_history(this, query, kserial, history, threepf_type::Nderiv);
+                break;
+              }
+
+            case cf_data_type::cf_tensor_twopf:
+              {
+                this->data_mgr.pull_tensor_twopf_time_history(this, query, kserial, history);
+                break;
+              }
+          }
+      }
+
+
     template <typename number>
     bool datapipe<number>::validate_attached(void) const
       {
@@ -246,7 +727,10 @@ namespace transport
         if((itk = dynamic_cast< integration_task<number>* >(tk)) != nullptr)    // trying to attach to an integration content group
           {
             // datapipe_attach_integration_content() will throw an exception if no suitable content group can be found
+            std::unique_lock<std::mutex> lock(*this->manager_mutex);
             this->attached_integration_group = this->data_mgr.datapipe_attach_integration_content(this, this->utilities.integration_finder, tk->get_name(), tags);
+            lock.unlock();
+
             this->type                       = attachment_type::integration_attached;
 
             // remember number of fields associated with this container
@@ -255,6 +739,9 @@ namespace transport
             integration_payload& payload = this->attached_integration_group->get_payload();
             this->attach_cache_tables(payload);
 
+            // remember storage precision, so that reduced-precision values are widened on read
+            this->storage = payload.get_storage_policy();
+
             BOOST_LOG_SEV(this->get_log(), log_severity_level::normal) << "** ATTACH integration content group " << boost::posix_time::to_simple_string(this->attached_integration_group->get_creation_time())
             << " (from integration task '" << tk->get_name() << "')";
 
@@ -263,10 +750,14 @@ namespace transport
         else if((ptk = dynamic_cast< postintegration_task<number>* >(tk)) != nullptr)      // trying to attach to a postintegration content group
           {
             // datapipe_attach_integration_content() will throw an exception if no suitable content group can be found
+            std::unique_lock<std::mutex> lock(*this->manager_mutex);
             this->attached_postintegration_group = this->data_mgr.datapipe_attach_postintegration_content(this, this->utilities.postintegration_finder, tk->get_name(), tags);
+            lock.unlock();
+
             this->type                           = attachment_type::postintegration_attached;
 
             this->N_fields = 0;
+            this->storage  = storage_policy();
 
             postintegration_payload& payload = this->attached_postintegration_group->get_payload();
             this->attach_cache_tables(payload);
@@ -283,6 +774,120 @@ namespace transport
       }
 
 
+    template <typename number>
+    bool datapipe<number>::find_content_group(derivable_task<number>* tk, const std::list<std::string>& tags,
+                                              std::string& name, boost::filesystem::path& output_path)
+      {
+        if(tk == nullptr) return(false);
+
+        std::lock_guard<std::mutex> lock(*this->manager_mutex);
+
+        try
+          {
+            if(dynamic_cast< integration_task<number>* >(tk) != nullptr)
+              {
+                std::unique_ptr< content_group_record<integration_payload> > rec = this->utilities.integration_finder(tk->get_name(), tags);
+                if(!rec) return(false);
+
+                name        = rec->get_name();
+                output_path = rec->get_abs_output_path();
+                return(true);
+              }
+            else if(dynamic_cast< postintegration_task<number>* >(tk) != nullptr)
+              {
+                std::unique_ptr< content_group_record<postintegration_payload> > rec = this->utilities.postintegration_finder(tk->get_name(), tags);
+                if(!rec) return(false);
+
+                name        = rec->get_name();
+                output_path = rec->get_abs_output_path();
+                return(true);
+              }
+          }
+        catch(runtime_exception& xe)
+          {
+            // no suitable content group; attach() will report the error if the caller goes on to use it
+          }
+
+        return(false);
+      }
+
+
+    template <typename number>
+    bool datapipe<number>::find_seed_group(derivable_task<number>* tk, const std::string& group,
+                                           std::string& seed, boost::filesystem::path& seed_output_path)
+      {
+        if(tk == nullptr) return(false);
+
+        std::lock_guard<std::mutex> lock(*this->manager_mutex);
+
+        try
+          {
+            if(dynamic_cast< integration_task<number>* >(tk) != nullptr)
+              {
+                std::unique_ptr< content_group_record<integration_payload> > rec = this->utilities.integration_finder.lookup(group);
+                if(!rec || !rec->get_payload().is_seeded()) return(false);
+
+                std::unique_ptr< content_group_record<integration_payload> > seed_rec = this->utilities.integration_finder.lookup(rec->get_payload().get_seed_group());
+                if(!seed_rec) return(false);
+
+                seed             = seed_rec->get_name();
+                seed_output_path = seed_rec->get_abs_output_path();
+                return(true);
+              }
+            else if(dynamic_cast< postintegration_task<number>* >(tk) != nullptr)
+              {
+                std::unique_ptr< content_group_record<postintegration_payload> > rec = this->utilities.postintegration_finder.lookup(group);
+                if(!rec || !rec->get_payload().is_seeded()) return(false);
+
+                std::unique_ptr< content_group_record<postintegration_payload> > seed_rec = this->utilities.postintegration_finder.lookup(rec->get_payload().get_seed_group());
+                if(!seed_rec) return(false);
+
+                seed             = seed_rec->get_name();
+                seed_output_path = seed_rec->get_abs_output_path();
+                return(true);
+              }
+          }
+        catch(runtime_exception& xe)
+          {
+            // seed group has been deleted, or is otherwise unavailable
+          }
+
+        return(false);
+      }
+
+
+    template <typename number>
+    void datapipe<number>::begin_kconfig_tracking(std::set<unsigned int> exclude)
+      {
+        this->kconfig_tracking = true;
+        this->kconfig_excluded = std::move(exclude);
+        this->kconfig_used.clear();
+      }
+
+
+    template <typename number>
+    bool datapipe<number>::use_kconfig(unsigned int serial)
+      {
+        if(!this->kconfig_tracking) return(true);
+        if(this->kconfig_excluded.count(serial) > 0) return(false);
+
+        this->kconfig_used.insert(serial);
+        return(true);
+      }
+
+
+    template <typename number>
+    std::set<unsigned int> datapipe<number>::end_kconfig_tracking()
+      {
+        this->kconfig_tracking = false;
+        this->kconfig_excluded.clear();
+
+        std::set<unsigned int> used;
+        used.swap(this->kconfig_used);
+        return(used);
+      }
+
+
     template <typename number>
     template <typename Payload>
     void datapipe<number>::attach_cache_tables(Payload& payload)
@@ -303,7 +908,10 @@ namespace transport
         assert(this->validate_attached());
         if(!this->validate_attached()) throw runtime_exception(exception_type::DATAPIPE_ERROR, CPPTRANSPORT_DATAMGR_DETACH_PIPE_NOT_ATTACHED);
 
-        this->data_mgr.datapipe_detach(this);
+        {
+          std::lock_guard<std::mutex> lock(*this->manager_mutex);
+          this->data_mgr.datapipe_detach(this);
+        }
 
         switch(this->type)
           {
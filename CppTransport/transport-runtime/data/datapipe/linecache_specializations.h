@@ -28,21 +28,30 @@
 #define CPPTRANSPORT_CONFIGURATIONS_H
 
 
+#include <string>
+#include <functional>
+
+
 namespace transport
 	{
 
 
-    // Provide specializations for the size methods used in linecache to compute the size of data elements
+    // Provide specializations for the size and hashing methods used by linecache
     namespace linecache
 	    {
         
         // template for any container implementing the STL container interface
         template <typename Container>
-        unsigned int elementsof_container(const Container& c) { return c.size(); }
+        size_t elementsof_container(const Container& c) { return c.size(); }
         
         // template for any container providing a value_type type
         template <typename Container>
-        unsigned int sizeof_container_element() { return sizeof(typename Container::value_type); }
+        size_t sizeof_container_element() { return sizeof(typename Container::value_type); }
+
+        // template for any query object providing a query string; query objects compare equal
+        // when their query strings agree, so hashing the string is consistent with operator==
+        template <typename QueryObject>
+        size_t hash_query(const QueryObject& q) { return std::hash<std::string>()(q.get_query_string()); }
 
 	    }   // namespace linecache -- specializations
 
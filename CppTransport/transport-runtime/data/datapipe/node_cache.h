@@ -0,0 +1,582 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+#ifndef CPPTRANSPORT_NODE_CACHE_H
+#define CPPTRANSPORT_NODE_CACHE_H
+
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <functional>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+#include <signal.h>
+#include <unistd.h>
+
+#include "transport-runtime/utilities/linecache.h"
+#include "transport-runtime/data/datapipe/tags_forward_declare.h"
+
+#include "boost/interprocess/managed_shared_memory.hpp"
+#include "boost/interprocess/shared_memory_object.hpp"
+
+
+namespace transport
+  {
+
+    // number of consecutive index slots examined when looking up or inserting a line
+    constexpr unsigned int CPPTRANSPORT_NODE_CACHE_PROBE = 16;
+
+    // number of slots sampled when choosing a line to evict
+    constexpr unsigned int CPPTRANSPORT_NODE_CACHE_SAMPLE = 8;
+
+    // number of evictions attempted to make room for a new line before giving up
+    constexpr unsigned int CPPTRANSPORT_NODE_CACHE_EVICT_ATTEMPTS = 32;
+
+    // typical size of a cache line in bytes, used to size the index
+    constexpr unsigned int CPPTRANSPORT_NODE_CACHE_LINE_ESTIMATE = 4096;
+
+    // maximum number of processes which can register with a segment
+    constexpr unsigned int CPPTRANSPORT_NODE_CACHE_MAX_PROCESSES = 256;
+
+
+    namespace node_cache_impl
+      {
+
+        // index entries live in shared memory, so the atomics they use must be address-free
+        static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2, "node_cache requires lock-free atomics");
+
+        constexpr auto segment_prefix = "CppTransport-";
+        constexpr auto header_name    = "header";
+        constexpr auto index_name     = "index";
+
+        //! life cycle of an index slot: empty -> writing -> ready -> evicting -> empty
+        enum slot_state : std::uint32_t { empty = 0, writing = 1, ready = 2, evicting = 3 };
+
+
+        //! segment header, shared by all attached processes
+        struct header
+          {
+            header(std::uint64_t n)
+              : clock(0), sweep(0), number_slots(n)
+              {
+                for(std::atomic<std::int32_t>& p : this->processes)
+                  {
+                    p.store(0);
+                  }
+              }
+
+            //! process ids of processes attached to the segment; zero marks a free entry
+            std::atomic<std::int32_t> processes[CPPTRANSPORT_NODE_CACHE_MAX_PROCESSES];
+
+            //! access clock, used to stamp lines for LRU eviction
+            std::atomic<std::uint64_t> clock;
+
+            //! rotating start position for eviction sampling
+            std::atomic<std::uint64_t> sweep;
+
+            //! number of slots in the index
+            const std::uint64_t number_slots;
+          };
+
+
+        //! index slot describing one cache line
+        struct slot
+          {
+            slot()
+              : state(empty), readers(0), key(0), check(0), stamp(0), offset(0), count(0)
+              {
+              }
+
+            //! current slot_state
+            std::atomic<std::uint32_t> state;
+
+            //! number of processes currently copying this line out
+            std::atomic<std::uint32_t> readers;
+
+            //! primary hash, used to choose the probe window
+            std::atomic<std::uint64_t> key;
+
+            //! independent secondary hash, used to confirm a match
+            std::atomic<std::uint64_t> check;
+
+            //! access stamp
+            std::atomic<std::uint64_t> stamp;
+
+            //! location of the line data within the segment; valid only while the slot is ready
+            boost::interprocess::managed_shared_memory::handle_t offset;
+
+            //! number of elements in the line
+            std::uint64_t count;
+          };
+
+
+        inline std::uint64_t mix(std::uint64_t x)
+          {
+            x += 0x9e3779b97f4a7c15ULL;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return(x ^ (x >> 31));
+          }
+
+
+        //! is a process on this node still running?
+        inline bool is_live(std::int32_t pid)
+          {
+            return(::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM);
+          }
+
+
+        inline std::uint64_t fnv1a(const std::string& s)
+          {
+            std::uint64_t h = 0xcbf29ce484222325ULL;
+            for(unsigned char c : s)
+              {
+                h ^= c;
+                h *= 0x100000001b3ULL;
+              }
+            return(h);
+          }
+
+      }   // namespace node_cache_impl
+
+
+    //! node_cache is a cache of datapipe lines held in a POSIX shared-memory segment, so that
+    //! worker processes on the same node which read the same content group can share lines
+    //! rather than each pulling them from the database.
+    //! Every process attaches to the same named segment; the index is a fixed-size open-addressed
+    //! table of slots which are claimed and released using atomic operations only.
+    //! Lines are evicted approximately in least-recently-used order by sampling a few slots at a time.
+    //!
+    //! Cleanup rules:
+    //! - a segment belongs to a single job. Its identifier should combine the job's temporary directory
+    //!   with a token generated afresh by the master process for each run, so a later job (including one
+    //!   which recovers the same content group) never opens a segment left behind by an earlier run
+    //! - the master process owns the segment on its own node, and calls remove() when the task ends,
+    //!   whether or not it succeeded
+    //! - on every node, each attached process registers its process id in the segment header.
+    //!   A detaching process removes the segment if no registered process is still running, so a rank
+    //!   which crashed without running its destructor does not keep the segment alive
+    //! - a process killed while it holds a slot in the writing state, or while inside the segment allocator,
+    //!   can leave that slot unusable or the allocator locked. The damage is confined to the segment of the
+    //!   current job, which is discarded when the job ends
+    //! - if every process on a node is killed, nothing removes the segment on that node. It stays in /dev/shm
+    //!   until removed by hand (its name begins CppTransport-) or the node reboots, but is never reused
+    template <typename number>
+    class node_cache: public linecache::shared_store< std::vector<number>, data_tag<number> >
+      {
+
+        // CONSTRUCTOR, DESTRUCTOR
+
+      public:
+
+        //! constructor attaches to (or creates) the segment for a given job.
+        //! Processes passing the same identifier share a segment.
+        //! Throws boost::interprocess::interprocess_exception if the segment cannot be mapped
+        node_cache(const std::string& id, size_t cap);
+
+        //! destructor detaches from the segment, and removes it if no other registered process is still running
+        ~node_cache();
+
+
+        // OWNERSHIP
+
+      public:
+
+        //! remove the segment for a given job from this node; processes which are still attached keep their
+        //! mapping, but the segment is freed once they detach. Used by the owning process when a job ends
+        static void remove(const std::string& id);
+
+
+        // INTERFACE -- implements a 'shared_store' interface
+
+      public:
+
+        //! fetch a line
+        virtual bool fetch(size_t group, const data_tag<number>& tag, std::vector<number>& data) override;
+
+        //! offer a line
+        virtual void offer(size_t group, const data_tag<number>& tag, const std::vector<number>& data) override;
+
+
+        // STATISTICS
+
+      public:
+
+        //! get name of segment
+        const std::string& get_name() const { return(this->name); }
+
+        //! get size of segment
+        size_t get_capacity() const { return(this->segment.get_size()); }
+
+        //! get number of lines supplied by this process
+        unsigned int get_hits() const { return(this->hits.load()); }
+
+        //! get number of lines stored by this process
+        unsigned int get_stores() const { return(this->stores.load()); }
+
+        //! get number of lines evicted by this process
+        unsigned int get_evictions() const { return(this->evictions.load()); }
+
+
+        // INTERNAL API
+
+      protected:
+
+        //! compute primary and secondary hashes for a line
+        void compute_keys(size_t group, const data_tag<number>& tag, std::uint64_t& key, std::uint64_t& check) const;
+
+        //! try to evict the line held in a slot. If 'reclaim' is set the slot is left in the writing state,
+        //! owned by the caller; otherwise it is returned to the empty state
+        bool evict(node_cache_impl::slot& s, bool reclaim);
+
+        //! evict the least-recently used of a sample of slots
+        bool evict_sample();
+
+        //! allocate storage for a line, evicting other lines if necessary; returns nullptr on failure
+        void* allocate(size_t bytes);
+
+        //! get the next access stamp
+        std::uint64_t next_stamp() { return(this->head->clock.fetch_add(1, std::memory_order_relaxed) + 1); }
+
+        //! register this process in the segment header; returns false if the table is full
+        bool register_process();
+
+        //! deregister this process, and determine whether any other registered process is still running
+        bool deregister_process();
+
+
+        // INTERNAL DATA
+
+      private:
+
+        //! segment name
+        const std::string name;
+
+        //! mapped segment
+        boost::interprocess::managed_shared_memory segment;
+
+        //! segment header
+        node_cache_impl::header* head;
+
+        //! slot array
+        node_cache_impl::slot* index;
+
+        //! number of slots
+        std::uint64_t number_slots;
+
+        //! id of this process
+        const std::int32_t pid;
+
+        //! did this process register in the segment header?
+        bool registered;
+
+        //! lines supplied
+        std::atomic<unsigned int> hits;
+
+        //! lines stored
+        std::atomic<unsigned int> stores;
+
+        //! lines evicted
+        std::atomic<unsigned int> evictions;
+
+
+        // HELPER
+
+      public:
+
+        //! build a segment name from a job identifier; POSIX limits shared-memory names, so the identifier is hashed
+        static std::string segment_name(const std::string& id);
+
+      };
+
+
+    template <typename number>
+    std::string node_cache<number>::segment_name(const std::string& id)
+      {
+        std::ostringstream nm;
+        nm << node_cache_impl::segment_prefix << std::hex << std::setw(16) << std::setfill('0')
+           << node_cache_impl::mix(node_cache_impl::fnv1a(id) ^ sizeof(number));
+        return(nm.str());
+      }
+
+
+    template <typename number>
+    node_cache<number>::node_cache(const std::string& id, size_t cap)
+      : name(segment_name(id)),
+        segment(boost::interprocess::open_or_create, name.c_str(), cap),
+        head(nullptr),
+        index(nullptr),
+        number_slots(0),
+        pid(static_cast<std::int32_t>(::getpid())),
+        registered(false),
+        hits(0),
+        stores(0),
+        evictions(0)
+      {
+        // size the index so it occupies a small fraction of the segment; if the segment already
+        // exists, the slot count recorded in its header takes precedence
+        std::uint64_t n = std::max(static_cast<std::uint64_t>(CPPTRANSPORT_NODE_CACHE_PROBE), static_cast<std::uint64_t>(cap / CPPTRANSPORT_NODE_CACHE_LINE_ESTIMATE));
+
+        // find_or_construct is atomic with respect to other processes opening the segment
+        this->head = this->segment.template find_or_construct<node_cache_impl::header>(node_cache_impl::header_name)(n);
+        this->number_slots = this->head->number_slots;
+        this->index = this->segment.template find_or_construct<node_cache_impl::slot>(node_cache_impl::index_name)[this->number_slots]();
+
+        this->registered = this->register_process();
+      }
+
+
+    template <typename number>
+    node_cache<number>::~node_cache()
+      {
+        // an unregistered process cannot tell whether it is the last one running, so leaves removal to others.
+        // The segment remains mapped by any process still attached, so it is safe to unlink the name;
+        // a process attaching later creates a fresh segment
+        if(this->registered && !this->deregister_process())
+          {
+            boost::interprocess::shared_memory_object::remove(this->name.c_str());
+          }
+      }
+
+
+    template <typename number>
+    void node_cache<number>::remove(const std::string& id)
+      {
+        boost::interprocess::shared_memory_object::remove(segment_name(id).c_str());
+      }
+
+
+    template <typename number>
+    bool node_cache<number>::register_process()
+      {
+        for(std::atomic<std::int32_t>& p : this->head->processes)
+          {
+            std::int32_t expected = 0;
+            if(p.compare_exchange_strong(expected, this->pid)) return(true);
+
+            // reuse an entry left behind by a process which has exited without detaching
+            if(!node_cache_impl::is_live(expected) && p.compare_exchange_strong(expected, this->pid)) return(true);
+          }
+
+        return(false);
+      }
+
+
+    template <typename number>
+    bool node_cache<number>::deregister_process()
+      {
+        bool others = false;
+        bool cleared = false;
+
+        for(std::atomic<std::int32_t>& p : this->head->processes)
+          {
+            std::int32_t entry = p.load();
+            if(entry == 0) continue;
+
+            // clear one entry only; this process may hold others through further node_cache instances
+            std::int32_t expected = this->pid;
+            if(!cleared && entry == this->pid && p.compare_exchange_strong(expected, 0))
+              {
+                cleared = true;
+              }
+            else if(node_cache_impl::is_live(entry))
+              {
+                others = true;
+              }
+          }
+
+        return(others);
+      }
+
+
+    template <typename number>
+    void node_cache<number>::compute_keys(size_t group, const data_tag<number>& tag, std::uint64_t& key, std::uint64_t& check) const
+      {
+        std::string nm = tag.name();
+
+        key   = node_cache_impl::mix(static_cast<std::uint64_t>(group) ^ static_cast<std::uint64_t>(std::hash<std::string>()(nm)));
+        check = node_cache_impl::fnv1a(nm) ^ node_cache_impl::mix(static_cast<std::uint64_t>(group) + 1);
+      }
+
+
+    template <typename number>
+    bool node_cache<number>::fetch(size_t group, const data_tag<number>& tag, std::vector<number>& data)
+      {
+        std::uint64_t key;
+        std::uint64_t check;
+        this->compute_keys(group, tag, key, check);
+
+        std::uint64_t start = key % this->number_slots;
+        for(unsigned int i = 0; i < CPPTRANSPORT_NODE_CACHE_PROBE && i < this->number_slots; ++i)
+          {
+            node_cache_impl::slot& s = this->index[(start + i) % this->number_slots];
+
+            if(s.state.load() != node_cache_impl::ready || s.key.load() != key) continue;
+
+            // register as a reader, then confirm the slot was not evicted or recycled in the meantime;
+            // an evicting process checks the reader count only after it has moved the slot out of the ready state
+            s.readers.fetch_add(1);
+            if(s.state.load() == node_cache_impl::ready && s.key.load() == key && s.check.load() == check)
+              {
+                const number* p = static_cast<const number*>(this->segment.get_address_from_handle(s.offset));
+                data.assign(p, p + s.count);
+                s.stamp.store(this->next_stamp(), std::memory_order_relaxed);
+                s.readers.fetch_sub(1);
+
+                ++this->hits;
+                return(true);
+              }
+            s.readers.fetch_sub(1);
+          }
+
+        return(false);
+      }
+
+
+    template <typename number>
+    void node_cache<number>::offer(size_t group, const data_tag<number>& tag, const std::vector<number>& data)
+      {
+        size_t bytes = data.size() * sizeof(number);
+
+        // don't allow a single line to displace a large part of the cache
+        if(bytes == 0 || bytes > this->segment.get_size() / 4) return;
+
+        std::uint64_t key;
+        std::uint64_t check;
+        this->compute_keys(group, tag, key, check);
+
+        std::uint64_t start = key % this->number_slots;
+
+        // claim an empty slot in the probe window, noting the least-recently used ready slot as a fallback
+        node_cache_impl::slot* claimed = nullptr;
+        node_cache_impl::slot* oldest = nullptr;
+        for(unsigned int i = 0; claimed == nullptr && i < CPPTRANSPORT_NODE_CACHE_PROBE && i < this->number_slots; ++i)
+          {
+            node_cache_impl::slot& s = this->index[(start + i) % this->number_slots];
+
+            std::uint32_t state = s.state.load();
+            if(state == node_cache_impl::ready)
+              {
+                // another process may already have stored this line
+                if(s.key.load() == key && s.check.load() == check) return;
+                if(oldest == nullptr || s.stamp.load(std::memory_order_relaxed) < oldest->stamp.load(std::memory_order_relaxed)) oldest = &s;
+              }
+            else if(state == node_cache_impl::empty)
+              {
+                std::uint32_t expected = node_cache_impl::empty;
+                if(s.state.compare_exchange_strong(expected, node_cache_impl::writing)) claimed = &s;
+              }
+          }
+
+        if(claimed == nullptr)
+          {
+            if(oldest == nullptr || !this->evict(*oldest, true)) return;
+            claimed = oldest;
+          }
+
+        void* p = this->allocate(bytes);
+        if(p == nullptr)
+          {
+            claimed->state.store(node_cache_impl::empty);
+            return;
+          }
+
+        std::memcpy(p, data.data(), bytes);
+
+        claimed->offset = this->segment.get_handle_from_address(p);
+        claimed->count  = data.size();
+        claimed->key.store(key);
+        claimed->check.store(check);
+        claimed->stamp.store(this->next_stamp(), std::memory_order_relaxed);
+        claimed->state.store(node_cache_impl::ready);
+
+        ++this->stores;
+      }
+
+
+    template <typename number>
+    bool node_cache<number>::evict(node_cache_impl::slot& s, bool reclaim)
+      {
+        std::uint32_t expected = node_cache_impl::ready;
+        if(!s.state.compare_exchange_strong(expected, node_cache_impl::evicting)) return(false);
+
+        // a reader is copying the line out; leave it alone
+        if(s.readers.load() != 0)
+          {
+            s.state.store(node_cache_impl::ready);
+            return(false);
+          }
+
+        this->segment.deallocate(this->segment.get_address_from_handle(s.offset));
+        s.state.store(reclaim ? node_cache_impl::writing : node_cache_impl::empty);
+
+        ++this->evictions;
+        return(true);
+      }
+
+
+    template <typename number>
+    bool node_cache<number>::evict_sample()
+      {
+        std::uint64_t start = this->head->sweep.fetch_add(CPPTRANSPORT_NODE_CACHE_SAMPLE, std::memory_order_relaxed);
+
+        node_cache_impl::slot* oldest = nullptr;
+        for(unsigned int i = 0; i < CPPTRANSPORT_NODE_CACHE_SAMPLE; ++i)
+          {
+            node_cache_impl::slot& s = this->index[(start + i) % this->number_slots];
+
+            if(s.state.load() != node_cache_impl::ready) continue;
+            if(oldest == nullptr || s.stamp.load(std::memory_order_relaxed) < oldest->stamp.load(std::memory_order_relaxed)) oldest = &s;
+          }
+
+        return(oldest != nullptr && this->evict(*oldest, false));
+      }
+
+
+    template <typename number>
+    void* node_cache<number>::allocate(size_t bytes)
+      {
+        void* p = this->segment.allocate(bytes, std::nothrow);
+
+        for(unsigned int i = 0; p == nullptr && i < CPPTRANSPORT_NODE_CACHE_EVICT_ATTEMPTS; ++i)
+          {
+            if(this->evict_sample()) p = this->segment.allocate(bytes, std::nothrow);
+          }
+
+        return(p);
+      }
+
+
+  }   // namespace transport
+
+
+#endif //CPPTRANSPORT_NODE_CACHE_H
@@ -87,6 +87,22 @@ namespace transport
         //! virtual function to identify this tag
         virtual std::string name() const = 0;
 
+
+        // BATCHED PULLS
+
+      public:
+
+        //! key identifying the bulk query which can supply this tag's line.
+        //! Tags with equal, non-empty keys can be pulled together by pull_batch(); an empty key means
+        //! the tag can only be pulled individually
+        virtual std::string batch_key() const { return std::string(); }
+
+        //! pull the lines for a batch of tags sharing this tag's batch key, which should be a member of the batch.
+        //! data is populated with one line per tag, in the same order as the batch.
+        //! The default implementation pulls each line individually
+        virtual void pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                std::vector< std::vector<number> >& data);
+
         // CLONE
 
       public:
@@ -145,6 +161,18 @@ namespace transport
         virtual std::string name() const override { std::ostringstream msg; msg << "background field " << id; return(msg.str()); }
 
 
+        // BATCHED PULLS
+
+      public:
+
+        //! all background fields are pulled by the same query
+        virtual std::string batch_key() const override { return std::string("background"); }
+
+        //! pull lines for a batch of background fields
+        virtual void pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                std::vector< std::vector<number> >& data) override;
+
+
         // CLONE
 
       public:
@@ -205,6 +233,18 @@ namespace transport
         virtual std::string name() const override;
 
 
+        // BATCHED PULLS
+
+      public:
+
+        //! all components of the same correlation function at the same k-configuration are pulled by the same query
+        virtual std::string batch_key() const override;
+
+        //! pull lines for a batch of components
+        virtual void pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                std::vector< std::vector<number> >& data) override;
+
+
         // CLONE
 
       public:
@@ -271,6 +311,18 @@ namespace transport
         virtual std::string name() const override;
 
 
+        // BATCHED PULLS
+
+      public:
+
+        //! all components of the same correlation function at the same time serial number are pulled by the same query
+        virtual std::string batch_key() const override;
+
+        //! pull lines for a batch of components
+        virtual void pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                std::vector< std::vector<number> >& data) override;
+
+
         // CLONE
 
       public:
@@ -527,6 +579,193 @@ namespace transport
 	    }
 
 
+    // BATCHED PULLS -- IMPLEMENTATION
+
+
+    template <typename number>
+    void data_tag<number>::pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                      std::vector< std::vector<number> >& data)
+      {
+        data.clear();
+        data.resize(batch.size());
+
+        for(unsigned int i = 0; i < batch.size(); ++i)
+          {
+            batch[i]->pull(query, data[i]);
+          }
+      }
+
+
+    template <typename number>
+    void background_time_data_tag<number>::pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                                      std::vector< std::vector<number> >& data)
+      {
+        // check that we are attached to an integration content group
+        assert(this->pipe->validate_attached(datapipe<number>::attachment_type::integration_attached));
+        if(!this->pipe->validate_attached(datapipe<number>::attachment_type::integration_attached)) throw runtime_exception(exception_type::DATAPIPE_ERROR, CPPTRANSPORT_DATAMGR_PIPE_NOT_ATTACHED);
+
+#ifdef CPPTRANSPORT_DEBUG_DATAPIPE
+        BOOST_LOG_SEV(this->pipe->get_log(), datapipe<number>::log_severity_level::datapipe_pull) << "** PULL background time history request for " << batch.size() << " elements";
+#endif
+
+        std::vector< std::vector<number> > history;
+        {
+          timing_instrument timer(this->pipe->database_timer);
+          this->pipe->data_mgr.pull_background_time_history(this->pipe, query, history);
+        }
+
+        data.clear();
+        data.reserve(batch.size());
+        for(data_tag<number>* t : batch)
+          {
+            background_time_data_tag<number>* tag = dynamic_cast< background_time_data_tag<number>* >(t);
+            assert(tag != nullptr);
+            assert(tag->id < history.size());
+            data.push_back(history[tag->id]);
+          }
+      }
+
+
+    template <typename number>
+    std::string cf_time_data_tag<number>::batch_key() const
+      {
+        std::ostringstream key;
+        key << "cf-time:" << static_cast<unsigned int>(this->type) << ":" << this->kserial;
+        return(key.str());
+      }
+
+
+    template <typename number>
+    void cf_time_data_tag<number>::pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                              std::vector< std::vector<number> >& data)
+      {
+        // check that we are attached to an integration content group
+        assert(this->pipe->validate_attached(datapipe<number>::attachment_type::integration_attached));
+        if(!this->pipe->validate_attached(datapipe<number>::attachment_type::integration_attached)) throw runtime_exception(exception_type::DATAPIPE_ERROR, CPPTRANSPORT_DATAMGR_PIPE_NOT_ATTACHED);
+
+#ifdef CPPTRANSPORT_DEBUG_DATAPIPE
+        BOOST_LOG_SEV(this->pipe->get_log(), datapipe<number>::log_severity_level::datapipe_pull) << "** PULL time history request for " << batch.size() << " elements, k-configuration " << this->kserial;
+#endif
+
+        std::vector< std::vector<number> > history;
+        {
+          timing_instrument timer(this->pipe->database_timer);
+          switch(this->type)
+            {
+              case cf_data_type::cf_twopf_re:
+                {
+                  this->pipe->data_mgr.pull_twopf_time_history(this->pipe, query, this->kserial, history, twopf_type::real);
+                  break;
+                }
+
+              case cf_data_type::cf_twopf_im:
+                {
+                  this->pipe->data_mgr.pull_twopf_time_history(this->pipe, query, this->kserial, history, twopf_type::imag);
+                  break;
+                }
+
+              case cf_data_type::cf_threepf_momentum:
+                {
+                  this->pipe->data_mgr.pull_threepf_time_history(this->pipe, query, this->kserial, history, threepf_type::momentum);
+                  break;
+                }
+
+              case cf_data_type::cf_threepf_Nderiv:
+                {
+                  this->pipe->data_mgr.pull_threepf_time_history(this->pipe, query, this->kserial, history, threepf_type::Nderiv);
+                  break;
+                }
+
+              case cf_data_type::cf_tensor_twopf:
+                {
+                  this->pipe->data_mgr.pull_tensor_twopf_time_history(this->pipe, query, this->kserial, history);
+                  break;
+                }
+            }
+        }
+
+        data.clear();
+        data.reserve(batch.size());
+        for(data_tag<number>* t : batch)
+          {
+            cf_time_data_tag<number>* tag = dynamic_cast< cf_time_data_tag<number>* >(t);
+            assert(tag != nullptr);
+            assert(tag->id < history.size());
+            data.push_back(history[tag->id]);
+          }
+      }
+
+
+    template <typename number>
+    std::string cf_kconfig_data_tag<number>::batch_key() const
+      {
+        std::ostringstream key;
+        key << "cf-kconfig:" << static_cast<unsigned int>(this->type) << ":" << this->tserial;
+        return(key.str());
+      }
+
+
+    template <typename number>
+    void cf_kconfig_data_tag<number>::pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                                 std::vector< std::vector<number> >& data)
+      {
+        // check that we are attached to an integration content group
+        assert(this->pipe->validate_attached(datapipe<number>::attachment_type::integration_attached));
+        if(!this->pipe->validate_attached(datapipe<number>::attachment_type::integration_attached)) throw runtime_exception(exception_type::DATAPIPE_ERROR, CPPTRANSPORT_DATAMGR_PIPE_NOT_ATTACHED);
+
+#ifdef CPPTRANSPORT_DEBUG_DATAPIPE
+        BOOST_LOG_SEV(this->pipe->get_log(), datapipe<number>::log_severity_level::datapipe_pull) << "** PULL kconfig history request for " << batch.size() << " elements, t-serial " << this->tserial;
+#endif
+
+        std::vector< std::vector<number> > history;
+        {
+          timing_instrument timer(this->pipe->database_timer);
+          switch(this->type)
+            {
+              case cf_data_type::cf_twopf_re:
+                {
+                  this->pipe->data_mgr.pull_twopf_kconfig_history(this->pipe, query, this->tserial, history, twopf_type::real);
+                  break;
+                }
+
+              case cf_data_type::cf_twopf_im:
+                {
+                  this->pipe->data_mgr.pull_twopf_kconfig_history(this->pipe, query, this->tserial, history, twopf_type::imag);
+                  break;
+                }
+
+              case cf_data_type::cf_threepf_momentum:
+                {
+                  this->pipe->data_mgr.pull_threepf_kconfig_history(this->pipe, query, this->tserial, history, threepf_type::momentum);
+                  break;
+                }
+
+              case cf_data_type::cf_threepf_Nderiv:
+                {
+                  this->pipe->data_mgr.pull_threepf_kconfig_history(this->pipe, query, this->tserial, history, threepf_type::Nderiv);
+                  break;
+                }
+
+              case cf_data_type::cf_tensor_twopf:
+                {
+                  this->pipe->data_mgr.pull_tensor_twopf_kconfig_history(this->pipe, query, this->tserial, history);
+                  break;
+                }
+            }
+        }
+
+        data.clear();
+        data.reserve(batch.size());
+        for(data_tag<number>* t : batch)
+          {
+            cf_kconfig_data_tag<number>* tag = dynamic_cast< cf_kconfig_data_tag<number>* >(t);
+            assert(tag != nullptr);
+            assert(tag->id < history.size());
+            data.push_back(history[tag->id]);
+          }
+      }
+
+
     // TAG EQUALITY -- IMPLEMENTATION
 
 
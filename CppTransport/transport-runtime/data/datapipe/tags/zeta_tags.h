@@ -256,6 +256,18 @@ namespace transport
         virtual std::string name() const override { std::ostringstream msg; msg << "zeta two-point function, tserial =  " << tserial; return(msg.str()); }
 
 
+        // BATCHED PULLS
+
+      public:
+
+        //! samples at every time serial number are pulled by the same query
+        virtual std::string batch_key() const override { return std::string("zeta-twopf-kconfig"); }
+
+        //! pull lines for a batch of time serial numbers
+        virtual void pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                std::vector< std::vector<number> >& data) override;
+
+
         // CLONE
 
       public:
@@ -314,6 +326,18 @@ namespace transport
         virtual std::string name() const override { std::ostringstream msg; msg << "zeta three-point function, tserial =  " << tserial; return(msg.str()); }
 
 
+        // BATCHED PULLS
+
+      public:
+
+        //! samples at every time serial number are pulled by the same query
+        virtual std::string batch_key() const override { return std::string("zeta-threepf-kconfig"); }
+
+        //! pull lines for a batch of time serial numbers
+        virtual void pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                std::vector< std::vector<number> >& data) override;
+
+
         // CLONE
 
       public:
@@ -372,6 +396,18 @@ namespace transport
         virtual std::string name() const override { std::ostringstream msg; msg << "zeta reduced bispectrum, tserial =  " << tserial; return(msg.str()); }
 
 
+        // BATCHED PULLS
+
+      public:
+
+        //! samples at every time serial number are pulled by the same query
+        virtual std::string batch_key() const override { return std::string("zeta-reduced-bispectrum-kconfig"); }
+
+        //! pull lines for a batch of time serial numbers
+        virtual void pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                std::vector< std::vector<number> >& data) override;
+
+
         // CLONE
 
       public:
@@ -492,6 +528,84 @@ namespace transport
 	    }
 
 
+    // BATCHED PULLS -- IMPLEMENTATION
+
+
+    template <typename number>
+    void zeta_twopf_kconfig_data_tag<number>::pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                                         std::vector< std::vector<number> >& data)
+      {
+        assert(this->pipe->validate_attached(datapipe<number>::attachment_type::postintegration_attached));
+        if(!this->pipe->validate_attached(datapipe<number>::attachment_type::postintegration_attached)) throw runtime_exception(exception_type::DATAPIPE_ERROR, CPPTRANSPORT_DATAMGR_PIPE_NOT_ATTACHED);
+
+#ifdef CPPTRANSPORT_DEBUG_DATAPIPE
+        BOOST_LOG_SEV(this->pipe->get_log(), datapipe<number>::log_severity_level::datapipe_pull) << "** PULL zeta twopf kconfig history request for " << batch.size() << " t-serials";
+#endif
+
+        std::vector<unsigned int> t_serials;
+        t_serials.reserve(batch.size());
+        for(data_tag<number>* t : batch)
+          {
+            zeta_twopf_kconfig_data_tag<number>* tag = dynamic_cast< zeta_twopf_kconfig_data_tag<number>* >(t);
+            assert(tag != nullptr);
+            t_serials.push_back(tag->tserial);
+          }
+
+        timing_instrument timer(this->pipe->database_timer);
+        this->pipe->data_mgr.pull_zeta_twopf_kconfig_history(this->pipe, query, t_serials, data);
+      }
+
+
+    template <typename number>
+    void zeta_threepf_kconfig_data_tag<number>::pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                                           std::vector< std::vector<number> >& data)
+      {
+        assert(this->pipe->validate_attached(datapipe<number>::attachment_type::postintegration_attached));
+        if(!this->pipe->validate_attached(datapipe<number>::attachment_type::postintegration_attached)) throw runtime_exception(exception_type::DATAPIPE_ERROR, CPPTRANSPORT_DATAMGR_PIPE_NOT_ATTACHED);
+
+#ifdef CPPTRANSPORT_DEBUG_DATAPIPE
+        BOOST_LOG_SEV(this->pipe->get_log(), datapipe<number>::log_severity_level::datapipe_pull) << "** PULL zeta threepf kconfig history request for " << batch.size() << " t-serials";
+#endif
+
+        std::vector<unsigned int> t_serials;
+        t_serials.reserve(batch.size());
+        for(data_tag<number>* t : batch)
+          {
+            zeta_threepf_kconfig_data_tag<number>* tag = dynamic_cast< zeta_threepf_kconfig_data_tag<number>* >(t);
+            assert(tag != nullptr);
+            t_serials.push_back(tag->tserial);
+          }
+
+        timing_instrument timer(this->pipe->database_timer);
+        this->pipe->data_mgr.pull_zeta_threepf_kconfig_history(this->pipe, query, t_serials, data);
+      }
+
+
+    template <typename number>
+    void zeta_reduced_bispectrum_kconfig_data_tag<number>::pull_batch(derived_data::SQL_query& query, const std::vector< data_tag<number>* >& batch,
+                                                                      std::vector< std::vector<number> >& data)
+      {
+        assert(this->pipe->validate_attached(datapipe<number>::attachment_type::postintegration_attached));
+        if(!this->pipe->validate_attached(datapipe<number>::attachment_type::postintegration_attached)) throw runtime_exception(exception_type::DATAPIPE_ERROR, CPPTRANSPORT_DATAMGR_PIPE_NOT_ATTACHED);
+
+#ifdef CPPTRANSPORT_DEBUG_DATAPIPE
+        BOOST_LOG_SEV(this->pipe->get_log(), datapipe<number>::log_severity_level::datapipe_pull) << "** PULL zeta reduced bispectrum kconfig history request for " << batch.size() << " t-serials";
+#endif
+
+        std::vector<unsigned int> t_serials;
+        t_serials.reserve(batch.size());
+        for(data_tag<number>* t : batch)
+          {
+            zeta_reduced_bispectrum_kconfig_data_tag<number>* tag = dynamic_cast< zeta_reduced_bispectrum_kconfig_data_tag<number>* >(t);
+            assert(tag != nullptr);
+            t_serials.push_back(tag->tserial);
+          }
+
+        timing_instrument timer(this->pipe->database_timer);
+        this->pipe->data_mgr.pull_zeta_redbsp_kconfig_history(this->pipe, query, t_serials, data);
+      }
+
+
     // TAG EQUALITY -- IMPLEMENTATION
 
 
@@ -0,0 +1,185 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+#ifndef CPPTRANSPORT_THREAD_CACHE_H
+#define CPPTRANSPORT_THREAD_CACHE_H
+
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "transport-runtime/utilities/linecache.h"
+#include "transport-runtime/data/datapipe/tags_forward_declare.h"
+
+
+namespace transport
+  {
+
+    //! thread_cache is an in-process cache of datapipe lines shared between a datapipe and its views,
+    //! so that threads deriving lines from the same content group pull each line from the database only once.
+    //! All operations take a single mutex; lines are copied in and out, so the lock is never held while
+    //! a client uses the data.
+    //! Lines are evicted in least-recently-used order once the approximate capacity is exceeded
+    template <typename number>
+    class thread_cache: public linecache::shared_store< std::vector<number>, data_tag<number> >
+      {
+
+        // ASSOCIATED TYPES
+
+      protected:
+
+        //! an entry: key, and line data
+        typedef std::pair< std::string, std::vector<number> > entry;
+
+        //! entries are held in least-recently-used order, most recent first
+        typedef std::list<entry> entry_list;
+
+
+        // CONSTRUCTOR, DESTRUCTOR
+
+      public:
+
+        //! constructor
+        thread_cache(size_t cap)
+          : capacity(cap),
+            size(0),
+            hits(0)
+          {
+          }
+
+        //! destructor is default
+        ~thread_cache() = default;
+
+
+        // INTERFACE -- implements a 'shared_store' interface
+
+      public:
+
+        //! fetch a line
+        virtual bool fetch(size_t group, const data_tag<number>& tag, std::vector<number>& data) override;
+
+        //! offer a line
+        virtual void offer(size_t group, const data_tag<number>& tag, const std::vector<number>& data) override;
+
+
+        // STATISTICS
+
+      public:
+
+        //! get capacity
+        size_t get_capacity() const { return(this->capacity); }
+
+        //! get number of lines supplied
+        unsigned int get_hits() const { return(this->hits.load()); }
+
+
+        // INTERNAL API
+
+      protected:
+
+        //! build key for a line
+        static std::string make_key(size_t group, const data_tag<number>& tag) { return(std::to_string(group) + ":" + tag.name()); }
+
+
+        // INTERNAL DATA
+
+      private:
+
+        //! approximate capacity in bytes
+        const size_t capacity;
+
+        //! approximate current size in bytes
+        size_t size;
+
+        //! entries, most recently used first
+        entry_list entries;
+
+        //! index from key to entry
+        std::unordered_map< std::string, typename entry_list::iterator > index;
+
+        //! lines supplied
+        std::atomic<unsigned int> hits;
+
+        //! mutex protecting entries and index
+        std::mutex mtx;
+
+      };
+
+
+    template <typename number>
+    bool thread_cache<number>::fetch(size_t group, const data_tag<number>& tag, std::vector<number>& data)
+      {
+        std::string key = make_key(group, tag);
+
+        std::lock_guard<std::mutex> lock(this->mtx);
+
+        auto t = this->index.find(key);
+        if(t == this->index.end()) return(false);
+
+        // move to front of LRU list
+        this->entries.splice(this->entries.begin(), this->entries, t->second);
+        data = t->second->second;
+
+        ++this->hits;
+        return(true);
+      }
+
+
+    template <typename number>
+    void thread_cache<number>::offer(size_t group, const data_tag<number>& tag, const std::vector<number>& data)
+      {
+        size_t bytes = data.size()*sizeof(number);
+        if(bytes > this->capacity) return;
+
+        std::string key = make_key(group, tag);
+
+        std::lock_guard<std::mutex> lock(this->mtx);
+
+        // another thread may have offered the same line while this one was pulling it
+        if(this->index.find(key) != this->index.end()) return;
+
+        while(this->size + bytes > this->capacity && !this->entries.empty())
+          {
+            entry& victim = this->entries.back();
+            this->size -= victim.second.size()*sizeof(number);
+            this->index.erase(victim.first);
+            this->entries.pop_back();
+          }
+
+        this->entries.emplace_front(key, data);
+        this->index.emplace(std::move(key), this->entries.begin());
+        this->size += bytes;
+      }
+
+
+  }   // namespace transport
+
+
+#endif //CPPTRANSPORT_THREAD_CACHE_H
@@ -67,6 +67,18 @@ namespace transport
         //! note, argument_cache stores the capacity in bytes so no conversion is needed
         size_t get_pipe_capacity() const { return this->args.get_datapipe_capacity(); }
 
+        //! Return the number of read-only connexions each datapipe should hold open
+        unsigned int get_pipe_readers() const { return this->args.get_datapipe_readers(); }
+
+        //! Return the capacity of the shared-memory cache shared by datapipes on this node; zero if disabled
+        size_t get_node_cache_capacity() const { return this->args.get_node_cache_capacity(); }
+
+        //! get aggregation mode
+        aggregation_mode get_aggregation_mode() const { return this->args.get_bulk_aggregation() ? aggregation_mode::sorted_bulk : aggregation_mode::incremental; }
+
+        //! should integration output be kept as per-worker shards?
+        bool get_sharded_output() const { return this->args.get_sharded_output(); }
+
 
         // CHECKPOINTING ADMIN
 
@@ -372,9 +384,10 @@ namespace transport
 
       public:
 
-        //! Create a datapipe
+        //! Create a datapipe; 'cache_id' identifies the node-shared cache for the job, if one is in use
         virtual std::unique_ptr< datapipe<number> > create_datapipe(const boost::filesystem::path& logdir,
                                                                     const boost::filesystem::path& tempdir,
+                                                                    const std::string& cache_id,
                                                                     integration_content_finder<number>& integration_finder,
                                                                     postintegration_content_finder<number>& postintegration_finder,
                                                                     datapipe_dispatch_function <number>& dispatcher,
@@ -421,6 +434,11 @@ namespace transport
         virtual void pull_background_time_sample(datapipe<number>* pipe, unsigned int id, const derived_data::SQL_query& query,
                                                  std::vector<number>& sample) = 0;
 
+        //! Pull the evolution of every background field from a datapipe, in bulk;
+        //! history is indexed by field and then by time sample
+        virtual void pull_background_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                  std::vector< std::vector<number> >& history) = 0;
+
         //! Pull a time sample of a twopf component at fixed k-configuration from a datapipe
         virtual void pull_twopf_time_sample(datapipe<number>* pipe, unsigned int id, const derived_data::SQL_query& query,
                                             unsigned int k_serial, std::vector<number>& sample, twopf_type type) = 0;
@@ -433,6 +451,19 @@ namespace transport
         virtual void pull_tensor_twopf_time_sample(datapipe<number>* pipe, unsigned int id, const derived_data::SQL_query& query,
                                                    unsigned int k_serial, std::vector<number>& sample) = 0;
 
+        //! Pull the time history of every twopf component at fixed k-configuration from a datapipe, in bulk;
+        //! history is indexed by component and then by time sample
+        virtual void pull_twopf_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                             unsigned int k_serial, std::vector< std::vector<number> >& history, twopf_type type) = 0;
+
+        //! Pull the time history of every threepf component at fixed k-configuration from a datapipe, in bulk
+        virtual void pull_threepf_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                               unsigned int k_serial, std::vector< std::vector<number> >& history, threepf_type type) = 0;
+
+        //! Pull the time history of every tensor twopf component at fixed k-configuration from a datapipe, in bulk
+        virtual void pull_tensor_twopf_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                    unsigned int k_serial, std::vector< std::vector<number> >& history) = 0;
+
         //! Pull a sample of the zeta twopf at fixed k-configuration from a datapipe
         virtual void pull_zeta_twopf_time_sample(datapipe<number>*, const derived_data::SQL_query& query,
                                                  unsigned int k_serial, std::vector<number>& sample) = 0;
@@ -469,6 +500,19 @@ namespace transport
         virtual void pull_tensor_twopf_kconfig_sample(datapipe<number>* pipe, unsigned int id, const derived_data::SQL_query& query,
                                                       unsigned int t_serial, std::vector<number>& sample) = 0;
 
+        //! Pull every twopf component at fixed time from a datapipe, in bulk;
+        //! history is indexed by component and then by k-configuration
+        virtual void pull_twopf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                unsigned int t_serial, std::vector< std::vector<number> >& history, twopf_type type) = 0;
+
+        //! Pull every threepf component at fixed time from a datapipe, in bulk
+        virtual void pull_threepf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                  unsigned int t_serial, std::vector< std::vector<number> >& history, threepf_type type) = 0;
+
+        //! Pull every tensor twopf component at fixed time from a datapipe, in bulk
+        virtual void pull_tensor_twopf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                       unsigned int t_serial, std::vector< std::vector<number> >& history) = 0;
+
         //! Pull a kconfig sample of the zeta twopf at fixed time from a datapipe
         virtual void pull_zeta_twopf_kconfig_sample(datapipe<number>*, const derived_data::SQL_query& query,
                                                     unsigned int t_serial, std::vector<number>& sample) = 0;
@@ -481,6 +525,19 @@ namespace transport
         virtual void pull_zeta_redbsp_kconfig_sample(datapipe<number>*, const derived_data::SQL_query& query,
                                                      unsigned int t_serial, std::vector<number>& sample) = 0;
 
+        //! Pull kconfig samples of the zeta twopf at several times from a datapipe, in a single pass;
+        //! lines are indexed in the same order as t_serials
+        virtual void pull_zeta_twopf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                     const std::vector<unsigned int>& t_serials, std::vector< std::vector<number> >& lines) = 0;
+
+        //! Pull kconfig samples of the zeta threepf at several times from a datapipe, in a single pass
+        virtual void pull_zeta_threepf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                       const std::vector<unsigned int>& t_serials, std::vector< std::vector<number> >& lines) = 0;
+
+        //! Pull kconfig samples of the zeta reduced bispectrum at several times from a datapipe, in a single pass
+        virtual void pull_zeta_redbsp_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                      const std::vector<unsigned int>& t_serials, std::vector< std::vector<number> >& lines) = 0;
+
         //! Pull a sample of k-configuration statistics from a datapipe
         virtual void pull_k_statistics_sample(datapipe<number>* pipe, const derived_data::SQL_query& query,
                                               std::vector<kconfiguration_statistics>& data) = 0;
@@ -0,0 +1,232 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+#ifndef CPPTRANSPORT_STORAGE_PRECISION_H
+#define CPPTRANSPORT_STORAGE_PRECISION_H
+
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "transport-runtime/serialization/serializable.h"
+
+
+namespace transport
+  {
+
+    constexpr auto CPPTRANSPORT_NODE_STORAGE_PRECISION              = "storage-precision";
+    constexpr auto CPPTRANSPORT_NODE_STORAGE_PRECISION_BACKG        = "background";
+    constexpr auto CPPTRANSPORT_NODE_STORAGE_PRECISION_TWOPF        = "twopf";
+    constexpr auto CPPTRANSPORT_NODE_STORAGE_PRECISION_TENSOR_TWOPF = "tensor-twopf";
+    constexpr auto CPPTRANSPORT_NODE_STORAGE_PRECISION_THREEPF      = "threepf";
+    constexpr auto CPPTRANSPORT_NODE_STORAGE_PRECISION_ICS          = "ics";
+
+    constexpr auto CPPTRANSPORT_NODE_STORAGE_PRECISION_FULL         = "full";
+    constexpr auto CPPTRANSPORT_NODE_STORAGE_PRECISION_SINGLE       = "single";
+
+
+    //! precision with which values are stored in a data container
+    enum class storage_precision
+      {
+        full,       // 8-byte double
+        single      // IEEE float32, widened on read
+      };
+
+
+    //! classes of value table whose storage precision can be set independently
+    enum class storage_table
+      {
+        backg, twopf, tensor_twopf, threepf, ics
+      };
+
+
+    namespace storage_precision_impl
+      {
+
+        constexpr unsigned int number_tables = 5;
+
+        inline unsigned int index(storage_table t)
+          {
+            switch(t)
+              {
+                case storage_table::backg:        return 0;
+                case storage_table::twopf:        return 1;
+                case storage_table::tensor_twopf: return 2;
+                case storage_table::threepf:      return 3;
+                case storage_table::ics:          return 4;
+              }
+
+            return 0;
+          }
+
+
+        inline const char* node_name(storage_table t)
+          {
+            switch(t)
+              {
+                case storage_table::backg:        return CPPTRANSPORT_NODE_STORAGE_PRECISION_BACKG;
+                case storage_table::twopf:        return CPPTRANSPORT_NODE_STORAGE_PRECISION_TWOPF;
+                case storage_table::tensor_twopf: return CPPTRANSPORT_NODE_STORAGE_PRECISION_TENSOR_TWOPF;
+                case storage_table::threepf:      return CPPTRANSPORT_NODE_STORAGE_PRECISION_THREEPF;
+                case storage_table::ics:          return CPPTRANSPORT_NODE_STORAGE_PRECISION_ICS;
+              }
+
+            return CPPTRANSPORT_NODE_STORAGE_PRECISION_BACKG;
+          }
+
+
+        //! pack a value into single precision.
+        //! The result is the bit pattern of the corresponding float32, returned as a 32-bit integer.
+        //! Value columns have REAL affinity, and SQLite writes integral REAL values to disk as integers,
+        //! so a packed value occupies at most 4 bytes in the record rather than 8
+        inline std::int32_t pack_single(double v)
+          {
+            float f = static_cast<float>(v);
+
+            std::int32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            return bits;
+          }
+
+
+        //! widen a packed single-precision value
+        inline double unpack_single(std::int32_t bits)
+          {
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            return static_cast<double>(f);
+          }
+
+      }   // namespace storage_precision_impl
+
+
+    //! storage_policy records the storage precision chosen for each class of value table.
+    //! By default everything is stored at full precision
+    class storage_policy: public serializable
+      {
+
+        // CONSTRUCTOR, DESTRUCTOR
+
+      public:
+
+        //! constructor sets full precision for all tables
+        storage_policy()
+          {
+            precision.fill(storage_precision::full);
+          }
+
+        //! deserialization constructor; records written before storage precision was configurable
+        //! do not have a storage-precision node, and are read as full precision
+        storage_policy(Json::Value& reader);
+
+        //! destructor is default
+        ~storage_policy() = default;
+
+
+        // INTERFACE
+
+      public:
+
+        //! get precision for a class of table
+        storage_precision get(storage_table t) const { return(this->precision[storage_precision_impl::index(t)]); }
+
+        //! set precision for a class of table
+        storage_policy& set(storage_table t, storage_precision p) { this->precision[storage_precision_impl::index(t)] = p; return *this; }
+
+        //! is any table stored at reduced precision?
+        bool is_reduced() const;
+
+        //! compare policies
+        bool operator==(const storage_policy& obj) const { return(this->precision == obj.precision); }
+        bool operator!=(const storage_policy& obj) const { return(this->precision != obj.precision); }
+
+
+        // SERIALIZATION -- implements a 'serializable' interface
+
+      public:
+
+        //! serialize this object
+        void serialize(Json::Value& writer) const override;
+
+
+        // INTERNAL DATA
+
+      private:
+
+        //! precision for each class of table, indexed by storage_precision_impl::index()
+        std::array< storage_precision, storage_precision_impl::number_tables > precision;
+
+      };
+
+
+    storage_policy::storage_policy(Json::Value& reader)
+      {
+        precision.fill(storage_precision::full);
+
+        if(!reader.isMember(CPPTRANSPORT_NODE_STORAGE_PRECISION)) return;
+        Json::Value& node = reader[CPPTRANSPORT_NODE_STORAGE_PRECISION];
+
+        for(storage_table t : { storage_table::backg, storage_table::twopf, storage_table::tensor_twopf, storage_table::threepf, storage_table::ics })
+          {
+            const char* name = storage_precision_impl::node_name(t);
+            if(node.isMember(name) && node[name].asString() == CPPTRANSPORT_NODE_STORAGE_PRECISION_SINGLE)
+              {
+                precision[storage_precision_impl::index(t)] = storage_precision::single;
+              }
+          }
+      }
+
+
+    bool storage_policy::is_reduced() const
+      {
+        for(storage_precision p : this->precision)
+          {
+            if(p != storage_precision::full) return true;
+          }
+
+        return false;
+      }
+
+
+    void storage_policy::serialize(Json::Value& writer) const
+      {
+        Json::Value node(Json::objectValue);
+
+        for(storage_table t : { storage_table::backg, storage_table::twopf, storage_table::tensor_twopf, storage_table::threepf, storage_table::ics })
+          {
+            node[storage_precision_impl::node_name(t)] = this->get(t) == storage_precision::single
+                                                         ? CPPTRANSPORT_NODE_STORAGE_PRECISION_SINGLE : CPPTRANSPORT_NODE_STORAGE_PRECISION_FULL;
+          }
+
+        writer[CPPTRANSPORT_NODE_STORAGE_PRECISION] = node;
+      }
+
+
+  }   // namespace transport
+
+
+#endif //CPPTRANSPORT_STORAGE_PRECISION_H
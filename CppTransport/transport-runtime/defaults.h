@@ -101,6 +101,25 @@ namespace transport
     constexpr unsigned int CPPTRANSPORT_DEFAULT_BATCHER_STORAGE            = (500*1024*1024);
     constexpr unsigned int CPPTRANSPORT_DEFAULT_PIPE_STORAGE               = (500*1024*1024);
 
+    // default number of read-only connexions held open by each datapipe, used to overlap
+    // independent database reads; zero means all reads go through the principal connexion
+    constexpr unsigned int CPPTRANSPORT_DEFAULT_PIPE_READERS               = (4);
+
+    // maximum number of further connexions a datapipe opens to the shards of a sharded content group,
+    // so that its readers can pull from a shard concurrently; bounds the number of open files
+    constexpr unsigned int CPPTRANSPORT_DEFAULT_SHARD_READER_CONNEXIONS    = (64);
+
+    // default size of the shared-memory cache shared by all datapipes on a node;
+    // zero means each datapipe relies only on its private cache
+    constexpr unsigned int CPPTRANSPORT_DEFAULT_NODE_CACHE_STORAGE         = (0);
+
+    // default number of threads used by an output worker to derive the lines of a product;
+    // one means lines are derived serially through the worker's datapipe
+    constexpr unsigned int CPPTRANSPORT_DEFAULT_OUTPUT_THREADS             = (1);
+
+    // default number of threads used by a postintegration worker to reduce fNL template overlaps
+    constexpr unsigned int CPPTRANSPORT_DEFAULT_REDUCTION_THREADS          = (1);
+
     // default size of the k-configuration caches - 1 Mb
     constexpr unsigned int CPPTRANSPORT_DEFAULT_CONFIGURATION_CACHE_SIZE   = (1*1024*1024);
 
@@ -247,6 +247,20 @@ namespace transport
 				    virtual void derive_lines(datapipe<number>& pipe, std::list<data_line<number> >& lines,
 				                              const std::list<std::string>& tags, slave_message_buffer& messages) const = 0;
 
+				    //! list the tasks whose content groups derive_lines() attaches, in order of attachment;
+				    //! by default this is just the parent task
+				    virtual void get_source_tasks(std::list< derivable_task<number>* >& tasks) const { tasks.push_back(this->parent_task); }
+
+				    //! does derive_lines() evaluate the model, rather than only reading stored data?
+				    //! Generated model code is not re-entrant, so such lines are derived while holding the datapipe's
+				    //! model mutex. Lines which only read data can override this to be derived concurrently
+				    virtual bool evaluates_model() const { return(true); }
+
+				    //! does derive_lines() generate its lines independently for each k-configuration, skipping those
+				    //! for which datapipe::use_kconfig() returns false? If so, lines derived from a seeded content group
+				    //! can be extended from those stored for its seed, rather than derived again from scratch
+				    virtual bool is_incremental() const { return(false); }
+
 
 				    // CLONE
 
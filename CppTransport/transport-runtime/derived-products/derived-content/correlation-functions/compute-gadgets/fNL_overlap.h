@@ -0,0 +1,441 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+
+#ifndef CPPTRANSPORT_FNL_OVERLAP_H
+#define CPPTRANSPORT_FNL_OVERLAP_H
+
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "transport-runtime/derived-products/derived-content/correlation-functions/template_types.h"
+
+
+namespace transport
+  {
+
+    namespace derived_data
+      {
+
+        // number of bispectrum templates
+        constexpr unsigned int CPPTRANSPORT_FNL_NUMBER_TEMPLATES = 4;
+
+        // number of triangles summed serially before partial sums are combined pairwise;
+        // fixed, so that results do not depend on the number of threads
+        constexpr unsigned int CPPTRANSPORT_FNL_OVERLAP_CHUNK = 16;
+
+
+        //! fNL_overlap holds time series for the inner products <B,B>, and <B,T> and <T,T> for every
+        //! bispectrum template T, accumulated over a set of triangles
+        template <typename number>
+        class fNL_overlap
+          {
+
+            // CONSTRUCTOR, DESTRUCTOR
+
+          public:
+
+            //! constructor builds zero-filled time series
+            fNL_overlap(unsigned int samples=0);
+
+            //! destructor is default
+            ~fNL_overlap() = default;
+
+
+            // INTERFACE
+
+          public:
+
+            //! get number of time samples
+            unsigned int size() const { return(static_cast<unsigned int>(this->BB_line.size())); }
+
+            //! add another set of inner products
+            fNL_overlap<number>& operator+=(const fNL_overlap<number>& obj);
+
+            //! get <B,B>
+            std::vector<number>& BB() { return(this->BB_line); }
+            const std::vector<number>& BB() const { return(this->BB_line); }
+
+            //! get <B,T> for a template
+            std::vector<number>& BT(bispectrum_template type) { return(this->BT_line[static_cast<unsigned int>(type)]); }
+            const std::vector<number>& BT(bispectrum_template type) const { return(this->BT_line[static_cast<unsigned int>(type)]); }
+
+            //! get <T,T> for a template
+            std::vector<number>& TT(bispectrum_template type) { return(this->TT_line[static_cast<unsigned int>(type)]); }
+            const std::vector<number>& TT(bispectrum_template type) const { return(this->TT_line[static_cast<unsigned int>(type)]); }
+
+
+            // INTERNAL DATA
+
+          private:
+
+            //! <B,B>
+            std::vector<number> BB_line;
+
+            //! <B,T>, indexed by template
+            std::array< std::vector<number>, CPPTRANSPORT_FNL_NUMBER_TEMPLATES > BT_line;
+
+            //! <T,T>, indexed by template
+            std::array< std::vector<number>, CPPTRANSPORT_FNL_NUMBER_TEMPLATES > TT_line;
+
+          };
+
+
+        template <typename number>
+        fNL_overlap<number>::fNL_overlap(unsigned int samples)
+          : BB_line(samples, 0.0)
+          {
+            for(unsigned int i = 0; i < CPPTRANSPORT_FNL_NUMBER_TEMPLATES; ++i)
+              {
+                BT_line[i].assign(samples, 0.0);
+                TT_line[i].assign(samples, 0.0);
+              }
+          }
+
+
+        template <typename number>
+        fNL_overlap<number>& fNL_overlap<number>::operator+=(const fNL_overlap<number>& obj)
+          {
+            assert(obj.size() == this->size());
+            const unsigned int T = this->size();
+
+            for(unsigned int j = 0; j < T; ++j)
+              {
+                this->BB_line[j] += obj.BB_line[j];
+              }
+
+            for(unsigned int i = 0; i < CPPTRANSPORT_FNL_NUMBER_TEMPLATES; ++i)
+              {
+                number* bt = this->BT_line[i].data();
+                number* tt = this->TT_line[i].data();
+                const number* obj_bt = obj.BT_line[i].data();
+                const number* obj_tt = obj.TT_line[i].data();
+
+                for(unsigned int j = 0; j < T; ++j)
+                  {
+                    bt[j] += obj_bt[j];
+                    tt[j] += obj_tt[j];
+                  }
+              }
+
+            return(*this);
+          }
+
+
+        //! fNL_overlap_kernel reduces the bispectrum-template inner products over a set of triangles.
+        //! Every template is evaluated at once, sharing the power spectrum factors between them, and the inner
+        //! loops run over contiguous time samples so they can be vectorized.
+        //! Triangles are supplied in blocks; each block is split into fixed-size chunks which are summed on a
+        //! pool of threads, and chunk totals are combined by pairwise summation in triangle order, so the
+        //! result is independent of the number of threads
+        template <typename number>
+        class fNL_overlap_kernel
+          {
+
+            // ASSOCIATED TYPES
+
+          public:
+
+            //! a triangle contributing to the overlap; the pointers refer to time series of length equal
+            //! to the number of samples, which must remain valid for the duration of accumulate()
+            struct triangle
+              {
+                //! integration measure
+                number measure;
+
+                //! comoving wavenumbers
+                double k1;
+                double k2;
+                double k3;
+
+                //! zeta bispectrum, stored as the dimensionless (k1 k2 k3)^2 B
+                const number* bispectrum;
+
+                //! zeta twopf on each side, stored as the dimensionless k^3 P
+                const number* twopf_k1;
+                const number* twopf_k2;
+                const number* twopf_k3;
+              };
+
+
+            // CONSTRUCTOR, DESTRUCTOR
+
+          public:
+
+            //! constructor
+            fNL_overlap_kernel(unsigned int samples, unsigned int threads=1);
+
+            //! destructor is default
+            ~fNL_overlap_kernel() = default;
+
+
+            // INTERFACE
+
+          public:
+
+            //! add the contributions from a block of triangles
+            void accumulate(const std::vector<triangle>& block);
+
+            //! get accumulated inner products
+            fNL_overlap<number> result() const;
+
+
+            // INTERNAL API
+
+          protected:
+
+            //! add the contribution from a single triangle; the scratch vectors are resized as needed
+            void accumulate_triangle(const triangle& tri, fNL_overlap<number>& acc, std::vector<number>& scratch) const;
+
+            //! push a partial sum onto the pairwise summation stack
+            void push(fNL_overlap<number>&& partial);
+
+
+            // INTERNAL DATA
+
+          private:
+
+            //! number of time samples
+            const unsigned int samples;
+
+            //! number of threads
+            const unsigned int threads;
+
+            //! pairwise summation stack; each entry holds the sum of 2^level chunks
+            std::vector< std::pair< unsigned int, fNL_overlap<number> > > stack;
+
+          };
+
+
+        template <typename number>
+        fNL_overlap_kernel<number>::fNL_overlap_kernel(unsigned int s, unsigned int t)
+          : samples(s),
+            threads(std::max(t, 1U))
+          {
+          }
+
+
+        template <typename number>
+        void fNL_overlap_kernel<number>::accumulate(const std::vector<triangle>& block)
+          {
+            const size_t chunks = (block.size() + CPPTRANSPORT_FNL_OVERLAP_CHUNK - 1) / CPPTRANSPORT_FNL_OVERLAP_CHUNK;
+            if(chunks == 0) return;
+
+            std::vector< fNL_overlap<number> > partials(chunks, fNL_overlap<number>(this->samples));
+
+            auto sum_chunk = [&](size_t c, std::vector<number>& scratch) -> void
+              {
+                size_t first = c * CPPTRANSPORT_FNL_OVERLAP_CHUNK;
+                size_t last  = std::min(first + CPPTRANSPORT_FNL_OVERLAP_CHUNK, block.size());
+                for(size_t i = first; i < last; ++i)
+                  {
+                    this->accumulate_triangle(block[i], partials[c], scratch);
+                  }
+              };
+
+            unsigned int pool_size = static_cast<unsigned int>(std::min(static_cast<size_t>(this->threads), chunks));
+
+            if(pool_size <= 1)
+              {
+                std::vector<number> scratch;
+                for(size_t c = 0; c < chunks; ++c)
+                  {
+                    sum_chunk(c, scratch);
+                  }
+              }
+            else
+              {
+                std::atomic<size_t> next(0);
+                std::vector<std::exception_ptr> errors(pool_size);
+                std::vector<std::thread> pool;
+                pool.reserve(pool_size);
+
+                for(unsigned int p = 0; p < pool_size; ++p)
+                  {
+                    pool.emplace_back([&, p]() -> void
+                      {
+                        try
+                          {
+                            std::vector<number> scratch;
+                            size_t c;
+                            while((c = next++) < chunks)
+                              {
+                                sum_chunk(c, scratch);
+                              }
+                          }
+                        catch(...)
+                          {
+                            errors[p] = std::current_exception();
+                            next = chunks;
+                          }
+                      });
+                  }
+
+                for(std::thread& th : pool)
+                  {
+                    th.join();
+                  }
+
+                for(std::exception_ptr& e : errors)
+                  {
+                    if(e) std::rethrow_exception(e);
+                  }
+              }
+
+            for(fNL_overlap<number>& partial : partials)
+              {
+                this->push(std::move(partial));
+              }
+          }
+
+
+        template <typename number>
+        void fNL_overlap_kernel<number>::push(fNL_overlap<number>&& partial)
+          {
+            this->stack.emplace_back(0, std::move(partial));
+
+            // merge equal-sized sums, as in a binary counter
+            while(this->stack.size() >= 2 && this->stack[this->stack.size()-1].first == this->stack[this->stack.size()-2].first)
+              {
+                std::pair< unsigned int, fNL_overlap<number> > top = std::move(this->stack.back());
+                this->stack.pop_back();
+
+                this->stack.back().second += top.second;
+                ++this->stack.back().first;
+              }
+          }
+
+
+        template <typename number>
+        fNL_overlap<number> fNL_overlap_kernel<number>::result() const
+          {
+            // fold remaining sums from the smallest upwards
+            fNL_overlap<number> total(this->samples);
+            for(typename std::vector< std::pair< unsigned int, fNL_overlap<number> > >::const_reverse_iterator t = this->stack.rbegin(); t != this->stack.rend(); ++t)
+              {
+                total += t->second;
+              }
+
+            return(total);
+          }
+
+
+        template <typename number>
+        void fNL_overlap_kernel<number>::accumulate_triangle(const triangle& tri, fNL_overlap<number>& acc, std::vector<number>& scratch) const
+          {
+            const unsigned int T = this->samples;
+
+            // cube roots of the stored twopfs; these are the only transcendental functions needed,
+            // so evaluate them in a separate pass and leave the main loop as pure arithmetic
+            scratch.resize(3*T);
+            number* b1 = scratch.data();
+            number* b2 = b1 + T;
+            number* b3 = b2 + T;
+
+            for(unsigned int j = 0; j < T; ++j)
+              {
+                b1[j] = std::cbrt(tri.twopf_k1[j]);
+                b2[j] = std::cbrt(tri.twopf_k2[j]);
+                b3[j] = std::cbrt(tri.twopf_k3[j]);
+              }
+
+            // the templates are built from P(k) = (k^3 P)/k^3, so P^(1/3) = (k^3 P)^(1/3) / k
+            const number inv_k1 = 1.0/tri.k1;
+            const number inv_k2 = 1.0/tri.k2;
+            const number inv_k3 = 1.0/tri.k3;
+            const number inv_k1_cube = inv_k1*inv_k1*inv_k1;
+            const number inv_k2_cube = inv_k2*inv_k2*inv_k2;
+            const number inv_k3_cube = inv_k3*inv_k3*inv_k3;
+            const number mu = tri.measure;
+
+            const number* B   = tri.bispectrum;
+            const number* tw1 = tri.twopf_k1;
+            const number* tw2 = tri.twopf_k2;
+            const number* tw3 = tri.twopf_k3;
+
+            number* BB       = acc.BB().data();
+            number* BT_local = acc.BT(bispectrum_template::local).data();
+            number* BT_equi  = acc.BT(bispectrum_template::equilateral).data();
+            number* BT_ortho = acc.BT(bispectrum_template::orthogonal).data();
+            number* BT_DBI   = acc.BT(bispectrum_template::DBI).data();
+            number* TT_local = acc.TT(bispectrum_template::local).data();
+            number* TT_equi  = acc.TT(bispectrum_template::equilateral).data();
+            number* TT_ortho = acc.TT(bispectrum_template::orthogonal).data();
+            number* TT_DBI   = acc.TT(bispectrum_template::DBI).data();
+
+            for(unsigned int j = 0; j < T; ++j)
+              {
+                const number P1 = tw1[j] * inv_k1_cube;
+                const number P2 = tw2[j] * inv_k2_cube;
+                const number P3 = tw3[j] * inv_k3_cube;
+
+                const number a1 = b1[j] * inv_k1;
+                const number a2 = b2[j] * inv_k2;
+                const number a3 = b3[j] * inv_k3;
+
+                // symmetric combinations shared by the templates
+                const number s2 = P1*P2 + P1*P3 + P2*P3;
+                const number a123 = a1*a2*a3;
+                const number c2 = a123*a123;
+                const number m = a1*a2*a2*P3 + a1*a3*a3*P2 + a2*a1*a1*P3 + a2*a3*a3*P1 + a3*a1*a1*P2 + a3*a2*a2*P1;
+
+                // the reference shape for the bispectrum uses the stored twopfs directly
+                const number b123 = b1[j]*b2[j]*b3[j];
+                const number S_B = B[j] / (b123*b123);
+
+                const number inv_ref = 1.0/c2;
+                const number S_local = 2.0*s2 * inv_ref;
+                const number S_equi  = 6.0*(-s2 - 2.0*c2 + m) * inv_ref;
+                const number S_ortho = 6.0*(-3.0*s2 - 8.0*c2 + 3.0*m) * inv_ref;
+                const number S_DBI   = inv_ref;    // DBI template is not yet implemented, and is set to unity
+
+                const number mu_SB = mu * S_B;
+
+                BB[j]       += mu_SB * S_B;
+                BT_local[j] += mu_SB * S_local;
+                BT_equi[j]  += mu_SB * S_equi;
+                BT_ortho[j] += mu_SB * S_ortho;
+                BT_DBI[j]   += mu_SB * S_DBI;
+                TT_local[j] += mu * S_local * S_local;
+                TT_equi[j]  += mu * S_equi * S_equi;
+                TT_ortho[j] += mu * S_ortho * S_ortho;
+                TT_DBI[j]   += mu * S_DBI * S_DBI;
+              }
+          }
+
+      }   // namespace derived_data
+
+  }   // namespace transport
+
+
+#endif //CPPTRANSPORT_FNL_OVERLAP_H
@@ -32,6 +32,7 @@
 #include <memory>
 
 #include "transport-runtime/derived-products/derived-content/correlation-functions/template_types.h"
+#include "transport-runtime/derived-products/derived-content/correlation-functions/compute-gadgets/fNL_overlap.h"
 
 // need data_manager for datapipe
 #include "transport-runtime/data/data_manager.h"
@@ -43,6 +44,10 @@ namespace transport
 		namespace derived_data
 			{
 
+        // number of triangles whose lines are loaded from the datapipe before being handed to the overlap kernel
+        constexpr unsigned int CPPTRANSPORT_FNL_OVERLAP_BLOCK = 256;
+
+
 				//! fNL_timeseries_compute is a utility class which computes derived lines for fNL amplitudes
 				template <typename number>
 		    class fNL_timeseries_compute
@@ -57,10 +62,12 @@ namespace transport
 
 				      public:
 
-				        handle(datapipe<number>& pipe, postintegration_task<number>* tk, const SQL_time_query& tq, bispectrum_template ty);
+				        handle(datapipe<number>& pipe, postintegration_task<number>* tk, const SQL_time_query& tq, bispectrum_template ty,
+                       unsigned int th=1);
 
                 handle(datapipe<number>& pipe, postintegration_task<number>* tk, const SQL_time_query& tq,
-                       bispectrum_template ty, const typename work_queue<threepf_kconfig_record>::device_work_list& wl);
+                       bispectrum_template ty, const typename work_queue<threepf_kconfig_record>::device_work_list& wl,
+                       unsigned int th=1);
 
 						    ~handle() = default;
 
@@ -93,6 +100,9 @@ namespace transport
                 //! subset of triangles to integrate, if used
                 typename work_queue<threepf_kconfig_record>::device_work_list work_list;
 
+                //! number of threads used to reduce the template overlaps
+                unsigned int threads;
+
 						    friend class fNL_timeseries_compute;
 
 					    };
@@ -114,58 +124,29 @@ namespace transport
 		      public:
 
 				    //! make a handle, integrate over all triangles
-				    std::unique_ptr<handle> make_handle(datapipe<number>& pipe, postintegration_task<number>* tk, const SQL_time_query& tq, bispectrum_template ty) const;
+				    std::unique_ptr<handle> make_handle(datapipe<number>& pipe, postintegration_task<number>* tk, const SQL_time_query& tq, bispectrum_template ty,
+                                                unsigned int threads=1) const;
 
             //! make a handle, integrate over a supplied subset of triangles
             std::unique_ptr<handle> make_handle(datapipe<number>& pipe, postintegration_task<number>* tk, const SQL_time_query& tq,
-                                                bispectrum_template ty, const typename work_queue<threepf_kconfig_record>::device_work_list& wl) const;
+                                                bispectrum_template ty, const typename work_queue<threepf_kconfig_record>::device_work_list& wl,
+                                                unsigned int threads=1) const;
 
 
 				    // COMPUTE FNL PRODUCT
 
 		      public:
 
+            //! compute timeseries for the inner products bispectrum.bispectrum, bispectrum.template and template.template
+            //! for every template at once
+            void overlaps(handle& h, fNL_overlap<number>& overlap) const;
+
             //! compute a timeseries for the inner products bispectrum.bispectrum, bispectrum.template, template.template
             void components(handle& h, std::vector<number>& BB, std::vector<number>& BT, std::vector<number>& TT) const;
 
 				    //! compute a timeseries for fNL
 				    void fNL(handle& h, std::vector<number>& line_data) const;
 
-
-		        // COMPUTE SELECTED SHAPE FUNCTIONS
-
-		      protected:
-
-		        //! compute shape function for a given bispectrum
-		        void shape_function(const std::vector<number>& bispectrum,
-                                const std::vector<number>& twopf_k1, const std::vector<number>& twopf_k2,
-                                const std::vector<number>& twopf_k3, std::vector<number>& shape) const;
-
-		        //! compute shape function for a selected template
-		        void shape_function(bispectrum_template type, const threepf_kconfig& config,
-		                            const std::vector<number>& twopf_k1, const std::vector<number>& twopf_k2,
-		                            const std::vector<number>& twopf_k3, std::vector<number>& shape) const;
-
-
-		        // BISPECTRUM SHAPES AND TEMPLATES
-
-		      protected:
-
-		        //! compute reference shape
-		        number reference_bispectrum(number Pk1, number Pk2, number Pk3) const;
-
-		        //! compute local template
-		        number local_template(number Pk1, number Pk2, number Pk3) const;
-
-		        //! compute equilateral template
-		        number equi_template(number Pk1, number Pk2, number Pk3) const;
-
-		        //! compute orthogonal template
-		        number ortho_template(number Pk1, number Pk2, number Pk3) const;
-
-		        //! DBI template
-		        number DBI_template(number Pk1, number Pk2, number Pk3) const;
-
 			    };
 
 
@@ -173,12 +154,14 @@ namespace transport
 
 
 		    template <typename number>
-		    fNL_timeseries_compute<number>::handle::handle(datapipe<number>& p, postintegration_task<number>* t, const SQL_time_query& tq, bispectrum_template ty)
+		    fNL_timeseries_compute<number>::handle::handle(datapipe<number>& p, postintegration_task<number>* t, const SQL_time_query& tq, bispectrum_template ty,
+                                                       unsigned int th)
 			    : pipe(p),
 			      tk(dynamic_cast<zeta_threepf_task<number>*>(t)),
 			      tquery(tq),
 			      type(ty),
-            restrict_triangles(false)
+            restrict_triangles(false),
+            threads(th)
 			    {
             this->validate();
 
@@ -200,13 +183,15 @@ namespace transport
 
         template <typename number>
         fNL_timeseries_compute<number>::handle::handle(datapipe<number>& p, postintegration_task<number>* t, const SQL_time_query& tq,
-                                                       bispectrum_template ty, const typename work_queue<threepf_kconfig_record>::device_work_list& wl)
+                                                       bispectrum_template ty, const typename work_queue<threepf_kconfig_record>::device_work_list& wl,
+                                                       unsigned int th)
           : pipe(p),
             tk(dynamic_cast<zeta_threepf_task<number>*>(t)),
             tquery(tq),
             type(ty),
             restrict_triangles(true),
-            work_list(wl)
+            work_list(wl),
+            threads(th)
           {
             this->validate();
 
@@ -244,83 +229,102 @@ namespace transport
 
 		    template <typename number>
 		    std::unique_ptr<typename fNL_timeseries_compute<number>::handle>
-		    fNL_timeseries_compute<number>::make_handle(datapipe<number>& pipe, postintegration_task<number>* tk, const SQL_time_query& tq, bispectrum_template ty) const
+		    fNL_timeseries_compute<number>::make_handle(datapipe<number>& pipe, postintegration_task<number>* tk, const SQL_time_query& tq, bispectrum_template ty,
+                                                    unsigned int threads) const
 			    {
-		        return std::make_unique<handle>(pipe, tk, tq, ty);
+		        return std::make_unique<handle>(pipe, tk, tq, ty, threads);
 			    }
 
 
         template <typename number>
         std::unique_ptr<typename fNL_timeseries_compute<number>::handle>
         fNL_timeseries_compute<number>::make_handle(datapipe<number>& pipe, postintegration_task<number>* tk, const SQL_time_query& tq,
-                                                    bispectrum_template ty, const typename work_queue<threepf_kconfig_record>::device_work_list& wl) const
+                                                    bispectrum_template ty, const typename work_queue<threepf_kconfig_record>::device_work_list& wl,
+                                                    unsigned int threads) const
           {
-            return std::make_unique<handle>(pipe, tk, tq, ty, wl);
+            return std::make_unique<handle>(pipe, tk, tq, ty, wl, threads);
           }
 
 
         template <typename number>
-        void fNL_timeseries_compute<number>::components(typename fNL_timeseries_compute<number>::handle& h,
-                                                        std::vector<number>& BB, std::vector<number>& BT, std::vector<number>& TT) const
+        void fNL_timeseries_compute<number>::overlaps(typename fNL_timeseries_compute<number>::handle& h, fNL_overlap<number>& overlap) const
           {
             // set up cache handles
             typename datapipe<number>::time_zeta_handle& z_handle = h.pipe.new_time_zeta_handle(h.tquery);
 
-            BB.clear();
-            BB.assign(h.t_axis.size(), 0.0);
-            BT.clear();
-            BT.assign(h.t_axis.size(), 0.0);
-            TT.clear();
-            TT.assign(h.t_axis.size(), 0.0);
-
-            // loop over all sampled k-configurations, adding their contributions to the integral
-            for(unsigned int i = 0; i < h.work_list.size(); ++i)
-              {
-                zeta_threepf_time_data_tag<number> bsp_tag = h.pipe.new_zeta_threepf_time_data_tag(*(h.work_list[i]));
+            fNL_overlap_kernel<number> kernel(static_cast<unsigned int>(h.t_axis.size()), h.threads);
 
-                // pull bispectrum information for this triangle
-                const std::vector<number> bispectrum = z_handle.lookup_tag(bsp_tag);
+            // lines are pulled from the datapipe serially, a block at a time, and the block is then reduced by the kernel
+            std::vector< std::vector<number> > lines;
+            std::vector< typename fNL_overlap_kernel<number>::triangle > block;
 
-                twopf_kconfig k1;
-                twopf_kconfig k2;
-                twopf_kconfig k3;
+            for(unsigned int first = 0; first < h.work_list.size(); first += CPPTRANSPORT_FNL_OVERLAP_BLOCK)
+              {
+                unsigned int last = std::min(first + CPPTRANSPORT_FNL_OVERLAP_BLOCK, static_cast<unsigned int>(h.work_list.size()));
 
-                k1.serial         = h.work_list[i]->k1_serial;
-                k1.k_comoving     = h.work_list[i]->k1_comoving;
-                k1.k_conventional = h.work_list[i]->k1_conventional;
+                lines.resize(4*(last-first));
+                block.clear();
 
-                k2.serial         = h.work_list[i]->k2_serial;
-                k2.k_comoving     = h.work_list[i]->k2_comoving;
-                k2.k_conventional = h.work_list[i]->k2_conventional;
+                for(unsigned int i = first; i < last; ++i)
+                  {
+                    const threepf_kconfig& config = *(h.work_list[i]);
+
+                    twopf_kconfig k1;
+                    twopf_kconfig k2;
+                    twopf_kconfig k3;
+
+                    k1.serial         = config.k1_serial;
+                    k1.k_comoving     = config.k1_comoving;
+                    k1.k_conventional = config.k1_conventional;
+
+                    k2.serial         = config.k2_serial;
+                    k2.k_comoving     = config.k2_comoving;
+                    k2.k_conventional = config.k2_conventional;
+
+                    k3.serial         = config.k3_serial;
+                    k3.k_comoving     = config.k3_comoving;
+                    k3.k_conventional = config.k3_conventional;
+
+                    zeta_threepf_time_data_tag<number> bsp_tag = h.pipe.new_zeta_threepf_time_data_tag(config);
+                    zeta_twopf_time_data_tag<number>   k1_tag  = h.pipe.new_zeta_twopf_time_data_tag(k1);
+                    zeta_twopf_time_data_tag<number>   k2_tag  = h.pipe.new_zeta_twopf_time_data_tag(k2);
+                    zeta_twopf_time_data_tag<number>   k3_tag  = h.pipe.new_zeta_twopf_time_data_tag(k3);
+
+                    // as of 14 Jan 2016 we store dimensionless twopf objects k^3 * 2pf and (k1 k2 k3)^2 * 3pf
+                    // in the database; the kernel takes care of conversion
+                    std::vector<number>* data = &lines[4*(i-first)];
+                    data[0] = z_handle.lookup_tag(bsp_tag);
+                    data[1] = z_handle.lookup_tag(k1_tag);
+                    data[2] = z_handle.lookup_tag(k2_tag);
+                    data[3] = z_handle.lookup_tag(k3_tag);
+
+                    for(unsigned int l = 0; l < 4; ++l)
+                      {
+                        assert(data[l].size() == h.t_axis.size());
+                      }
+
+                    block.push_back(typename fNL_overlap_kernel<number>::triangle{ h.tk->measure(config),
+                                                                                   config.k1_comoving, config.k2_comoving, config.k3_comoving,
+                                                                                   data[0].data(), data[1].data(), data[2].data(), data[3].data() });
+                  }
 
-                k3.serial         = h.work_list[i]->k3_serial;
-                k3.k_comoving     = h.work_list[i]->k3_comoving;
-                k3.k_conventional = h.work_list[i]->k3_conventional;
+                kernel.accumulate(block);
+              }
 
-                zeta_twopf_time_data_tag<number> k1_tag = h.pipe.new_zeta_twopf_time_data_tag(k1);
-                zeta_twopf_time_data_tag<number> k2_tag = h.pipe.new_zeta_twopf_time_data_tag(k2);
-                zeta_twopf_time_data_tag<number> k3_tag = h.pipe.new_zeta_twopf_time_data_tag(k3);
+            overlap = kernel.result();
+          }
 
-                // as of 14 Jan 2016 we store dimensionless twopf objects k^3 * 2pf in the database
-                // so these will require conversion
-                const std::vector<number> twopf_k1 = z_handle.lookup_tag(k1_tag);
-                const std::vector<number> twopf_k2 = z_handle.lookup_tag(k2_tag);
-                const std::vector<number> twopf_k3 = z_handle.lookup_tag(k3_tag);
 
-                // compute shape functions for template
-                std::vector<number> S_bispectrum;
-                std::vector<number> S_template;
-                this->shape_function(bispectrum, twopf_k1, twopf_k2, twopf_k3, S_bispectrum);
-                this->shape_function(h.type, *(h.work_list[i]), twopf_k1, twopf_k2, twopf_k3, S_template);
+        template <typename number>
+        void fNL_timeseries_compute<number>::components(typename fNL_timeseries_compute<number>::handle& h,
+                                                        std::vector<number>& BB, std::vector<number>& BT, std::vector<number>& TT) const
+          {
+            fNL_overlap<number> overlap;
+            this->overlaps(h, overlap);
 
-                number measure = h.tk->measure(*(h.work_list[i]));
-                for(unsigned int j = 0; j < h.t_axis.size(); ++j)
-                  {
-                    BB[j] += measure * S_bispectrum[j] * S_bispectrum[j];
-                    BT[j] += measure * S_bispectrum[j] * S_template[j];
-                    TT[j] += measure * S_template[j]   * S_template[j];
-                  }
-              }
+            BB = std::move(overlap.BB());
+            BT = std::move(overlap.BT(h.type));
+            TT = std::move(overlap.TT(h.type));
           }
 
 
@@ -342,124 +346,6 @@ namespace transport
 			    }
 
 
-		    // compute shape function for a supplied bispectrum
-		    template <typename number>
-		    void fNL_timeseries_compute<number>::shape_function(const std::vector<number>& bispectrum,
-                                                            const std::vector<number>& twopf_k1,
-                                                            const std::vector<number>& twopf_k2,
-                                                            const std::vector<number>& twopf_k3,
-		                                                        std::vector<number>& shape) const
-			    {
-		        shape.clear();
-		        shape.resize(bispectrum.size());
-
-		        for(unsigned int j = 0; j < bispectrum.size(); ++j)
-			        {
-                // as of 14 Jan 2016 we store dimensionless objects k^3 * 2pf and (k1 k2 k3)^3 * 3pf in the
-                // database, but that does not cause any changes here
-		            number Bref = this->reference_bispectrum(twopf_k1[j], twopf_k2[j], twopf_k3[j]);
-
-		            shape[j] = bispectrum[j] / Bref;
-			        }
-			    }
-
-
-		    // compute shape function for the intended template
-		    template <typename number>
-        void fNL_timeseries_compute<number>::shape_function(bispectrum_template type, const threepf_kconfig& config,
-                                                            const std::vector<number>& twopf_k1,
-                                                            const std::vector<number>& twopf_k2,
-                                                            const std::vector<number>& twopf_k3,
-                                                            std::vector<number>& shape) const
-			    {
-		        shape.clear();
-		        shape.resize(twopf_k1.size());
-
-            const double k1 = config.k1_comoving;
-            const double k2 = config.k2_comoving;
-            const double k3 = config.k3_comoving;
-
-            const double k1_cube = k1*k1*k1;
-            const double k2_cube = k2*k2*k2;
-            const double k3_cube = k3*k3*k3;
-
-		        for(unsigned int j = 0; j < twopf_k1.size(); ++j)
-			        {
-		            number T = 0.0;
-
-		            switch(type)
-			            {
-		                case bispectrum_template::local:
-			                T = this->local_template(twopf_k1[j]/k1_cube, twopf_k2[j]/k2_cube, twopf_k3[j]/k3_cube);
-			                break;
-
-		                case bispectrum_template::equilateral:
-			                T = this->equi_template(twopf_k1[j]/k1_cube, twopf_k2[j]/k2_cube, twopf_k3[j]/k3_cube);
-			                break;
-
-		                case bispectrum_template::orthogonal:
-			                T = this->ortho_template(twopf_k1[j]/k1_cube, twopf_k2[j]/k2_cube, twopf_k3[j]/k3_cube);
-			                break;
-
-		                case bispectrum_template::DBI:
-			                T = this->DBI_template(twopf_k1[j]/k1_cube, twopf_k2[j]/k2_cube, twopf_k3[j]/k3_cube);
-		                  break;
-			            }
-
-		            number Bref = this->reference_bispectrum(twopf_k1[j]/k1_cube, twopf_k2[j]/k2_cube, twopf_k3[j]/k3_cube);
-
-		            shape[j] = T/Bref;
-			        }
-
-			    }
-
-
-		    // compute reference bispectrum -- currently uses the constant bispectrum
-		    template <typename number>
-		    number fNL_timeseries_compute<number>::reference_bispectrum(number Pk1, number Pk2, number Pk3) const
-			    {
-		        return(pow(Pk1*Pk2*Pk3, 2.0/3.0));
-			    }
-
-
-		    // local template
-		    template <typename number>
-		    number fNL_timeseries_compute<number>::local_template(number Pk1, number Pk2, number Pk3) const
-			    {
-		        return(2.0 * (Pk1*Pk2 + Pk1*Pk3 + Pk2*Pk3));
-			    }
-
-
-		    // equilateral template
-		    template <typename number>
-		    number fNL_timeseries_compute<number>::equi_template(number Pk1, number Pk2, number Pk3) const
-			    {
-		        return(6.0 * (-Pk1*Pk2 - Pk1*Pk3 - Pk2*Pk3 - 2.0*std::pow(Pk1*Pk2*Pk3, 2.0/3.0)
-			        + std::pow(Pk1*Pk2*Pk2, 1.0/3.0)*Pk3 + std::pow(Pk1*Pk3*Pk3, 1.0/3.0)*Pk2
-			        + std::pow(Pk2*Pk1*Pk1, 1.0/3.0)*Pk3 + std::pow(Pk2*Pk3*Pk3, 1.0/3.0)*Pk1
-			        + std::pow(Pk3*Pk1*Pk1, 1.0/3.0)*Pk2 + std::pow(Pk3*Pk2*Pk2, 1.0/3.0)*Pk1) );
-			    }
-
-
-		    // orthogonal template
-		    template <typename number>
-		    number fNL_timeseries_compute<number>::ortho_template(number Pk1, number Pk2, number Pk3) const
-			    {
-		        return(6.0 * (-3.0*Pk1*Pk2 - 3.0*Pk1*Pk3 - 3.0*Pk2*Pk3 - 8.0*std::pow(Pk1*Pk2*Pk3, 2.0/3.0)
-			        + 3.0*std::pow(Pk1*Pk2*Pk2, 1.0/3.0)*Pk3 + 3.0*std::pow(Pk1*Pk3*Pk3, 1.0/3.0)*Pk2
-			        + 3.0*std::pow(Pk2*Pk1*Pk1, 1.0/3.0)*Pk3 + 3.0*std::pow(Pk2*Pk3*Pk3, 1.0/3.0)*Pk1
-			        + 3.0*std::pow(Pk3*Pk1*Pk1, 1.0/3.0)*Pk2 + 3.0*std::pow(Pk3*Pk2*Pk2, 1.0/3.0)*Pk1) );
-			    }
-
-
-		    // DBI template
-		    template <typename number>
-		    number fNL_timeseries_compute<number>::DBI_template(number Pk1, number Pk2, number Pk3) const
-			    {
-            // TODO: not yet implemented
-		        return(1.0);
-			    }
-
 			}
 
 	}
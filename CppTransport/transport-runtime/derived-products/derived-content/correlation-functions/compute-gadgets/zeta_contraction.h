@@ -0,0 +1,362 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+
+#ifndef CPPTRANSPORT_ZETA_CONTRACTION_H
+#define CPPTRANSPORT_ZETA_CONTRACTION_H
+
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "transport-runtime/models/model.h"
+
+
+namespace transport
+  {
+
+    namespace derived_data
+      {
+
+        //! component_matrix is a dense (component x time) matrix.
+        //! Storage is row-major, so the time series for each component is contiguous and loops over the
+        //! time axis can be vectorized by the compiler
+        template <typename number>
+        class component_matrix
+          {
+
+            // CONSTRUCTOR, DESTRUCTOR
+
+          public:
+
+            //! constructor builds a zero-filled matrix
+            component_matrix(unsigned int r=0, unsigned int c=0)
+              : rows(r),
+                cols(c),
+                data(static_cast<size_t>(r)*c, 0.0)
+              {
+              }
+
+            //! destructor is default
+            ~component_matrix() = default;
+
+
+            // INTERFACE
+
+          public:
+
+            //! resize and zero-fill
+            void resize(unsigned int r, unsigned int c) { this->rows = r; this->cols = c; this->data.assign(static_cast<size_t>(r)*c, 0.0); }
+
+            //! get number of components
+            unsigned int get_rows() const { return(this->rows); }
+
+            //! get number of time samples
+            unsigned int get_cols() const { return(this->cols); }
+
+            //! get time series for a component
+            number* row(unsigned int r) { return(this->data.data() + static_cast<size_t>(r)*this->cols); }
+
+            //! get time series for a component
+            const number* row(unsigned int r) const { return(this->data.data() + static_cast<size_t>(r)*this->cols); }
+
+            //! set time series for a component
+            void set_row(unsigned int r, const std::vector<number>& line);
+
+            //! fill from a list of time series, one per component
+            void assign_rows(const std::vector< std::vector<number> >& lines);
+
+            //! fill from a list of component values, one per time sample
+            void assign_columns(const std::vector< std::vector<number> >& samples);
+
+
+            // INTERNAL DATA
+
+          private:
+
+            //! number of components
+            unsigned int rows;
+
+            //! number of time samples
+            unsigned int cols;
+
+            //! matrix elements
+            std::vector<number> data;
+
+          };
+
+
+        template <typename number>
+        void component_matrix<number>::set_row(unsigned int r, const std::vector<number>& line)
+          {
+            assert(r < this->rows);
+            assert(line.size() == this->cols);
+
+            std::copy(line.begin(), line.end(), this->row(r));
+          }
+
+
+        template <typename number>
+        void component_matrix<number>::assign_rows(const std::vector< std::vector<number> >& lines)
+          {
+            this->resize(static_cast<unsigned int>(lines.size()), lines.empty() ? 0 : static_cast<unsigned int>(lines.front().size()));
+
+            for(unsigned int r = 0; r < this->rows; ++r)
+              {
+                this->set_row(r, lines[r]);
+              }
+          }
+
+
+        template <typename number>
+        void component_matrix<number>::assign_columns(const std::vector< std::vector<number> >& samples)
+          {
+            this->resize(samples.empty() ? 0 : static_cast<unsigned int>(samples.front().size()), static_cast<unsigned int>(samples.size()));
+
+            for(unsigned int j = 0; j < this->cols; ++j)
+              {
+                assert(samples[j].size() == this->rows);
+                for(unsigned int r = 0; r < this->rows; ++r)
+                  {
+                    this->row(r)[j] = samples[j][r];
+                  }
+              }
+          }
+
+
+        //! zeta_contraction evaluates the gauge transformation from field-space correlation functions to zeta
+        //! correlation functions, working on whole time series at once.
+        //! Contractions are performed one index at a time: contracting each twopf with dN on its second index
+        //! first reduces the (2N)^4 sum in the quadratic part of the threepf transformation to a (2N)^2 sum,
+        //! and the (2N)^3 sum in the linear part is evaluated as a sequence of matrix-vector products
+        template <typename number>
+        class zeta_contraction
+          {
+
+            // CONSTRUCTOR, DESTRUCTOR
+
+          public:
+
+            //! constructor captures the model's index flattening, and the first-order gauge transformation
+            //! dN indexed as [time][component]
+            zeta_contraction(model<number>* mdl, unsigned int Nf, const std::vector< std::vector<number> >& dN);
+
+            //! destructor is default
+            ~zeta_contraction() = default;
+
+
+            // INTERFACE
+
+          public:
+
+            //! get number of phase-space components
+            unsigned int get_components() const { return(this->D); }
+
+            //! get number of time samples
+            unsigned int get_samples() const { return(this->T); }
+
+            //! get row of a twopf matrix holding component (l,m)
+            unsigned int twopf_row(unsigned int l, unsigned int m) const { return(this->index2[l*this->D + m]); }
+
+            //! get row of a threepf matrix holding component (l,m,n)
+            unsigned int threepf_row(unsigned int l, unsigned int m, unsigned int n) const { return(this->index3[(l*this->D + m)*this->D + n]); }
+
+            //! contract a twopf matrix with dN on its second index: s[l][j] = sum_p sigma[l,p][j] dN[p][j]
+            void contract_twopf(const component_matrix<number>& sigma, component_matrix<number>& s) const;
+
+            //! zeta twopf from a contracted twopf: out[j] = sum_l dN[l][j] s[l][j]
+            void twopf(const component_matrix<number>& s, std::vector<number>& out) const;
+
+            //! accumulate the linear part of the zeta threepf: out[j] += sum_{l,m,n} dN[l][j] dN[m][j] dN[n][j] B[l,m,n][j]
+            void threepf_linear(const component_matrix<number>& B, std::vector<number>& out) const;
+
+            //! accumulate one quadratic part of the zeta threepf, given the second-order gauge transformation X and
+            //! contracted twopfs a, b at the two momenta it pairs:
+            //! out[j] += factor * sum_{l,m} X[l,m][j] (a_re[l][j] b_re[m][j] - a_im[l][j] b_im[m][j])
+            void threepf_quadratic(const component_matrix<number>& X,
+                                   const component_matrix<number>& a_re, const component_matrix<number>& a_im,
+                                   const component_matrix<number>& b_re, const component_matrix<number>& b_im,
+                                   number factor, std::vector<number>& out) const;
+
+
+            // INTERNAL DATA
+
+          private:
+
+            //! number of phase-space components
+            const unsigned int D;
+
+            //! number of time samples
+            const unsigned int T;
+
+            //! flattened index for each (l,m)
+            std::vector<unsigned int> index2;
+
+            //! flattened index for each (l,m,n)
+            std::vector<unsigned int> index3;
+
+            //! first-order gauge transformation, indexed as (component x time)
+            component_matrix<number> dN;
+
+          };
+
+
+        template <typename number>
+        zeta_contraction<number>::zeta_contraction(model<number>* mdl, unsigned int Nf, const std::vector< std::vector<number> >& dN_samples)
+          : D(2*Nf),
+            T(static_cast<unsigned int>(dN_samples.size()))
+          {
+            assert(mdl != nullptr);
+
+            index2.resize(D*D);
+            index3.resize(D*D*D);
+            for(unsigned int l = 0; l < D; ++l)
+              {
+                for(unsigned int m = 0; m < D; ++m)
+                  {
+                    index2[l*D + m] = mdl->flatten(l,m);
+                    for(unsigned int n = 0; n < D; ++n)
+                      {
+                        index3[(l*D + m)*D + n] = mdl->flatten(l,m,n);
+                      }
+                  }
+              }
+
+            dN.assign_columns(dN_samples);
+          }
+
+
+        template <typename number>
+        void zeta_contraction<number>::contract_twopf(const component_matrix<number>& sigma, component_matrix<number>& s) const
+          {
+            s.resize(this->D, this->T);
+
+            for(unsigned int l = 0; l < this->D; ++l)
+              {
+                number* out = s.row(l);
+
+                for(unsigned int p = 0; p < this->D; ++p)
+                  {
+                    const number* sig = sigma.row(this->twopf_row(l,p));
+                    const number* dNp = this->dN.row(p);
+
+                    for(unsigned int j = 0; j < this->T; ++j)
+                      {
+                        out[j] += sig[j] * dNp[j];
+                      }
+                  }
+              }
+          }
+
+
+        template <typename number>
+        void zeta_contraction<number>::twopf(const component_matrix<number>& s, std::vector<number>& out) const
+          {
+            out.assign(this->T, 0.0);
+
+            for(unsigned int l = 0; l < this->D; ++l)
+              {
+                const number* sl  = s.row(l);
+                const number* dNl = this->dN.row(l);
+
+                for(unsigned int j = 0; j < this->T; ++j)
+                  {
+                    out[j] += dNl[j] * sl[j];
+                  }
+              }
+          }
+
+
+        template <typename number>
+        void zeta_contraction<number>::threepf_linear(const component_matrix<number>& B, std::vector<number>& out) const
+          {
+            assert(out.size() == this->T);
+
+            // contract the final index first, then weight by dN_l dN_m
+            std::vector<number> t_lm(this->T);
+
+            for(unsigned int l = 0; l < this->D; ++l)
+              {
+                const number* dNl = this->dN.row(l);
+
+                for(unsigned int m = 0; m < this->D; ++m)
+                  {
+                    const number* dNm = this->dN.row(m);
+                    std::fill(t_lm.begin(), t_lm.end(), 0.0);
+
+                    for(unsigned int n = 0; n < this->D; ++n)
+                      {
+                        const number* b   = B.row(this->threepf_row(l,m,n));
+                        const number* dNn = this->dN.row(n);
+
+                        for(unsigned int j = 0; j < this->T; ++j)
+                          {
+                            t_lm[j] += b[j] * dNn[j];
+                          }
+                      }
+
+                    for(unsigned int j = 0; j < this->T; ++j)
+                      {
+                        out[j] += dNl[j] * dNm[j] * t_lm[j];
+                      }
+                  }
+              }
+          }
+
+
+        template <typename number>
+        void zeta_contraction<number>::threepf_quadratic(const component_matrix<number>& X,
+                                                         const component_matrix<number>& a_re, const component_matrix<number>& a_im,
+                                                         const component_matrix<number>& b_re, const component_matrix<number>& b_im,
+                                                         number factor, std::vector<number>& out) const
+          {
+            assert(out.size() == this->T);
+
+            for(unsigned int l = 0; l < this->D; ++l)
+              {
+                const number* ar = a_re.row(l);
+                const number* ai = a_im.row(l);
+
+                for(unsigned int m = 0; m < this->D; ++m)
+                  {
+                    const number* x  = X.row(this->twopf_row(l,m));
+                    const number* br = b_re.row(m);
+                    const number* bi = b_im.row(m);
+
+                    for(unsigned int j = 0; j < this->T; ++j)
+                      {
+                        out[j] += factor * x[j] * (ar[j]*br[j] - ai[j]*bi[j]);
+                      }
+                  }
+              }
+          }
+
+      }   // namespace derived_data
+
+  }   // namespace transport
+
+
+#endif //CPPTRANSPORT_ZETA_CONTRACTION_H
@@ -35,6 +35,8 @@
 // need data_manager for datapipe
 #include "transport-runtime/data/data_manager.h"
 
+#include "transport-runtime/derived-products/derived-content/correlation-functions/compute-gadgets/zeta_contraction.h"
+
 
 namespace transport
   {
@@ -56,8 +58,8 @@ namespace transport
 
               public:
 
-		            //! constructor
-                handle(datapipe<number>& pipe, twopf_db_task<number>* tk, const SQL_time_query& tq, unsigned int Nf);
+		            //! constructor; if streaming is set, each k-configuration is read in bulk rather than through the line cache
+                handle(datapipe<number>& pipe, twopf_db_task<number>* tk, const SQL_time_query& tq, unsigned int Nf, bool streaming=false);
 
 		            //! destructor is default
                 ~handle() = default;
@@ -93,6 +95,12 @@ namespace transport
                 //! cached gauge transformation coefficients
                 std::vector< std::vector<number> > dN;
 
+                //! contraction engine, holding dN as a (component x time) matrix
+                std::unique_ptr< zeta_contraction<number> > contraction;
+
+                //! read complete k-configuration histories in bulk, bypassing the line cache?
+                const bool streaming;
+
                 friend class zeta_timeseries_compute;
 
               };
@@ -112,8 +120,10 @@ namespace transport
 
           public:
 
-            //! make a handle
-            std::unique_ptr<handle> make_handle(datapipe<number>& pipe, twopf_db_task<number>* tk, const SQL_time_query& tq, unsigned int Nf) const;
+            //! make a handle; streaming handles read each k-configuration in a single bulk query per table, which is
+            //! preferable when every configuration is visited once (eg. postintegration tasks)
+            std::unique_ptr<handle> make_handle(datapipe<number>& pipe, twopf_db_task<number>* tk, const SQL_time_query& tq, unsigned int Nf,
+                                                bool streaming=false) const;
 
 
             // COMPUTE ZETA PRODUCTS
@@ -133,6 +143,16 @@ namespace transport
             //! compute a time series for the zeta two-point function (don't copy gauge xfms)
             void twopf(handle& h, std::vector<number>& zeta_twopf, const twopf_kconfig& k) const;
 
+            //! load the time series for every component of a correlation function at a k-configuration into
+            //! a (component x time) matrix, with rows in flattened-index order
+            void load_components(handle& h, cf_data_type type, unsigned int kserial, unsigned int count, component_matrix<number>& lines) const;
+
+            //! load a twopf at a k-configuration and contract it with dN on its second index
+            void load_contracted_twopf(handle& h, cf_data_type type, unsigned int kserial, component_matrix<number>& s) const;
+
+            //! pull a bulk history and check that it covers every time sample
+            void pull_history(handle& h, cf_data_type type, unsigned int kserial, std::vector< std::vector<number> >& history) const;
+
           };
 
 
@@ -140,12 +160,13 @@ namespace transport
 
 
         template <typename number>
-        zeta_timeseries_compute<number>::handle::handle(datapipe<number>& p, twopf_db_task<number>* t, const SQL_time_query& tq, unsigned int Nf)
+        zeta_timeseries_compute<number>::handle::handle(datapipe<number>& p, twopf_db_task<number>* t, const SQL_time_query& tq, unsigned int Nf, bool s)
           : pipe(p),
             tk(t),
             tquery(tq),
             t_handle(p.new_time_data_handle(tq)),
-            N_fields(Nf)
+            N_fields(Nf),
+            streaming(s)
           {
             assert(tk != nullptr);
 
@@ -162,9 +183,18 @@ namespace transport
             background.clear();
             background.resize(t_axis.size());
 
+            // announce the background lines, so they are pulled in a single bulk query and pinned while we read them
+            std::vector< background_time_data_tag<number> > bg_tags;
+            bg_tags.reserve(2*N_fields);
+            for(unsigned int i = 0; i < 2*N_fields; ++i)
+              {
+                bg_tags.push_back(pipe.new_background_time_data_tag(i));
+              }
+            typename datapipe<number>::line_prefetch bg_prefetch(pipe, t_handle, bg_tags);
+
             for(unsigned int i = 0; i < 2*N_fields; ++i)
               {
-                background_time_data_tag<number> tag = pipe.new_background_time_data_tag(i);
+                background_time_data_tag<number>& tag = bg_tags[i];
 
                 // safe to take a reference here and avoid a copy
                 const std::vector<number>& bg_line = t_handle.lookup_tag(tag);
@@ -183,6 +213,8 @@ namespace transport
                 dN[j].resize(2*N_fields);
                 mdl->compute_gauge_xfm_1(tk, background[j], dN[j]);
               }
+
+            contraction = std::make_unique< zeta_contraction<number> >(mdl, N_fields, dN);
           }
 
 
@@ -191,42 +223,88 @@ namespace transport
 
         template <typename number>
         std::unique_ptr<typename zeta_timeseries_compute<number>::handle>
-        zeta_timeseries_compute<number>::make_handle(datapipe<number>& pipe, twopf_db_task<number>* t, const SQL_time_query& tq, unsigned int Nf) const
+        zeta_timeseries_compute<number>::make_handle(datapipe<number>& pipe, twopf_db_task<number>* t, const SQL_time_query& tq, unsigned int Nf,
+                                                     bool streaming) const
           {
-            return std::make_unique<handle>(pipe, t, tq, Nf);
+            return std::make_unique<handle>(pipe, t, tq, Nf, streaming);
           }
 
 
         template <typename number>
-        void zeta_timeseries_compute<number>::twopf(typename zeta_timeseries_compute<number>::handle& h,
-                                                    std::vector<number>& zeta_twopf, const twopf_kconfig& k) const
+        void zeta_timeseries_compute<number>::pull_history(typename zeta_timeseries_compute<number>::handle& h, cf_data_type type, unsigned int kserial,
+                                                           std::vector< std::vector<number> >& history) const
           {
-            unsigned int N_fields = h.N_fields;
-
-            zeta_twopf.clear();
-            zeta_twopf.assign(h.t_axis.size(), 0.0);
+            h.pipe.pull_time_history(h.tquery, type, kserial, history);
 
-            // compute zeta twopf
-            for(unsigned int m = 0; m < 2*N_fields; ++m)
+            for(const std::vector<number>& line : history)
               {
-                for(unsigned int n = 0; n < 2*N_fields; ++n)
+                if(line.size() != h.t_axis.size())
                   {
-                    cf_time_data_tag<number> tag =
-                                               h.pipe.new_cf_time_data_tag(cf_data_type::cf_twopf_re, h.mdl->flatten(m,n), k.serial);
+                    std::ostringstream msg;
+                    msg << CPPTRANSPORT_DATAMGR_TIME_HISTORY_INCOMPLETE << " " << kserial;
+                    throw runtime_exception(exception_type::DATAPIPE_ERROR, msg.str());
+                  }
+              }
+          }
 
-                    // pull twopf data for this component; can use a reference to avoid copying
-                    const std::vector<number>& sigma_line = h.t_handle.lookup_tag(tag);
 
-                    for(unsigned int j = 0; j < h.t_axis.size(); ++j)
-                      {
-                        number component = h.dN[j][m]*h.dN[j][n]*sigma_line[j];
-                        zeta_twopf[j] += component;
-                      }
-                  }
+        template <typename number>
+        void zeta_timeseries_compute<number>::load_components(typename zeta_timeseries_compute<number>::handle& h, cf_data_type type, unsigned int kserial,
+                                                              unsigned int count, component_matrix<number>& lines) const
+          {
+            // streaming handles read every component in one query
+            if(h.streaming)
+              {
+                std::vector< std::vector<number> > history;
+                this->pull_history(h, type, kserial, history);
+                assert(history.size() == count);
+
+                lines.assign_rows(history);
+                return;
+              }
+
+            // otherwise, announce the components so they are pulled in a single bulk query and pinned
+            // while we copy them out
+            std::vector< cf_time_data_tag<number> > tags;
+            tags.reserve(count);
+            for(unsigned int r = 0; r < count; ++r)
+              {
+                tags.push_back(h.pipe.new_cf_time_data_tag(type, r, kserial));
+              }
+            typename datapipe<number>::line_prefetch prefetch(h.pipe, h.t_handle, tags);
+
+            lines.resize(count, static_cast<unsigned int>(h.t_axis.size()));
+            for(unsigned int r = 0; r < count; ++r)
+              {
+                lines.set_row(r, h.t_handle.lookup_tag(tags[r]));
               }
           }
 
 
+        template <typename number>
+        void zeta_timeseries_compute<number>::load_contracted_twopf(typename zeta_timeseries_compute<number>::handle& h, cf_data_type type, unsigned int kserial,
+                                                                    component_matrix<number>& s) const
+          {
+            unsigned int D = 2*h.N_fields;
+
+            component_matrix<number> sigma;
+            this->load_components(h, type, kserial, D*D, sigma);
+
+            h.contraction->contract_twopf(sigma, s);
+          }
+
+
+        template <typename number>
+        void zeta_timeseries_compute<number>::twopf(typename zeta_timeseries_compute<number>::handle& h,
+                                                    std::vector<number>& zeta_twopf, const twopf_kconfig& k) const
+          {
+            component_matrix<number> s;
+            this->load_contracted_twopf(h, cf_data_type::cf_twopf_re, k.serial, s);
+
+            h.contraction->twopf(s, zeta_twopf);
+          }
+
+
         template <typename number>
         void zeta_timeseries_compute<number>::twopf(typename zeta_timeseries_compute<number>::handle& h,
                                                     std::vector<number>& zeta_twopf, std::vector< std::vector<number> >& gauge_xfm1, const twopf_kconfig& k) const
@@ -244,17 +322,14 @@ namespace transport
                                                       std::vector< std::vector<number> >& gauge_xfm2_123, std::vector< std::vector<number> >& gauge_xfm2_213,
                                                       std::vector< std::vector<number> >& gauge_xfm2_312, const threepf_kconfig& k) const
           {
-            unsigned int N_fields = h.N_fields;
-
-            zeta_threepf.clear();
-            zeta_threepf.assign(h.t_axis.size(), 0.0);
-            redbsp.clear();
-            redbsp.assign(h.t_axis.size(), 0.0);
+            unsigned int D = 2*h.N_fields;
 
             const double k1 = k.k1_comoving;
             const double k2 = k.k2_comoving;
             const double k3 = k.k3_comoving;
 
+            // as of 14 Jan 2016 the database stores dimensionless quantities k^3 * 2pf, (k1 k2 k3) * 3pf
+            // this means we need some dimensionless factors k1k2, k1k3, k2k3 to convert between the different normalization conventions
             const double k1k2 = k3*k3/(k1*k2);
             const double k1k3 = k2*k2/(k1*k3);
             const double k2k3 = k1*k1/(k2*k3);
@@ -270,104 +345,48 @@ namespace transport
                 h.mdl->compute_gauge_xfm_2(h.tk, h.background[j], k3, k1, k2, h.t_axis[j].t, gauge_xfm2_312[j]);
               }
 
-            // linear component of the gauge transformation
-            for(unsigned int l = 0; l < 2*N_fields; ++l)
-              {
-                for(unsigned int m = 0; m < 2*N_fields; ++m)
-                  {
-                    for(unsigned int n = 0; n < 2*N_fields; ++n)
-                      {
-                        // pull threepf data for this component
-                        cf_time_data_tag<number> tag = h.pipe.new_cf_time_data_tag(cf_data_type::cf_threepf_Nderiv, h.mdl->flatten(l,m,n), k.serial);
-
-                        const std::vector<number>& threepf_line = h.t_handle.lookup_tag(tag);
-
-                        for(unsigned int j = 0; j < h.t_axis.size(); ++j)
-                          {
-                            number component = h.dN[j][l]*h.dN[j][m]*h.dN[j][n] * threepf_line[j];
-                            zeta_threepf[j] += component;
-                          }
-                      }
-                  }
-              }
+            component_matrix<number> X123;
+            component_matrix<number> X213;
+            component_matrix<number> X312;
+            X123.assign_columns(gauge_xfm2_123);
+            X213.assign_columns(gauge_xfm2_213);
+            X312.assign_columns(gauge_xfm2_312);
 
-            // quadratic component of the gauge transformation
-            for(unsigned int l = 0; l < 2*N_fields; ++l)
-              {
-                for(unsigned int m = 0; m < 2*N_fields; ++m)
-                  {
-                    for(unsigned int p = 0; p < 2*N_fields; ++p)
-                      {
-                        for(unsigned int q = 0; q < 2*N_fields; ++q)
-                          {
-                            // the indices are N_lm, N_p, N_q, so the 2pfs we sum over are
-                            // sigma_lp(k2)*sigma_mq(k3) etc.
-
-                            cf_time_data_tag<number> k1_re_lp_tag = h.pipe.new_cf_time_data_tag(cf_data_type::cf_twopf_re, h.mdl->flatten(l,p), k.k1_serial);
-                            cf_time_data_tag<number> k1_im_lp_tag = h.pipe.new_cf_time_data_tag(cf_data_type::cf_twopf_im, h.mdl->flatten(l,p), k.k1_serial);
-
-                            cf_time_data_tag<number> k2_re_lp_tag = h.pipe.new_cf_time_data_tag(cf_data_type::cf_twopf_re, h.mdl->flatten(l,p), k.k2_serial);
-                            cf_time_data_tag<number> k2_im_lp_tag = h.pipe.new_cf_time_data_tag(cf_data_type::cf_twopf_im, h.mdl->flatten(l,p), k.k2_serial);
-
-                            cf_time_data_tag<number> k2_re_mq_tag = h.pipe.new_cf_time_data_tag(cf_data_type::cf_twopf_re, h.mdl->flatten(m,q), k.k2_serial);
-                            cf_time_data_tag<number> k2_im_mq_tag = h.pipe.new_cf_time_data_tag(cf_data_type::cf_twopf_im, h.mdl->flatten(m,q), k.k2_serial);
-
-                            cf_time_data_tag<number> k3_re_mq_tag = h.pipe.new_cf_time_data_tag(cf_data_type::cf_twopf_re, h.mdl->flatten(m,q), k.k3_serial);
-                            cf_time_data_tag<number> k3_im_mq_tag = h.pipe.new_cf_time_data_tag(cf_data_type::cf_twopf_im, h.mdl->flatten(m,q), k.k3_serial);
-
-                            // can only take reference for the last lookup, because previous items may be evicted
-                            const std::vector<number>  k1_re_lp = h.t_handle.lookup_tag(k1_re_lp_tag);
-                            const std::vector<number>  k1_im_lp = h.t_handle.lookup_tag(k1_im_lp_tag);
-                            const std::vector<number>  k2_re_lp = h.t_handle.lookup_tag(k2_re_lp_tag);
-                            const std::vector<number>  k2_im_lp = h.t_handle.lookup_tag(k2_im_lp_tag);
-                            const std::vector<number>  k2_re_mq = h.t_handle.lookup_tag(k2_re_mq_tag);
-                            const std::vector<number>  k2_im_mq = h.t_handle.lookup_tag(k2_im_mq_tag);
-                            const std::vector<number>  k3_re_mq = h.t_handle.lookup_tag(k3_re_mq_tag);
-                            const std::vector<number>& k3_im_mq = h.t_handle.lookup_tag(k3_im_mq_tag);
-
-                            // as of 14 Jan 2016 the database stores dimensionless quantities k^3 * 2pf, (k1 k2 k3) * 3pf
-                            // this means we need some dimensionless factors k1k2, k1k3, k2k3 to convert between the different normalization conventions
-
-                            for(unsigned int j = 0; j < h.t_axis.size(); ++j)
-                              {
-                                number component1 = gauge_xfm2_123[j][h.mdl->flatten(l,m)] * h.dN[j][p] * h.dN[j][q] * k2k3 * (k2_re_lp[j]*k3_re_mq[j] - k2_im_lp[j]*k3_im_mq[j]);
-                                number component2 = gauge_xfm2_213[j][h.mdl->flatten(l,m)] * h.dN[j][p] * h.dN[j][q] * k1k3 * (k1_re_lp[j]*k3_re_mq[j] - k1_im_lp[j]*k3_im_mq[j]);
-                                number component3 = gauge_xfm2_312[j][h.mdl->flatten(l,m)] * h.dN[j][p] * h.dN[j][q] * k1k2 * (k1_re_lp[j]*k2_re_mq[j] - k1_im_lp[j]*k2_im_mq[j]);
-
-                                zeta_threepf[j] += component1;
-                                zeta_threepf[j] += component2;
-                                zeta_threepf[j] += component3;
-                              }
-                          }
-                      }
-                  }
-              }
+            zeta_threepf.assign(h.t_axis.size(), 0.0);
+            redbsp.assign(h.t_axis.size(), 0.0);
 
-            // compute reduced bispectrum
+            // linear component of the gauge transformation
+            {
+              component_matrix<number> threepf;
+              this->load_components(h, cf_data_type::cf_threepf_Nderiv, k.serial, D*D*D, threepf);
+
+              h.contraction->threepf_linear(threepf, zeta_threepf);
+            }
+
+            // quadratic component of the gauge transformation.
+            // The terms are N_lm N_p N_q sigma_lp(ka) sigma_mq(kb), so contracting each twopf with dN first
+            // leaves only a sum over (l,m)
+            component_matrix<number> k1_re, k1_im, k2_re, k2_im, k3_re, k3_im;
+            this->load_contracted_twopf(h, cf_data_type::cf_twopf_re, k.k1_serial, k1_re);
+            this->load_contracted_twopf(h, cf_data_type::cf_twopf_im, k.k1_serial, k1_im);
+            this->load_contracted_twopf(h, cf_data_type::cf_twopf_re, k.k2_serial, k2_re);
+            this->load_contracted_twopf(h, cf_data_type::cf_twopf_im, k.k2_serial, k2_im);
+            this->load_contracted_twopf(h, cf_data_type::cf_twopf_re, k.k3_serial, k3_re);
+            this->load_contracted_twopf(h, cf_data_type::cf_twopf_im, k.k3_serial, k3_im);
+
+            h.contraction->threepf_quadratic(X123, k2_re, k2_im, k3_re, k3_im, static_cast<number>(k2k3), zeta_threepf);
+            h.contraction->threepf_quadratic(X213, k1_re, k1_im, k3_re, k3_im, static_cast<number>(k1k3), zeta_threepf);
+            h.contraction->threepf_quadratic(X312, k1_re, k1_im, k2_re, k2_im, static_cast<number>(k1k2), zeta_threepf);
+
+            // compute reduced bispectrum; the zeta twopfs follow from the contracted real twopfs already in memory
             std::vector<number> twopf_k1;
             std::vector<number> twopf_k2;
             std::vector<number> twopf_k3;
 
-            twopf_kconfig k1_config;
-            k1_config.serial         = k.k1_serial;
-            k1_config.k_comoving     = k.k1_comoving;
-            k1_config.k_conventional = k.k1_conventional;
-
-            twopf_kconfig k2_config;
-            k2_config.serial         = k.k2_serial;
-            k2_config.k_comoving     = k.k2_comoving;
-            k2_config.k_conventional = k.k2_conventional;
-
-            twopf_kconfig k3_config;
-            k3_config.serial         = k.k3_serial;
-            k3_config.k_comoving     = k.k3_comoving;
-            k3_config.k_conventional = k.k3_conventional;
-
-            this->twopf(h, twopf_k1, k1_config);
-            this->twopf(h, twopf_k2, k2_config);
-            this->twopf(h, twopf_k3, k3_config);
+            h.contraction->twopf(k1_re, twopf_k1);
+            h.contraction->twopf(k2_re, twopf_k2);
+            h.contraction->twopf(k3_re, twopf_k3);
 
-            // build the reduced bispectrum
             for(unsigned int j = 0; j < h.t_axis.size(); ++j)
               {
                 number form_factor = (6.0/5.0) * ( twopf_k1[j]*twopf_k2[j]*k1k2 + twopf_k1[j]*twopf_k3[j]*k1k3 + twopf_k2[j]*twopf_k3[j]*k2k3 );
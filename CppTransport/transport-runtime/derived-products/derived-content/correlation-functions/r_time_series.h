@@ -95,6 +95,9 @@ namespace transport
 				    virtual void derive_lines(datapipe<number>& pipe, std::list<data_line<number> >& lines,
 				                              const std::list<std::string>& tags, slave_message_buffer& messages) const override;
 
+				    //! list source tasks; the zeta content group is attached first, followed by the integration content group supplying the tensor modes
+				    virtual void get_source_tasks(std::list< derivable_task<number>* >& tasks) const override;
+
 		        //! generate a LaTeX label
 		        std::string get_LaTeX_label(const twopf_kconfig& k) const;
 
@@ -168,6 +171,17 @@ namespace transport
 					}
 
 
+		    template <typename number>
+		    void r_time_series<number>::get_source_tasks(std::list< derivable_task<number>* >& tasks) const
+			    {
+				    postintegration_task<number>* ptk = dynamic_cast< postintegration_task<number>* >(this->parent_task);
+				    assert(ptk != nullptr);
+
+				    tasks.push_back(this->parent_task);
+				    tasks.push_back(ptk->get_parent_task());
+			    }
+
+
 		    template <typename number>
 		    void r_time_series<number>::derive_lines(datapipe<number>& pipe, std::list< data_line<number> >& lines,
 		                                             const std::list<std::string>& tags, slave_message_buffer& messages) const
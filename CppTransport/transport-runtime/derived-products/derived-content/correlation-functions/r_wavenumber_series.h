@@ -94,6 +94,9 @@ namespace transport
 		        virtual void derive_lines(datapipe<number>& pipe, std::list<data_line<number> >& lines,
 		                                  const std::list<std::string>& tags, slave_message_buffer& messages) const override;
 
+		        //! list source tasks; the zeta content group is attached first, followed by the integration content group supplying the tensor modes
+		        virtual void get_source_tasks(std::list< derivable_task<number>* >& tasks) const override;
+
 		        //! generate a LaTeX label
 		        std::string get_LaTeX_label(double t) const;
 
@@ -163,6 +166,17 @@ namespace transport
 			    }
 
 
+		    template <typename number>
+		    void r_wavenumber_series<number>::get_source_tasks(std::list< derivable_task<number>* >& tasks) const
+			    {
+				    postintegration_task<number>* ptk = dynamic_cast< postintegration_task<number>* >(this->parent_task);
+				    assert(ptk != nullptr);
+
+				    tasks.push_back(this->parent_task);
+				    tasks.push_back(ptk->get_parent_task());
+			    }
+
+
 		    template <typename number>
 		    void r_wavenumber_series<number>::derive_lines(datapipe<number>& pipe, std::list<data_line<number> >& lines,
 		                                                   const std::list<std::string>& tags, slave_message_buffer& messages) const
@@ -187,6 +201,15 @@ namespace transport
 		        std::vector< std::vector<number> > zeta_data;
 				    zeta_data.resize(t_values.size());
 
+		        // extract zeta samples for every t-configuration in a single pass over the k-configurations
+		        std::vector< zeta_twopf_kconfig_data_tag<number> > prefetch_tags;
+		        prefetch_tags.reserve(t_values.size());
+		        for(const time_config& t : t_values)
+			        {
+		            prefetch_tags.push_back(pipe.new_zeta_twopf_kconfig_data_tag(t.serial));
+			        }
+		        typename datapipe<number>::line_prefetch prefetch(pipe, z_handle, prefetch_tags);
+
 				    // for each t-configuration, pull zeta data from the database and cache it
             unsigned int i = 0;
 				    for(std::vector<time_config>::const_iterator t = t_values.begin(); t != t_values.end(); ++t, ++i)
@@ -197,6 +220,7 @@ namespace transport
 						    zeta_data[i] = z_handle.lookup_tag(zeta_tag);
 					    }
 
+				    prefetch.release();
 				    pipe.detach();
 
 				    // attach datapipe to a content group for the tensor part of r
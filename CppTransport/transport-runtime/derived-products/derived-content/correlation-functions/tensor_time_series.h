@@ -96,6 +96,13 @@ namespace transport
 		        virtual void derive_lines(datapipe<number>& pipe, std::list<data_line<number> >& lines,
 		                                  const std::list<std::string>& tags, slave_message_buffer& messages) const override;
 
+		        //! generates one group of lines per k-configuration, so can be extended incrementally when new
+		        //! k-configurations are added to a seeded content group
+		        virtual bool is_incremental() const override { return(true); }
+
+		        //! only reads stored data, so can be derived concurrently with other lines
+		        virtual bool evaluates_model() const override { return(false); }
+
 		        //! generate a LaTeX label
 		        std::string get_LaTeX_label(unsigned int m, unsigned int n, const twopf_kconfig& k) const;
 
@@ -191,6 +198,8 @@ namespace transport
 		        // for each k-configuration, loop through all components of the tensor twopf and pull data from the database
 		        for(std::vector<twopf_kconfig>::const_iterator t = k_values.begin(); t != k_values.end(); ++t)
 			        {
+				        if(!pipe.use_kconfig(t->serial)) continue;
+
 				        for(unsigned int m = 0; m < 2; ++m)
 					        {
 						        for(unsigned int n = 0; n < 2; ++n)
@@ -96,6 +96,9 @@ namespace transport
 				    virtual void derive_lines(datapipe<number>& pipe, std::list<data_line<number> >& lines,
 				                              const std::list<std::string>& tags, slave_message_buffer& messages) const override;
 
+				    //! only reads stored data, so can be derived concurrently with other lines
+				    virtual bool evaluates_model() const override { return(false); }
+
 		        //! generate a LaTeX label
 		        std::string get_LaTeX_label(unsigned int m, unsigned int n, double t) const;
 
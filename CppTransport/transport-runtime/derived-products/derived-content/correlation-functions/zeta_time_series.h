@@ -97,6 +97,10 @@ namespace transport
             virtual void derive_lines(datapipe<number>& pipe, std::list<data_line<number> >& lines,
                                       const std::list<std::string>& tags, slave_message_buffer& messages) const override;
 
+            //! generates one group of lines per k-configuration, so can be extended incrementally when new
+            //! k-configurations are added to a seeded content group
+            virtual bool is_incremental() const override { return(true); }
+
             //! generate a LaTeX label
             std::string get_LaTeX_label(const twopf_kconfig& k) const;
 
@@ -187,6 +191,8 @@ namespace transport
 
             for(std::vector<twopf_kconfig>::const_iterator t = k_values.begin(); t != k_values.end(); ++t)
               {
+		            if(!pipe.use_kconfig(t->serial)) continue;
+
 		            zeta_twopf_time_data_tag<number> tag = pipe.new_zeta_twopf_time_data_tag(*t);
 
                 std::vector<number> line_data = z_handle.lookup_tag(tag);
@@ -333,6 +339,10 @@ namespace transport
             virtual void derive_lines(datapipe<number>& pipe, std::list< data_line<number> >& lines,
                                       const std::list<std::string>& tags, slave_message_buffer& messages) const override;
 
+            //! generates one group of lines per k-configuration, so can be extended incrementally when new
+            //! k-configurations are added to a seeded content group
+            virtual bool is_incremental() const override { return(true); }
+
             //! generate a LaTeX label
             std::string get_LaTeX_label(const threepf_kconfig& k) const;
 
@@ -420,6 +430,8 @@ namespace transport
 
             for(std::vector<threepf_kconfig>::const_iterator t = k_values.begin(); t != k_values.end(); ++t)
               {
+		            if(!pipe.use_kconfig(t->serial)) continue;
+
 		            zeta_threepf_time_data_tag<number> tag = pipe.new_zeta_threepf_time_data_tag(*t);
 
                 std::vector<number> line_data = z_handle.lookup_tag(tag);
@@ -565,6 +577,10 @@ namespace transport
             virtual void derive_lines(datapipe<number>& pipe, std::list<data_line<number> >& lines,
                                       const std::list<std::string>& tags, slave_message_buffer& messages) const override;
 
+            //! generates one group of lines per k-configuration, so can be extended incrementally when new
+            //! k-configurations are added to a seeded content group
+            virtual bool is_incremental() const override { return(true); }
+
             //! generate a LaTeX label
             std::string get_LaTeX_label(const threepf_kconfig& k) const;
 
@@ -652,6 +668,8 @@ namespace transport
 
             for(std::vector<threepf_kconfig>::const_iterator t = k_values.begin(); t != k_values.end(); ++t)
               {
+		            if(!pipe.use_kconfig(t->serial)) continue;
+
 		            zeta_reduced_bispectrum_time_data_tag<number> tag = pipe.new_zeta_reduced_bispectrum_time_data_tag(*t);
 
                 // it's safe to take a reference here to avoid a copy; we don't need the cache data to survive over multiple calls to lookup_tag()
@@ -188,6 +188,16 @@ namespace transport
 		        twopf_kconfig_tag<number>                 k_tag    = pipe.new_twopf_kconfig_tag();
 		        const typename std::vector<twopf_kconfig> k_values = kc_handle.lookup_tag(k_tag);
 
+		        // announce the samples for every t-configuration, so they are extracted in a single pass over the
+		        // k-configurations rather than one query per time; the lines are pinned while we read them
+		        std::vector< zeta_twopf_kconfig_data_tag<number> > prefetch_tags;
+		        prefetch_tags.reserve(t_values.size());
+		        for(const time_config& t : t_values)
+			        {
+		            prefetch_tags.push_back(pipe.new_zeta_twopf_kconfig_data_tag(t.serial));
+			        }
+		        typename datapipe<number>::line_prefetch prefetch(pipe, z_handle, prefetch_tags);
+
 		        // loop through all components of the twopf, for each t-configuration we use, pulling data from the database
 		        for(std::vector<time_config>::const_iterator t = t_values.begin(); t != t_values.end(); ++t)
 			        {
@@ -223,7 +233,8 @@ namespace transport
                                    this->get_LaTeX_label(t->t), this->get_non_LaTeX_label(t->t), messages, this->is_spectral_index());
 			        }
 
-		        // detach pipe from content group
+		        // release pinned lines and detach pipe from content group
+		        prefetch.release();
 		        this->detach(pipe);
 			    }
 
@@ -435,6 +446,16 @@ namespace transport
             threepf_kconfig_tag<number>                 k_tag    = pipe.new_threepf_kconfig_tag();
             const typename std::vector<threepf_kconfig> k_values = kc_handle.lookup_tag(k_tag);
 
+		        // announce the samples for every t-configuration, so they are extracted in a single pass over the
+		        // k-configurations rather than one query per time; the lines are pinned while we read them
+		        std::vector< zeta_threepf_kconfig_data_tag<number> > prefetch_tags;
+		        prefetch_tags.reserve(t_values.size());
+		        for(const time_config& t : t_values)
+			        {
+		            prefetch_tags.push_back(pipe.new_zeta_threepf_kconfig_data_tag(t.serial));
+			        }
+		        typename datapipe<number>::line_prefetch prefetch(pipe, z_handle, prefetch_tags);
+
 		        // loop through all components of the twopf, for each t-configuration we use, pulling data from the database
 		        for(std::vector<time_config>::const_iterator t = t_values.begin(); t != t_values.end(); ++t)
 			        {
@@ -464,7 +485,8 @@ namespace transport
                                    this->get_LaTeX_label(t->t), this->get_non_LaTeX_label(t->t), messages, this->is_spectral_index());
 			        }
 
-		        // detach pipe from content group
+		        // release pinned lines and detach pipe from content group
+		        prefetch.release();
 		        this->detach(pipe);
 			    }
 
@@ -671,6 +693,16 @@ namespace transport
 		        time_config_tag<number> t_tag = pipe.new_time_config_tag();
 		        const std::vector< time_config > t_values = tc_handle.lookup_tag(t_tag);
 
+		        // announce the samples for every t-configuration, so they are extracted in a single pass over the
+		        // k-configurations rather than one query per time; the lines are pinned while we read them
+		        std::vector< zeta_reduced_bispectrum_kconfig_data_tag<number> > prefetch_tags;
+		        prefetch_tags.reserve(t_values.size());
+		        for(const time_config& t : t_values)
+			        {
+		            prefetch_tags.push_back(pipe.new_zeta_reduced_bispectrum_kconfig_data_tag(t.serial));
+			        }
+		        typename datapipe<number>::line_prefetch prefetch(pipe, z_handle, prefetch_tags);
+
 		        // loop through all components of the twopf, for each t-configuration we use, pulling data from the database
 		        for(std::vector<time_config>::const_iterator t = t_values.begin(); t != t_values.end(); ++t)
 			        {
@@ -683,7 +715,8 @@ namespace transport
                                    this->get_LaTeX_label(t->t), this->get_non_LaTeX_label(t->t), messages, this->is_spectral_index());
 			        }
 
-		        // detach pipe from content group
+		        // release pinned lines and detach pipe from content group
+		        prefetch.release();
 		        this->detach(pipe);
 			    }
 
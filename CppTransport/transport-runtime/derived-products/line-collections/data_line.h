@@ -91,6 +91,21 @@ namespace transport
               {
               }
 
+            //! Construct a dataline object from a list of points which have already been zipped and
+            //! processed, eg. when restoring a line from the derived-line cache
+            data_line(std::list<std::string> g, axis_value at, value_type vt, point_list p, data_line_type dt,
+                      std::string Ll, std::string nLl, slave_message_buffer& msg)
+              : messages(msg),
+                groups(std::move(g)),
+                x_type(at),
+                y_type(vt),
+                data(std::move(p)),
+                data_type(dt),
+                LaTeX_label(std::move(Ll)),
+                non_LaTeX_label(std::move(nLl))
+              {
+              }
+
             ~data_line() = default;
 
 
@@ -111,7 +126,7 @@ namespace transport
 		        const point_list& get_data_points() const { return(this->data); }
 
 		        //! Get axis type
-		        axis_class get_axis_value() const { return(this->x_type); }
+		        axis_value get_axis_value() const { return(this->x_type); }
 
 		        //! Get value type
 		        value_type get_value_type() const { return(this->y_type); }
@@ -0,0 +1,551 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+
+#ifndef CPPTRANSPORT_DERIVED_LINE_CACHE_H
+#define CPPTRANSPORT_DERIVED_LINE_CACHE_H
+
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <list>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "transport-runtime/version.h"
+
+#include "transport-runtime/derived-products/derived-content/concepts/derived_line.h"
+#include "transport-runtime/derived-products/line-collections/data_line.h"
+
+#include "boost/filesystem/operations.hpp"
+
+#include "json/json.h"
+
+
+namespace transport
+	{
+
+		namespace derived_data
+			{
+
+        // leaf name of the derived-line cache, stored inside the output directory of the content group a line attaches first;
+        // entries are deleted along with the content group
+        constexpr auto CPPTRANSPORT_DERIVED_LINE_CACHE_LEAF = "derived-lines";
+
+        // version of the cache entry format; bump whenever the format, or the way lines are derived, changes
+        constexpr auto CPPTRANSPORT_DERIVED_LINE_CACHE_VERSION = "3";
+
+        constexpr auto CPPTRANSPORT_NODE_LINE_CACHE_KEY         = "key";
+        constexpr auto CPPTRANSPORT_NODE_LINE_CACHE_LINES       = "lines";
+        constexpr auto CPPTRANSPORT_NODE_LINE_CACHE_KCONFIGS    = "kconfigs";
+        constexpr auto CPPTRANSPORT_NODE_LINE_CACHE_GROUPS      = "groups";
+        constexpr auto CPPTRANSPORT_NODE_LINE_CACHE_X_TYPE      = "x-type";
+        constexpr auto CPPTRANSPORT_NODE_LINE_CACHE_Y_TYPE      = "y-type";
+        constexpr auto CPPTRANSPORT_NODE_LINE_CACHE_LINE_TYPE   = "line-type";
+        constexpr auto CPPTRANSPORT_NODE_LINE_CACHE_LATEX       = "latex-label";
+        constexpr auto CPPTRANSPORT_NODE_LINE_CACHE_NON_LATEX   = "non-latex-label";
+        constexpr auto CPPTRANSPORT_NODE_LINE_CACHE_X_VALUES    = "x";
+        constexpr auto CPPTRANSPORT_NODE_LINE_CACHE_Y_VALUES    = "y";
+
+        // JSON has no representation for non-finite values, so they are stored as strings
+        constexpr auto CPPTRANSPORT_LINE_CACHE_NAN              = "nan";
+        constexpr auto CPPTRANSPORT_LINE_CACHE_INF              = "inf";
+        constexpr auto CPPTRANSPORT_LINE_CACHE_MINUS_INF        = "-inf";
+
+
+        namespace derived_line_cache_impl
+          {
+
+            //! encode a sample value for a cache entry; JsonCpp would otherwise write NaN as null,
+            //! which reads back as zero
+            inline Json::Value encode_value(double v)
+              {
+                if(std::isnan(v)) return Json::Value(CPPTRANSPORT_LINE_CACHE_NAN);
+                if(std::isinf(v)) return Json::Value(v > 0.0 ? CPPTRANSPORT_LINE_CACHE_INF : CPPTRANSPORT_LINE_CACHE_MINUS_INF);
+                return Json::Value(v);
+              }
+
+
+            //! decode a sample value from a cache entry; throws if it is not recognized, so the entry is treated as a miss
+            inline double decode_value(const Json::Value& v)
+              {
+                if(v.isNumeric()) return(v.asDouble());
+
+                if(v.isString())
+                  {
+                    const std::string str = v.asString();
+                    if(str == CPPTRANSPORT_LINE_CACHE_NAN)       return(std::numeric_limits<double>::quiet_NaN());
+                    if(str == CPPTRANSPORT_LINE_CACHE_INF)       return(std::numeric_limits<double>::infinity());
+                    if(str == CPPTRANSPORT_LINE_CACHE_MINUS_INF) return(-std::numeric_limits<double>::infinity());
+                  }
+
+                throw std::runtime_error("unrecognized sample value");
+              }
+
+
+            //! build a cache entry from a key, a list of lines and the k-configurations they cover
+            template <typename number>
+            Json::Value encode_entry(const std::string& key, const std::list< data_line<number> >& lines, const std::set<unsigned int>& covered)
+              {
+                Json::Value root(Json::objectValue);
+                root[CPPTRANSPORT_NODE_LINE_CACHE_KEY] = key;
+
+                Json::Value kconfigs(Json::arrayValue);
+                for(unsigned int serial : covered)
+                  {
+                    kconfigs.append(serial);
+                  }
+                root[CPPTRANSPORT_NODE_LINE_CACHE_KCONFIGS] = kconfigs;
+
+                Json::Value line_array(Json::arrayValue);
+                for(const data_line<number>& line : lines)
+                  {
+                    Json::Value node(Json::objectValue);
+
+                    Json::Value groups(Json::arrayValue);
+                    for(const std::string& g : line.get_parent_groups())
+                      {
+                        groups.append(g);
+                      }
+                    node[CPPTRANSPORT_NODE_LINE_CACHE_GROUPS] = groups;
+
+                    node[CPPTRANSPORT_NODE_LINE_CACHE_X_TYPE]    = static_cast<int>(line.get_axis_value());
+                    node[CPPTRANSPORT_NODE_LINE_CACHE_Y_TYPE]    = static_cast<int>(line.get_value_type());
+                    node[CPPTRANSPORT_NODE_LINE_CACHE_LINE_TYPE] = static_cast<int>(line.get_data_line_type());
+                    node[CPPTRANSPORT_NODE_LINE_CACHE_LATEX]     = line.get_LaTeX_label();
+                    node[CPPTRANSPORT_NODE_LINE_CACHE_NON_LATEX] = line.get_non_LaTeX_label();
+
+                    Json::Value x(Json::arrayValue);
+                    Json::Value y(Json::arrayValue);
+                    for(const std::pair<double, number>& point : line.get_data_points())
+                      {
+                        x.append(encode_value(point.first));
+                        y.append(encode_value(static_cast<double>(point.second)));
+                      }
+                    node[CPPTRANSPORT_NODE_LINE_CACHE_X_VALUES] = x;
+                    node[CPPTRANSPORT_NODE_LINE_CACHE_Y_VALUES] = y;
+
+                    line_array.append(node);
+                  }
+                root[CPPTRANSPORT_NODE_LINE_CACHE_LINES] = line_array;
+
+                return(root);
+              }
+
+
+            //! restore lines, and the k-configurations they cover, from a cache entry.
+            //! Returns false if the entry was stored under a different key, or does not record its k-configurations
+            //! when 'need_covered' is set; throws if the entry is malformed.
+            //! Restored lines are appended to 'lines' only on success
+            template <typename number>
+            bool decode_entry(const Json::Value& root, const std::string& expected, bool need_covered,
+                              std::list< data_line<number> >& lines, std::set<unsigned int>& covered, slave_message_buffer& messages)
+              {
+                if(root[CPPTRANSPORT_NODE_LINE_CACHE_KEY].asString() != expected) return(false);
+
+                // lines can only be extended if the k-configurations they cover are known
+                if(need_covered && !root.isMember(CPPTRANSPORT_NODE_LINE_CACHE_KCONFIGS)) return(false);
+
+                std::list< data_line<number> > restored;
+                std::set<unsigned int> restored_kconfigs;
+
+                for(const Json::Value& serial : root[CPPTRANSPORT_NODE_LINE_CACHE_KCONFIGS])
+                  {
+                    restored_kconfigs.insert(serial.asUInt());
+                  }
+
+                for(const Json::Value& node : root[CPPTRANSPORT_NODE_LINE_CACHE_LINES])
+                  {
+                    std::list<std::string> groups;
+                    for(const Json::Value& g : node[CPPTRANSPORT_NODE_LINE_CACHE_GROUPS])
+                      {
+                        groups.push_back(g.asString());
+                      }
+
+                    const Json::Value& x = node[CPPTRANSPORT_NODE_LINE_CACHE_X_VALUES];
+                    const Json::Value& y = node[CPPTRANSPORT_NODE_LINE_CACHE_Y_VALUES];
+                    if(x.size() != y.size()) return(false);
+
+                    typename data_line<number>::point_list points;
+                    points.reserve(x.size());
+                    for(Json::ArrayIndex i = 0; i < x.size(); ++i)
+                      {
+                        points.emplace_back(decode_value(x[i]), static_cast<number>(decode_value(y[i])));
+                      }
+
+                    restored.emplace_back(std::move(groups),
+                                          static_cast<axis_value>(node[CPPTRANSPORT_NODE_LINE_CACHE_X_TYPE].asInt()),
+                                          static_cast<value_type>(node[CPPTRANSPORT_NODE_LINE_CACHE_Y_TYPE].asInt()),
+                                          std::move(points),
+                                          static_cast<data_line_type>(node[CPPTRANSPORT_NODE_LINE_CACHE_LINE_TYPE].asInt()),
+                                          node[CPPTRANSPORT_NODE_LINE_CACHE_LATEX].asString(),
+                                          node[CPPTRANSPORT_NODE_LINE_CACHE_NON_LATEX].asString(),
+                                          messages);
+                  }
+
+                lines.splice(lines.end(), restored);
+                covered.swap(restored_kconfigs);
+                return(true);
+              }
+
+
+            //! read a cache entry from disk; returns false if it does not exist or cannot be opened,
+            //! and throws if it cannot be parsed
+            inline bool read_entry(const boost::filesystem::path& path, Json::Value& root)
+              {
+                if(!boost::filesystem::is_regular_file(path)) return(false);
+
+                std::ifstream in(path.string().c_str(), std::ios_base::in);
+                if(!in) return(false);
+
+                in >> root;
+                return(true);
+              }
+
+
+            //! write a cache entry to disk. The entry is written to a temporary file and moved into place,
+            //! so concurrent workers never see a partial entry; the temporary file is removed on every failure path.
+            //! Returns false if the entry could not be written; filesystem errors are rethrown
+            inline bool write_entry(const Json::Value& root, const boost::filesystem::path& path)
+              {
+                boost::filesystem::path temp;
+                try
+                  {
+                    boost::filesystem::path dir = path.parent_path();
+                    boost::filesystem::create_directories(dir);
+
+                    temp = dir / boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+
+                    std::ofstream out(temp.string().c_str(), std::ios_base::out | std::ios_base::trunc);
+                    if(out.is_open() && !out.fail())
+                      {
+                        Json::StreamWriterBuilder builder;
+                        builder["indentation"] = "";
+                        builder["precision"] = 17;
+                        out << Json::writeString(builder, root);
+                        out.close();
+                      }
+
+                    // never move a truncated entry into place
+                    if(out.fail())
+                      {
+                        boost::system::error_code ec;
+                        boost::filesystem::remove(temp, ec);
+                        return(false);
+                      }
+
+                    boost::filesystem::rename(temp, path);
+                  }
+                catch(boost::filesystem::filesystem_error& xe)
+                  {
+                    if(!temp.empty())
+                      {
+                        boost::system::error_code ec;
+                        boost::filesystem::remove(temp, ec);
+                      }
+                    throw;
+                  }
+
+                return(true);
+              }
+
+          }   // namespace derived_line_cache_impl
+
+
+        //! derived_line_cache memoizes the data_lines generated by a derived_line, so that re-running an output task
+        //! need not recompute lines whose definition and source content are unchanged.
+        //! An entry is keyed on the runtime API version, the identity and translator version of the model which
+        //! produced each content group, the content groups the line would attach, its JSON serialization and the
+        //! tags supplied to the output task. The full key is stored in the entry and checked on load,
+        //! so a hash collision produces a miss rather than a wrong line.
+        //! A model can be rebuilt without changing its identity, so lines which evaluate the model should not
+        //! be memoized; line_collection only consults the cache for lines which read stored data.
+        //! Each entry also records the k-configurations its lines cover. If a line is incremental and its
+        //! content group was seeded, the entry stored for the seed group can be located, and only
+        //! k-configurations which it does not cover need to be derived
+        template <typename number>
+        class derived_line_cache
+          {
+
+            // CONSTRUCTOR, DESTRUCTOR
+
+          public:
+
+            //! constructor resolves the content groups which the line would attach, and computes its key
+            derived_line_cache(datapipe<number>& p, const derived_line<number>& line, const std::list<std::string>& tags);
+
+            //! destructor is default
+            ~derived_line_cache() = default;
+
+
+            // INTERFACE
+
+          public:
+
+            //! can entries be looked up for this line? false if any of its content groups could not be resolved
+            bool is_valid() const { return(this->valid); }
+
+            //! look up lines; if found, they are appended to 'lines' and the return value is true
+            bool load(std::list< data_line<number> >& lines, slave_message_buffer& messages);
+
+            //! look up lines stored for the seed of this line's content group; if found, they are appended to 'lines',
+            //! the k-configurations they cover are written to 'covered', and the return value is true
+            bool load_seed(std::list< data_line<number> >& lines, std::set<unsigned int>& covered, slave_message_buffer& messages);
+
+            //! store the lines generated by the line, together with the k-configurations they cover;
+            //! failure to write is not an error
+            void store(const std::list< data_line<number> >& lines, const std::set<unsigned int>& covered);
+
+
+            // INTERNAL API
+
+          protected:
+
+            //! build the key for a given list of source tasks and their content groups
+            std::string make_key(const derived_line<number>& line, const std::list< derivable_task<number>* >& tasks,
+                                 const std::list<std::string>& groups, const std::list<std::string>& tags) const;
+
+            //! build the path to an entry, given its key and the output directory of the first content group
+            static boost::filesystem::path make_entry(const std::string& key, const boost::filesystem::path& root);
+
+            //! read an entry
+            bool read(const boost::filesystem::path& path, const std::string& expected, std::list< data_line<number> >& lines,
+                      std::set<unsigned int>& covered, bool need_covered, slave_message_buffer& messages);
+
+            //! 64-bit FNV-1a hash; this is stable between runs, unlike std::hash
+            static std::uint64_t hash(const std::string& s);
+
+
+            // INTERNAL DATA
+
+          private:
+
+            //! datapipe, used for logging
+            datapipe<number>& pipe;
+
+            //! is the entry usable?
+            bool valid;
+
+            //! full key
+            std::string key;
+
+            //! path to the entry
+            boost::filesystem::path entry;
+
+            //! is there an entry for the seed group?
+            bool seeded;
+
+            //! key for the seed group's entry
+            std::string seed_key;
+
+            //! path to the seed group's entry
+            boost::filesystem::path seed_entry;
+
+          };
+
+
+        template <typename number>
+        derived_line_cache<number>::derived_line_cache(datapipe<number>& p, const derived_line<number>& line, const std::list<std::string>& tags)
+          : pipe(p),
+            valid(false),
+            seeded(false)
+          {
+            std::list< derivable_task<number>* > tasks;
+            line.get_source_tasks(tasks);
+            if(tasks.empty()) return;
+
+            std::list<std::string> groups;
+            boost::filesystem::path root;
+            for(derivable_task<number>* tk : tasks)
+              {
+                std::string group;
+                boost::filesystem::path output;
+                if(!this->pipe.find_content_group(tk, tags, group, output)) return;
+
+                // the entry is filed with the first content group to be attached
+                if(root.empty()) root = output;
+                groups.push_back(group);
+              }
+
+            this->key   = this->make_key(line, tasks, groups, tags);
+            this->entry = make_entry(this->key, root);
+            this->valid = true;
+
+            // lines which attach a single content group can be extended from the entry stored for its seed, if any
+            std::string seed;
+            boost::filesystem::path seed_root;
+            if(line.is_incremental() && tasks.size() == 1
+               && this->pipe.find_seed_group(tasks.front(), groups.front(), seed, seed_root))
+              {
+                this->seed_key   = this->make_key(line, tasks, std::list<std::string>{ seed }, tags);
+                this->seed_entry = make_entry(this->seed_key, seed_root);
+                this->seeded     = true;
+              }
+          }
+
+
+        template <typename number>
+        std::string derived_line_cache<number>::make_key(const derived_line<number>& line, const std::list< derivable_task<number>* >& tasks,
+                                                         const std::list<std::string>& groups, const std::list<std::string>& tags) const
+          {
+            std::ostringstream key_stream;
+            key_stream << CPPTRANSPORT_DERIVED_LINE_CACHE_VERSION << '\n' << CPPTRANSPORT_RUNTIME_API_VERSION << '\n' << sizeof(number) << '\n';
+
+            // record the model which produced each source task's content; postintegration tasks inherit
+            // the model of their parent integration task
+            for(derivable_task<number>* tk : tasks)
+              {
+                derivable_task<number>* source = tk;
+                postintegration_task<number>* ptk = nullptr;
+                while((ptk = dynamic_cast< postintegration_task<number>* >(source)) != nullptr)
+                  {
+                    source = ptk->get_parent_task();
+                  }
+
+                integration_task<number>* itk = dynamic_cast< integration_task<number>* >(source);
+                if(itk != nullptr)
+                  {
+                    model<number>* mdl = itk->get_model();
+                    key_stream << mdl->get_identity_string() << '\n' << mdl->get_translator_version() << '\n';
+                  }
+              }
+
+            for(const std::string& group : groups)
+              {
+                key_stream << group << '\n';
+              }
+
+            for(const std::string& tag : tags)
+              {
+                key_stream << tag << '\n';
+              }
+
+            Json::Value definition(Json::objectValue);
+            line.serialize(definition);
+
+            Json::StreamWriterBuilder builder;
+            builder["indentation"] = "";
+            key_stream << Json::writeString(builder, definition);
+
+            return(key_stream.str());
+          }
+
+
+        template <typename number>
+        boost::filesystem::path derived_line_cache<number>::make_entry(const std::string& key, const boost::filesystem::path& root)
+          {
+            std::ostringstream leaf;
+            leaf << std::hex << std::setw(16) << std::setfill('0') << hash(key) << ".json";
+            return(root / CPPTRANSPORT_DERIVED_LINE_CACHE_LEAF / leaf.str());
+          }
+
+
+        template <typename number>
+        std::uint64_t derived_line_cache<number>::hash(const std::string& s)
+          {
+            std::uint64_t h = 0xcbf29ce484222325ULL;
+            for(unsigned char c : s)
+              {
+                h ^= c;
+                h *= 0x100000001b3ULL;
+              }
+            return(h);
+          }
+
+
+        template <typename number>
+        bool derived_line_cache<number>::load(std::list< data_line<number> >& lines, slave_message_buffer& messages)
+          {
+            if(!this->valid) return(false);
+
+            std::set<unsigned int> covered;
+            return(this->read(this->entry, this->key, lines, covered, false, messages));
+          }
+
+
+        template <typename number>
+        bool derived_line_cache<number>::load_seed(std::list< data_line<number> >& lines, std::set<unsigned int>& covered,
+                                                   slave_message_buffer& messages)
+          {
+            if(!this->valid || !this->seeded) return(false);
+
+            return(this->read(this->seed_entry, this->seed_key, lines, covered, true, messages));
+          }
+
+
+        template <typename number>
+        bool derived_line_cache<number>::read(const boost::filesystem::path& path, const std::string& expected, std::list< data_line<number> >& lines,
+                                              std::set<unsigned int>& covered, bool need_covered, slave_message_buffer& messages)
+          {
+            try
+              {
+                Json::Value root;
+                if(!derived_line_cache_impl::read_entry(path, root)) return(false);
+
+                return(derived_line_cache_impl::decode_entry(root, expected, need_covered, lines, covered, messages));
+              }
+            catch(std::exception& xe)
+              {
+                // a damaged entry is treated as a miss, and will be overwritten
+                BOOST_LOG_SEV(this->pipe.get_log(), datapipe<number>::log_severity_level::warning)
+                  << ":: Warning: could not read derived-line cache entry '" << path.string() << "' (" << xe.what() << ")";
+                return(false);
+              }
+          }
+
+
+        template <typename number>
+        void derived_line_cache<number>::store(const std::list< data_line<number> >& lines, const std::set<unsigned int>& covered)
+          {
+            if(!this->valid) return;
+
+            Json::Value root = derived_line_cache_impl::encode_entry(this->key, lines, covered);
+
+            try
+              {
+                if(!derived_line_cache_impl::write_entry(root, this->entry))
+                  {
+                    BOOST_LOG_SEV(this->pipe.get_log(), datapipe<number>::log_severity_level::warning)
+                      << ":: Warning: could not write derived-line cache entry '" << this->entry.string() << "'";
+                  }
+              }
+            catch(boost::filesystem::filesystem_error& xe)
+              {
+                BOOST_LOG_SEV(this->pipe.get_log(), datapipe<number>::log_severity_level::warning)
+                  << ":: Warning: could not write derived-line cache entry '" << this->entry.string() << "' (" << xe.what() << ")";
+              }
+          }
+
+      }   // namespace derived_data
+
+  }   // namespace transport
+
+
+#endif //CPPTRANSPORT_DERIVED_LINE_CACHE_H
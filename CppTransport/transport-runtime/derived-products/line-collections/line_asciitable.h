@@ -257,7 +257,7 @@ namespace transport
 
             // generate output from our constituent lines
 				    std::list< data_line<number> > derived_lines;
-						this->obtain_output(pipe, tags, derived_lines, messages);
+						this->obtain_output(pipe, tags, derived_lines, messages, args.get_derived_line_cache(), args.get_output_threads());
 
 						// merge this output onto a single axis
 				    std::deque<double> axis;
@@ -32,11 +32,19 @@
 #include <sstream>
 #include <string>
 #include <cmath>
+#include <algorithm>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <set>
 
 #include "transport-runtime/derived-products/derived_product.h"
 #include "transport-runtime/derived-products/derived-content/concepts/derived_line.h"
 #include "transport-runtime/derived-products/derived-content/concepts/derived_line_helper.h"
 #include "transport-runtime/derived-products/line-collections/data_line.h"
+#include "transport-runtime/derived-products/line-collections/derived_line_cache.h"
 
 #include "transport-runtime/defaults.h"
 #include "transport-runtime/messages.h"
@@ -278,9 +286,17 @@ namespace transport
 				    //! Merge axes and value data into a single series
 				    void merge_lines(datapipe<number>& pipe, const std::list< data_line<number> >& input, std::deque<double>& axis, std::vector<output_line>& data) const;
 
-						//! Obtain output from our lines
+						//! Obtain output from our lines; if 'memoize' is set, lines are reused from (and stored in)
+						//! the derived-line cache where possible. Lines which evaluate the model are always derived afresh.
+						//! If 'threads' is larger than one, lines are shared among a pool of threads which each read through
+						//! their own view onto the datapipe; the output is assembled in the same order as the lines
 				    void obtain_output(datapipe<number>& pipe, const std::list<std::string>& tags,
-                               std::list< data_line<number> >& derived_lines, slave_message_buffer& messages) const;
+                               std::list< data_line<number> >& derived_lines, slave_message_buffer& messages,
+                               bool memoize, unsigned int threads=1) const;
+
+						//! Obtain output from a single line
+						void obtain_line_output(datapipe<number>& pipe, const derived_line<number>& line, const std::list<std::string>& tags,
+						                        std::list< data_line<number> >& derived_lines, slave_message_buffer& messages, bool memoize) const;
 
 
             // DERIVED PRODUCTS -- AGGREGATE CONSTITUENT TASKS -- implements a 'derived_product' interface
@@ -446,12 +462,145 @@ namespace transport
 
 		    template <typename number>
 		    void line_collection<number>::obtain_output(datapipe<number>& pipe, const std::list<std::string>& tags,
-                                                    std::list< data_line<number> >& derived_lines, slave_message_buffer& messages) const
+                                                    std::list< data_line<number> >& derived_lines, slave_message_buffer& messages,
+                                                    bool memoize, unsigned int threads) const
 			    {
+            // index lines so that threads can claim them by position
+            std::vector< const derived_line<number>* > work;
+            work.reserve(this->lines.size());
             for(const std::unique_ptr< derived_line<number> >& line : this->lines)
-			        {
-		            line->derive_lines(pipe, derived_lines, tags, messages);
-			        }
+              {
+                work.push_back(line.get());
+              }
+
+            // each line derives into its own list, so the output can be assembled in order whichever thread derives it
+            std::vector< std::list< data_line<number> > > outputs(work.size());
+
+            unsigned int pool_size = static_cast<unsigned int>(std::min(static_cast<size_t>(threads), work.size()));
+
+            if(pool_size <= 1)
+              {
+                for(size_t n = 0; n < work.size(); ++n)
+                  {
+                    this->obtain_line_output(pipe, *work[n], tags, outputs[n], messages, memoize);
+                  }
+              }
+            else
+              {
+                // each thread reads through its own view; the views share lines through a common cache, and
+                // split the capacity of the parent's private cache between them
+                std::vector< std::unique_ptr< datapipe<number> > > views;
+                views.reserve(pool_size);
+                for(unsigned int i = 0; i < pool_size; ++i)
+                  {
+                    views.push_back(pipe.new_view(pipe.get_capacity() / pool_size));
+                  }
+
+                BOOST_LOG_SEV(pipe.get_log(), datapipe<number>::log_severity_level::normal) << "** Deriving " << work.size() << " lines using " << pool_size << " threads";
+
+                std::atomic<size_t> next(0);
+                std::exception_ptr error;
+                std::mutex error_mutex;
+
+                auto worker = [&](datapipe<number>& view) -> void
+                  {
+                    size_t n;
+                    while((n = next++) < work.size())
+                      {
+                        try
+                          {
+                            this->obtain_line_output(view, *work[n], tags, outputs[n], messages, memoize);
+                          }
+                        catch(...)
+                          {
+                            std::lock_guard<std::mutex> lock(error_mutex);
+                            if(!error) error = std::current_exception();
+                            next = work.size();
+                          }
+                      }
+                  };
+
+                std::vector<std::thread> pool;
+                pool.reserve(pool_size);
+                for(unsigned int i = 0; i < pool_size; ++i)
+                  {
+                    pool.emplace_back(worker, std::ref(*views[i]));
+                  }
+
+                for(std::thread& t : pool)
+                  {
+                    t.join();
+                  }
+
+                if(error) std::rethrow_exception(error);
+              }
+
+            for(std::list< data_line<number> >& output : outputs)
+              {
+                derived_lines.splice(derived_lines.end(), output);
+              }
+			    }
+
+
+		    template <typename number>
+		    void line_collection<number>::obtain_line_output(datapipe<number>& pipe, const derived_line<number>& line, const std::list<std::string>& tags,
+		                                                     std::list< data_line<number> >& derived_lines, slave_message_buffer& messages, bool memoize) const
+			    {
+            // generated model code is not re-entrant, so lines which evaluate the model are derived one at a time
+            std::unique_lock<std::mutex> model_lock(pipe.get_model_mutex(), std::defer_lock);
+            if(line.evaluates_model()) model_lock.lock();
+
+            // a rebuilt model keeps its identity, so lines which evaluate it are never memoized
+            if(!memoize || line.evaluates_model())
+              {
+                line.derive_lines(pipe, derived_lines, tags, messages);
+                return;
+              }
+
+            derived_line_cache<number> cache(pipe, line, tags);
+            size_t count = derived_lines.size();
+            if(cache.load(derived_lines, messages))
+              {
+                BOOST_LOG_SEV(pipe.get_log(), datapipe<number>::log_severity_level::normal) << "** Reused " << derived_lines.size() - count << " cached data lines";
+                return;
+              }
+
+            // if this line's content group was seeded, lines stored for the seed group need only be extended
+            // with those for k-configurations added since; the reused lines retain the seed group as their parent
+            std::list< data_line<number> > old_lines;
+            std::set<unsigned int> covered;
+            bool extend = line.is_incremental() && cache.load_seed(old_lines, covered, messages);
+            if(!extend)
+              {
+                old_lines.clear();
+                covered.clear();
+              }
+
+            // derive into a separate list, so that only this line's output is stored
+            std::list< data_line<number> > new_lines;
+            pipe.begin_kconfig_tracking(covered);
+            try
+              {
+                line.derive_lines(pipe, new_lines, tags, messages);
+              }
+            catch(...)
+              {
+                pipe.end_kconfig_tracking();
+                throw;
+              }
+            std::set<unsigned int> used = pipe.end_kconfig_tracking();
+
+            if(extend)
+              {
+                BOOST_LOG_SEV(pipe.get_log(), datapipe<number>::log_severity_level::normal)
+                  << "** Reused " << old_lines.size() << " data lines from seed content group; derived " << new_lines.size()
+                  << " data lines for " << used.size() << " new k-configurations";
+                used.insert(covered.begin(), covered.end());
+              }
+
+            old_lines.splice(old_lines.end(), new_lines);
+            cache.store(old_lines, used);
+            derived_lines.splice(derived_lines.end(), old_lines);
 			    }
 
 
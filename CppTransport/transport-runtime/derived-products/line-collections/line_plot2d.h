@@ -35,6 +35,7 @@
 
 #include "transport-runtime/derived-products/line-collections/line_collection.h"
 #include "transport-runtime/derived-products/line-collections/data_line.h"
+#include "transport-runtime/derived-products/line-collections/plot_renderer.h"
 
 #include "transport-runtime/utilities/plot_environment.h"
 
@@ -195,6 +196,11 @@ namespace transport
 				                   const typename std::vector< std::vector< typename line_collection<number>::output_line > >& data_bins,
 				                   const std::vector< value_type >& bin_types, local_environment& env, argument_cache& args) const;
 
+				    //! Render plot in-process, without generating a Matplotlib script
+				    bool render_plot(const boost::filesystem::path& plot_file, const std::deque<double>& axis,
+				                     const typename std::vector< std::vector< typename line_collection<number>::output_line > >& data_bins,
+				                     const std::vector< value_type >& bin_types) const;
+
 
 		        // GET AND SET BASIC PLOT ATTRIBUTES
 
@@ -459,7 +465,7 @@ namespace transport
 
 						// generate output from our constituent lines
 				    std::list< data_line<number> > derived_lines;
-						this->obtain_output(pipe, tags, derived_lines, messages);
+						this->obtain_output(pipe, tags, derived_lines, messages, args.get_derived_line_cache(), args.get_output_threads());
 
 						// merge this output onto a single axis
 						// this turns our collection of data_lines into a collection of output_lines.
@@ -561,6 +567,16 @@ namespace transport
 				    // obtain path for plot output
 				    boost::filesystem::path plot_file = temp_root / this->filename;
 
+				    // formats supported by the native renderer don't need a Python interpreter;
+				    // everything else, including export of the script itself, goes via Matplotlib.
+				    // The native renderer only reproduces Matplotlib's default style and has no TeX engine,
+				    // so a non-default --plot-style or LaTeX typesetting also goes via Matplotlib
+				    if(args.get_plot_renderer() == plot_renderer_type::native && plot_renderer::supports(plot_file)
+				       && args.get_plot_environment() == plot_style::raw_matplotlib && !this->typeset_with_LaTeX)
+					    {
+				        return(this->render_plot(plot_file, axis, data_bins, bin_types));
+					    }
+
 				    boost::filesystem::path script_file = plot_file;
 						if(script_file.extension() != ".py")
 							{
@@ -808,6 +824,74 @@ namespace transport
 					}
 
 
+				template <typename number>
+				bool line_plot2d<number>::render_plot(const boost::filesystem::path& plot_file, const std::deque<double>& axis,
+				                                      const typename std::vector< std::vector< typename line_collection<number>::output_line > >& data_bins,
+				                                      const std::vector< value_type >& bin_types) const
+					{
+				    plot_renderer renderer;
+
+				    renderer.set_log_axes(this->log_x, this->log_y)
+				            .set_reverse_axes(this->reverse_x, this->reverse_y)
+				            .set_dash_second_axis(this->dash_second_axis)
+				            .set_legend(this->legend, this->position);
+
+				    // as for the Matplotlib backend, only the first two bins are given their own axes;
+				    // lines in later bins share the second axis
+				    unsigned int bin = 0;
+				    for(typename std::vector< std::vector< typename line_collection<number>::output_line > >::const_iterator t = data_bins.begin(); t != data_bins.end(); ++t, ++bin)
+					    {
+				        for(typename std::vector< typename line_collection<number>::output_line >::const_iterator u = t->begin(); u != t->end(); ++u)
+					        {
+				            plot_renderer::series s;
+				            s.label       = u->get_label();
+				            s.scattered   = u->get_data_line_type() == data_line_type::scattered_data;
+				            s.second_axis = bin > 0;
+
+				            const std::deque< typename line_collection<number>::output_value >& line_data = u->get_values();
+				            assert(line_data.size() == axis.size());
+
+				            std::deque<double>::const_iterator x = axis.begin();
+				            for(typename std::deque< typename line_collection<number>::output_value >::const_iterator w = line_data.begin(); w != line_data.end() && x != axis.end(); ++w, ++x)
+					            {
+				                if(w->is_present()) s.points.emplace_back(*x, static_cast<double>(w->format_number()));
+					            }
+
+				            renderer.add_series(std::move(s));
+					        }
+					    }
+
+				    if(this->x_label) renderer.set_x_label(this->x_label_text);
+
+				    if(this->y_label)
+					    {
+				        if(this->y_label_text.length() > 0)
+					        {
+				            renderer.set_y_label(0, this->y_label_text);
+					        }
+				        else
+					        {
+				            unsigned int i = 0;
+				            for(std::vector<value_type>::const_iterator w = bin_types.begin(); w != bin_types.end() && i < 2; ++w, ++i)
+					            {
+				                renderer.set_y_label(i, this->use_LaTeX ? value_type_to_string_LaTeX(*w) : value_type_to_string_non_LaTeX(*w));
+					            }
+					        }
+					    }
+
+				    if(this->title) renderer.set_title(this->title_text);
+
+				    if(!renderer.write(plot_file))
+					    {
+				        std::ostringstream msg;
+				        msg << CPPTRANSPORT_DERIVED_PRODUCT_FAILED << " " << plot_file;
+				        throw runtime_exception(exception_type::DERIVED_PRODUCT_ERROR, msg.str());
+					    }
+
+				    return(true);
+					}
+
+
 		    template <typename number>
 		    void line_plot2d<number>::serialize(Json::Value& writer) const
 			    {
@@ -0,0 +1,1336 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+
+#ifndef CPPTRANSPORT_PLOT_RENDERER_H
+#define CPPTRANSPORT_PLOT_RENDERER_H
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "transport-runtime/derived-products/enumerations.h"
+
+#include "boost/filesystem/operations.hpp"
+#include "boost/algorithm/string.hpp"
+
+
+namespace transport
+  {
+
+    namespace derived_data
+      {
+
+        namespace plot_renderer_impl
+          {
+
+            // figure dimensions in points; these match Matplotlib's default 6.4in x 4.8in figure
+            constexpr double figure_width  = 460.8;
+            constexpr double figure_height = 345.6;
+
+            // position of the axes box as fractions of the figure, again matching Matplotlib's defaults
+            constexpr double axes_left   = 0.125;
+            constexpr double axes_right  = 0.9;
+            constexpr double axes_bottom = 0.11;
+            constexpr double axes_top    = 0.88;
+
+            constexpr double label_size  = 10.0;
+            constexpr double title_size  = 12.0;
+            constexpr double tick_length = 3.5;
+            constexpr double line_width  = 1.5;
+            constexpr double marker_size = 3.0;   // radius
+
+            // relative size and vertical offset of superscripts and subscripts
+            constexpr double script_scale = 0.7;
+            constexpr double script_rise  = 0.35;
+
+            // fraction of the data range added as a margin on linear axes
+            constexpr double axis_margin = 0.05;
+
+            // Matplotlib's default colour cycle
+            constexpr const char* palette[] = { "#1f77b4", "#ff7f0e", "#2ca02c", "#d62728", "#9467bd",
+                                                "#8c564b", "#e377c2", "#7f7f7f", "#bcbd22", "#17becf" };
+            constexpr unsigned int palette_size = 10;
+
+            // Helvetica advance widths for printable ASCII, in thousandths of an em
+            constexpr unsigned short helvetica_widths[95] =
+              {
+                278, 278, 355, 556, 556, 889, 667, 191, 333, 333, 389, 584, 278, 333, 278, 278,     // space to /
+                556, 556, 556, 556, 556, 556, 556, 556, 556, 556, 278, 278, 584, 584, 584, 556,     // 0 to ?
+                1015, 667, 667, 722, 722, 667, 611, 778, 722, 278, 500, 667, 556, 833, 722, 778,   // @ to O
+                667, 778, 722, 667, 611, 722, 667, 944, 667, 667, 611, 278, 278, 278, 469, 556,     // P to _
+                333, 556, 556, 500, 556, 556, 278, 556, 556, 222, 222, 500, 222, 833, 556, 556,     // ` to o
+                556, 556, 333, 500, 278, 556, 500, 722, 500, 500, 500, 334, 260, 334, 584           // p to ~
+              };
+
+            // approximate width of characters set in the Symbol font, or not covered by the table above
+            constexpr unsigned short default_width = 600;
+
+
+            //! a LaTeX command which maps to a single glyph.
+            //! 'utf8' is used for SVG output; 'symbol' is the corresponding character in the PDF Symbol font
+            struct glyph
+              {
+                const char* name;
+                const char* utf8;
+                unsigned char symbol;
+              };
+
+            constexpr glyph glyph_table[] =
+              {
+                { "alpha", "α", 'a' },       { "beta", "β", 'b' },        { "gamma", "γ", 'g' },
+                { "delta", "δ", 'd' },       { "epsilon", "ε", 'e' },     { "varepsilon", "ε", 'e' },
+                { "zeta", "ζ", 'z' },        { "eta", "η", 'h' },         { "theta", "θ", 'q' },
+                { "vartheta", "ϑ", 'J' },    { "iota", "ι", 'i' },        { "kappa", "κ", 'k' },
+                { "lambda", "λ", 'l' },      { "mu", "μ", 'm' },          { "nu", "ν", 'n' },
+                { "xi", "ξ", 'x' },          { "pi", "π", 'p' },          { "varpi", "ϖ", 'v' },
+                { "rho", "ρ", 'r' },         { "sigma", "σ", 's' },       { "varsigma", "ς", 'V' },
+                { "tau", "τ", 't' },         { "upsilon", "υ", 'u' },     { "phi", "φ", 'f' },
+                { "varphi", "ϕ", 'j' },      { "chi", "χ", 'c' },         { "psi", "ψ", 'y' },
+                { "omega", "ω", 'w' },       { "Gamma", "Γ", 'G' },       { "Delta", "Δ", 'D' },
+                { "Theta", "Θ", 'Q' },       { "Lambda", "Λ", 'L' },      { "Xi", "Ξ", 'X' },
+                { "Pi", "Π", 'P' },          { "Sigma", "Σ", 'S' },       { "Upsilon", "Υ", 0xa1 },
+                { "Phi", "Φ", 'F' },         { "Psi", "Ψ", 'Y' },         { "Omega", "Ω", 'W' },
+                { "langle", "⟨", 0xe1 },     { "rangle", "⟩", 0xf1 },     { "partial", "∂", 0xb6 },
+                { "times", "×", 0xb4 },      { "cdot", "⋅", 0xd7 },       { "pm", "±", 0xb1 },
+                { "infty", "∞", 0xa5 },      { "sim", "∼", 0x7e },        { "approx", "≈", 0xbb },
+                { "leq", "≤", 0xa3 },        { "le", "≤", 0xa3 },         { "geq", "≥", 0xb3 },
+                { "ge", "≥", 0xb3 },         { "neq", "≠", 0xb9 },        { "prime", "′", 0xa2 },
+                { "nabla", "∇", 0xd1 },      { "sum", "∑", 0xe5 },        { "int", "∫", 0xf2 },
+                { "to", "→", 0xae },         { "rightarrow", "→", 0xae }, { "leftarrow", "←", 0xac },
+                { "propto", "∝", 0xb5 },     { "sqrt", "√", 0xd6 }
+              };
+
+
+            //! a run of text set in a single font at a single script level
+            struct text_run
+              {
+                //! text encoded as UTF-8, for SVG output
+                std::string utf8;
+
+                //! text encoded for the PDF font: WinAnsi for Helvetica, or the Symbol font encoding
+                std::string pdf;
+
+                //! set in the Symbol font?
+                bool symbol;
+
+                //! script level: 0 for normal text, positive for superscripts, negative for subscripts
+                int level;
+
+                //! width in ems at unit scale
+                double width;
+              };
+
+
+            //! plot_text converts a LaTeX-style label into runs of text which can be set without a TeX installation.
+            //! Greek letters and common symbols are mapped to glyphs, superscripts and subscripts are raised and lowered,
+            //! and font-selection commands such as \mathrm are dropped in favour of their contents.
+            //! This covers the labels generated by CppTransport; anything else is set as literal text
+            class plot_text
+              {
+
+                // CONSTRUCTOR, DESTRUCTOR
+
+              public:
+
+                //! constructor parses a label
+                plot_text(const std::string& label);
+
+                //! destructor is default
+                ~plot_text() = default;
+
+
+                // INTERFACE
+
+              public:
+
+                //! get runs
+                const std::vector<text_run>& get_runs() const { return(this->runs); }
+
+                //! is the text empty?
+                bool empty() const { return(this->runs.empty()); }
+
+                //! get width when set at a given size
+                double width(double size) const;
+
+                //! scale factor for a script level
+                static double scale(int level) { return(level == 0 ? 1.0 : std::pow(script_scale, std::abs(level))); }
+
+                //! vertical offset for a script level, in units of the base size; positive is upwards
+                static double rise(int level);
+
+
+                // INTERNAL API
+
+              protected:
+
+                //! parse until end of input, or a closing brace if 'group' is set
+                void parse_group(int level, bool group);
+
+                //! parse a single atom: a character, a command, or a braced group
+                void parse_atom(int level);
+
+                //! parse a command, with the cursor positioned after the backslash
+                void parse_command(int level);
+
+                //! parse a single literal character, which may be a multi-byte UTF-8 sequence
+                void parse_character(int level);
+
+                //! append text in the normal font
+                void emit_text(const std::string& utf8, const std::string& pdf, int level);
+
+                //! append a glyph in the Symbol font
+                void emit_symbol(const std::string& utf8, unsigned char code, int level);
+
+                //! append to the current run, or start a new one
+                void emit(const std::string& utf8, const std::string& pdf, bool symbol, int level, double width);
+
+
+                // INTERNAL DATA
+
+              private:
+
+                //! label being parsed
+                const std::string source;
+
+                //! parse cursor
+                size_t pos;
+
+                //! inside $...$?
+                bool math;
+
+                //! parsed runs
+                std::vector<text_run> runs;
+
+              };
+
+
+            plot_text::plot_text(const std::string& label)
+              : source(label),
+                pos(0),
+                math(false)
+              {
+                this->parse_group(0, false);
+              }
+
+
+            double plot_text::rise(int level)
+              {
+                double r = 0.0;
+                for(int i = 0; i < std::abs(level); ++i)
+                  {
+                    r += script_rise * scale(i);
+                  }
+                return(level >= 0 ? r : -r);
+              }
+
+
+            double plot_text::width(double size) const
+              {
+                double w = 0.0;
+                for(const text_run& run : this->runs)
+                  {
+                    w += run.width * size * scale(run.level);
+                  }
+                return(w);
+              }
+
+
+            void plot_text::parse_group(int level, bool group)
+              {
+                while(this->pos < this->source.length())
+                  {
+                    char c = this->source[this->pos];
+
+                    if(c == '}')
+                      {
+                        ++this->pos;
+                        if(group) return;
+                      }
+                    else if(c == '$')
+                      {
+                        this->math = !this->math;
+                        ++this->pos;
+                      }
+                    else if(c == '^' || c == '_')
+                      {
+                        ++this->pos;
+                        int new_level = std::max(-2, std::min(2, level + (c == '^' ? 1 : -1)));
+                        this->parse_atom(new_level);
+                      }
+                    else
+                      {
+                        this->parse_atom(level);
+                      }
+                  }
+              }
+
+
+            void plot_text::parse_atom(int level)
+              {
+                // spaces are not significant in math mode
+                while(this->math && this->pos < this->source.length() && this->source[this->pos] == ' ') ++this->pos;
+                if(this->pos >= this->source.length()) return;
+
+                char c = this->source[this->pos];
+
+                if(c == '{')
+                  {
+                    ++this->pos;
+                    this->parse_group(level, true);
+                  }
+                else if(c == '\\')
+                  {
+                    ++this->pos;
+                    this->parse_command(level);
+                  }
+                else if(c == '$' || c == '}' || c == '^' || c == '_')
+                  {
+                    // structural characters are handled by parse_group
+                    this->parse_group(level, false);
+                  }
+                else
+                  {
+                    this->parse_character(level);
+                  }
+              }
+
+
+            void plot_text::parse_command(int level)
+              {
+                if(this->pos >= this->source.length()) return;
+
+                // control symbols: spacing, or an escaped literal
+                if(!std::isalpha(static_cast<unsigned char>(this->source[this->pos])))
+                  {
+                    char c = this->source[this->pos++];
+                    switch(c)
+                      {
+                        case ',':
+                        case ';':
+                        case ':':
+                        case ' ':
+                          this->emit_text(" ", " ", level);
+                          break;
+
+                        case '!':
+                          break;
+
+                        default:
+                          this->emit_text(std::string(1, c), std::string(1, c), level);
+                          break;
+                      }
+                    return;
+                  }
+
+                size_t start = this->pos;
+                while(this->pos < this->source.length() && std::isalpha(static_cast<unsigned char>(this->source[this->pos]))) ++this->pos;
+                std::string name = this->source.substr(start, this->pos - start);
+
+                for(const glyph& g : glyph_table)
+                  {
+                    if(name == g.name)
+                      {
+                        this->emit_symbol(g.utf8, g.symbol, level);
+                        if(name == "sqrt") this->parse_atom(level);
+                        return;
+                      }
+                  }
+
+                if(name == "mathrm" || name == "mathcal" || name == "mathbf" || name == "mathit" || name == "mathsf"
+                   || name == "text" || name == "textrm" || name == "textit" || name == "textbf" || name == "boldsymbol"
+                   || name == "operatorname")
+                  {
+                    // set the argument as text; spaces inside \text{...} are significant
+                    bool was_math = this->math;
+                    if(name.compare(0, 4, "text") == 0) this->math = false;
+                    this->parse_atom(level);
+                    this->math = was_math;
+                  }
+                else if(name == "rm" || name == "it" || name == "bf" || name == "cal" || name == "displaystyle"
+                        || name == "big" || name == "Big" || name == "bigg" || name == "Bigg" || name == "right")
+                  {
+                    // no visible output
+                  }
+                else if(name == "left")
+                  {
+                    // \left. produces no delimiter
+                    if(this->pos < this->source.length() && this->source[this->pos] == '.') ++this->pos;
+                  }
+                else if(name == "frac")
+                  {
+                    this->parse_atom(level);
+                    this->emit_text("/", "/", level);
+                    this->parse_atom(level);
+                  }
+                else if(name == "dot" || name == "ddot")
+                  {
+                    // set the base, then mark the derivative with raised dots
+                    this->parse_atom(level);
+                    std::string dots = name == "dot" ? "˙" : "¨";
+                    this->emit_text(dots, name == "dot" ? "\xb7" : "\xb7\xb7", std::min(2, level+1));
+                  }
+                else if(name == "bar" || name == "hat" || name == "tilde" || name == "vec" || name == "overline")
+                  {
+                    // accents are dropped
+                    this->parse_atom(level);
+                  }
+                else if(name == "quad" || name == "qquad")
+                  {
+                    this->emit_text("  ", "  ", level);
+                  }
+                else
+                  {
+                    // unknown command; set its name
+                    this->emit_text(name, name, level);
+                  }
+              }
+
+
+            void plot_text::parse_character(int level)
+              {
+                unsigned char c = static_cast<unsigned char>(this->source[this->pos]);
+
+                if(c < 0x80)
+                  {
+                    ++this->pos;
+                    if(c == '~') this->emit_text(" ", " ", level);
+                    else         this->emit_text(std::string(1, static_cast<char>(c)), std::string(1, static_cast<char>(c)), level);
+                    return;
+                  }
+
+                // decode a UTF-8 sequence
+                size_t length = c >= 0xf0 ? 4 : c >= 0xe0 ? 3 : c >= 0xc0 ? 2 : 1;
+                length = std::min(length, this->source.length() - this->pos);
+                std::string utf8 = this->source.substr(this->pos, length);
+                this->pos += length;
+
+                unsigned int code = length == 1 ? c : (c & (0xff >> (length+1)));
+                for(size_t i = 1; i < length; ++i)
+                  {
+                    code = (code << 6) | (static_cast<unsigned char>(utf8[i]) & 0x3f);
+                  }
+
+                // Greek letters and symbols which are in the glyph table are set in the Symbol font
+                for(const glyph& g : glyph_table)
+                  {
+                    if(utf8 == g.utf8)
+                      {
+                        this->emit_symbol(utf8, g.symbol, level);
+                        return;
+                      }
+                  }
+
+                // WinAnsi coincides with Latin-1 in the upper half of the code page
+                std::string pdf = code >= 0xa0 && code <= 0xff ? std::string(1, static_cast<char>(code)) : std::string("?");
+                this->emit_text(utf8, pdf, level);
+              }
+
+
+            void plot_text::emit_text(const std::string& utf8, const std::string& pdf, int level)
+              {
+                double w = 0.0;
+                for(char c : pdf)
+                  {
+                    unsigned char u = static_cast<unsigned char>(c);
+                    w += (u >= 32 && u < 127 ? helvetica_widths[u - 32] : default_width) / 1000.0;
+                  }
+                this->emit(utf8, pdf, false, level, w);
+              }
+
+
+            void plot_text::emit_symbol(const std::string& utf8, unsigned char code, int level)
+              {
+                this->emit(utf8, std::string(1, static_cast<char>(code)), true, level, default_width / 1000.0);
+              }
+
+
+            void plot_text::emit(const std::string& utf8, const std::string& pdf, bool symbol, int level, double width)
+              {
+                if(this->runs.empty() || this->runs.back().symbol != symbol || this->runs.back().level != level)
+                  {
+                    this->runs.push_back(text_run{ std::string(), std::string(), symbol, level, 0.0 });
+                  }
+
+                text_run& run = this->runs.back();
+                run.utf8 += utf8;
+                run.pdf += pdf;
+                run.width += width;
+              }
+
+
+            //! horizontal alignment of text relative to its anchor point
+            enum class text_anchor { start, middle, end };
+
+            //! a point in figure coordinates, measured in points from the top-left corner
+            typedef std::pair<double, double> point;
+
+
+            //! canvas is the drawing interface implemented by each output format.
+            //! Coordinates are in points, measured from the top-left corner of the figure
+            class canvas
+              {
+
+              public:
+
+                virtual ~canvas() = default;
+
+                //! set clipping rectangle used by clipped drawing operations
+                virtual void set_clip(double x0, double y0, double x1, double y1) = 0;
+
+                //! draw a polyline
+                virtual void polyline(const std::vector<point>& points, const std::string& colour, double width, bool dashed, bool clip) = 0;
+
+                //! draw filled circular markers; always clipped
+                virtual void markers(const std::vector<point>& points, const std::string& colour, double radius) = 0;
+
+                //! set text with its baseline at y; if 'vertical' is set the text reads upwards, and x, y is the anchor
+                virtual void text(double x, double y, const plot_text& t, double size, text_anchor anchor, bool vertical) = 0;
+
+              };
+
+
+            //! format a coordinate for output; the classic locale ensures a decimal point is used
+            inline std::string coord(double v)
+              {
+                std::ostringstream out;
+                out.imbue(std::locale::classic());
+                out << std::fixed << std::setprecision(2) << v;
+                return(out.str());
+              }
+
+
+            //! escape text for inclusion in XML
+            inline std::string xml_escape(const std::string& s)
+              {
+                std::string out;
+                for(char c : s)
+                  {
+                    switch(c)
+                      {
+                        case '&':  out += "&amp;"; break;
+                        case '<':  out += "&lt;"; break;
+                        case '>':  out += "&gt;"; break;
+                        case '"':  out += "&quot;"; break;
+                        default:   out += c; break;
+                      }
+                  }
+                return(out);
+              }
+
+
+            //! escape text for inclusion in a PDF string
+            inline std::string pdf_escape(const std::string& s)
+              {
+                std::string out;
+                for(char c : s)
+                  {
+                    if(c == '(' || c == ')' || c == '\\') out += '\\';
+                    out += c;
+                  }
+                return(out);
+              }
+
+
+            //! svg_canvas writes an SVG document
+            class svg_canvas: public canvas
+              {
+
+              public:
+
+                svg_canvas(std::ostream& o, double w, double h);
+
+                ~svg_canvas();
+
+                void set_clip(double x0, double y0, double x1, double y1) override;
+
+                void polyline(const std::vector<point>& points, const std::string& colour, double width, bool dashed, bool clip) override;
+
+                void markers(const std::vector<point>& points, const std::string& colour, double radius) override;
+
+                void text(double x, double y, const plot_text& t, double size, text_anchor anchor, bool vertical) override;
+
+              private:
+
+                //! output stream
+                std::ostream& out;
+
+              };
+
+
+            svg_canvas::svg_canvas(std::ostream& o, double w, double h)
+              : out(o)
+              {
+                out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>" << '\n';
+                out << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" width=\"" << coord(w) << "pt\" height=\"" << coord(h) << "pt\""
+                    << " viewBox=\"0 0 " << coord(w) << " " << coord(h) << "\">" << '\n';
+                out << "<rect width=\"100%\" height=\"100%\" fill=\"#ffffff\"/>" << '\n';
+              }
+
+
+            svg_canvas::~svg_canvas()
+              {
+                out << "</svg>" << '\n';
+              }
+
+
+            void svg_canvas::set_clip(double x0, double y0, double x1, double y1)
+              {
+                out << "<defs><clipPath id=\"axes\"><rect x=\"" << coord(x0) << "\" y=\"" << coord(y0) << "\" width=\"" << coord(x1-x0)
+                    << "\" height=\"" << coord(y1-y0) << "\"/></clipPath></defs>" << '\n';
+              }
+
+
+            void svg_canvas::polyline(const std::vector<point>& points, const std::string& colour, double width, bool dashed, bool clip)
+              {
+                if(points.size() < 2) return;
+
+                out << "<polyline fill=\"none\" stroke=\"" << colour << "\" stroke-width=\"" << coord(width) << "\" stroke-linejoin=\"round\"";
+                if(dashed) out << " stroke-dasharray=\"5.55,2.4\"";
+                if(clip) out << " clip-path=\"url(#axes)\"";
+                out << " points=\"";
+                for(const point& p : points)
+                  {
+                    out << coord(p.first) << "," << coord(p.second) << " ";
+                  }
+                out << "\"/>" << '\n';
+              }
+
+
+            void svg_canvas::markers(const std::vector<point>& points, const std::string& colour, double radius)
+              {
+                if(points.empty()) return;
+
+                out << "<g fill=\"" << colour << "\" clip-path=\"url(#axes)\">" << '\n';
+                for(const point& p : points)
+                  {
+                    out << "<circle cx=\"" << coord(p.first) << "\" cy=\"" << coord(p.second) << "\" r=\"" << coord(radius) << "\"/>" << '\n';
+                  }
+                out << "</g>" << '\n';
+              }
+
+
+            void svg_canvas::text(double x, double y, const plot_text& t, double size, text_anchor anchor, bool vertical)
+              {
+                if(t.empty()) return;
+
+                out << "<text x=\"" << coord(x) << "\" y=\"" << coord(y) << "\" font-family=\"DejaVu Sans, Helvetica, Arial, sans-serif\" font-size=\"" << coord(size) << "\"";
+                switch(anchor)
+                  {
+                    case text_anchor::start:  break;
+                    case text_anchor::middle: out << " text-anchor=\"middle\""; break;
+                    case text_anchor::end:    out << " text-anchor=\"end\""; break;
+                  }
+                if(vertical) out << " transform=\"rotate(-90 " << coord(x) << " " << coord(y) << ")\"";
+                out << ">";
+
+                // scripts are positioned using relative shifts, which are more widely supported than baseline-shift
+                double current_rise = 0.0;
+                for(const text_run& run : t.get_runs())
+                  {
+                    double r = plot_text::rise(run.level) * size;
+                    out << "<tspan font-size=\"" << coord(size * plot_text::scale(run.level)) << "\"";
+                    if(r != current_rise) out << " dy=\"" << coord(current_rise - r) << "\"";
+                    out << ">" << xml_escape(run.utf8) << "</tspan>";
+                    current_rise = r;
+                  }
+
+                out << "</text>" << '\n';
+              }
+
+
+            //! pdf_canvas accumulates a PDF content stream, and writes a complete single-page document on destruction.
+            //! Only the standard Helvetica and Symbol fonts are used, so no fonts need to be embedded
+            class pdf_canvas: public canvas
+              {
+
+              public:
+
+                pdf_canvas(std::ostream& o, double w, double h);
+
+                ~pdf_canvas();
+
+                void set_clip(double x0, double y0, double x1, double y1) override;
+
+                void polyline(const std::vector<point>& points, const std::string& colour, double width, bool dashed, bool clip) override;
+
+                void markers(const std::vector<point>& points, const std::string& colour, double radius) override;
+
+                void text(double x, double y, const plot_text& t, double size, text_anchor anchor, bool vertical) override;
+
+              protected:
+
+                //! convert a colour of the form #rrggbb to a PDF colour specification
+                static std::string rgb(const std::string& colour);
+
+                //! PDF places the origin at the bottom-left
+                double flip(double y) const { return(this->height - y); }
+
+              private:
+
+                //! output stream
+                std::ostream& out;
+
+                //! page dimensions
+                const double width;
+                const double height;
+
+                //! clipping rectangle, in PDF coordinates
+                std::string clip_rect;
+
+                //! content stream
+                std::ostringstream content;
+
+              };
+
+
+            pdf_canvas::pdf_canvas(std::ostream& o, double w, double h)
+              : out(o),
+                width(w),
+                height(h)
+              {
+                content.imbue(std::locale::classic());
+                content << "1 1 1 rg 0 0 " << coord(w) << " " << coord(h) << " re f" << '\n';
+              }
+
+
+            pdf_canvas::~pdf_canvas()
+              {
+                std::ostringstream doc;
+                doc.imbue(std::locale::classic());
+                std::vector<size_t> offsets;
+
+                std::string stream = this->content.str();
+
+                doc << "%PDF-1.4" << '\n' << "%\xe2\xe3\xcf\xd3" << '\n';
+
+                offsets.push_back(static_cast<size_t>(doc.tellp()));
+                doc << "1 0 obj << /Type /Catalog /Pages 2 0 R >> endobj" << '\n';
+
+                offsets.push_back(static_cast<size_t>(doc.tellp()));
+                doc << "2 0 obj << /Type /Pages /Kids [3 0 R] /Count 1 >> endobj" << '\n';
+
+                offsets.push_back(static_cast<size_t>(doc.tellp()));
+                doc << "3 0 obj << /Type /Page /Parent 2 0 R /MediaBox [0 0 " << coord(this->width) << " " << coord(this->height) << "]"
+                    << " /Resources << /Font << /F1 5 0 R /F2 6 0 R >> >> /Contents 4 0 R >> endobj" << '\n';
+
+                offsets.push_back(static_cast<size_t>(doc.tellp()));
+                doc << "4 0 obj << /Length " << stream.length() << " >>" << '\n' << "stream" << '\n' << stream << "endstream" << '\n' << "endobj" << '\n';
+
+                offsets.push_back(static_cast<size_t>(doc.tellp()));
+                doc << "5 0 obj << /Type /Font /Subtype /Type1 /BaseFont /Helvetica /Encoding /WinAnsiEncoding >> endobj" << '\n';
+
+                offsets.push_back(static_cast<size_t>(doc.tellp()));
+                doc << "6 0 obj << /Type /Font /Subtype /Type1 /BaseFont /Symbol >> endobj" << '\n';
+
+                size_t xref = static_cast<size_t>(doc.tellp());
+                doc << "xref" << '\n' << "0 " << offsets.size()+1 << '\n' << "0000000000 65535 f " << '\n';
+                for(size_t offset : offsets)
+                  {
+                    doc << std::setw(10) << std::setfill('0') << offset << " 00000 n " << '\n';
+                  }
+                doc << "trailer << /Size " << offsets.size()+1 << " /Root 1 0 R >>" << '\n' << "startxref" << '\n' << xref << '\n' << "%%EOF" << '\n';
+
+                this->out << doc.str();
+              }
+
+
+            std::string pdf_canvas::rgb(const std::string& colour)
+              {
+                unsigned int r = 0, g = 0, b = 0;
+                if(colour.length() == 7) std::sscanf(colour.c_str(), "#%02x%02x%02x", &r, &g, &b);
+
+                std::ostringstream spec;
+                spec.imbue(std::locale::classic());
+                spec << std::fixed << std::setprecision(3) << r/255.0 << " " << g/255.0 << " " << b/255.0;
+                return(spec.str());
+              }
+
+
+            void pdf_canvas::set_clip(double x0, double y0, double x1, double y1)
+              {
+                this->clip_rect = coord(x0) + " " + coord(this->flip(y1)) + " " + coord(x1-x0) + " " + coord(y1-y0) + " re W n";
+              }
+
+
+            void pdf_canvas::polyline(const std::vector<point>& points, const std::string& colour, double width, bool dashed, bool clip)
+              {
+                if(points.size() < 2) return;
+
+                content << "q" << '\n';
+                if(clip && !this->clip_rect.empty()) content << this->clip_rect << '\n';
+                content << rgb(colour) << " RG " << coord(width) << " w 1 j 1 J";
+                if(dashed) content << " [5.55 2.4] 0 d";
+                content << '\n';
+
+                bool first = true;
+                for(const point& p : points)
+                  {
+                    content << coord(p.first) << " " << coord(this->flip(p.second)) << (first ? " m" : " l") << '\n';
+                    first = false;
+                  }
+                content << "S" << '\n' << "Q" << '\n';
+              }
+
+
+            void pdf_canvas::markers(const std::vector<point>& points, const std::string& colour, double radius)
+              {
+                if(points.empty()) return;
+
+                // circles are approximated by four Bezier arcs
+                const double k = 0.5523 * radius;
+
+                content << "q" << '\n';
+                if(!this->clip_rect.empty()) content << this->clip_rect << '\n';
+                content << rgb(colour) << " rg" << '\n';
+                for(const point& p : points)
+                  {
+                    double x = p.first;
+                    double y = this->flip(p.second);
+
+                    content << coord(x+radius) << " " << coord(y) << " m "
+                            << coord(x+radius) << " " << coord(y+k) << " " << coord(x+k) << " " << coord(y+radius) << " " << coord(x) << " " << coord(y+radius) << " c "
+                            << coord(x-k) << " " << coord(y+radius) << " " << coord(x-radius) << " " << coord(y+k) << " " << coord(x-radius) << " " << coord(y) << " c "
+                            << coord(x-radius) << " " << coord(y-k) << " " << coord(x-k) << " " << coord(y-radius) << " " << coord(x) << " " << coord(y-radius) << " c "
+                            << coord(x+k) << " " << coord(y-radius) << " " << coord(x+radius) << " " << coord(y-k) << " " << coord(x+radius) << " " << coord(y) << " c f" << '\n';
+                  }
+                content << "Q" << '\n';
+              }
+
+
+            void pdf_canvas::text(double x, double y, const plot_text& t, double size, text_anchor anchor, bool vertical)
+              {
+                if(t.empty()) return;
+
+                // PDF has no notion of text alignment, so offset the start point along the baseline
+                double offset = 0.0;
+                switch(anchor)
+                  {
+                    case text_anchor::start:  break;
+                    case text_anchor::middle: offset = t.width(size) / 2.0; break;
+                    case text_anchor::end:    offset = t.width(size); break;
+                  }
+
+                double px = vertical ? x : x - offset;
+                double py = vertical ? this->flip(y) - offset : this->flip(y);
+
+                content << "BT 0 0 0 rg" << '\n';
+                if(vertical) content << "0 1 -1 0 " << coord(px) << " " << coord(py) << " Tm" << '\n';
+                else         content << "1 0 0 1 " << coord(px) << " " << coord(py) << " Tm" << '\n';
+
+                for(const text_run& run : t.get_runs())
+                  {
+                    content << (run.symbol ? "/F2 " : "/F1 ") << coord(size * plot_text::scale(run.level)) << " Tf "
+                            << coord(plot_text::rise(run.level) * size) << " Ts (" << pdf_escape(run.pdf) << ") Tj" << '\n';
+                  }
+                content << "ET" << '\n';
+              }
+
+
+            //! axis maps data values to figure coordinates, and chooses tick positions
+            class axis
+              {
+
+              public:
+
+                //! constructor; 'lo' and 'hi' are the figure coordinates of the low and high ends of the axis
+                axis(bool lg, bool rev, double lo, double hi)
+                  : log_scale(lg),
+                    reverse(rev),
+                    pos_lo(lo),
+                    pos_hi(hi),
+                    min(std::numeric_limits<double>::max()),
+                    max(-std::numeric_limits<double>::max())
+                  {
+                  }
+
+                //! include a value in the range; values which cannot be shown are ignored
+                void include(double v) { if(this->is_valid(v)) { double t = this->transform(v); this->min = std::min(this->min, t); this->max = std::max(this->max, t); } }
+
+                //! can a value be shown on this axis?
+                bool is_valid(double v) const { return(std::isfinite(v) && (!this->log_scale || v > 0.0)); }
+
+                //! fix the range once all values are included
+                void finalize();
+
+                //! map a value to a figure coordinate
+                double map(double v) const;
+
+                //! get tick positions, as data values
+                std::vector<double> ticks() const;
+
+                //! get tick label
+                std::string tick_label(double v) const;
+
+                //! is this a logarithmic axis?
+                bool is_log() const { return(this->log_scale); }
+
+              protected:
+
+                double transform(double v) const { return(this->log_scale ? std::log10(v) : v); }
+
+              private:
+
+                const bool log_scale;
+                const bool reverse;
+                const double pos_lo;
+                const double pos_hi;
+
+                //! range, in transformed coordinates
+                double min;
+                double max;
+
+              };
+
+
+            void axis::finalize()
+              {
+                if(this->min > this->max)
+                  {
+                    // no data
+                    this->min = 0.0;
+                    this->max = 1.0;
+                  }
+                else if(this->min == this->max)
+                  {
+                    double pad = this->log_scale ? 1.0 : (this->min == 0.0 ? 1.0 : 0.5*std::abs(this->min));
+                    this->min -= pad;
+                    this->max += pad;
+                  }
+
+                double margin = axis_margin * (this->max - this->min);
+                this->min -= margin;
+                this->max += margin;
+              }
+
+
+            double axis::map(double v) const
+              {
+                double f = (this->transform(v) - this->min) / (this->max - this->min);
+                if(this->reverse) f = 1.0 - f;
+                return(this->pos_lo + f * (this->pos_hi - this->pos_lo));
+              }
+
+
+            std::vector<double> axis::ticks() const
+              {
+                std::vector<double> t;
+
+                if(this->log_scale && this->max - this->min >= 1.0)
+                  {
+                    // one tick per decade, thinned if there are too many
+                    double first = std::ceil(this->min);
+                    double last = std::floor(this->max);
+                    double stride = std::max(1.0, std::ceil((last - first + 1.0) / 8.0));
+                    for(double d = first; d <= last; d += stride)
+                      {
+                        t.push_back(std::pow(10.0, d));
+                      }
+                    return(t);
+                  }
+
+                // choose a step of 1, 2 or 5 times a power of ten giving about five ticks
+                double lo = this->log_scale ? std::pow(10.0, this->min) : this->min;
+                double hi = this->log_scale ? std::pow(10.0, this->max) : this->max;
+                double rough = (hi - lo) / 5.0;
+                double magnitude = std::pow(10.0, std::floor(std::log10(rough)));
+                double residual = rough / magnitude;
+                double step = (residual < 1.5 ? 1.0 : residual < 3.0 ? 2.0 : residual < 7.0 ? 5.0 : 10.0) * magnitude;
+
+                for(double v = std::ceil(lo / step) * step; v <= hi + 1E-9*step; v += step)
+                  {
+                    // suppress rounding noise near zero
+                    t.push_back(std::abs(v) < 1E-9*step ? 0.0 : v);
+                  }
+                return(t);
+              }
+
+
+            std::string axis::tick_label(double v) const
+              {
+                std::ostringstream label;
+                label.imbue(std::locale::classic());
+
+                if(this->log_scale && this->max - this->min >= 1.0)
+                  {
+                    label << "$10^{" << static_cast<int>(std::lround(std::log10(v))) << "}$";
+                  }
+                else
+                  {
+                    label << std::setprecision(6) << v;
+                  }
+
+                return(label.str());
+              }
+
+          }   // namespace plot_renderer_impl
+
+
+        //! plot_renderer draws a two-dimensional line plot directly to SVG or PDF, without invoking an external
+        //! plotting package. The layout follows Matplotlib's defaults, so plots look similar whichever renderer is used.
+        //! A plot_renderer has no shared state, so several can be used concurrently from different threads
+        class plot_renderer
+          {
+
+            // ASSOCIATED TYPES
+
+          public:
+
+            //! a line to be plotted
+            struct series
+              {
+                //! data points; points which cannot be shown on the axes are skipped
+                std::vector< std::pair<double, double> > points;
+
+                //! label used in the legend
+                std::string label;
+
+                //! draw markers rather than a line?
+                bool scattered;
+
+                //! plot against the second y-axis?
+                bool second_axis;
+              };
+
+
+            // CONSTRUCTOR, DESTRUCTOR
+
+          public:
+
+            //! constructor
+            plot_renderer()
+              : log_x(false),
+                log_y(false),
+                reverse_x(false),
+                reverse_y(false),
+                dash_second_axis(false),
+                legend(false),
+                position(legend_pos::top_right)
+              {
+              }
+
+            //! destructor is default
+            ~plot_renderer() = default;
+
+
+            // INTERFACE
+
+          public:
+
+            //! add a line
+            void add_series(series s) { this->lines.push_back(std::move(s)); }
+
+            //! set axis scales
+            plot_renderer& set_log_axes(bool x, bool y) { this->log_x = x; this->log_y = y; return(*this); }
+
+            //! set axis directions
+            plot_renderer& set_reverse_axes(bool x, bool y) { this->reverse_x = x; this->reverse_y = y; return(*this); }
+
+            //! set whether lines on the second y-axis are dashed
+            plot_renderer& set_dash_second_axis(bool d) { this->dash_second_axis = d; return(*this); }
+
+            //! set legend
+            plot_renderer& set_legend(bool l, legend_pos p) { this->legend = l; this->position = p; return(*this); }
+
+            //! set x-axis label
+            plot_renderer& set_x_label(const std::string& l) { this->x_label = l; return(*this); }
+
+            //! set label for the first or second y-axis
+            plot_renderer& set_y_label(unsigned int i, const std::string& l) { this->y_label[i > 0 ? 1 : 0] = l; return(*this); }
+
+            //! set title
+            plot_renderer& set_title(const std::string& t) { this->title = t; return(*this); }
+
+            //! can a file be rendered natively? true if its extension is .svg or .pdf
+            static bool supports(const boost::filesystem::path& file);
+
+            //! render to a file, choosing the format from its extension; returns false if the file could not be written
+            bool write(const boost::filesystem::path& file) const;
+
+            //! render as SVG
+            void write_svg(std::ostream& out) const;
+
+            //! render as PDF
+            void write_pdf(std::ostream& out) const;
+
+
+            // INTERNAL API
+
+          protected:
+
+            //! draw the plot on a canvas
+            void render(plot_renderer_impl::canvas& c) const;
+
+            //! draw the legend
+            void render_legend(plot_renderer_impl::canvas& c, double left, double top, double right, double bottom) const;
+
+            //! get the colour used for a line
+            static std::string colour(size_t i) { return(plot_renderer_impl::palette[i % plot_renderer_impl::palette_size]); }
+
+            //! get file extension in lower case
+            static std::string extension(const boost::filesystem::path& file) { return(boost::algorithm::to_lower_copy(file.extension().string())); }
+
+
+            // INTERNAL DATA
+
+          private:
+
+            //! lines to be plotted
+            std::vector<series> lines;
+
+            //! axis settings
+            bool log_x;
+            bool log_y;
+            bool reverse_x;
+            bool reverse_y;
+
+            //! dash lines on second y-axis?
+            bool dash_second_axis;
+
+            //! legend settings
+            bool legend;
+            legend_pos position;
+
+            //! labels
+            std::string x_label;
+            std::string y_label[2];
+            std::string title;
+
+          };
+
+
+        bool plot_renderer::supports(const boost::filesystem::path& file)
+          {
+            std::string ext = extension(file);
+            return(ext == ".svg" || ext == ".pdf");
+          }
+
+
+        bool plot_renderer::write(const boost::filesystem::path& file) const
+          {
+            std::ofstream out(file.string().c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+            if(!out.is_open() || out.fail()) return(false);
+
+            if(extension(file) == ".pdf") this->write_pdf(out);
+            else                          this->write_svg(out);
+
+            out.close();
+            return(!out.fail());
+          }
+
+
+        void plot_renderer::write_svg(std::ostream& out) const
+          {
+            plot_renderer_impl::svg_canvas c(out, plot_renderer_impl::figure_width, plot_renderer_impl::figure_height);
+            this->render(c);
+          }
+
+
+        void plot_renderer::write_pdf(std::ostream& out) const
+          {
+            plot_renderer_impl::pdf_canvas c(out, plot_renderer_impl::figure_width, plot_renderer_impl::figure_height);
+            this->render(c);
+          }
+
+
+        void plot_renderer::render(plot_renderer_impl::canvas& c) const
+          {
+            using namespace plot_renderer_impl;
+
+            const double left   = axes_left * figure_width;
+            const double right  = axes_right * figure_width;
+            const double top    = (1.0 - axes_top) * figure_height;
+            const double bottom = (1.0 - axes_bottom) * figure_height;
+
+            bool have_second = std::any_of(this->lines.begin(), this->lines.end(), [](const series& s) -> bool { return(s.second_axis); });
+
+            axis x(this->log_x, this->reverse_x, left, right);
+            axis y1(this->log_y, this->reverse_y, bottom, top);
+            axis y2(this->log_y, this->reverse_y, bottom, top);
+
+            for(const series& s : this->lines)
+              {
+                axis& y = s.second_axis ? y2 : y1;
+                for(const std::pair<double, double>& p : s.points)
+                  {
+                    if(x.is_valid(p.first) && y.is_valid(p.second))
+                      {
+                        x.include(p.first);
+                        y.include(p.second);
+                      }
+                  }
+              }
+
+            x.finalize();
+            y1.finalize();
+            y2.finalize();
+
+            c.set_clip(left, top, right, bottom);
+
+            // data lines; a point which cannot be shown breaks the line
+            for(size_t i = 0; i < this->lines.size(); ++i)
+              {
+                const series& s = this->lines[i];
+                const axis& y = s.second_axis ? y2 : y1;
+                bool dashed = s.second_axis && this->dash_second_axis;
+
+                std::vector<point> segment;
+                for(const std::pair<double, double>& p : s.points)
+                  {
+                    if(x.is_valid(p.first) && y.is_valid(p.second))
+                      {
+                        segment.emplace_back(x.map(p.first), y.map(p.second));
+                      }
+                    else if(!s.scattered)
+                      {
+                        c.polyline(segment, colour(i), line_width, dashed, true);
+                        segment.clear();
+                      }
+                  }
+
+                if(s.scattered) c.markers(segment, colour(i), marker_size);
+                else            c.polyline(segment, colour(i), line_width, dashed, true);
+              }
+
+            // axes box
+            c.polyline({ point(left, top), point(right, top), point(right, bottom), point(left, bottom), point(left, top) }, "#000000", 0.8, false, false);
+
+            // ticks and tick labels
+            for(double t : x.ticks())
+              {
+                double px = x.map(t);
+                if(px < left - 0.5 || px > right + 0.5) continue;
+                c.polyline({ point(px, bottom), point(px, bottom + tick_length) }, "#000000", 0.8, false, false);
+                c.text(px, bottom + tick_length + 3.5 + label_size, plot_text(x.tick_label(t)), label_size, text_anchor::middle, false);
+              }
+
+            for(unsigned int a = 0; a < (have_second ? 2 : 1); ++a)
+              {
+                const axis& y = a == 0 ? y1 : y2;
+                double edge = a == 0 ? left : right;
+                double dir = a == 0 ? -1.0 : 1.0;
+
+                for(double t : y.ticks())
+                  {
+                    double py = y.map(t);
+                    if(py < top - 0.5 || py > bottom + 0.5) continue;
+                    c.polyline({ point(edge, py), point(edge + dir*tick_length, py) }, "#000000", 0.8, false, false);
+                    c.text(edge + dir*(tick_length + 3.5), py + 0.35*label_size, plot_text(y.tick_label(t)), label_size,
+                           a == 0 ? text_anchor::end : text_anchor::start, false);
+                  }
+              }
+
+            // axis labels and title
+            if(!this->x_label.empty())
+              {
+                c.text(0.5*(left + right), bottom + tick_length + 3.5 + 2.6*label_size, plot_text(this->x_label), label_size, text_anchor::middle, false);
+              }
+            if(!this->y_label[0].empty())
+              {
+                c.text(left - tick_length - 4.2*label_size, 0.5*(top + bottom), plot_text(this->y_label[0]), label_size, text_anchor::middle, true);
+              }
+            if(have_second && !this->y_label[1].empty())
+              {
+                c.text(right + tick_length + 5.0*label_size, 0.5*(top + bottom), plot_text(this->y_label[1]), label_size, text_anchor::middle, true);
+              }
+            if(!this->title.empty())
+              {
+                c.text(0.5*(left + right), top - 0.6*title_size, plot_text(this->title), title_size, text_anchor::middle, false);
+              }
+
+            if(this->legend) this->render_legend(c, left, top, right, bottom);
+          }
+
+
+        void plot_renderer::render_legend(plot_renderer_impl::canvas& c, double left, double top, double right, double bottom) const
+          {
+            using namespace plot_renderer_impl;
+
+            const double pad    = 0.5*label_size;
+            const double sample = 2.0*label_size;
+            const double gap    = 0.8*label_size;
+            const double row    = 1.4*label_size;
+
+            std::vector<plot_text> labels;
+            double text_width = 0.0;
+            for(const series& s : this->lines)
+              {
+                labels.emplace_back(s.label);
+                text_width = std::max(text_width, labels.back().width(label_size));
+              }
+            if(labels.empty()) return;
+
+            double w = sample + gap + text_width;
+            double h = row * labels.size();
+
+            double x0 = 0.0;
+            double y0 = 0.0;
+            switch(this->position)
+              {
+                case legend_pos::top_left:     x0 = left + pad;               y0 = top + pad;                  break;
+                case legend_pos::top_right:    x0 = right - pad - w;          y0 = top + pad;                  break;
+                case legend_pos::bottom_left:  x0 = left + pad;               y0 = bottom - pad - h;           break;
+                case legend_pos::bottom_right: x0 = right - pad - w;          y0 = bottom - pad - h;           break;
+                case legend_pos::right:
+                case legend_pos::centre_right: x0 = right - pad - w;          y0 = 0.5*(top + bottom - h);     break;
+                case legend_pos::centre_left:  x0 = left + pad;               y0 = 0.5*(top + bottom - h);     break;
+                case legend_pos::upper_centre: x0 = 0.5*(left + right - w);   y0 = top + pad;                  break;
+                case legend_pos::lower_centre: x0 = 0.5*(left + right - w);   y0 = bottom - pad - h;           break;
+                case legend_pos::centre:       x0 = 0.5*(left + right - w);   y0 = 0.5*(top + bottom - h);     break;
+              }
+
+            for(size_t i = 0; i < labels.size(); ++i)
+              {
+                const series& s = this->lines[i];
+                double cy = y0 + (i + 0.5)*row;
+
+                if(s.scattered)
+                  {
+                    c.markers({ point(x0 + 0.5*sample, cy) }, colour(i), marker_size);
+                  }
+                else
+                  {
+                    c.polyline({ point(x0, cy), point(x0 + sample, cy) }, colour(i), line_width, s.second_axis && this->dash_second_axis, false);
+                  }
+
+                c.text(x0 + sample + gap, cy + 0.35*label_size, labels[i], label_size, text_anchor::start, false);
+              }
+          }
+
+      }   // namespace derived_data
+
+  }   // namespace transport
+
+
+#endif //CPPTRANSPORT_PLOT_RENDERER_H
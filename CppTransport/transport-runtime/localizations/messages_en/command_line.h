@@ -56,6 +56,12 @@
 #define CPPTRANSPORT_SWITCH_REJECT_FAILED     "reject-failed"
 #define CPPTRANSPORT_HELP_REJECT_FAILED       "don't commit failed integrations"
 
+#define CPPTRANSPORT_SWITCH_BULK_AGGREGATION  "bulk-aggregation"
+#define CPPTRANSPORT_HELP_BULK_AGGREGATION    "aggregate worker containers in sorted bulk-append mode; constraint checks are deferred to finalization"
+
+#define CPPTRANSPORT_SWITCH_SHARDED_OUTPUT    "sharded-output"
+#define CPPTRANSPORT_HELP_SHARDED_OUTPUT      "keep worker containers as shards of the output group instead of aggregating their correlation-function tables"
+
 #define CPPTRANSPORT_SWITCH_TAG               "tag"
 #define CPPTRANSPORT_HELP_TAG                 "add tag to output generated by task"
 
@@ -68,6 +74,21 @@
 #define CPPTRANSPORT_SWITCH_CACHE_CAPACITY    "datapipe-cache"
 #define CPPTRANSPORT_HELP_CACHE_CAPACITY      "set datapipe cache capacity, measured in Mb (default 500Mb)"
 
+#define CPPTRANSPORT_SWITCH_PIPE_READERS      "datapipe-readers"
+#define CPPTRANSPORT_HELP_PIPE_READERS        "set number of concurrent read-only connexions per datapipe, and per shard of sharded output (default 4; 0 disables)"
+
+#define CPPTRANSPORT_SWITCH_OUTPUT_THREADS    "output-threads"
+#define CPPTRANSPORT_HELP_OUTPUT_THREADS      "set number of threads used by each output worker to derive the lines of a product (default 1)"
+
+#define CPPTRANSPORT_SWITCH_REDUCTION_THREADS "reduction-threads"
+#define CPPTRANSPORT_HELP_REDUCTION_THREADS   "set number of threads used by each postintegration worker to reduce fNL template overlaps (default 1)"
+
+#define CPPTRANSPORT_SWITCH_NO_LINE_CACHE     "no-line-cache"
+#define CPPTRANSPORT_HELP_NO_LINE_CACHE       "recompute all derived lines, rather than reusing lines cached by earlier output tasks"
+
+#define CPPTRANSPORT_SWITCH_NODE_CACHE        "node-cache"
+#define CPPTRANSPORT_HELP_NODE_CACHE          "set capacity of shared-memory datapipe cache shared by workers on the same node, measured in Mb (default 0; 0 disables)"
+
 #define CPPTRANSPORT_SWITCH_VERBOSE           "verbose,v"
 #define CPPTRANSPORT_SWITCH_VERBOSE_LONG      "verbose"
 #define CPPTRANSPORT_HELP_VERBOSE             "enable verbose output"
@@ -115,6 +136,9 @@
 #define CPPTRANSPORT_SWITCH_MPL_BACKEND       "mpl-backend"
 #define CPPTRANSPORT_HELP_MPL_BACKEND         "set Matplotlib backend"
 
+#define CPPTRANSPORT_SWITCH_PLOT_RENDERER     "plot-renderer"
+#define CPPTRANSPORT_HELP_PLOT_RENDERER       "render SVG and PDF plots natively ('native', default; not used with a plot style or LaTeX typesetting) or by executing a Matplotlib script ('matplotlib')"
+
 #define CPPTRANSPORT_SWITCH_STATUS            "status"
 #define CPPTRANSPORT_HELP_STATUS              "summarize current status of repository"
 
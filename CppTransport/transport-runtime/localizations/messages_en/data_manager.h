@@ -78,6 +78,10 @@
 #define CPPTRANSPORT_DATACTR_REMOVE_TEMP                         "Data container error: Could not remove temporary container"
 #define CPPTRANSPORT_DATACTR_ATTACH_FAIL                         "Data container error: Could not attach temporary database (backend code="
 #define CPPTRANSPORT_DATACTR_DETACH_FAIL                         "Data container error: Could not detach temporary database (backend code="
+#define CPPTRANSPORT_DATACTR_ATTACH_PRINCIPAL_FAIL               "Data container error: Could not attach principal container to shard (backend code="
+#define CPPTRANSPORT_DATACTR_SHARD_MOVE_FAIL                     "Data container error: Could not move worker container into shard directory"
+#define CPPTRANSPORT_DATACTR_FOREIGN_KEY_FAIL                    "Data container error: Foreign key check failed after bulk aggregation; violations ="
+#define CPPTRANSPORT_DATACTR_FOREIGN_KEY_FIRST                   "first violation in table"
 
 #define CPPTRANSPORT_DATAMGR_NULL_DATAPIPE                       "Data manager error: Null datapipe specifier"
 #define CPPTRANSPORT_DATAMGR_DETACH_PIPE_NOT_ATTACHED            "Data manager error: Attempt to detach datapipe, but no content group is attached"
@@ -96,6 +100,7 @@
 
 #define CPPTRANSPORT_DATAMGR_TIME_SERIAL_READ_FAIL               "Data manager error: Failed to select time sample (backend code="
 #define CPPTRANSPORT_DATAMGR_KCONFIG_SERIAL_READ_FAIL            "Data manager error: Failed to select k-configuration sample (backend code="
+#define CPPTRANSPORT_DATAMGR_TIME_HISTORY_INCOMPLETE             "Data manager error: Incomplete time history for k-configuration"
 #define CPPTRANSPORT_DATAMGR_WORKER_TABLE_READ_FAIL              "Data manager error: Failed to read worker information table (backend code="
 #define CPPTRANSPORT_DATAMGR_STATISTICS_TABLE_READ_FAIL          "Data manager error: Failed to read statistics information table (backend code="
 
@@ -70,6 +70,7 @@
 
 #define CPPTRANSPORT_PAYLOAD_INTEGRATION_BACKEND        "Created by backend"
 #define CPPTRANSPORT_PAYLOAD_INTEGRATION_DATA           "Data container"
+#define CPPTRANSPORT_PAYLOAD_INTEGRATION_SHARD          "Shard container"
 #define CPPTRANSPORT_PAYLOAD_OUTPUT_CONTENT_PRODUCT     "Derived product"
 #define CPPTRANSPORT_PAYLOAD_OUTPUT_CONTENT_PATH        "filename"
 #define CPPTRANSPORT_PAYLOAD_HAS_ZETA_TWO               "Cached zeta twopf"
@@ -69,6 +69,9 @@ namespace transport
     constexpr auto CPPTRANSPORT_REPORT_DATABASE_ROWS_PER_SEC = "Rows/sec";
     constexpr auto CPPTRANSPORT_REPORT_DATABASE_CTR_SIZE = "Container size";
     constexpr auto CPPTRANSPORT_REPORT_DATABASE_TEMP_SIZE = "Temporary size";
+    constexpr auto CPPTRANSPORT_REPORT_DATABASE_MODE = "Aggregation mode";
+    constexpr auto CPPTRANSPORT_REPORT_DATABASE_MODE_INCREMENTAL = "incremental";
+    constexpr auto CPPTRANSPORT_REPORT_DATABASE_MODE_SORTED_BULK = "sorted bulk-append";
     
     constexpr auto CPPTRANSPORT_REPORT_WORK_COMPLETE = "All work items processed";
     
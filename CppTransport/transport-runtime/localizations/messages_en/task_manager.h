@@ -51,6 +51,8 @@
 #define CPPTRANSPORT_SEED_GROUP_MISMATCHED_SERIALS_A "Paired groups"
 #define CPPTRANSPORT_SEED_GROUP_MISMATCHED_SERIALS_B "and"
 #define CPPTRANSPORT_SEED_GROUP_MISMATCHED_SERIALS_C "do not have the same missing k-configurations and cannot be used to seed a paired integration"
+#define CPPTRANSPORT_SEED_GROUP_MISMATCHED_PRECISION_A "Content group"
+#define CPPTRANSPORT_SEED_GROUP_MISMATCHED_PRECISION_B "was written with a different storage precision and cannot be used to seed task"
 
 #define CPPTRANSPORT_PROCESSING_GANTT_CHART          "generating process Gantt chart"
 #define CPPTRANSPORT_PROCESSING_ACTIVITY_JOURNAL     "generating activity journal"
@@ -61,6 +63,7 @@
 #define CPPTRANSPORT_UNKNOWN_SWITCH                  "Ignored unknown command-line switch"
 #define CPPTRANSPORT_UNKNOWN_PLOT_STYLE              "Ignored unknown plot style"
 #define CPPTRANSPORT_UNKNOWN_MPL_BACKEND             "Ignored unknown Matplotlib backend"
+#define CPPTRANSPORT_UNKNOWN_PLOT_RENDERER           "Ignored unknown plot renderer"
 #define CPPTRANSPORT_UNKNOWN_REPORT_INTERVAL         "Ignored unrecognized report interval"
 #define CPPTRANSPORT_UNKNOWN_REPORT_DELAY            "Ignored unrecognized report time delay"
 #define CPPTRANSPORT_UNKNOWN_CHECKPOINT_INTERVAL     "Ignored unrecognized checkpoint interval"
@@ -62,6 +62,12 @@ namespace transport
         PDF
       };
 
+    enum class plot_renderer_type
+      {
+        native,
+        matplotlib
+      };
+
 
     class argument_cache
 	    {
@@ -120,6 +126,18 @@ namespace transport
         //! Set commit-failed mode
         void set_commit_failed(bool c)                            { this->commit_failed = c; }
 
+        //! Use sorted bulk-append aggregation?
+        bool get_bulk_aggregation() const                         { return(this->bulk_aggregation); }
+
+        //! Set sorted bulk-append aggregation mode
+        void set_bulk_aggregation(bool b)                         { this->bulk_aggregation = b; }
+
+        //! Keep worker containers as shards?
+        bool get_sharded_output() const                           { return(this->sharded_output); }
+
+        //! Set sharded output mode
+        void set_sharded_output(bool s)                           { this->sharded_output = s; }
+
 
         // REPOSITORY OPTIONS
 
@@ -171,6 +189,36 @@ namespace transport
         //! Get datapipe capacity
         size_t get_datapipe_capacity() const                      { return(this->pipe_capacity); }
 
+        //! Set number of read-only connexions per datapipe
+        void set_datapipe_readers(unsigned int r)                 { this->pipe_readers = r; }
+
+        //! Get number of read-only connexions per datapipe
+        unsigned int get_datapipe_readers() const                 { return(this->pipe_readers); }
+
+        //! Set whether derived lines are reused between output tasks
+        void set_derived_line_cache(bool c)                       { this->derived_line_cache = c; }
+
+        //! Get whether derived lines are reused between output tasks
+        bool get_derived_line_cache() const                       { return(this->derived_line_cache); }
+
+        //! Set number of threads used to derive the lines of a product
+        void set_output_threads(unsigned int t)                   { this->output_threads = t; }
+
+        //! Get number of threads used to derive the lines of a product
+        unsigned int get_output_threads() const                   { return(this->output_threads); }
+
+        //! Set number of threads used to reduce fNL template overlaps
+        void set_reduction_threads(unsigned int t)                { this->reduction_threads = t; }
+
+        //! Get number of threads used to reduce fNL template overlaps
+        unsigned int get_reduction_threads() const                { return(this->reduction_threads); }
+
+        //! Set capacity of node-shared datapipe cache
+        void set_node_cache_capacity(size_t c)                    { this->node_cache_capacity = c; }
+
+        //! Get capacity of node-shared datapipe cache
+        size_t get_node_cache_capacity() const                    { return(this->node_cache_capacity); }
+
 
         // MPI VISUALIZATION OPTIONS
 
@@ -216,6 +264,12 @@ namespace transport
 
         /// Get Matplotlib backend
         matplotlib_backend get_matplotlib_backend() const { return this->mpl_backend; }
+
+        //! Set plot renderer; returns true if renderer was recognized or false if it was not
+        bool set_plot_renderer(std::string e);
+
+        //! Get plot renderer
+        plot_renderer_type get_plot_renderer() const { return this->renderer; }
         
         
         // TASK PROGRESS REPORTING
@@ -323,12 +377,33 @@ namespace transport
         //! commit integrations with failures?
         bool commit_failed;
 
+        //! aggregate in sorted bulk-append mode?
+        bool bulk_aggregation;
+
+        //! keep worker containers as shards, rather than aggregating them?
+        bool sharded_output;
+
         //! Storage capacity per batcher
         size_t batcher_capacity;
 
         //! Data cache capacity per datapipe
         size_t pipe_capacity;
 
+        //! Number of read-only connexions per datapipe
+        unsigned int pipe_readers;
+
+        //! Capacity of shared-memory datapipe cache on each node; zero disables
+        size_t node_cache_capacity;
+
+        //! Reuse derived lines cached by earlier output tasks?
+        bool derived_line_cache;
+
+        //! Number of threads used to derive the lines of a product
+        unsigned int output_threads;
+
+        //! Number of threads used to reduce fNL template overlaps
+        unsigned int reduction_threads;
+
         //! checkpoint interval in seconds. Zero indicates that checkpointing is disabled
         unsigned int checkpoint_interval;
 
@@ -338,6 +413,9 @@ namespace transport
         //! Matplotlib backend
         matplotlib_backend mpl_backend;
 
+        //! plot renderer
+        plot_renderer_type renderer;
+
         //! search paths for assets, eg. jQuery, bootstrap ...
         //! have to use std::string internally since boost::filesystem::path won't serialize
         std::list< std::string > search_paths;
@@ -382,11 +460,19 @@ namespace transport
             ar & colour_output;
             ar & network_mode;
             ar & commit_failed;
+            ar & bulk_aggregation;
+            ar & sharded_output;
             ar & batcher_capacity;
             ar & pipe_capacity;
+            ar & pipe_readers;
+            ar & node_cache_capacity;
+            ar & derived_line_cache;
+            ar & output_threads;
+            ar & reduction_threads;
             ar & checkpoint_interval;
             ar & plot_env;
             ar & mpl_backend;
+            ar & renderer;
             ar & search_paths;
             ar & report_percent_interval;
             ar & report_time_interval;
@@ -412,11 +498,19 @@ namespace transport
         terminal_width(CPPTRANSPORT_DEFAULT_TERMINAL_WIDTH),
         network_mode(false),
         commit_failed(true),
+        bulk_aggregation(false),
+        sharded_output(false),
         batcher_capacity(CPPTRANSPORT_DEFAULT_BATCHER_STORAGE),
         pipe_capacity(CPPTRANSPORT_DEFAULT_PIPE_STORAGE),
+        pipe_readers(CPPTRANSPORT_DEFAULT_PIPE_READERS),
+        node_cache_capacity(CPPTRANSPORT_DEFAULT_NODE_CACHE_STORAGE),
+        derived_line_cache(true),
+        output_threads(CPPTRANSPORT_DEFAULT_OUTPUT_THREADS),
+        reduction_threads(CPPTRANSPORT_DEFAULT_REDUCTION_THREADS),
         checkpoint_interval(CPPTRANSPORT_DEFAULT_CHECKPOINT_INTERVAL),
         plot_env(plot_style::raw_matplotlib),
         mpl_backend(matplotlib_backend::unset),
+        renderer(plot_renderer_type::native),
         report_percent_interval(CPPTRANSPORT_DEFAULT_REPORT_PERCENT_INTERVAL),
         report_time_interval(CPPTRANSPORT_DEFAULT_REPORT_TIME_INTERVAL),
         report_time_delay(CPPTRANSPORT_DEFAULT_REPORT_TIME_DELAY),
@@ -453,6 +547,17 @@ namespace transport
       }
 
 
+    bool argument_cache::set_plot_renderer(std::string e)
+      {
+        boost::algorithm::to_lower(e);
+
+        if(e == "native")          { this->renderer = plot_renderer_type::native; return true; }
+        else if(e == "matplotlib") { this->renderer = plot_renderer_type::matplotlib; return true; }
+
+        return false;
+      }
+
+
     template <typename Container>
     void argument_cache::set_search_paths(const Container& path_set)
       {
@@ -599,6 +599,23 @@ namespace transport
         // wait for all messages to be received, then return
         boost::mpi::wait_all(requests.begin(), requests.end());
       }
+
+
+    template <typename number>
+    std::string master_controller<number>::make_node_cache_id(const boost::filesystem::path& tempdir) const
+      {
+        if(this->arg_cache.get_node_cache_capacity() == 0) return(std::string());
+
+        // the identifier is hashed to form the segment name, so the token may contain any characters
+        return(tempdir.string() + "|" + random_string(16));
+      }
+
+
+    template <typename number>
+    void master_controller<number>::release_node_cache(const std::string& id) const
+      {
+        if(!id.empty()) node_cache<number>::remove(id);
+      }
     
     
     template <typename number>
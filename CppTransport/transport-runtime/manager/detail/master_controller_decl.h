@@ -61,6 +61,8 @@
 
 #include "transport-runtime/instruments/busyidle_timer_set.h"
 
+#include "transport-runtime/utilities/random_string.h"
+
 
 #include "boost/mpi.hpp"
 #include "boost/serialization/string.hpp"
@@ -209,6 +211,14 @@ namespace transport
         //! with the current task
         void workers_end_of_task(base_writer::logger& log);
 
+        //! Master node: generate an identifier for the node-shared cache used by one run of a task.
+        //! A fresh token is included, so that a later run never opens a segment left behind by this one
+        std::string make_node_cache_id(const boost::filesystem::path& tempdir) const;
+
+        //! Master node: the master owns the node-shared cache on its own node, and removes it
+        //! once the workers have finished with a task
+        void release_node_cache(const std::string& id) const;
+
         //! Master node: main loop: poll workers for events
         template <typename WriterObject>
         bool poll_workers(integration_aggregator<number>& int_agg, postintegration_aggregator<number>& post_agg, derived_content_aggregator<number>& derived_agg,
@@ -159,6 +159,14 @@ namespace transport
             throw runtime_exception(exception_type::SEEDING_ERROR, msg.str());
           }
 
+        // values from the seed are copied verbatim, so the seed must have been written with the same storage precision
+        if(t->second->get_payload().get_storage_policy() != tk->get_storage_policy())
+          {
+            std::ostringstream msg;
+            msg << CPPTRANSPORT_SEED_GROUP_MISMATCHED_PRECISION_A << " '" << seed_group << "' " << CPPTRANSPORT_SEED_GROUP_MISMATCHED_PRECISION_B << " '" << tk->get_name() << "'";
+            throw runtime_exception(exception_type::SEEDING_ERROR, msg.str());
+          }
+
         // mark writer as seeded
         writer.set_seed(seed_group);
 
@@ -290,9 +298,9 @@ namespace transport
             // inform scheduler of a new aggregation
             this->work_scheduler.report_aggregation(aggregate_timer.elapsed().wall);
 
-            // remove temporary container
+            // remove temporary container; in sharded mode it has already been moved into the shard directory
 //        BOOST_LOG_SEV(writer->get_log(), base_writer::log_severity_level::normal) << "++ Deleting temporary container '" << payload.get_container_path() << "'";
-            if(!boost::filesystem::remove(ctr_path))
+            if(!writer.is_sharded() && !boost::filesystem::remove(ctr_path))
               {
                 std::ostringstream msg;
                 msg << CPPTRANSPORT_DATACTR_REMOVE_TEMP << " '" << ctr_path.string() << "'";
@@ -111,12 +111,15 @@ namespace transport
         boost::filesystem::path tempdir_path = writer.get_abs_tempdir_path();
         boost::filesystem::path logdir_path  = writer.get_abs_logdir_path();
 
+        // identify the node-shared cache for this run of the task
+        std::string cache_id = this->make_node_cache_id(tempdir_path);
+
         {
           // journal_instrument will log time spent doing MPI when it goes out of scope
           journal_instrument instrument(this->journal, master_work_event::event_type::MPI_begin, master_work_event::event_type::MPI_end);
 
           std::vector<boost::mpi::request> requests(this->world.size()-1);
-          MPI::new_derived_content_payload payload(writer.get_task_name(), writer.get_name(), tempdir_path, logdir_path, tags);
+          MPI::new_derived_content_payload payload(writer.get_task_name(), writer.get_name(), tempdir_path, logdir_path, tags, cache_id);
 
           for(unsigned int i = 0; i < this->world.size()-1; ++i)
             {
@@ -132,6 +135,7 @@ namespace transport
         // we keep track of the global content group list, but content groups are also tracked
         // on a product-by-product basis as they are emplaced during the task
         bool success = this->poll_workers(i_agg, p_agg, d_agg, i_metadata, o_metadata, content_groups, writer, begin_label, end_label);
+        this->release_node_cache(cache_id);
 
         writer.set_metadata(o_metadata);
         writer.set_content_groups(content_groups);
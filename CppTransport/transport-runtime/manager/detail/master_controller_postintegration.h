@@ -413,12 +413,15 @@ namespace transport
         boost::filesystem::path tempdir_path = writer.get_abs_tempdir_path();
         boost::filesystem::path logdir_path  = writer.get_abs_logdir_path();
 
+        // identify the node-shared cache for this run of the task
+        std::string cache_id = this->make_node_cache_id(tempdir_path);
+
         {
           // journal_instrument will log time spent doing MPI when it goes out of scope
           journal_instrument instrument(this->journal, master_work_event::event_type::MPI_begin, master_work_event::event_type::MPI_end);
 
           std::vector<boost::mpi::request> requests(this->world.size()-1);
-          MPI::new_postintegration_payload payload(writer.get_task_name(), writer.get_name(), tempdir_path, logdir_path, tags);
+          MPI::new_postintegration_payload payload(writer.get_task_name(), writer.get_name(), tempdir_path, logdir_path, tags, cache_id);
 
           for(unsigned int i = 0; i < this->world.size()-1; ++i)
             {
@@ -432,6 +435,7 @@ namespace transport
         }
 
         bool success = this->poll_workers(i_agg, p_agg, d_agg, i_metadata, o_metadata, content_groups, writer, begin_label, end_label);
+        this->release_node_cache(cache_id);
 
         if(content_groups.size() > 1) throw runtime_exception(exception_type::RUNTIME_ERROR,  CPPTRANSPORT_POSTINTEGRATION_MULTIPLE_GROUPS);
 
@@ -470,12 +474,15 @@ namespace transport
         boost::filesystem::path p_tempdir_path = p_writer.get_abs_tempdir_path();
         boost::filesystem::path p_logdir_path  = p_writer.get_abs_logdir_path();
 
+        // identify the node-shared cache for this run of the task
+        std::string cache_id = this->make_node_cache_id(p_tempdir_path);
+
         {
           // journal instrument will log time spent doing MPI when it goes out of scope
           journal_instrument instrument(this->journal, master_work_event::event_type::MPI_begin, master_work_event::event_type::MPI_end);
 
           std::vector<boost::mpi::request> requests(this->world.size()-1);
-          MPI::new_postintegration_payload payload(p_writer.get_task_name(), p_writer.get_name(), p_tempdir_path, p_logdir_path, tags, i_tempdir_path, i_logdir_path, i_writer.get_workgroup_number());
+          MPI::new_postintegration_payload payload(p_writer.get_task_name(), p_writer.get_name(), p_tempdir_path, p_logdir_path, tags, i_tempdir_path, i_logdir_path, i_writer.get_workgroup_number(), cache_id);
 
           for(unsigned int i = 0; i < this->world.size()-1; ++i)
             {
@@ -489,6 +496,7 @@ namespace transport
         }
 
         bool success = this->poll_workers(i_agg, p_agg, d_agg, i_metadata, o_metadata, content_groups, i_writer, begin_label, end_label);
+        this->release_node_cache(cache_id);
 
         if(content_groups.size() > 1) throw runtime_exception(exception_type::RUNTIME_ERROR, CPPTRANSPORT_POSTINTEGRATION_MULTIPLE_GROUPS);
 
@@ -130,14 +130,22 @@ namespace transport
           (CPPTRANSPORT_SWITCH_CAPACITY, boost::program_options::value<long int>(), CPPTRANSPORT_HELP_CAPACITY)
           (CPPTRANSPORT_SWITCH_BATCHER_CAPACITY, boost::program_options::value<long int>(), CPPTRANSPORT_HELP_BATCHER_CAPACITY)
           (CPPTRANSPORT_SWITCH_CACHE_CAPACITY, boost::program_options::value<long int>(), CPPTRANSPORT_HELP_CACHE_CAPACITY)
+          (CPPTRANSPORT_SWITCH_PIPE_READERS, boost::program_options::value<int>(), CPPTRANSPORT_HELP_PIPE_READERS)
+          (CPPTRANSPORT_SWITCH_NODE_CACHE, boost::program_options::value<long int>(), CPPTRANSPORT_HELP_NODE_CACHE)
+          (CPPTRANSPORT_SWITCH_OUTPUT_THREADS, boost::program_options::value<int>(), CPPTRANSPORT_HELP_OUTPUT_THREADS)
+          (CPPTRANSPORT_SWITCH_REDUCTION_THREADS, boost::program_options::value<int>(), CPPTRANSPORT_HELP_REDUCTION_THREADS)
+          (CPPTRANSPORT_SWITCH_NO_LINE_CACHE, CPPTRANSPORT_HELP_NO_LINE_CACHE)
           (CPPTRANSPORT_SWITCH_NETWORK_MODE, CPPTRANSPORT_HELP_NETWORK_MODE)
           (CPPTRANSPORT_SWITCH_REJECT_FAILED, CPPTRANSPORT_HELP_REJECT_FAILED)
+          (CPPTRANSPORT_SWITCH_BULK_AGGREGATION, CPPTRANSPORT_HELP_BULK_AGGREGATION)
+          (CPPTRANSPORT_SWITCH_SHARDED_OUTPUT, CPPTRANSPORT_HELP_SHARDED_OUTPUT)
           ;
         
         boost::program_options::options_description plotting("Plot styling", width);
         plotting.add_options()
           (CPPTRANSPORT_SWITCH_PLOT_STYLE, boost::program_options::value<std::string>(), CPPTRANSPORT_HELP_PLOT_STYLE)
           (CPPTRANSPORT_SWITCH_MPL_BACKEND, boost::program_options::value<std::string>(), CPPTRANSPORT_HELP_MPL_BACKEND)
+          (CPPTRANSPORT_SWITCH_PLOT_RENDERER, boost::program_options::value<std::string>(), CPPTRANSPORT_HELP_PLOT_RENDERER)
           ;
         
         boost::program_options::options_description task_reporting("In-progress task reporting", width);
@@ -431,6 +439,9 @@ namespace transport
         
         if(option_map.count(CPPTRANSPORT_SWITCH_NETWORK_MODE)) this->arg_cache.set_network_mode(true);
         if(option_map.count(CPPTRANSPORT_SWITCH_REJECT_FAILED)) this->arg_cache.set_commit_failed(false);
+        if(option_map.count(CPPTRANSPORT_SWITCH_BULK_AGGREGATION)) this->arg_cache.set_bulk_aggregation(true);
+        if(option_map.count(CPPTRANSPORT_SWITCH_NO_LINE_CACHE)) this->arg_cache.set_derived_line_cache(false);
+        if(option_map.count(CPPTRANSPORT_SWITCH_SHARDED_OUTPUT)) this->arg_cache.set_sharded_output(true);
         
         // process global capacity specification, if provided
         if(option_map.count(CPPTRANSPORT_SWITCH_CAPACITY))
@@ -489,6 +500,79 @@ namespace transport
               }
           }
         
+        // process datapipe reader specification, if provided
+        if(option_map.count(CPPTRANSPORT_SWITCH_PIPE_READERS))
+          {
+            int readers = option_map[CPPTRANSPORT_SWITCH_PIPE_READERS].as<int>();
+
+            if(readers >= 0)
+              {
+                this->arg_cache.set_datapipe_readers(static_cast<unsigned int>(readers));
+              }
+            else
+              {
+                std::ostringstream msg;
+                msg << CPPTRANSPORT_EXPECTED_POSITIVE << " " << CPPTRANSPORT_SWITCH_PIPE_READERS;
+                this->err(msg.str());
+              }
+          }
+
+        if(option_map.count(CPPTRANSPORT_SWITCH_OUTPUT_THREADS))
+          {
+            int threads = option_map[CPPTRANSPORT_SWITCH_OUTPUT_THREADS].as<int>();
+
+            if(threads > 0)
+              {
+                this->arg_cache.set_output_threads(static_cast<unsigned int>(threads));
+              }
+            else
+              {
+                std::ostringstream msg;
+                msg << CPPTRANSPORT_EXPECTED_POSITIVE << " " << CPPTRANSPORT_SWITCH_OUTPUT_THREADS;
+                this->err(msg.str());
+              }
+          }
+
+        if(option_map.count(CPPTRANSPORT_SWITCH_REDUCTION_THREADS))
+          {
+            int threads = option_map[CPPTRANSPORT_SWITCH_REDUCTION_THREADS].as<int>();
+
+            if(threads > 0)
+              {
+                this->arg_cache.set_reduction_threads(static_cast<unsigned int>(threads));
+              }
+            else
+              {
+                std::ostringstream msg;
+                msg << CPPTRANSPORT_EXPECTED_POSITIVE << " " << CPPTRANSPORT_SWITCH_REDUCTION_THREADS;
+                this->err(msg.str());
+              }
+          }
+
+        // process node-shared cache specification, if provided
+        if(option_map.count(CPPTRANSPORT_SWITCH_NODE_CACHE))
+          {
+            long int capacity = -1;
+            try
+              {
+                capacity = option_map[CPPTRANSPORT_SWITCH_NODE_CACHE].as<long int>() * 1024 * 1024;      // argument size interpreted in Mb
+              }
+            catch(boost::exception& xe)
+              {
+              }
+
+            if(capacity >= 0)
+              {
+                this->arg_cache.set_node_cache_capacity(static_cast<size_t>(capacity));
+              }
+            else
+              {
+                std::ostringstream msg;
+                msg << CPPTRANSPORT_EXPECTED_POSITIVE << " " << CPPTRANSPORT_SWITCH_NODE_CACHE;
+                this->err(msg.str());
+              }
+          }
+        
         // process batcher capacity specification, if provided
         if(option_map.count(CPPTRANSPORT_SWITCH_BATCHER_CAPACITY))
           {
@@ -695,6 +779,18 @@ namespace transport
                 this->warn(msg.str());
               }
           }
+
+        // process plot renderer, if provided
+        if(option_map.count(CPPTRANSPORT_SWITCH_PLOT_RENDERER))
+          {
+            if(!this->arg_cache.set_plot_renderer(option_map[CPPTRANSPORT_SWITCH_PLOT_RENDERER].as<std::string>()))
+              {
+                std::ostringstream msg;
+                msg << CPPTRANSPORT_UNKNOWN_PLOT_RENDERER << " '"
+                    << option_map[CPPTRANSPORT_SWITCH_PLOT_RENDERER].as<std::string>() << "'";
+                this->warn(msg.str());
+              }
+          }
       }
     
     
@@ -542,7 +542,7 @@ namespace transport
         slave_datapipe_dispatch<number> dispatcher(*this);
 
         // acquire a datapipe which we can use to stream content from the databse
-        std::unique_ptr< datapipe<number> > pipe = this->data_mgr->create_datapipe(payload.get_logdir_path(), payload.get_tempdir_path(), i_finder, p_finder, dispatcher, this->get_rank());
+        std::unique_ptr< datapipe<number> > pipe = this->data_mgr->create_datapipe(payload.get_logdir_path(), payload.get_tempdir_path(), payload.get_node_cache_id(), i_finder, p_finder, dispatcher, this->get_rank());
 
         // write log header
         boost::posix_time::ptime now = boost::posix_time::second_clock::universal_time();
@@ -956,7 +956,7 @@ namespace transport
         slave_null_dispatch_function<number> dispatcher(*this);
 
         // acquire a datapipe which we can use to stream content from the databse
-        std::unique_ptr< datapipe<number> > pipe = this->data_mgr->create_datapipe(payload.get_logdir_path(), payload.get_tempdir_path(), i_finder, p_finder, dispatcher, this->get_rank(), true);
+        std::unique_ptr< datapipe<number> > pipe = this->data_mgr->create_datapipe(payload.get_logdir_path(), payload.get_tempdir_path(), payload.get_node_cache_id(), i_finder, p_finder, dispatcher, this->get_rank(), true);
 
         bool complete = false;
         while(!complete)
@@ -1005,6 +1005,7 @@ namespace transport
                     try
                       {
                         group = pipe->attach(ptk, payload.get_tags());
+                        this->work_handler.set_reduction_threads(this->arg_cache.get_reduction_threads());
                         this->work_handler.postintegration_handler(tk, ptk, work, batcher, *pipe);
                         pipe->detach();
                       }
@@ -28,6 +28,7 @@
 
 
 #include <list>
+#include <mutex>
 #include <string>
 
 #include "transport-runtime/manager/mpi_operations.h"
@@ -71,12 +72,12 @@ namespace transport
       public:
 
         //! add context
-        void push_context(std::string c) { this->context.push_back(std::move(c)); }
+        void push_context(std::string c) { std::lock_guard<std::mutex> lock(this->mtx); this->context.push_back(std::move(c)); }
 
         //! pop context
-        void pop_context() { if(this->context.size() > 0) this->context.pop_back(); }
+        void pop_context() { std::lock_guard<std::mutex> lock(this->mtx); if(this->context.size() > 0) this->context.pop_back(); }
 
-        //! add message
+        //! add message; may be called concurrently from several threads
         void push_back(std::string m);
 
 
@@ -96,6 +97,9 @@ namespace transport
         //! context stack
         std::list<std::string> context;
 
+        //! mutex protecting message buffer and context stack
+        std::mutex mtx;
+
         //! callback object, used eg. for journalling messages in a log
         notify_handler handler;
 
@@ -104,6 +108,9 @@ namespace transport
 
     void slave_message_buffer::push_back(std::string m)
       {
+        // the context stack is read while formatting, so hold the lock throughout
+        std::lock_guard<std::mutex> lock(this->mtx);
+
         std::ostringstream msg;
         msg << m;
 
@@ -550,12 +550,14 @@ namespace transport
                 new_derived_content_payload(std::string tk, std::string nm,
                                             const boost::filesystem::path& tmp_d,
                                             const boost::filesystem::path& log_d,
-                                            std::list<std::string> tg)
+                                            std::list<std::string> tg,
+                                            std::string nc_id)
 	                : task(std::move(tk)),
                     group_name(std::move(nm)),
                     tempdir(tmp_d.string()),
                     logdir(log_d.string()),
-                    tags(std::move(tg))
+                    tags(std::move(tg)),
+                    node_cache_id(std::move(nc_id))
 	                {
 	                }
 
@@ -574,6 +576,9 @@ namespace transport
 		            //! Get tags specified on the command line, used to narrow-down the list of content groups
 		            const std::list<std::string>& get_tags()          const { return(this->tags); }
 
+                //! Get identifier of the node-shared cache for this run of the job
+                const std::string&            get_node_cache_id() const { return(this->node_cache_id); }
+
               private:
 
                 //! Name of task, to be looked up in repository database
@@ -591,6 +596,9 @@ namespace transport
  		            //! Search tags specified on the command line
 		            std::list<std::string> tags;
 
+                //! Identifier of the node-shared cache
+                std::string node_cache_id;
+
                 // enable boost::serialization support, and hence automated packing for transmission over MPI
                 friend class boost::serialization::access;
 
@@ -602,6 +610,7 @@ namespace transport
                     ar & tempdir;
                     ar & logdir;
 		                ar & tags;
+                    ar & node_cache_id;
 	                }
 
 	            };
@@ -901,13 +910,15 @@ namespace transport
                 new_postintegration_payload(std::string tk, std::string nm,
                                             const boost::filesystem::path& tmp_d,
                                             const boost::filesystem::path& log_d,
-                                            std::list<std::string> tg)
+                                            std::list<std::string> tg,
+                                            std::string nc_id)
                   : task(std::move(tk)),
                     group_name(std::move(nm)),
                     tempdir(tmp_d.string()),
                     logdir(log_d.string()),
                     tags(std::move(tg)),
-                    workgroup_number(0)
+                    workgroup_number(0),
+                    node_cache_id(std::move(nc_id))
                   {
                   }
 
@@ -918,7 +929,8 @@ namespace transport
                                             std::list<std::string> tg,
                                             const boost::filesystem::path& i_tmp_d,
                                             const boost::filesystem::path& i_log_d,
-                                            unsigned int wg)
+                                            unsigned int wg,
+                                            std::string nc_id)
                   : task(std::move(tk)),
                     group_name(std::move(nm)),
                     tempdir(p_tmp_d.string()),
@@ -926,7 +938,8 @@ namespace transport
                     tags(std::move(tg)),
                     paired_tempdir(i_tmp_d.string()),
                     paired_logdir(i_log_d.string()),
-                    workgroup_number(wg)
+                    workgroup_number(wg),
+                    node_cache_id(std::move(nc_id))
                   {
                   }
 
@@ -954,6 +967,9 @@ namespace transport
                 //! Get tags specified on the command line, used to narrow-down the list of content groups
                 const std::list<std::string>& get_tags()                    const { return(this->tags); }
 
+                //! Get identifier of the node-shared cache for this run of the job
+                const std::string&            get_node_cache_id()           const { return(this->node_cache_id); }
+
               private:
 
                 //! Name of task, to be looked up in repository database
@@ -980,6 +996,9 @@ namespace transport
                 //! Workgroup number for paired integration (if using)
                 unsigned int workgroup_number;
 
+                //! Identifier of the node-shared cache
+                std::string node_cache_id;
+
                 // enable boost::serialization support, and hence automated packing for transmission over MPI
                 friend class boost::serialization::access;
 
@@ -994,6 +1013,7 @@ namespace transport
                     ar & paired_tempdir;
                     ar & paired_logdir;
                     ar & workgroup_number;
+                    ar & node_cache_id;
                   }
 
               };
@@ -623,6 +623,8 @@ namespace transport
             
             store.insert_back(CPPTRANSPORT_REPORT_DATABASE_EVENT_TIME, boost::posix_time::to_simple_string(rec->get_creation_time()));
             store.insert_back(CPPTRANSPORT_REPORT_DATABASE_ROWS, format_number(rec->get_rows(), 5));
+            store.insert_back(CPPTRANSPORT_REPORT_DATABASE_MODE, rec->get_mode() == aggregation_mode::sorted_bulk
+                                                                 ? CPPTRANSPORT_REPORT_DATABASE_MODE_SORTED_BULK : CPPTRANSPORT_REPORT_DATABASE_MODE_INCREMENTAL);
             
             auto total_time = rec->get_total_time();
             if(total_time)
@@ -56,7 +56,10 @@ namespace transport
 
       public:
 
-		    slave_work_handler() = default;
+		    slave_work_handler()
+          : reduction_threads(1)
+          {
+          }
 
 		    ~slave_work_handler() = default;
 
@@ -65,6 +68,9 @@ namespace transport
 
       public:
 
+        //! Set number of threads used to reduce fNL template overlaps
+        void set_reduction_threads(unsigned int t) { this->reduction_threads = t; }
+
         //! Handler: zeta twopf task
         void postintegration_handler(zeta_twopf_task<number>* tk, twopf_task<number>* ptk, work_queue<twopf_kconfig_record>& work,
                                      zeta_twopf_batcher<number>& batcher, datapipe<number>& pipe);
@@ -88,6 +94,9 @@ namespace transport
         //! compute delegate - fNL products
         derived_data::fNL_timeseries_compute<number> fNL_computer;
 
+        //! number of threads used to reduce fNL template overlaps
+        unsigned int reduction_threads;
+
 	    };
 
 
@@ -116,8 +125,9 @@ namespace transport
 		    // get list of k-configurations
 		    const twopf_kconfig_database& twopf_db = ptk->get_twopf_database();
 
-        // set up handle for compute delegate
-        std::unique_ptr<typename derived_data::zeta_timeseries_compute<number>::handle> handle = this->zeta_computer.make_handle(pipe, ptk, tquery, ptk->get_model()->get_N_fields());
+        // set up handle for compute delegate; each k-configuration is visited once, so stream it in bulk rather than
+        // pulling individual components through the line cache
+        std::unique_ptr<typename derived_data::zeta_timeseries_compute<number>::handle> handle = this->zeta_computer.make_handle(pipe, ptk, tquery, ptk->get_model()->get_N_fields(), true);
 
         // buffer for computed values
         std::vector<number> zeta_npf;
@@ -166,9 +176,9 @@ namespace transport
         time_config_tag<number>                        tc_tag      = pipe.new_time_config_tag();
         const std::vector<time_config>                 time_values = tc_handle.lookup_tag(tc_tag);
 
-        // set up handle for compute delegate
+        // set up handle for compute delegate; as above, stream each k-configuration in bulk
         unsigned int N_fields = ptk->get_model()->get_N_fields();
-        std::unique_ptr<typename derived_data::zeta_timeseries_compute<number>::handle> handle = this->zeta_computer.make_handle(pipe, ptk, tquery, N_fields);
+        std::unique_ptr<typename derived_data::zeta_timeseries_compute<number>::handle> handle = this->zeta_computer.make_handle(pipe, ptk, tquery, N_fields, true);
 
 		    // buffer for computed values
         std::vector<number> zeta_npf;
@@ -286,7 +296,8 @@ namespace transport
         std::vector<number> TT;
 
 		    // set up handle for compute delegate
-        std::unique_ptr<typename derived_data::fNL_timeseries_compute<number>::handle> handle = this->fNL_computer.make_handle(pipe, ptk, tquery, tk->get_template(), list);
+        std::unique_ptr<typename derived_data::fNL_timeseries_compute<number>::handle> handle =
+          this->fNL_computer.make_handle(pipe, ptk, tquery, tk->get_template(), list, this->reduction_threads);
 
 		    this->fNL_computer.components(*handle, BB, BT, TT);
         assert(BB.size() == time_values.size());
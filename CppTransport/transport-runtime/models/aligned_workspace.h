@@ -0,0 +1,67 @@
+//
+// Created by David Seery on 18/10/2026.
+// --@@
+// Copyright (c) 2016 University of Sussex. All rights reserved.
+//
+// This file is part of the CppTransport platform.
+//
+// CppTransport is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// CppTransport is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with CppTransport.  If not, see <http://www.gnu.org/licenses/>.
+//
+// @license: GPL-2
+// @contributor: David Seery <D.Seery@sussex.ac.uk>
+// --@@
+//
+
+#ifndef CPPTRANSPORT_ALIGNED_WORKSPACE_H
+#define CPPTRANSPORT_ALIGNED_WORKSPACE_H
+
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+
+// alignment (in bytes) of workspace arrays used by vectorized transport functors;
+// 64 bytes covers a full AVX-512 register and a typical cache line
+#ifndef CPPTRANSPORT_WORKSPACE_ALIGNMENT
+#define CPPTRANSPORT_WORKSPACE_ALIGNMENT 64
+#endif
+
+
+namespace transport
+  {
+
+    //! allocate an uninitialized workspace array of n elements, aligned for SIMD loads and stores;
+    //! it must be released using release_aligned_workspace()
+    template <typename number>
+    number* allocate_aligned_workspace(size_t n)
+      {
+        void* ptr = nullptr;
+        if(posix_memalign(&ptr, CPPTRANSPORT_WORKSPACE_ALIGNMENT, n*sizeof(number)) != 0) throw std::bad_alloc();
+
+        return(static_cast<number*>(ptr));
+      }
+
+
+    //! release a workspace array allocated by allocate_aligned_workspace()
+    template <typename number>
+    void release_aligned_workspace(number* ptr)
+      {
+        std::free(ptr);
+      }
+
+  }   // namespace transport
+
+
+#endif //CPPTRANSPORT_ALIGNED_WORKSPACE_H
@@ -554,9 +554,21 @@ namespace transport
         payload.set_statistics(writer.is_collecting_statistics());
         payload.set_initial_conditions(writer.is_collecting_initial_conditions());
 
+        // record storage precision so that datapipes can widen reduced-precision values on read
+        twopf_db_task<number>* dbtk = dynamic_cast< twopf_db_task<number>* >(rec->get_task());
+        if(dbtk != nullptr) payload.set_storage_policy(dbtk->get_storage_policy());
+
+        // record shard manifest, if the writer catalogued worker containers instead of aggregating them
+        payload.set_shards(writer.get_shards());
+
         try
           {
-            payload.set_size(boost::filesystem::file_size(this->root_path / writer.get_relative_container_path()));
+            unsigned int size = boost::filesystem::file_size(this->root_path / writer.get_relative_container_path());
+            for(const content_shard& shard : writer.get_shards())
+              {
+                size += boost::filesystem::file_size(this->root_path / shard.get_container_path());
+              }
+            payload.set_size(size);
           }
         catch(boost::filesystem::filesystem_error& xe)
           {
@@ -65,6 +65,9 @@ namespace transport
         //! find content group
         std::unique_ptr< content_group_record<integration_payload> > operator()(const std::string& name, const std::list<std::string>& tags);
 
+        //! look up a content group by name
+        std::unique_ptr< content_group_record<integration_payload> > lookup(const std::string& group);
+
 
         // INTERNAL DATA
 
@@ -101,6 +104,9 @@ namespace transport
         //! find content group
         std::unique_ptr< content_group_record<postintegration_payload> > operator()(const std::string& name, const std::list<std::string>& tags);
 
+        //! look up a content group by name
+        std::unique_ptr< content_group_record<postintegration_payload> > lookup(const std::string& group);
+
 
         // INTERNAL DATA
 
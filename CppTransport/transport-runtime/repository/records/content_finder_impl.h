@@ -41,6 +41,14 @@ namespace transport
       }
 
 
+    template <typename number>
+    std::unique_ptr< content_group_record<integration_payload> >
+    integration_content_finder<number>::lookup(const std::string& group)
+      {
+        return this->repo.query_integration_content(group);
+      }
+
+
     template <typename number>
     std::unique_ptr< content_group_record<postintegration_payload> >
     postintegration_content_finder<number>::operator()(const std::string& name, const std::list<std::string>& tags)
@@ -49,6 +57,14 @@ namespace transport
       }
 
 
+    template <typename number>
+    std::unique_ptr< content_group_record<postintegration_payload> >
+    postintegration_content_finder<number>::lookup(const std::string& group)
+      {
+        return this->repo.query_postintegration_content(group);
+      }
+
+
   }   // namespace transport
 
 
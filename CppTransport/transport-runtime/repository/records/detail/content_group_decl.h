@@ -228,6 +228,67 @@ namespace transport
       };
 
 
+    //! Shard descriptor. Integration content groups written in sharded mode keep each worker container
+    //! as an immutable shard rather than aggregating its correlation-function tables into the principal container;
+    //! the descriptor records where the shard lives and which k-configurations it holds
+    class content_shard: public serializable
+      {
+
+      public:
+
+        //! Create a shard descriptor
+        content_shard(const boost::filesystem::path& p, std::set<unsigned int> tw, std::set<unsigned int> th)
+          : container(p),
+            twopf_serials(std::move(tw)),
+            threepf_serials(std::move(th))
+          {
+          }
+
+        //! Deserialization constructor
+        content_shard(Json::Value& reader);
+
+        //! Destroy a shard descriptor
+        ~content_shard() = default;
+
+
+        // INTERFACE
+
+      public:
+
+        //! Get path of shard container, relative to the repository root
+        const boost::filesystem::path& get_container_path() const { return(this->container); }
+
+        //! Get twopf k-configuration serial numbers held in this shard
+        const std::set<unsigned int>& get_twopf_serials() const { return(this->twopf_serials); }
+
+        //! Get threepf k-configuration serial numbers held in this shard (empty for twopf tasks)
+        const std::set<unsigned int>& get_threepf_serials() const { return(this->threepf_serials); }
+
+
+        // SERIALIZATION -- implements a 'serializable' interface
+
+      public:
+
+        //! Serialize this object
+        virtual void serialize(Json::Value& writer) const override;
+
+
+        // INTERNAL DATA
+
+      protected:
+
+        //! Path to shard container
+        boost::filesystem::path container;
+
+        //! twopf k-configurations held in this shard
+        std::set<unsigned int> twopf_serials;
+
+        //! threepf k-configurations held in this shard
+        std::set<unsigned int> threepf_serials;
+
+      };
+
+
     //! Integration payload
     class integration_payload: public serializable
       {
@@ -314,6 +375,21 @@ namespace transport
         //! Get initial conditions flag
         bool has_initial_conditions() const { return(this->initial_conditions); }
 
+        //! Set storage precision policy
+        void set_storage_policy(const storage_policy& p) { this->storage = p; }
+
+        //! Get storage precision policy
+        const storage_policy& get_storage_policy() const { return(this->storage); }
+
+        //! Set shard manifest
+        void set_shards(std::list<content_shard> s) { this->shards = std::move(s); }
+
+        //! Get shard manifest
+        const std::list<content_shard>& get_shards() const { return(this->shards); }
+
+        //! Is this group sharded?
+        bool is_sharded() const { return(!this->shards.empty()); }
+
         //! Set container size
         void set_size(unsigned int s) { this->size = s; }
 
@@ -370,6 +446,12 @@ namespace transport
         //! does this group has initial conditions data?
         bool initial_conditions;
 
+        //! precision with which each class of value table was written
+        storage_policy storage;
+
+        //! shards holding correlation-function tables, if this group was written in sharded mode
+        std::list<content_shard> shards;
+
         //! record container size
         unsigned int size;
 
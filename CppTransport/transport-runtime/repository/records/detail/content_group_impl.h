@@ -46,6 +46,11 @@ namespace transport
     constexpr auto CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_ICS = "has-ics";
     constexpr auto CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_SIZE = "size";
     constexpr auto CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_DATA_TYPE = "data-type";
+    constexpr auto CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_SHARDS = "shards";
+
+    constexpr auto CPPTRANSPORT_NODE_SHARD_CONTAINER = "container";
+    constexpr auto CPPTRANSPORT_NODE_SHARD_TWOPF_SERIALS = "twopf-serials";
+    constexpr auto CPPTRANSPORT_NODE_SHARD_THREEPF_SERIALS = "threepf-serials";
 
     constexpr auto CPPTRANSPORT_NODE_PAYLOAD_POSTINTEGRATION_DATABASE = "database-path";
     constexpr auto CPPTRANSPORT_NODE_PAYLOAD_POSTINTEGRATION_FAILED = "failed";
@@ -337,7 +342,8 @@ namespace transport
 
 
     integration_payload::integration_payload(Json::Value& reader)
-      : metadata(reader)
+      : metadata(reader),
+        storage(reader)
       {
         container          = reader[CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_DATABASE].asString();
         fail               = reader[CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_FAILED].asBool();
@@ -356,6 +362,17 @@ namespace transport
           {
             failed_serials.insert(t->asUInt());
           }
+
+        // groups written before sharded output was available have no shard manifest
+        if(reader.isMember(CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_SHARDS))
+          {
+            Json::Value& shard_array = reader[CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_SHARDS];
+            assert(shard_array.isArray());
+            for(Json::Value::iterator t = shard_array.begin(); t != shard_array.end(); ++t)
+              {
+                shards.emplace_back(*t);
+              }
+          }
       }
 
 
@@ -371,6 +388,8 @@ namespace transport
         writer[CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_SIZE]       = this->size;
         writer[CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_DATA_TYPE]  = this->data_type;
 
+        this->storage.serialize(writer);
+
         Json::Value failure_array(Json::arrayValue);
         for(unsigned int n : this->failed_serials)
           {
@@ -379,6 +398,18 @@ namespace transport
           }
         writer[CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_FAILED_SERIALS] = failure_array;
 
+        if(!this->shards.empty())
+          {
+            Json::Value shard_array(Json::arrayValue);
+            for(const content_shard& shard : this->shards)
+              {
+                Json::Value element(Json::objectValue);
+                shard.serialize(element);
+                shard_array.append(element);
+              }
+            writer[CPPTRANSPORT_NODE_PAYLOAD_INTEGRATION_SHARDS] = shard_array;
+          }
+
         this->metadata.serialize(writer);
       }
 
@@ -387,6 +418,52 @@ namespace transport
     void integration_payload::write(Stream& out) const
       {
         out << CPPTRANSPORT_PAYLOAD_INTEGRATION_DATA << " = " << this->container << '\n';
+        for(const content_shard& shard : this->shards)
+          {
+            out << CPPTRANSPORT_PAYLOAD_INTEGRATION_SHARD << " = " << shard.get_container_path() << '\n';
+          }
+      }
+
+
+    content_shard::content_shard(Json::Value& reader)
+      {
+        container = reader[CPPTRANSPORT_NODE_SHARD_CONTAINER].asString();
+
+        Json::Value& twopf_array = reader[CPPTRANSPORT_NODE_SHARD_TWOPF_SERIALS];
+        assert(twopf_array.isArray());
+        for(Json::Value::iterator t = twopf_array.begin(); t != twopf_array.end(); ++t)
+          {
+            twopf_serials.insert(t->asUInt());
+          }
+
+        Json::Value& threepf_array = reader[CPPTRANSPORT_NODE_SHARD_THREEPF_SERIALS];
+        assert(threepf_array.isArray());
+        for(Json::Value::iterator t = threepf_array.begin(); t != threepf_array.end(); ++t)
+          {
+            threepf_serials.insert(t->asUInt());
+          }
+      }
+
+
+    void content_shard::serialize(Json::Value& writer) const
+      {
+        writer[CPPTRANSPORT_NODE_SHARD_CONTAINER] = this->container.string();
+
+        Json::Value twopf_array(Json::arrayValue);
+        for(unsigned int n : this->twopf_serials)
+          {
+            Json::Value element = n;
+            twopf_array.append(element);
+          }
+        writer[CPPTRANSPORT_NODE_SHARD_TWOPF_SERIALS] = twopf_array;
+
+        Json::Value threepf_array(Json::arrayValue);
+        for(unsigned int n : this->threepf_serials)
+          {
+            Json::Value element = n;
+            threepf_array.append(element);
+          }
+        writer[CPPTRANSPORT_NODE_SHARD_THREEPF_SERIALS] = threepf_array;
       }
 
 
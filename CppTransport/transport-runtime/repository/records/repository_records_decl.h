@@ -60,6 +60,8 @@
 #include "boost/date_time/posix_time/posix_time.hpp"
 #include "boost/filesystem/operations.hpp"
 
+#include "transport-runtime/data/storage_precision.h"
+
 #include "transport-runtime/repository/records/detail/metadata_decl.h"
 #include "transport-runtime/repository/records/detail/notes.h"
 #include "transport-runtime/repository/records/detail/record_decl.h"
@@ -51,6 +51,14 @@ namespace transport
       };
 
 
+    //! aggregation mode: incremental mode copies rows in whatever order they appear in the worker container;
+    //! sorted_bulk mode appends rows in primary-key order and defers constraint checks to finalization
+    enum class aggregation_mode
+      {
+        incremental, sorted_bulk
+      };
+
+
     class aggregation_table_data
       {
       public:
@@ -117,12 +125,25 @@ namespace transport
           {
             if(v)
               {
-                return format_number(static_cast<double>(v->time) / normalization, 6) + "," + boost::lexical_cast<std::string>(v->rows);
+                double seconds = static_cast<double>(v->time) / normalization;
+                std::string rate = v->time > 0 ? format_number(static_cast<double>(v->rows) / seconds, 6) : std::string("NaN");
+                return format_number(seconds, 6) + "," + boost::lexical_cast<std::string>(v->rows) + "," + rate;
               }
             else
               {
-                return "NaN,NaN";
+                return "NaN,NaN,NaN";
+              }
+          }
+
+
+        std::string format(aggregation_mode mode)
+          {
+            switch(mode)
+              {
+                case aggregation_mode::incremental: return "incremental";
+                case aggregation_mode::sorted_bulk: return "sorted_bulk";
               }
+            return "unknown";
           }
 
 
@@ -171,7 +192,7 @@ namespace transport
         template <enum aggregation_profile_record_type type>
         void write_headings(std::ofstream& out)
           {
-            const std::array< std::string, 6 > basic_headings = { "ctr_size_Mb", "temp_size_Mb", "attach", "detach", "total", "inserts_sec" };
+            const std::array< std::string, 7 > basic_headings = { "mode", "ctr_size_Mb", "temp_size_Mb", "attach", "detach", "total", "inserts_sec" };
             const auto type_headings = aggregation_profiler_impl::record_traits<type>().get_headings();
 
             unsigned int count = 0;
@@ -184,7 +205,7 @@ namespace transport
 
             for(const std::string& col_title : type_headings)
               {
-                out << "," << col_title << "_time," << col_title << "_rows";
+                out << "," << col_title << "_time," << col_title << "_rows," << col_title << "_rows_sec";
               }
             out << '\n';
           }
@@ -196,7 +217,8 @@ namespace transport
     class aggregation_profile_record
       {
       public:
-        aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t);
+        aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t,
+                                   aggregation_mode m=aggregation_mode::incremental);
         virtual ~aggregation_profile_record() = default;
 
       public:
@@ -204,6 +226,7 @@ namespace transport
         virtual size_t get_rows() const = 0;
 
         const boost::posix_time::ptime& get_creation_time() const { return this->timestamp; }
+        aggregation_mode get_mode() const { return this->mode; }
         const boost::optional< boost::timer::nanosecond_type >& get_total_time() const { return this->total_time; }
 
         const boost::optional< boost::uintmax_t >& get_container_size() const { return this->container_size; }
@@ -227,15 +250,18 @@ namespace transport
       private:
         boost::filesystem::path container_path;
         boost::filesystem::path temporary_path;
+        aggregation_mode mode;
         boost::posix_time::ptime timestamp;
         boost::timer::cpu_timer timer;
       };
 
 
-    aggregation_profile_record::aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t)
+    aggregation_profile_record::aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t,
+                                                           aggregation_mode m)
       : timestamp(boost::posix_time::second_clock::local_time()),   // timestamp using local time for compatibility with report_manager
         container_path(c),
-        temporary_path(t)
+        temporary_path(t),
+        mode(m)
       {
         if(boost::filesystem::exists(c) && boost::filesystem::is_regular_file(c))
           {
@@ -257,7 +283,8 @@ namespace transport
 
     void aggregation_profile_record::write_row(std::ofstream& out) const
       {
-        out << aggregation_profiler_impl::format(this->container_size)            // will be formatted in Mb
+        out << aggregation_profiler_impl::format(this->mode)
+            << "," << aggregation_profiler_impl::format(this->container_size)     // will be formatted in Mb
             << "," << aggregation_profiler_impl::format(this->temporary_size)     // will be formatted in Mb
             << "," << aggregation_profiler_impl::format(this->attach_time)        // will be formatted in seconds
             << "," << aggregation_profiler_impl::format(this->detach_time)        // will be formatted in seconds
@@ -271,8 +298,9 @@ namespace transport
     class twopf_aggregation_profile_record: public aggregation_profile_record
       {
       public:
-        twopf_aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t)
-          : aggregation_profile_record(c, t)
+        twopf_aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t,
+                                         aggregation_mode m=aggregation_mode::incremental)
+          : aggregation_profile_record(c, t, m)
           {
           }
 
@@ -321,8 +349,9 @@ namespace transport
     class threepf_aggregation_profile_record: public aggregation_profile_record
       {
       public:
-        threepf_aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t)
-          : aggregation_profile_record(c, t)
+        threepf_aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t,
+                                           aggregation_mode m=aggregation_mode::incremental)
+          : aggregation_profile_record(c, t, m)
           {
           }
 
@@ -383,8 +412,9 @@ namespace transport
     class zeta_twopf_aggregation_profile_record: public aggregation_profile_record
       {
       public:
-        zeta_twopf_aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t)
-          : aggregation_profile_record(c, t)
+        zeta_twopf_aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t,
+                                              aggregation_mode m=aggregation_mode::incremental)
+          : aggregation_profile_record(c, t, m)
           {
           }
 
@@ -421,8 +451,9 @@ namespace transport
     class zeta_threepf_aggregation_profile_record: public aggregation_profile_record
       {
       public:
-        zeta_threepf_aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t)
-          : aggregation_profile_record(c, t)
+        zeta_threepf_aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t,
+                                                aggregation_mode m=aggregation_mode::incremental)
+          : aggregation_profile_record(c, t, m)
           {
           }
 
@@ -471,8 +502,9 @@ namespace transport
     class fNL_aggregation_profile_record: public aggregation_profile_record
       {
       public:
-        fNL_aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t)
-          : aggregation_profile_record(c, t)
+        fNL_aggregation_profile_record(const boost::filesystem::path& c, const boost::filesystem::path& t,
+                                       aggregation_mode m=aggregation_mode::incremental)
+          : aggregation_profile_record(c, t, m)
           {
           }
 
@@ -209,6 +209,9 @@ namespace transport
 
       public:
 
+        //! Return path to repository root
+        boost::filesystem::path get_abs_repo_path() const { return(this->paths.root); }
+
         //! Return path to output directory
         boost::filesystem::path get_abs_output_path() const { return(this->paths.root/this->paths.output); }
 
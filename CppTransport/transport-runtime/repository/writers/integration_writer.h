@@ -33,6 +33,7 @@
 #include <memory>
 #include <functional>
 #include <set>
+#include <list>
 
 #include "transport-runtime/serialization/serializable.h"
 
@@ -285,6 +286,26 @@ namespace transport
         void set_collecting_initial_conditions(bool g) { this->collect_initial_conditions = g; }
 
 
+        // SHARDED OUTPUT
+
+      public:
+
+        //! Is this writer keeping worker containers as shards?
+        bool is_sharded() const { return(this->sharded); }
+
+        //! Set sharded mode
+        void set_sharded(bool g) { this->sharded = g; }
+
+        //! Add a shard to the manifest
+        void add_shard(content_shard s) { this->shards.push_back(std::move(s)); }
+
+        //! Get shard manifest
+        std::list<content_shard>& get_shards() { return(this->shards); }
+
+        //! Get shard manifest (const version)
+        const std::list<content_shard>& get_shards() const { return(this->shards); }
+
+
         // METADATA
 
       public:
@@ -433,6 +454,15 @@ namespace transport
 		    bool collect_initial_conditions;
 
 
+        // SHARDED OUTPUT
+
+        //! are worker containers kept as shards?
+        bool sharded;
+
+        //! manifest of shards catalogued so far
+        std::list<content_shard> shards;
+
+
         // PROFILING SUPPORT
 
         //! profile gadget
@@ -462,6 +492,7 @@ namespace transport
 	      collect_statistics(rec.get_task()->get_model()->supports_per_configuration_statistics()),
 	      metadata(),
         data_type(data_type_name<number>()),
+        sharded(false),
         agg_profile(n)
 	    {
 	      twopf_db_task<number>* tk_as_twopf_list = dynamic_cast< twopf_db_task<number>* >(rec.get_task());
@@ -36,6 +36,9 @@ namespace transport
     constexpr auto CPPTRANSPORT_TEMPORARY_CONTAINER_STEM = "worker";
     constexpr auto CPPTRANSPORT_TEMPORARY_CONTAINER_XTN = ".sqlite";
 
+    constexpr auto CPPTRANSPORT_SHARD_CONTAINER_LEAF = "shards";
+    constexpr auto CPPTRANSPORT_SEED_SHARD_STEM = "seed_";
+
 
     // forward declare container replacement functions
     template <typename number> class sqlite3_container_replace_twopf;
@@ -427,6 +430,7 @@ namespace transport
         //! Create a new datapipe
         virtual std::unique_ptr< datapipe<number> > create_datapipe(const boost::filesystem::path& logdir,
                                                                     const boost::filesystem::path& tempdir,
+                                                                    const std::string& cache_id,
                                                                     integration_content_finder<number>& integration_finder,
                                                                     postintegration_content_finder<number>& postintegration_finder,
                                                                     datapipe_dispatch_function<number>& dispatcher,
@@ -467,6 +471,10 @@ namespace transport
         //! Pull a time sample of a background field from a datapipe
         virtual void pull_background_time_sample(datapipe<number>* pipe, unsigned int id, const derived_data::SQL_query& query, std::vector<number>& sample) override;
 
+        //! Pull the evolution of every background field from a datapipe, in bulk
+        virtual void pull_background_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                  std::vector< std::vector<number> >& history) override;
+
         //! Pull a time sample of a twopf component at fixed k-configuration from a datapipe
         virtual void pull_twopf_time_sample(datapipe<number>* pipe, unsigned int id, const derived_data::SQL_query& query,
                                             unsigned int k_serial, std::vector<number>& sample, twopf_type type) override;
@@ -479,6 +487,18 @@ namespace transport
         virtual void pull_tensor_twopf_time_sample(datapipe<number>* pipe, unsigned int id, const derived_data::SQL_query& query,
                                                    unsigned int k_serial, std::vector<number>& sample) override;
 
+        //! Pull the time history of every twopf component at fixed k-configuration from a datapipe, in bulk
+        virtual void pull_twopf_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                             unsigned int k_serial, std::vector< std::vector<number> >& history, twopf_type type) override;
+
+        //! Pull the time history of every threepf component at fixed k-configuration from a datapipe, in bulk
+        virtual void pull_threepf_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                               unsigned int k_serial, std::vector< std::vector<number> >& history, threepf_type type) override;
+
+        //! Pull the time history of every tensor twopf component at fixed k-configuration from a datapipe, in bulk
+        virtual void pull_tensor_twopf_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                    unsigned int k_serial, std::vector< std::vector<number> >& history) override;
+
         //! Pull a sample of the zeta twopf at fixed k-configuration from a datapipe
         virtual void pull_zeta_twopf_time_sample(datapipe<number>* pipe, const derived_data::SQL_query& query,
                                                  unsigned int k_serial, std::vector<number>& sample) override;
@@ -516,6 +536,18 @@ namespace transport
         virtual void pull_tensor_twopf_kconfig_sample(datapipe<number>* pipe, unsigned int id, const derived_data::SQL_query& query,
                                                       unsigned int t_serial, std::vector<number>& sample) override;
 
+        //! Pull every twopf component at fixed time from a datapipe, in bulk
+        virtual void pull_twopf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                unsigned int t_serial, std::vector< std::vector<number> >& history, twopf_type type) override;
+
+        //! Pull every threepf component at fixed time from a datapipe, in bulk
+        virtual void pull_threepf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                  unsigned int t_serial, std::vector< std::vector<number> >& history, threepf_type type) override;
+
+        //! Pull every tensor twopf component at fixed time from a datapipe, in bulk
+        virtual void pull_tensor_twopf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                       unsigned int t_serial, std::vector< std::vector<number> >& history) override;
+
         //! Pull a kconfig sample of the zeta twopf at fixed time from a datapipe
         virtual void pull_zeta_twopf_kconfig_sample(datapipe<number>* pipe, const derived_data::SQL_query& query,
                                                     unsigned int t_serial, std::vector<number>& sample) override;
@@ -528,6 +560,18 @@ namespace transport
         virtual void pull_zeta_redbsp_kconfig_sample(datapipe<number>* pipe, const derived_data::SQL_query& query,
                                                      unsigned int t_serial, std::vector<number>& sample) override;
 
+        //! Pull kconfig samples of the zeta twopf at several times from a datapipe, in a single pass
+        virtual void pull_zeta_twopf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                     const std::vector<unsigned int>& t_serials, std::vector< std::vector<number> >& lines) override;
+
+        //! Pull kconfig samples of the zeta threepf at several times from a datapipe, in a single pass
+        virtual void pull_zeta_threepf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                       const std::vector<unsigned int>& t_serials, std::vector< std::vector<number> >& lines) override;
+
+        //! Pull kconfig samples of the zeta reduced bispectrum at several times from a datapipe, in a single pass
+        virtual void pull_zeta_redbsp_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                      const std::vector<unsigned int>& t_serials, std::vector< std::vector<number> >& lines) override;
+
         //! Pull a sample of k-configuration statistics from a datapipe
         virtual void pull_k_statistics_sample(datapipe<number>* pipe, const derived_data::SQL_query& query,
                                               std::vector<kconfiguration_statistics>& data) override;
@@ -537,6 +581,31 @@ namespace transport
         //! Attach a SQLite database to a datapipe
         void datapipe_attach_container(datapipe<number>* pipe, const boost::filesystem::path& ctr_path);
 
+        //! Open a read-only connexion to a SQLite database for use by a datapipe
+        sqlite3* open_datapipe_connexion(const boost::filesystem::path& ctr_path);
+
+        //! Attach the shards of a sharded content group to a datapipe.
+        //! Each shard gets its own read-only connexion, with the principal container attached to it so that
+        //! the time and k-configuration sample tables resolve there. Readers in the datapipe's pool open
+        //! further connexions to a shard on first use, so that concurrent pulls from it are not serialized
+        void datapipe_attach_shards(datapipe<number>* pipe, const boost::filesystem::path& repo_root,
+                                    const boost::filesystem::path& ctr_path, const std::list<content_shard>& shards);
+
+        //! Open a read-only connexion to a shard, with the principal container attached
+        sqlite3* open_shard_connexion(const boost::filesystem::path& shard_path, const boost::filesystem::path& ctr_path);
+
+        //! Pull a kconfig sample from a sharded content group; each shard (and the principal container) is
+        //! queried separately, and the results are merged into k-configuration order
+        template <typename ValueType>
+        void pull_sharded_kconfig_sample(datapipe<number>* pipe, unsigned int id, const derived_data::SQL_query& query,
+                                         unsigned int t_serial, std::vector<number>& sample, storage_precision precision);
+
+        //! Pull every element of a paged table at fixed time; if the content group is sharded, each shard
+        //! (and the principal container) is queried separately and the results merged into k-configuration order
+        template <typename ValueType>
+        void pull_paged_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                        unsigned int t_serial, std::vector< std::vector<number> >& history, storage_precision precision);
+
 
         // RAW DATA ACCESS -- DOESN'T REQUIRE USE OF DATAPIPE
 
@@ -588,6 +657,37 @@ namespace transport
         boost::filesystem::path generate_lockfile_path(const boost::filesystem::path& tempdir, unsigned int worker);
 
 
+        // SHARDED OUTPUT
+
+      protected:
+
+        //! Open a read/write connexion to a shard container
+        sqlite3* open_shard_container(const boost::filesystem::path& ctr_path);
+
+        //! Move a worker container into the shard directory of a writer and add it to the writer's manifest
+        void catalogue_shard(integration_writer<number>& writer, const boost::filesystem::path& ctr_path);
+
+        //! Rebuild the shard manifest of a writer from the contents of its shard directory; used in recovery mode
+        void recover_shards(integration_writer<number>& writer);
+
+        //! Seed a writer from the shards of a sharded content group.
+        //! If the writer is sharded the seed shards are copied and catalogued; otherwise their rows are aggregated
+        void seed_shards(integration_writer<number>& writer, const content_group_record<integration_payload>& seed);
+
+        //! Remove from a set of missing serial numbers any which are present in a shard
+        template <typename ValueType>
+        void remove_sharded_serials(integration_writer<number>& writer, std::set<unsigned int>& missing);
+
+        //! Drop k-configurations from the shards of a writer; threepf selects whether drop_list refers to
+        //! twopf or threepf serial numbers
+        template <typename ValueType, typename Database>
+        void drop_shard_configurations(transaction_manager& mgr, integration_writer<number>& writer,
+                                       const std::set<unsigned int>& drop_list, const Database& dbase, bool threepf);
+
+        //! Build indexes for each shard of a writer, and bring the manifest up to date following any integrity-check drops
+        void finalize_shards(integration_writer<number>& writer);
+
+
         friend class sqlite3_container_replace_twopf<number>;
         friend class sqlite3_container_replace_threepf<number>;
         friend class sqlite3_container_replace_zeta_twopf<number>;
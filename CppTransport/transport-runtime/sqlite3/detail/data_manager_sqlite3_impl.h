@@ -190,10 +190,18 @@ namespace transport
         sqlite3_operations::container_write_pragmas(db, this->args.get_network_mode());
 #endif
 
+        // in sorted bulk-append mode, constraint enforcement is deferred until finalization
+        if(this->get_aggregation_mode() == aggregation_mode::sorted_bulk) sqlite3_operations::bulk_aggregation_pragmas(db);
+
         // remember this connexion
         this->open_containers.push_back(db);
         writer.set_data_manager_handle(db);
 
+        // in sharded mode, worker containers are catalogued as shards rather than having their
+        // correlation-function tables copied into the principal container
+        writer.set_sharded(this->get_sharded_output());
+        if(recovery_mode) this->recover_shards(writer);
+
         // set up aggregation handlers
         switch(writer.get_type())
           {
@@ -294,6 +302,9 @@ namespace transport
         sqlite3_operations::container_write_pragmas(db, this->args.get_network_mode());
 #endif
 
+        // in sorted bulk-append mode, constraint enforcement is deferred until finalization
+        if(this->get_aggregation_mode() == aggregation_mode::sorted_bulk) sqlite3_operations::bulk_aggregation_pragmas(db);
+
         // remember this connexion
         this->open_containers.push_back(db);
         writer.set_data_manager_handle(db);
@@ -609,6 +620,9 @@ namespace transport
 
         mgr.commit();
 
+        // correlation-function tables of a sharded seed group are held in its shards
+        if(seed.get_payload().is_sharded()) this->seed_shards(writer, seed);
+
         timer.stop();
         BOOST_LOG_SEV(writer.get_log(), base_writer::log_severity_level::notification)
           << "** Seeding complete in time " << format_time(timer.elapsed().wall);
@@ -650,6 +664,9 @@ namespace transport
 
         mgr.commit();
 
+        // correlation-function tables of a sharded seed group are held in its shards
+        if(seed.get_payload().is_sharded()) this->seed_shards(writer, seed);
+
         timer.stop();
         BOOST_LOG_SEV(writer.get_log(), base_writer::log_severity_level::notification)
           << "** Seeding complete in time " << format_time(timer.elapsed().wall);
@@ -783,16 +800,17 @@ namespace transport
         writers.factory      = [this, lockfile](integration_batcher<number>* b) -> transaction_manager { sqlite3* h = nullptr; b->get_manager_handle(&h); return this->transaction_factory(h, lockfile); };
         writers.host_info    = std::bind(&sqlite3_operations::write_host_info<number>, std::placeholders::_1, std::placeholders::_2);
         writers.stats        = std::bind(&sqlite3_operations::write_stats<number>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.ics          = std::bind(&sqlite3_operations::write_coordinate_output<number, typename integration_items<number>::ics_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.backg        = std::bind(&sqlite3_operations::write_coordinate_output<number, typename integration_items<number>::backg_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.twopf        = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::twopf_re_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.tensor_twopf = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::tensor_twopf_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+        writers.ics          = std::bind(&sqlite3_operations::write_coordinate_output<number, typename integration_items<number>::ics_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::ics));
+        writers.backg        = std::bind(&sqlite3_operations::write_coordinate_output<number, typename integration_items<number>::backg_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::backg));
+        writers.twopf        = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::twopf_re_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::twopf));
+        writers.tensor_twopf = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::tensor_twopf_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::tensor_twopf));
 
         // set up a replacement function
         std::unique_ptr< sqlite3_container_replace_twopf<number> > replacer = std::make_unique< sqlite3_container_replace_twopf<number> >(*this, tempdir, worker, m, tk->get_collect_initial_conditions());
 
         // set up batcher
         twopf_batcher<number> batcher(this->get_batcher_capacity(), this->get_checkpoint_interval(), m, tk, container, logdir, writers, std::move(dispatcher), std::move(replacer), db, worker, group);
+        batcher.set_sorted_flush(this->get_aggregation_mode() == aggregation_mode::sorted_bulk);
 
         BOOST_LOG_SEV(batcher.get_log(), generic_batcher::log_severity_level::normal) << "** Created new temporary twopf container " << container;
 
@@ -840,20 +858,21 @@ namespace transport
         writers.factory          = [this, lockfile](integration_batcher<number>* b) -> transaction_manager { sqlite3* h = nullptr; b->get_manager_handle(&h); return this->transaction_factory(h, lockfile); };
         writers.host_info        = std::bind(&sqlite3_operations::write_host_info<number>, std::placeholders::_1, std::placeholders::_2);
         writers.stats            = std::bind(&sqlite3_operations::write_stats<number>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.ics              = std::bind(&sqlite3_operations::write_coordinate_output<number, typename integration_items<number>::ics_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.kt_ics           = std::bind(&sqlite3_operations::write_coordinate_output<number, typename integration_items<number>::ics_kt_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.backg            = std::bind(&sqlite3_operations::write_coordinate_output<number, typename integration_items<number>::backg_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.twopf_re         = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::twopf_re_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.twopf_im         = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::twopf_im_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.tensor_twopf     = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::tensor_twopf_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.threepf_momentum = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::threepf_momentum_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.threepf_Nderiv   = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::threepf_Nderiv_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+        writers.ics              = std::bind(&sqlite3_operations::write_coordinate_output<number, typename integration_items<number>::ics_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::ics));
+        writers.kt_ics           = std::bind(&sqlite3_operations::write_coordinate_output<number, typename integration_items<number>::ics_kt_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::ics));
+        writers.backg            = std::bind(&sqlite3_operations::write_coordinate_output<number, typename integration_items<number>::backg_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::backg));
+        writers.twopf_re         = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::twopf_re_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::twopf));
+        writers.twopf_im         = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::twopf_im_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::twopf));
+        writers.tensor_twopf     = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::tensor_twopf_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::tensor_twopf));
+        writers.threepf_momentum = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::threepf_momentum_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::threepf));
+        writers.threepf_Nderiv   = std::bind(&sqlite3_operations::write_paged_output<number, integration_batcher<number>, typename integration_items<number>::threepf_Nderiv_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, tk->get_storage_precision(storage_table::threepf));
 
         // set up a replacement function
         std::unique_ptr< sqlite3_container_replace_threepf<number> > replacer = std::make_unique< sqlite3_container_replace_threepf<number> >(*this, tempdir, worker, m, tk->get_collect_initial_conditions());
 
         // set up batcher
         threepf_batcher<number> batcher(this->get_batcher_capacity(), this->get_checkpoint_interval(), m, tk, container, logdir, writers, std::move(dispatcher), std::move(replacer), db, worker, group);
+        batcher.set_sorted_flush(this->get_aggregation_mode() == aggregation_mode::sorted_bulk);
         BOOST_LOG_SEV(batcher.get_log(), generic_batcher::log_severity_level::normal) << "** Created new temporary threepf container " << container;
 
         // add this database to our list of open connections
@@ -906,13 +925,14 @@ namespace transport
         typename zeta_twopf_batcher<number>::writer_group writers;
         writers.factory    = [this, lockfile](postintegration_batcher<number>* b) -> transaction_manager { sqlite3* h = nullptr; b->get_manager_handle(&h); return this->transaction_factory(h, lockfile); };
         writers.twopf      = std::bind(&sqlite3_operations::write_unpaged<number, postintegration_batcher<number>, typename postintegration_items<number>::zeta_twopf_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.gauge_xfm1 = std::bind(&sqlite3_operations::write_paged_output<number, postintegration_batcher<number>, typename postintegration_items<number>::gauge_xfm1_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+        writers.gauge_xfm1 = std::bind(&sqlite3_operations::write_paged_output<number, postintegration_batcher<number>, typename postintegration_items<number>::gauge_xfm1_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, storage_precision::full);
 
         // set up replacement function
         std::unique_ptr< sqlite3_container_replace_zeta_twopf<number> > replacer = std::make_unique< sqlite3_container_replace_zeta_twopf<number> >(*this, tempdir, worker, m);
 
         // set up batcher
         zeta_twopf_batcher<number> batcher(this->get_batcher_capacity(), this->get_checkpoint_interval(), m, tk, container, logdir, writers, std::move(dispatcher), std::move(replacer), db, worker);
+        batcher.set_sorted_flush(this->get_aggregation_mode() == aggregation_mode::sorted_bulk);
 
         BOOST_LOG_SEV(batcher.get_log(), generic_batcher::log_severity_level::normal) << "** Created new temporary zeta twopf container " << container;
 
@@ -951,16 +971,17 @@ namespace transport
         writers.factory        = [this, lockfile](postintegration_batcher<number>* b) -> transaction_manager { sqlite3* h = nullptr; b->get_manager_handle(&h); return this->transaction_factory(h, lockfile); };
         writers.twopf          = std::bind(&sqlite3_operations::write_unpaged<number, postintegration_batcher<number>, typename postintegration_items<number>::zeta_twopf_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
         writers.threepf        = std::bind(&sqlite3_operations::write_unpaged<number, postintegration_batcher<number>, typename postintegration_items<number>::zeta_threepf_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.gauge_xfm1     = std::bind(&sqlite3_operations::write_paged_output<number, postintegration_batcher<number>, typename postintegration_items<number>::gauge_xfm1_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.gauge_xfm2_123 = std::bind(&sqlite3_operations::write_paged_output<number, postintegration_batcher<number>, typename postintegration_items<number>::gauge_xfm2_123_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.gauge_xfm2_213 = std::bind(&sqlite3_operations::write_paged_output<number, postintegration_batcher<number>, typename postintegration_items<number>::gauge_xfm2_213_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        writers.gauge_xfm2_312 = std::bind(&sqlite3_operations::write_paged_output<number, postintegration_batcher<number>, typename postintegration_items<number>::gauge_xfm2_312_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+        writers.gauge_xfm1     = std::bind(&sqlite3_operations::write_paged_output<number, postintegration_batcher<number>, typename postintegration_items<number>::gauge_xfm1_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, storage_precision::full);
+        writers.gauge_xfm2_123 = std::bind(&sqlite3_operations::write_paged_output<number, postintegration_batcher<number>, typename postintegration_items<number>::gauge_xfm2_123_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, storage_precision::full);
+        writers.gauge_xfm2_213 = std::bind(&sqlite3_operations::write_paged_output<number, postintegration_batcher<number>, typename postintegration_items<number>::gauge_xfm2_213_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, storage_precision::full);
+        writers.gauge_xfm2_312 = std::bind(&sqlite3_operations::write_paged_output<number, postintegration_batcher<number>, typename postintegration_items<number>::gauge_xfm2_312_item>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, storage_precision::full);
 
         // set up replacement function
         std::unique_ptr< sqlite3_container_replace_zeta_threepf<number> > replacer = std::make_unique< sqlite3_container_replace_zeta_threepf<number> >(*this, tempdir, worker, m);
 
         // set up batcher
         zeta_threepf_batcher<number> batcher(this->get_batcher_capacity(), this->get_checkpoint_interval(), m, tk, container, logdir, writers, std::move(dispatcher), std::move(replacer), db, worker);
+        batcher.set_sorted_flush(this->get_aggregation_mode() == aggregation_mode::sorted_bulk);
 
         BOOST_LOG_SEV(batcher.get_log(), generic_batcher::log_severity_level::normal) << "** Created new temporary zeta threepf container " << container;
 
@@ -1007,6 +1028,7 @@ namespace transport
 
         // set up batcher
         fNL_batcher<number> batcher(this->get_batcher_capacity(), this->get_checkpoint_interval(), m, tk, container, logdir, writers, std::move(dispatcher), std::move(replacer), db, worker, type);
+        batcher.set_sorted_flush(this->get_aggregation_mode() == aggregation_mode::sorted_bulk);
 
         BOOST_LOG_SEV(batcher.get_log(), generic_batcher::log_severity_level::normal) << "** Created new temporary " <<
             derived_data::template_type_to_string(type) << " container " << container;
@@ -1225,30 +1247,286 @@ namespace transport
       }
 
 
+    // SHARDED OUTPUT
+
+
+    template <typename number>
+    sqlite3* data_manager_sqlite3<number>::open_shard_container(const boost::filesystem::path& ctr_path)
+      {
+        if(!boost::filesystem::exists(ctr_path))
+          {
+            std::ostringstream msg;
+            msg << CPPTRANSPORT_DATAMGR_CONTAINER_NOT_EXIST << " '" << ctr_path.string() << "'";
+            throw runtime_exception(exception_type::RUNTIME_ERROR, msg.str());
+          }
+
+        sqlite3* db = nullptr;
+
+        int status = sqlite3_open_v2(ctr_path.string().c_str(), &db, SQLITE_OPEN_READWRITE, nullptr);
+
+        if(status != SQLITE_OK)
+          {
+            std::ostringstream msg;
+            if(db != nullptr)
+              {
+                msg << CPPTRANSPORT_DATACTR_OPEN_A << " '" << ctr_path.string() << "' " << CPPTRANSPORT_DATACTR_OPEN_B << status << ": " << sqlite3_errmsg(db) << ")";
+                sqlite3_close(db);
+              }
+            else
+              {
+                msg << CPPTRANSPORT_DATACTR_OPEN_A << " '" << ctr_path.string() << "' " << CPPTRANSPORT_DATACTR_OPEN_B << status << ")";
+              }
+            throw runtime_exception(exception_type::DATA_CONTAINER_ERROR, msg.str());
+          }
+
+        sqlite3_extended_result_codes(db, 1);
+        sqlite3_operations::consistency_pragmas(db);
+
+        this->open_containers.push_back(db);
+
+        return db;
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::catalogue_shard(integration_writer<number>& writer, const boost::filesystem::path& ctr_path)
+      {
+        boost::filesystem::path shard_dir = writer.get_abs_output_path() / CPPTRANSPORT_SHARD_CONTAINER_LEAF;
+        if(!boost::filesystem::exists(shard_dir)) boost::filesystem::create_directories(shard_dir);
+
+        // move the worker container into the shard directory, unless it is already there (eg. seed shards);
+        // temporary container names are only unique within a single run, so disambiguate if necessary
+        boost::filesystem::path shard_path = ctr_path;
+        if(ctr_path.parent_path() != shard_dir)
+          {
+            shard_path = shard_dir / ctr_path.filename();
+            for(unsigned int n = 1; boost::filesystem::exists(shard_path); ++n)
+              {
+                std::ostringstream leaf;
+                leaf << ctr_path.stem().string() << "_" << n << ctr_path.extension().string();
+                shard_path = shard_dir / leaf.str();
+              }
+
+            // rename() fails if the temporary directory is on a different filesystem, so fall back to copy+remove
+            boost::system::error_code ec;
+            boost::filesystem::rename(ctr_path, shard_path, ec);
+            if(ec)
+              {
+                boost::filesystem::copy_file(ctr_path, shard_path, ec);
+                if(!ec) boost::filesystem::remove(ctr_path, ec);
+              }
+
+            if(ec)
+              {
+                std::ostringstream msg;
+                msg << CPPTRANSPORT_DATACTR_SHARD_MOVE_FAIL << " '" << ctr_path.string() << "': " << ec.message();
+                throw runtime_exception(exception_type::DATA_CONTAINER_ERROR, msg.str());
+              }
+          }
+
+        // read the k-configurations held by this shard to build its manifest entry
+        sqlite3* db = this->open_container(shard_path);
+
+        std::set<unsigned int> twopf_serials = sqlite3_operations::get_stored_serials<number, typename integration_items<number>::twopf_re_item>(db);
+        std::set<unsigned int> threepf_serials;
+        if(writer.get_type() == integration_task_type::threepf)
+          threepf_serials = sqlite3_operations::get_stored_serials<number, typename integration_items<number>::threepf_momentum_item>(db);
+
+        this->close_container(db);
+
+        boost::filesystem::path relative_path = writer.get_relative_output_path() / CPPTRANSPORT_SHARD_CONTAINER_LEAF / shard_path.filename();
+        writer.add_shard(content_shard(relative_path, std::move(twopf_serials), std::move(threepf_serials)));
+
+        BOOST_LOG_SEV(writer.get_log(), base_writer::log_severity_level::normal) << "++ Catalogued shard '" << relative_path.string() << "'";
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::recover_shards(integration_writer<number>& writer)
+      {
+        boost::filesystem::path shard_dir = writer.get_abs_output_path() / CPPTRANSPORT_SHARD_CONTAINER_LEAF;
+        if(!boost::filesystem::exists(shard_dir) || !boost::filesystem::is_directory(shard_dir)) return;
+
+        // collect shard containers in a fixed order, so the rebuilt manifest does not depend on directory iteration order
+        std::set<boost::filesystem::path> containers;
+        for(boost::filesystem::directory_iterator t(shard_dir); t != boost::filesystem::directory_iterator(); ++t)
+          {
+            if(boost::filesystem::is_regular_file(t->path()) && t->path().extension() == CPPTRANSPORT_TEMPORARY_CONTAINER_XTN) containers.insert(t->path());
+          }
+
+        if(containers.empty()) return;
+
+        // a recovered group is sharded whatever the current setting, because some of its content is already in shards
+        writer.set_sharded(true);
+        for(const boost::filesystem::path& p : containers)
+          {
+            this->catalogue_shard(writer, p);
+          }
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::seed_shards(integration_writer<number>& writer, const content_group_record<integration_payload>& seed)
+      {
+        const std::list<content_shard>& shards = seed.get_payload().get_shards();
+        bool threepf = writer.get_type() == integration_task_type::threepf;
+
+        if(writer.is_sharded())
+          {
+            // copy each seed shard into our shard directory; shards are immutable once catalogued, so
+            // copying is enough and the seed group is left untouched
+            boost::filesystem::path shard_dir = writer.get_abs_output_path() / CPPTRANSPORT_SHARD_CONTAINER_LEAF;
+            if(!boost::filesystem::exists(shard_dir)) boost::filesystem::create_directories(shard_dir);
+
+            for(const content_shard& shard : shards)
+              {
+                boost::filesystem::path seed_path = seed.get_abs_repo_path() / shard.get_container_path();
+                boost::filesystem::path dest_path = shard_dir / (std::string(CPPTRANSPORT_SEED_SHARD_STEM) + seed_path.filename().string());
+
+                if(boost::filesystem::exists(dest_path)) boost::filesystem::remove(dest_path);
+                boost::filesystem::copy_file(seed_path, dest_path);
+                this->catalogue_shard(writer, dest_path);
+              }
+
+            return;
+          }
+
+        // otherwise, aggregate the correlation-function tables of each seed shard into our principal container
+        sqlite3* db = nullptr;
+        writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
+
+        for(const content_shard& shard : shards)
+          {
+            boost::filesystem::path seed_path = seed.get_abs_repo_path() / shard.get_container_path();
+            sqlite3_operations::attach_manager mgr(db, seed_path);
+
+            sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::twopf_re_item>(mgr, writer);
+            sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::tensor_twopf_item>(mgr, writer);
+
+            if(threepf)
+              {
+                sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::twopf_im_item>(mgr, writer);
+                sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::threepf_momentum_item>(mgr, writer);
+                sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::threepf_Nderiv_item>(mgr, writer);
+              }
+
+            mgr.commit();
+          }
+      }
+
+
+    template <typename number>
+    template <typename ValueType>
+    void data_manager_sqlite3<number>::remove_sharded_serials(integration_writer<number>& writer, std::set<unsigned int>& missing)
+      {
+        for(const content_shard& shard : writer.get_shards())
+          {
+            if(missing.empty()) return;
+
+            sqlite3* db = this->open_container(writer.get_abs_repo_path() / shard.get_container_path());
+            std::set<unsigned int> stored = sqlite3_operations::get_stored_serials<number, ValueType>(db);
+            this->close_container(db);
+
+            for(unsigned int serial : stored) missing.erase(serial);
+          }
+      }
+
+
+    template <typename number>
+    template <typename ValueType, typename Database>
+    void data_manager_sqlite3<number>::drop_shard_configurations(transaction_manager& mgr, integration_writer<number>& writer,
+                                                                 const std::set<unsigned int>& drop_list, const Database& dbase, bool threepf)
+      {
+        for(const content_shard& shard : writer.get_shards())
+          {
+            // only visit shards which hold some of the configurations to be dropped
+            const std::set<unsigned int>& held = threepf ? shard.get_threepf_serials() : shard.get_twopf_serials();
+
+            std::set<unsigned int> shard_drop_list;
+            std::set_intersection(drop_list.begin(), drop_list.end(), held.begin(), held.end(), std::inserter(shard_drop_list, shard_drop_list.begin()));
+            if(shard_drop_list.empty()) continue;
+
+            // each shard is a separate database, so the outer transaction on the principal container does not cover it
+            sqlite3* db = this->open_shard_container(writer.get_abs_repo_path() / shard.get_container_path());
+
+            this->begin_transaction(db);
+            sqlite3_operations::drop_k_configurations(mgr, db, writer, shard_drop_list, dbase,
+                                                      sqlite3_operations::data_traits<number, ValueType>::sqlite_table());
+            this->commit_transaction(db);
+
+            this->close_container(db);
+          }
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::finalize_shards(integration_writer<number>& writer)
+      {
+        bool threepf = writer.get_type() == integration_task_type::threepf;
+        boost::filesystem::path lockfile = writer.get_abs_container_path().parent_path() / CPPTRANSPORT_DATAMGR_LOCKFILE_LEAF;
+
+        std::list<content_shard> finalized;
+        for(const content_shard& shard : writer.get_shards())
+          {
+            sqlite3* db = this->open_shard_container(writer.get_abs_repo_path() / shard.get_container_path());
+
+            // shards are written by workers, which never defer constraint checks, so finalize in incremental mode
+            transaction_manager mgr = this->transaction_factory(db, lockfile);
+            if(threepf) sqlite3_operations::finalize_threepf_writer(mgr, db);
+            else        sqlite3_operations::finalize_twopf_writer(mgr, db);
+            mgr.commit();
+
+            // rebuild manifest entry, which may have changed if the integrity check dropped configurations
+            std::set<unsigned int> twopf_serials = sqlite3_operations::get_stored_serials<number, typename integration_items<number>::twopf_re_item>(db);
+            std::set<unsigned int> threepf_serials;
+            if(threepf) threepf_serials = sqlite3_operations::get_stored_serials<number, typename integration_items<number>::threepf_momentum_item>(db);
+
+            finalized.emplace_back(shard.get_container_path(), std::move(twopf_serials), std::move(threepf_serials));
+
+            sqlite3_operations::force_truncate_journal(db);
+            this->close_container(db);
+          }
+
+        writer.get_shards().swap(finalized);
+
+        BOOST_LOG_SEV(writer.get_log(), base_writer::log_severity_level::notification)
+          << "** Finalized " << writer.get_shards().size() << " shards";
+      }
+
+
     template <typename number>
     bool data_manager_sqlite3<number>::aggregate_twopf_batch(integration_writer<number>& writer, const boost::filesystem::path& temp_ctr)
       {
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        std::unique_ptr< twopf_aggregation_profile_record > record = std::make_unique< twopf_aggregation_profile_record >(writer.get_abs_container_path(), temp_ctr);
+        aggregation_mode mode = this->get_aggregation_mode();
+        std::unique_ptr< twopf_aggregation_profile_record > record = std::make_unique< twopf_aggregation_profile_record >(writer.get_abs_container_path(), temp_ctr, mode);
         sqlite3_operations::attach_manager mgr(db, temp_ctr, *record);
 
-        record->backg        = sqlite3_operations::aggregate_backg<number>(mgr, writer);
-        record->twopf_re     = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::twopf_re_item>(mgr, writer);
-        record->tensor_twopf = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::tensor_twopf_item>(mgr, writer);
+        record->backg        = sqlite3_operations::aggregate_backg<number>(mgr, writer, mode);
+
+        // in sharded mode the correlation-function tables stay in the worker container, which becomes a shard
+        if(!writer.is_sharded())
+          {
+            record->twopf_re     = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::twopf_re_item>(mgr, writer, mode);
+            record->tensor_twopf = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::tensor_twopf_item>(mgr, writer, mode);
+          }
 
         record->workers = sqlite3_operations::aggregate_workers<number>(mgr, writer);
         if(writer.is_collecting_statistics()) record->statistics = sqlite3_operations::aggregate_statistics<number>(mgr, writer);
 
         if(writer.is_collecting_initial_conditions())
-          record->ics = sqlite3_operations::aggregate_ics<number, typename integration_items<number>::ics_item>(mgr, writer);
+          record->ics = sqlite3_operations::aggregate_ics<number, typename integration_items<number>::ics_item>(mgr, writer, mode);
 
         // commit aggregation and report profiling data
         mgr.commit();
         record->stop();
         writer.get_aggregation_profiler().add_record(std::move(record));
 
+        // the temporary container is detached once the aggregation has committed, so it can now be moved into place
+        if(writer.is_sharded()) this->catalogue_shard(writer, temp_ctr);
+
         return(true);
       }
 
@@ -1259,23 +1537,29 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        std::unique_ptr< threepf_aggregation_profile_record > record = std::make_unique< threepf_aggregation_profile_record >(writer.get_abs_container_path(), temp_ctr);
+        aggregation_mode mode = this->get_aggregation_mode();
+        std::unique_ptr< threepf_aggregation_profile_record > record = std::make_unique< threepf_aggregation_profile_record >(writer.get_abs_container_path(), temp_ctr, mode);
         sqlite3_operations::attach_manager mgr(db, temp_ctr, *record);
 
-        record->backg            = sqlite3_operations::aggregate_backg<number>(mgr, writer);
-        record->twopf_re         = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::twopf_re_item>(mgr, writer);
-        record->twopf_im         = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::twopf_im_item>(mgr, writer);
-        record->tensor_twopf     = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::tensor_twopf_item>(mgr, writer);
-        record->threepf_momentum = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::threepf_momentum_item>(mgr, writer);
-        record->threepf_Nderiv   = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::threepf_Nderiv_item>(mgr, writer);
+        record->backg            = sqlite3_operations::aggregate_backg<number>(mgr, writer, mode);
+
+        // in sharded mode the correlation-function tables stay in the worker container, which becomes a shard
+        if(!writer.is_sharded())
+          {
+            record->twopf_re         = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::twopf_re_item>(mgr, writer, mode);
+            record->twopf_im         = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::twopf_im_item>(mgr, writer, mode);
+            record->tensor_twopf     = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::tensor_twopf_item>(mgr, writer, mode);
+            record->threepf_momentum = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::threepf_momentum_item>(mgr, writer, mode);
+            record->threepf_Nderiv   = sqlite3_operations::aggregate_table<number, integration_writer<number>, typename integration_items<number>::threepf_Nderiv_item>(mgr, writer, mode);
+          }
 
         record->workers = sqlite3_operations::aggregate_workers<number>(mgr, writer);
         if(writer.is_collecting_statistics()) record->statistics = sqlite3_operations::aggregate_statistics<number>(mgr, writer);
 
         if(writer.is_collecting_initial_conditions())
           {
-            record->ics    = sqlite3_operations::aggregate_ics<number, typename integration_items<number>::ics_item>(mgr, writer);
-            record->ics_kt = sqlite3_operations::aggregate_ics<number, typename integration_items<number>::ics_kt_item>(mgr, writer);
+            record->ics    = sqlite3_operations::aggregate_ics<number, typename integration_items<number>::ics_item>(mgr, writer, mode);
+            record->ics_kt = sqlite3_operations::aggregate_ics<number, typename integration_items<number>::ics_kt_item>(mgr, writer, mode);
           }
 
         // commit aggregation and report profiling data
@@ -1283,6 +1567,9 @@ namespace transport
         record->stop();
         writer.get_aggregation_profiler().add_record(std::move(record));
 
+        // the temporary container is detached once the aggregation has committed, so it can now be moved into place
+        if(writer.is_sharded()) this->catalogue_shard(writer, temp_ctr);
+
         return(true);
       }
 
@@ -1293,11 +1580,12 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        std::unique_ptr< zeta_twopf_aggregation_profile_record > record = std::make_unique< zeta_twopf_aggregation_profile_record >(writer.get_abs_container_path(), temp_ctr);
+        aggregation_mode mode = this->get_aggregation_mode();
+        std::unique_ptr< zeta_twopf_aggregation_profile_record > record = std::make_unique< zeta_twopf_aggregation_profile_record >(writer.get_abs_container_path(), temp_ctr, mode);
         sqlite3_operations::attach_manager mgr(db, temp_ctr, *record);
 
-        record->twopf      = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::zeta_twopf_item>(mgr, writer);
-        record->gauge_xfm1 = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::gauge_xfm1_item>(mgr, writer);
+        record->twopf      = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::zeta_twopf_item>(mgr, writer, mode);
+        record->gauge_xfm1 = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::gauge_xfm1_item>(mgr, writer, mode);
 
         // commit aggregation and report profiling data
         mgr.commit();
@@ -1314,15 +1602,16 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        std::unique_ptr< zeta_threepf_aggregation_profile_record > record = std::make_unique< zeta_threepf_aggregation_profile_record >(writer.get_abs_container_path(), temp_ctr);
+        aggregation_mode mode = this->get_aggregation_mode();
+        std::unique_ptr< zeta_threepf_aggregation_profile_record > record = std::make_unique< zeta_threepf_aggregation_profile_record >(writer.get_abs_container_path(), temp_ctr, mode);
         sqlite3_operations::attach_manager mgr(db, temp_ctr, *record);
 
-        record->twopf          = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::zeta_twopf_item>(mgr, writer);
-        record->threepf        = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::zeta_threepf_item>(mgr, writer);
-        record->gauge_xfm1     = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::gauge_xfm1_item>(mgr, writer);
-        record->gauge_xfm2_123 = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::gauge_xfm2_123_item>(mgr, writer);
-        record->gauge_xfm2_213 = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::gauge_xfm2_213_item>(mgr, writer);
-        record->gauge_xfm2_312 = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::gauge_xfm2_312_item>(mgr, writer);
+        record->twopf          = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::zeta_twopf_item>(mgr, writer, mode);
+        record->threepf        = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::zeta_threepf_item>(mgr, writer, mode);
+        record->gauge_xfm1     = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::gauge_xfm1_item>(mgr, writer, mode);
+        record->gauge_xfm2_123 = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::gauge_xfm2_123_item>(mgr, writer, mode);
+        record->gauge_xfm2_213 = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::gauge_xfm2_213_item>(mgr, writer, mode);
+        record->gauge_xfm2_312 = sqlite3_operations::aggregate_table<number, postintegration_writer<number>, typename postintegration_items<number>::gauge_xfm2_312_item>(mgr, writer, mode);
 
         // commit aggregation and report profiling data
         mgr.commit();
@@ -1339,7 +1628,8 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        std::unique_ptr< fNL_aggregation_profile_record > record = std::make_unique< fNL_aggregation_profile_record >(writer.get_abs_container_path(), temp_ctr);
+        aggregation_mode mode = this->get_aggregation_mode();
+        std::unique_ptr< fNL_aggregation_profile_record > record = std::make_unique< fNL_aggregation_profile_record >(writer.get_abs_container_path(), temp_ctr, mode);
         sqlite3_operations::attach_manager mgr(db, temp_ctr, *record);
 
         record->fNL = sqlite3_operations::aggregate_fNL<number>(mgr, writer, type);
@@ -1404,7 +1694,12 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        return sqlite3_operations::get_missing_serials<number, typename integration_items<number>::twopf_re_item>(db);
+        std::set<unsigned int> missing = sqlite3_operations::get_missing_serials<number, typename integration_items<number>::twopf_re_item>(db);
+
+        // configurations held in a shard are not missing
+        if(writer.is_sharded()) this->template remove_sharded_serials<typename integration_items<number>::twopf_re_item>(writer, missing);
+
+        return missing;
       }
 
 
@@ -1415,7 +1710,12 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        return sqlite3_operations::get_missing_serials<number, typename integration_items<number>::twopf_im_item>(db);
+        std::set<unsigned int> missing = sqlite3_operations::get_missing_serials<number, typename integration_items<number>::twopf_im_item>(db);
+
+        // configurations held in a shard are not missing
+        if(writer.is_sharded()) this->template remove_sharded_serials<typename integration_items<number>::twopf_im_item>(writer, missing);
+
+        return missing;
       }
 
 
@@ -1426,7 +1726,12 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        return sqlite3_operations::get_missing_serials<number, typename integration_items<number>::tensor_twopf_item>(db);
+        std::set<unsigned int> missing = sqlite3_operations::get_missing_serials<number, typename integration_items<number>::tensor_twopf_item>(db);
+
+        // configurations held in a shard are not missing
+        if(writer.is_sharded()) this->template remove_sharded_serials<typename integration_items<number>::tensor_twopf_item>(writer, missing);
+
+        return missing;
       }
 
 
@@ -1437,7 +1742,12 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        return sqlite3_operations::get_missing_serials<number, typename integration_items<number>::threepf_momentum_item>(db);
+        std::set<unsigned int> missing = sqlite3_operations::get_missing_serials<number, typename integration_items<number>::threepf_momentum_item>(db);
+
+        // configurations held in a shard are not missing
+        if(writer.is_sharded()) this->template remove_sharded_serials<typename integration_items<number>::threepf_momentum_item>(writer, missing);
+
+        return missing;
       }
 
 
@@ -1448,7 +1758,12 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        return sqlite3_operations::get_missing_serials<number, typename integration_items<number>::threepf_Nderiv_item>(db);
+        std::set<unsigned int> missing = sqlite3_operations::get_missing_serials<number, typename integration_items<number>::threepf_Nderiv_item>(db);
+
+        // configurations held in a shard are not missing
+        if(writer.is_sharded()) this->template remove_sharded_serials<typename integration_items<number>::threepf_Nderiv_item>(writer, missing);
+
+        return missing;
       }
 
 
@@ -1533,6 +1848,9 @@ namespace transport
 
         sqlite3_operations::drop_k_configurations(mgr, db, writer, drop_list, dbase,
                                                   sqlite3_operations::data_traits<number, typename integration_items<number>::twopf_re_item>::sqlite_table());
+
+        if(writer.is_sharded())
+          this->template drop_shard_configurations<typename integration_items<number>::twopf_re_item>(mgr, writer, drop_list, dbase, false);
       }
 
 
@@ -1551,6 +1869,9 @@ namespace transport
 
         sqlite3_operations::drop_k_configurations(mgr, db, writer, drop_list, dbase,
                                                   sqlite3_operations::data_traits<number, typename integration_items<number>::twopf_im_item>::sqlite_table());
+
+        if(writer.is_sharded())
+          this->template drop_shard_configurations<typename integration_items<number>::twopf_im_item>(mgr, writer, drop_list, dbase, false);
       }
 
 
@@ -1569,6 +1890,9 @@ namespace transport
 
         sqlite3_operations::drop_k_configurations(mgr, db, writer, drop_list, dbase,
                                                   sqlite3_operations::data_traits<number, typename integration_items<number>::tensor_twopf_item>::sqlite_table());
+
+        if(writer.is_sharded())
+          this->template drop_shard_configurations<typename integration_items<number>::tensor_twopf_item>(mgr, writer, drop_list, dbase, false);
       }
 
 
@@ -1587,6 +1911,9 @@ namespace transport
 
         sqlite3_operations::drop_k_configurations(mgr, db, writer, drop_list, dbase,
                                                   sqlite3_operations::data_traits<number, typename integration_items<number>::threepf_momentum_item>::sqlite_table());
+
+        if(writer.is_sharded())
+          this->template drop_shard_configurations<typename integration_items<number>::threepf_momentum_item>(mgr, writer, drop_list, dbase, true);
       }
 
 
@@ -1605,6 +1932,9 @@ namespace transport
 
         sqlite3_operations::drop_k_configurations(mgr, db, writer, drop_list, dbase,
                                                   sqlite3_operations::data_traits<number, typename integration_items<number>::threepf_Nderiv_item>::sqlite_table());
+
+        if(writer.is_sharded())
+          this->template drop_shard_configurations<typename integration_items<number>::threepf_Nderiv_item>(mgr, writer, drop_list, dbase, true);
       }
 
 
@@ -1803,7 +2133,7 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        sqlite3_operations::finalize_twopf_writer(mgr, db);
+        sqlite3_operations::finalize_twopf_writer(mgr, db, this->get_aggregation_mode());
 
         mgr.commit();
 
@@ -1813,6 +2143,9 @@ namespace transport
         // (the journal mode can only be changed outside a transaction, so we have to do this after mgr.commit())
         sqlite3_operations::force_truncate_journal(db);
 
+        // shards are finalized separately, after the transaction on the principal container has been released
+        if(writer.is_sharded()) this->finalize_shards(writer);
+
         timer.stop();
         BOOST_LOG_SEV(writer.get_log(), base_writer::log_severity_level::notification)
           << "** Finalization complete in time " << format_time(timer.elapsed().wall);
@@ -1833,7 +2166,7 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        sqlite3_operations::finalize_threepf_writer(mgr, db);
+        sqlite3_operations::finalize_threepf_writer(mgr, db, this->get_aggregation_mode());
 
         mgr.commit();
 
@@ -1843,6 +2176,9 @@ namespace transport
         // (the journal mode can only be changed outside a transaction, so we have to do this after mgr.commit())
         sqlite3_operations::force_truncate_journal(db);
 
+        // shards are finalized separately, after the transaction on the principal container has been released
+        if(writer.is_sharded()) this->finalize_shards(writer);
+
         timer.stop();
         BOOST_LOG_SEV(writer.get_log(), base_writer::log_severity_level::notification)
           << "** Finalization complete in time " << format_time(timer.elapsed().wall);
@@ -1863,7 +2199,7 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        sqlite3_operations::finalize_zeta_twopf_writer(mgr, db);
+        sqlite3_operations::finalize_zeta_twopf_writer(mgr, db, this->get_aggregation_mode());
 
         mgr.commit();
 
@@ -1893,7 +2229,7 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        sqlite3_operations::finalize_zeta_threepf_writer(mgr, db);
+        sqlite3_operations::finalize_zeta_threepf_writer(mgr, db, this->get_aggregation_mode());
 
         mgr.commit();
 
@@ -1923,7 +2259,7 @@ namespace transport
         sqlite3* db = nullptr;
         writer.get_data_manager_handle(&db); // throws an exception if handle is unset, so the return value is guaranteed not to be nullptr
 
-        sqlite3_operations::finalize_fNL_writer(mgr, db);
+        sqlite3_operations::finalize_fNL_writer(mgr, db, this->get_aggregation_mode());
 
         mgr.commit();
 
@@ -1944,6 +2280,7 @@ namespace transport
 
     template <typename number>
     std::unique_ptr< datapipe<number> > data_manager_sqlite3<number>::create_datapipe(const boost::filesystem::path& logdir, const boost::filesystem::path& tempdir,
+                                                                                      const std::string& cache_id,
                                                                                       integration_content_finder<number>& integration_finder,
                                                                                       postintegration_content_finder<number>& postintegration_finder,
                                                                                       datapipe_dispatch_function<number>& dispatcher,
@@ -1953,7 +2290,7 @@ namespace transport
         typename datapipe<number>::utility_callbacks utilities(integration_finder, postintegration_finder, dispatcher);
 
         // set up datapipe
-        return std::make_unique< datapipe<number> >(this->get_pipe_capacity(), logdir, tempdir, worker, *this, utilities, no_log);
+        return std::make_unique< datapipe<number> >(this->get_pipe_capacity(), this->get_pipe_readers(), this->get_node_cache_capacity(), logdir, tempdir, cache_id, worker, *this, utilities, no_log);
       }
 
 
@@ -2009,7 +2346,23 @@ namespace transport
         sqlite3* db = nullptr;
         pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
 
-        sqlite3_operations::pull_background_time_sample(db, id, query, sample, pipe->get_worker_number(), pipe->get_N_fields());
+        sqlite3_operations::pull_background_time_sample(db, id, query, sample, pipe->get_worker_number(), pipe->get_N_fields(),
+                                                        pipe->get_storage_precision(storage_table::backg));
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::pull_background_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                                    std::vector< std::vector<number> >& history)
+      {
+        assert(pipe != nullptr);
+        if(pipe == nullptr) throw runtime_exception(exception_type::RUNTIME_ERROR, CPPTRANSPORT_DATAMGR_NULL_DATAPIPE);
+
+        sqlite3* db = nullptr;
+        pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
+
+        sqlite3_operations::pull_background_time_history(db, query, history, pipe->get_worker_number(), pipe->get_N_fields(),
+                                                         pipe->get_storage_precision(storage_table::backg));
       }
 
 
@@ -2024,19 +2377,24 @@ namespace transport
         sqlite3* db = nullptr;
         pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
 
+        // if the attached group is sharded, read from the shard holding this configuration
+        pipe->get_twopf_shard_handle(k_serial, &db);
+
         switch(type)
           {
             case twopf_type::real:
               {
                 sqlite3_operations::pull_paged_time_sample<number, typename integration_items<number>::twopf_re_item>(db, id, query, k_serial, sample,
-                                                                                                                      pipe->get_worker_number(), pipe->get_N_fields());
+                                                                                                                      pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                      pipe->get_storage_precision(storage_table::twopf));
                 break;
               }
 
             case twopf_type::imag:
               {
                 sqlite3_operations::pull_paged_time_sample<number, typename integration_items<number>::twopf_im_item>(db, id, query, k_serial, sample,
-                                                                                                                      pipe->get_worker_number(), pipe->get_N_fields());
+                                                                                                                      pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                      pipe->get_storage_precision(storage_table::twopf));
                 break;
               }
           }
@@ -2054,19 +2412,24 @@ namespace transport
         sqlite3* db = nullptr;
         pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
 
+        // if the attached group is sharded, read from the shard holding this configuration
+        pipe->get_threepf_shard_handle(k_serial, &db);
+
         switch(type)
           {
             case threepf_type::momentum:
               {
                 sqlite3_operations::pull_paged_time_sample<number, typename integration_items<number>::threepf_momentum_item>(db, id, query, k_serial, sample,
-                                                                                                                              pipe->get_worker_number(), pipe->get_N_fields());
+                                                                                                                              pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                              pipe->get_storage_precision(storage_table::threepf));
                 break;
               }
 
             case threepf_type::Nderiv:
               {
                 sqlite3_operations::pull_paged_time_sample<number, typename integration_items<number>::threepf_Nderiv_item>(db, id, query, k_serial, sample,
-                                                                                                                            pipe->get_worker_number(), pipe->get_N_fields());
+                                                                                                                            pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                            pipe->get_storage_precision(storage_table::threepf));
                 break;
               }
           }
@@ -2084,8 +2447,99 @@ namespace transport
         sqlite3* db = nullptr;
         pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
 
+        // if the attached group is sharded, read from the shard holding this configuration
+        pipe->get_twopf_shard_handle(k_serial, &db);
+
         sqlite3_operations::pull_paged_time_sample<number, typename integration_items<number>::tensor_twopf_item>(db, id, query, k_serial, sample,
-                                                                                                                  pipe->get_worker_number(), pipe->get_N_fields());
+                                                                                                                  pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                  pipe->get_storage_precision(storage_table::tensor_twopf));
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::pull_twopf_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                               unsigned int k_serial, std::vector< std::vector<number> >& history, twopf_type type)
+      {
+        assert(pipe != nullptr);
+        if(pipe == nullptr) throw runtime_exception(exception_type::RUNTIME_ERROR, CPPTRANSPORT_DATAMGR_NULL_DATAPIPE);
+
+        sqlite3* db = nullptr;
+        pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
+
+        // if the attached group is sharded, read from the shard holding this configuration
+        pipe->get_twopf_shard_handle(k_serial, &db);
+
+        switch(type)
+          {
+            case twopf_type::real:
+              {
+                sqlite3_operations::pull_paged_time_history<number, typename integration_items<number>::twopf_re_item>(db, query, k_serial, history,
+                                                                                                                       pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                       pipe->get_storage_precision(storage_table::twopf));
+                break;
+              }
+
+            case twopf_type::imag:
+              {
+                sqlite3_operations::pull_paged_time_history<number, typename integration_items<number>::twopf_im_item>(db, query, k_serial, history,
+                                                                                                                       pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                       pipe->get_storage_precision(storage_table::twopf));
+                break;
+              }
+          }
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::pull_threepf_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                                 unsigned int k_serial, std::vector< std::vector<number> >& history, threepf_type type)
+      {
+        assert(pipe != nullptr);
+        if(pipe == nullptr) throw runtime_exception(exception_type::RUNTIME_ERROR, CPPTRANSPORT_DATAMGR_NULL_DATAPIPE);
+
+        sqlite3* db = nullptr;
+        pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
+
+        // if the attached group is sharded, read from the shard holding this configuration
+        pipe->get_threepf_shard_handle(k_serial, &db);
+
+        switch(type)
+          {
+            case threepf_type::momentum:
+              {
+                sqlite3_operations::pull_paged_time_history<number, typename integration_items<number>::threepf_momentum_item>(db, query, k_serial, history,
+                                                                                                                               pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                               pipe->get_storage_precision(storage_table::threepf));
+                break;
+              }
+
+            case threepf_type::Nderiv:
+              {
+                sqlite3_operations::pull_paged_time_history<number, typename integration_items<number>::threepf_Nderiv_item>(db, query, k_serial, history,
+                                                                                                                             pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                             pipe->get_storage_precision(storage_table::threepf));
+                break;
+              }
+          }
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::pull_tensor_twopf_time_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                                      unsigned int k_serial, std::vector< std::vector<number> >& history)
+      {
+        assert(pipe != nullptr);
+        if(pipe == nullptr) throw runtime_exception(exception_type::RUNTIME_ERROR, CPPTRANSPORT_DATAMGR_NULL_DATAPIPE);
+
+        sqlite3* db = nullptr;
+        pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
+
+        // if the attached group is sharded, read from the shard holding this configuration
+        pipe->get_twopf_shard_handle(k_serial, &db);
+
+        sqlite3_operations::pull_paged_time_history<number, typename integration_items<number>::tensor_twopf_item>(db, query, k_serial, history,
+                                                                                                                   pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                   pipe->get_storage_precision(storage_table::tensor_twopf));
       }
 
 
@@ -2191,15 +2645,25 @@ namespace transport
           {
             case twopf_type::real:
               {
-                sqlite3_operations::pull_paged_kconfig_sample<number, typename integration_items<number>::twopf_re_item>(db, id, query, t_serial, sample,
-                                                                                                                         pipe->get_worker_number(), pipe->get_N_fields());
+                if(pipe->is_sharded())
+                  this->template pull_sharded_kconfig_sample<typename integration_items<number>::twopf_re_item>(pipe, id, query, t_serial, sample,
+                                                                                                                pipe->get_storage_precision(storage_table::twopf));
+                else
+                  sqlite3_operations::pull_paged_kconfig_sample<number, typename integration_items<number>::twopf_re_item>(db, id, query, t_serial, sample,
+                                                                                                                           pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                           pipe->get_storage_precision(storage_table::twopf));
                 break;
               }
 
             case twopf_type::imag:
               {
-                sqlite3_operations::pull_paged_kconfig_sample<number, typename integration_items<number>::twopf_im_item>(db, id, query, t_serial, sample,
-                                                                                                                         pipe->get_worker_number(), pipe->get_N_fields());
+                if(pipe->is_sharded())
+                  this->template pull_sharded_kconfig_sample<typename integration_items<number>::twopf_im_item>(pipe, id, query, t_serial, sample,
+                                                                                                                pipe->get_storage_precision(storage_table::twopf));
+                else
+                  sqlite3_operations::pull_paged_kconfig_sample<number, typename integration_items<number>::twopf_im_item>(db, id, query, t_serial, sample,
+                                                                                                                           pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                           pipe->get_storage_precision(storage_table::twopf));
                 break;
               }
           }
@@ -2221,15 +2685,25 @@ namespace transport
           {
             case threepf_type::momentum:
               {
-                sqlite3_operations::pull_paged_kconfig_sample<number, typename integration_items<number>::threepf_momentum_item>(db, id, query, t_serial, sample,
-                                                                                                                                 pipe->get_worker_number(), pipe->get_N_fields());
+                if(pipe->is_sharded())
+                  this->template pull_sharded_kconfig_sample<typename integration_items<number>::threepf_momentum_item>(pipe, id, query, t_serial, sample,
+                                                                                                                        pipe->get_storage_precision(storage_table::threepf));
+                else
+                  sqlite3_operations::pull_paged_kconfig_sample<number, typename integration_items<number>::threepf_momentum_item>(db, id, query, t_serial, sample,
+                                                                                                                                   pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                                   pipe->get_storage_precision(storage_table::threepf));
                 break;
               }
 
             case threepf_type::Nderiv:
               {
-                sqlite3_operations::pull_paged_kconfig_sample<number, typename integration_items<number>::threepf_Nderiv_item>(db, id, query, t_serial, sample,
-                                                                                                                               pipe->get_worker_number(), pipe->get_N_fields());
+                if(pipe->is_sharded())
+                  this->template pull_sharded_kconfig_sample<typename integration_items<number>::threepf_Nderiv_item>(pipe, id, query, t_serial, sample,
+                                                                                                                      pipe->get_storage_precision(storage_table::threepf));
+                else
+                  sqlite3_operations::pull_paged_kconfig_sample<number, typename integration_items<number>::threepf_Nderiv_item>(db, id, query, t_serial, sample,
+                                                                                                                                 pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                                 pipe->get_storage_precision(storage_table::threepf));
                 break;
               }
           }
@@ -2247,8 +2721,155 @@ namespace transport
         sqlite3* db = nullptr;
         pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
 
-        sqlite3_operations::pull_paged_kconfig_sample<number, typename integration_items<number>::tensor_twopf_item>(db, id, query, t_serial, sample,
-                                                                                                                     pipe->get_worker_number(), pipe->get_N_fields());
+        if(pipe->is_sharded())
+          this->template pull_sharded_kconfig_sample<typename integration_items<number>::tensor_twopf_item>(pipe, id, query, t_serial, sample,
+                                                                                                            pipe->get_storage_precision(storage_table::tensor_twopf));
+        else
+          sqlite3_operations::pull_paged_kconfig_sample<number, typename integration_items<number>::tensor_twopf_item>(db, id, query, t_serial, sample,
+                                                                                                                       pipe->get_worker_number(), pipe->get_N_fields(),
+                                                                                                                       pipe->get_storage_precision(storage_table::tensor_twopf));
+      }
+
+
+    template <typename number>
+    template <typename ValueType>
+    void data_manager_sqlite3<number>::pull_sharded_kconfig_sample(datapipe<number>* pipe, unsigned int id, const derived_data::SQL_query& query,
+                                                                   unsigned int t_serial, std::vector<number>& sample, storage_precision precision)
+      {
+        // k-configurations may be held in any shard, or in the principal container if the group was seeded
+        // from an unsharded group; pull from each, labelled by serial number, and merge into serial-number order
+        std::vector< std::pair<unsigned int, number> > labelled;
+
+        sqlite3* db = nullptr;
+        pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
+
+        sqlite3_operations::pull_labelled_paged_kconfig_sample<number, ValueType>(db, id, query, t_serial, labelled,
+                                                                                 pipe->get_worker_number(), pipe->get_N_fields(), precision);
+
+        for(unsigned int i = 0; i < pipe->get_shard_count(); ++i)
+          {
+            sqlite3_operations::pull_labelled_paged_kconfig_sample<number, ValueType>(pipe->template get_shard_handle<sqlite3*>(i), id, query, t_serial, labelled,
+                                                                                     pipe->get_worker_number(), pipe->get_N_fields(), precision);
+          }
+
+        std::sort(labelled.begin(), labelled.end(),
+                  [](const std::pair<unsigned int, number>& a, const std::pair<unsigned int, number>& b) -> bool { return a.first < b.first; });
+
+        sample.clear();
+        sample.reserve(labelled.size());
+        for(const std::pair<unsigned int, number>& v : labelled)
+          {
+            sample.push_back(v.second);
+          }
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::pull_twopf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                                  unsigned int t_serial, std::vector< std::vector<number> >& history, twopf_type type)
+      {
+        assert(pipe != nullptr);
+        if(pipe == nullptr) throw runtime_exception(exception_type::RUNTIME_ERROR, CPPTRANSPORT_DATAMGR_NULL_DATAPIPE);
+
+        switch(type)
+          {
+            case twopf_type::real:
+              {
+                this->template pull_paged_kconfig_history<typename integration_items<number>::twopf_re_item>(pipe, query, t_serial, history,
+                                                                                                             pipe->get_storage_precision(storage_table::twopf));
+                break;
+              }
+
+            case twopf_type::imag:
+              {
+                this->template pull_paged_kconfig_history<typename integration_items<number>::twopf_im_item>(pipe, query, t_serial, history,
+                                                                                                             pipe->get_storage_precision(storage_table::twopf));
+                break;
+              }
+          }
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::pull_threepf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                                    unsigned int t_serial, std::vector< std::vector<number> >& history, threepf_type type)
+      {
+        assert(pipe != nullptr);
+        if(pipe == nullptr) throw runtime_exception(exception_type::RUNTIME_ERROR, CPPTRANSPORT_DATAMGR_NULL_DATAPIPE);
+
+        switch(type)
+          {
+            case threepf_type::momentum:
+              {
+                this->template pull_paged_kconfig_history<typename integration_items<number>::threepf_momentum_item>(pipe, query, t_serial, history,
+                                                                                                                     pipe->get_storage_precision(storage_table::threepf));
+                break;
+              }
+
+            case threepf_type::Nderiv:
+              {
+                this->template pull_paged_kconfig_history<typename integration_items<number>::threepf_Nderiv_item>(pipe, query, t_serial, history,
+                                                                                                                   pipe->get_storage_precision(storage_table::threepf));
+                break;
+              }
+          }
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::pull_tensor_twopf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                                         unsigned int t_serial, std::vector< std::vector<number> >& history)
+      {
+        assert(pipe != nullptr);
+        if(pipe == nullptr) throw runtime_exception(exception_type::RUNTIME_ERROR, CPPTRANSPORT_DATAMGR_NULL_DATAPIPE);
+
+        this->template pull_paged_kconfig_history<typename integration_items<number>::tensor_twopf_item>(pipe, query, t_serial, history,
+                                                                                                         pipe->get_storage_precision(storage_table::tensor_twopf));
+      }
+
+
+    template <typename number>
+    template <typename ValueType>
+    void data_manager_sqlite3<number>::pull_paged_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                                  unsigned int t_serial, std::vector< std::vector<number> >& history, storage_precision precision)
+      {
+        std::vector< std::pair< unsigned int, std::vector<number> > > rows;
+
+        sqlite3* db = nullptr;
+        pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
+
+        sqlite3_operations::pull_labelled_paged_kconfig_history<number, ValueType>(db, query, t_serial, rows,
+                                                                                  pipe->get_worker_number(), pipe->get_N_fields(), precision);
+
+        // k-configurations may be held in any shard, so rows drawn from each have to be merged into serial-number order
+        if(pipe->is_sharded())
+          {
+            for(unsigned int i = 0; i < pipe->get_shard_count(); ++i)
+              {
+                sqlite3_operations::pull_labelled_paged_kconfig_history<number, ValueType>(pipe->template get_shard_handle<sqlite3*>(i), query, t_serial, rows,
+                                                                                          pipe->get_worker_number(), pipe->get_N_fields(), precision);
+              }
+
+            std::stable_sort(rows.begin(), rows.end(),
+                             [](const std::pair< unsigned int, std::vector<number> >& a, const std::pair< unsigned int, std::vector<number> >& b) -> bool { return a.first < b.first; });
+          }
+
+        unsigned int num_elements = sqlite3_operations::data_traits<number, ValueType>::number_elements(pipe->get_N_fields());
+
+        history.clear();
+        history.resize(num_elements);
+        for(std::vector<number>& line : history)
+          {
+            line.reserve(rows.size());
+          }
+
+        for(const std::pair< unsigned int, std::vector<number> >& row : rows)
+          {
+            for(unsigned int i = 0; i < num_elements; ++i)
+              {
+                history[i].push_back(row.second[i]);
+              }
+          }
       }
 
 
@@ -2297,6 +2918,51 @@ namespace transport
       }
 
 
+    template <typename number>
+    void data_manager_sqlite3<number>::pull_zeta_twopf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                                    const std::vector<unsigned int>& t_serials, std::vector< std::vector<number> >& lines)
+      {
+        assert(pipe != nullptr);
+        if(pipe == nullptr) throw runtime_exception(exception_type::RUNTIME_ERROR, CPPTRANSPORT_DATAMGR_NULL_DATAPIPE);
+
+        sqlite3* db = nullptr;
+        pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
+
+        sqlite3_operations::pull_unpaged_kconfig_history<number, typename postintegration_items<number>::zeta_twopf_item>(db, query, t_serials, lines,
+                                                                                                             pipe->get_worker_number());
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::pull_zeta_threepf_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                                    const std::vector<unsigned int>& t_serials, std::vector< std::vector<number> >& lines)
+      {
+        assert(pipe != nullptr);
+        if(pipe == nullptr) throw runtime_exception(exception_type::RUNTIME_ERROR, CPPTRANSPORT_DATAMGR_NULL_DATAPIPE);
+
+        sqlite3* db = nullptr;
+        pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
+
+        sqlite3_operations::pull_unpaged_kconfig_history<number, typename postintegration_items<number>::zeta_threepf_item>(db, query, t_serials, lines,
+                                                                                                             pipe->get_worker_number());
+      }
+
+
+    template <typename number>
+    void data_manager_sqlite3<number>::pull_zeta_redbsp_kconfig_history(datapipe<number>* pipe, const derived_data::SQL_query& query,
+                                                                    const std::vector<unsigned int>& t_serials, std::vector< std::vector<number> >& lines)
+      {
+        assert(pipe != nullptr);
+        if(pipe == nullptr) throw runtime_exception(exception_type::RUNTIME_ERROR, CPPTRANSPORT_DATAMGR_NULL_DATAPIPE);
+
+        sqlite3* db = nullptr;
+        pipe->get_manager_handle(&db);    // throws an exception if the handle is unset, so safe to proceed; we can't get nullptr back
+
+        sqlite3_operations::pull_unpaged_kconfig_history<number, typename postintegration_items<number>::zeta_redbsp_item>(db, query, t_serials, lines,
+                                                                                                             pipe->get_worker_number());
+      }
+
+
     template <typename number>
     void data_manager_sqlite3<number>::pull_k_statistics_sample(datapipe<number>* pipe, const derived_data::SQL_query& query,
                                                                 std::vector<kconfiguration_statistics>& data)
@@ -2313,6 +2979,29 @@ namespace transport
 
     template <typename number>
     void data_manager_sqlite3<number>::datapipe_attach_container(datapipe<number>* pipe, const boost::filesystem::path& ctr_path)
+      {
+        sqlite3* db = this->open_datapipe_connexion(ctr_path);
+
+        // remember this connexion
+        this->open_containers.push_back(db);
+        pipe->set_manager_handle(db);
+
+        // provision read-only reader connexions, which are used when the datapipe pulls several lines concurrently
+        for(unsigned int i = 0; i < pipe->get_reader_count(); ++i)
+          {
+            sqlite3* reader = this->open_datapipe_connexion(ctr_path);
+
+            this->open_containers.push_back(reader);
+            pipe->add_reader_handle(reader);
+          }
+
+        BOOST_LOG_SEV(pipe->get_log(), datapipe<number>::log_severity_level::normal) << "** Attached SQLite3 container '" << ctr_path.string() << "' to datapipe"
+          << " (" << pipe->get_reader_count() << " reader connexions)";
+      }
+
+
+    template <typename number>
+    sqlite3* data_manager_sqlite3<number>::open_datapipe_connexion(const boost::filesystem::path& ctr_path)
       {
         sqlite3* db = nullptr;
 
@@ -2338,11 +3027,7 @@ namespace transport
         // set performance-related options
         sqlite3_operations::consistency_pragmas(db);
 
-        // remember this connexion
-        this->open_containers.push_back(db);
-        pipe->set_manager_handle(db);
-
-        BOOST_LOG_SEV(pipe->get_log(), datapipe<number>::log_severity_level::normal) << "** Attached SQLite3 container '" << ctr_path.string() << "' to datapipe";
+        return db;
       }
 
 
@@ -2363,11 +3048,68 @@ namespace transport
         boost::filesystem::path ctr_path = group->get_abs_repo_path() / payload.get_container_path();
 
         this->datapipe_attach_container(pipe, ctr_path);
+        if(payload.is_sharded()) this->datapipe_attach_shards(pipe, group->get_abs_repo_path(), ctr_path, payload.get_shards());
 
         return std::move(group);   // std::move required by GCC 5.2 although standard implies that copy elision should occur
       }
 
 
+    template <typename number>
+    void data_manager_sqlite3<number>::datapipe_attach_shards(datapipe<number>* pipe, const boost::filesystem::path& repo_root,
+                                                              const boost::filesystem::path& ctr_path, const std::list<content_shard>& shards)
+      {
+        std::vector<boost::filesystem::path> shard_paths;
+
+        for(const content_shard& shard : shards)
+          {
+            boost::filesystem::path shard_path = repo_root / shard.get_container_path();
+            shard_paths.push_back(shard_path);
+
+            // this connexion is used by threads which do not hold a reader lease
+            sqlite3* db = this->open_shard_connexion(shard_path, ctr_path);
+            this->open_containers.push_back(db);
+            pipe->add_shard_handle(db, shard.get_twopf_serials(), shard.get_threepf_serials());
+          }
+
+        // SQLite serializes access to each connexion, so readers are given their own connexions to a shard
+        // when they first pull from it. These are opened from reader threads, so are not recorded in
+        // open_containers; they are returned by drain_shard_handles() when the datapipe is detached
+        if(pipe->get_reader_count() > 0)
+          {
+            pipe->set_shard_opener([this, shard_paths, ctr_path](unsigned int i) -> void*
+                                     {
+                                       return(static_cast<void*>(this->open_shard_connexion(shard_paths[i], ctr_path)));
+                                     });
+          }
+
+        BOOST_LOG_SEV(pipe->get_log(), datapipe<number>::log_severity_level::normal) << "** Attached " << shards.size() << " shards to datapipe";
+      }
+
+
+    template <typename number>
+    sqlite3* data_manager_sqlite3<number>::open_shard_connexion(const boost::filesystem::path& shard_path, const boost::filesystem::path& ctr_path)
+      {
+        sqlite3* db = this->open_datapipe_connexion(shard_path);
+
+        // shards do not carry the sample tables, so attach the principal container; unqualified
+        // table names resolve to the shard first and then to the principal container
+        std::ostringstream attach_stmt;
+        attach_stmt << "ATTACH DATABASE '" << ctr_path.string() << "' AS " << sqlite3_operations::CPPTRANSPORT_SQLITE_PRINCIPAL_DBNAME << ";";
+
+        try
+          {
+            sqlite3_operations::exec(db, attach_stmt.str(), CPPTRANSPORT_DATACTR_ATTACH_PRINCIPAL_FAIL);
+          }
+        catch(runtime_exception&)
+          {
+            sqlite3_close(db);
+            throw;
+          }
+
+        return(db);
+      }
+
+
     template <typename number>
     std::unique_ptr< content_group_record<postintegration_payload> >
     data_manager_sqlite3<number>::datapipe_attach_postintegration_content(datapipe<number>* pipe, postintegration_content_finder<number>& finder,
@@ -2401,6 +3143,22 @@ namespace transport
         this->open_containers.remove(db);
         sqlite3_close(db);
 
+        // close any reader connexions
+        std::list<sqlite3*> readers = pipe->template drain_reader_handles<sqlite3*>();
+        for(sqlite3* reader : readers)
+          {
+            this->open_containers.remove(reader);
+            sqlite3_close(reader);
+          }
+
+        // close any shard connexions
+        std::list<sqlite3*> shards = pipe->template drain_shard_handles<sqlite3*>();
+        for(sqlite3* shard : shards)
+          {
+            this->open_containers.remove(shard);
+            sqlite3_close(shard);
+          }
+
         BOOST_LOG_SEV(pipe->get_log(), datapipe<number>::log_severity_level::normal) << "** Detached SQLite3 container from datapipe";
       }
 
@@ -158,9 +158,26 @@ namespace transport
           }
 
 
+        namespace aggregate_impl
+          {
+
+            // in sorted bulk-append mode, rows are copied out of the temporary container in primary-key order,
+            // so that insertions into the principal container append to the end of each b-tree
+            // rather than landing at random positions
+            template <typename number, typename ValueType>
+            std::string sort_clause(aggregation_mode mode)
+              {
+                if(mode != aggregation_mode::sorted_bulk) return std::string();
+                return std::string(" ORDER BY ") + data_traits<number, ValueType>::sqlite_sort_order();
+              }
+
+          }   // namespace aggregate_impl
+
+
         // Aggregate the background value table from a temporary container into a principal container
         template <typename number>
-        aggregation_table_data aggregate_backg(attach_manager& mgr, integration_writer<number>& writer)
+        aggregation_table_data aggregate_backg(attach_manager& mgr, integration_writer<number>& writer,
+                                               aggregation_mode mode=aggregation_mode::incremental)
           {
             boost::timer::cpu_timer timer;
             sqlite3* db = mgr.get_db_connexion();
@@ -174,7 +191,8 @@ namespace transport
             std::ostringstream copy_stmt;
             copy_stmt
               << "INSERT OR IGNORE INTO " << CPPTRANSPORT_SQLITE_BACKG_VALUE_TABLE
-              << " SELECT * FROM " << CPPTRANSPORT_SQLITE_TEMPORARY_DBNAME << "." << CPPTRANSPORT_SQLITE_BACKG_VALUE_TABLE << ";";
+              << " SELECT * FROM " << CPPTRANSPORT_SQLITE_TEMPORARY_DBNAME << "." << CPPTRANSPORT_SQLITE_BACKG_VALUE_TABLE
+              << aggregate_impl::sort_clause<number, typename integration_items<number>::backg_item>(mode) << ";";
 
             exec(db, copy_stmt.str(), CPPTRANSPORT_DATACTR_BACKGROUND_COPY);
 
@@ -184,7 +202,8 @@ namespace transport
 
 
 		    template <typename number, typename WriterObject, typename ValueType>
-		    aggregation_table_data aggregate_table(attach_manager& mgr, WriterObject& writer)
+		    aggregation_table_data aggregate_table(attach_manager& mgr, WriterObject& writer,
+                                               aggregation_mode mode=aggregation_mode::incremental)
 			    {
             boost::timer::cpu_timer timer;
             sqlite3* db = mgr.get_db_connexion();
@@ -192,7 +211,8 @@ namespace transport
             std::ostringstream copy_stmt;
 				    copy_stmt
 				      << "INSERT INTO " << data_traits<number, ValueType>::sqlite_table()
-			        << " SELECT * FROM " << CPPTRANSPORT_SQLITE_TEMPORARY_DBNAME << "." << data_traits<number, ValueType>::sqlite_table() << ";";
+			        << " SELECT * FROM " << CPPTRANSPORT_SQLITE_TEMPORARY_DBNAME << "." << data_traits<number, ValueType>::sqlite_table()
+              << aggregate_impl::sort_clause<number, ValueType>(mode) << ";";
 
 				    exec(db, copy_stmt.str(), data_traits<number, ValueType>::copy_error_msg());
 
@@ -286,7 +306,8 @@ namespace transport
 
         // Aggregate an initial-conditions value table frmo a temporary container into a principal container
         template <typename number, typename ValueType>
-        aggregation_table_data aggregate_ics(attach_manager& mgr, integration_writer<number>& writer)
+        aggregation_table_data aggregate_ics(attach_manager& mgr, integration_writer<number>& writer,
+                                             aggregation_mode mode=aggregation_mode::incremental)
 	        {
             boost::timer::cpu_timer timer;
             sqlite3* db = mgr.get_db_connexion();
@@ -294,7 +315,8 @@ namespace transport
             std::ostringstream copy_stmt;
             copy_stmt
 	            << "INSERT INTO " << data_traits<number, ValueType>::sqlite_table()
-	            << " SELECT * FROM " << CPPTRANSPORT_SQLITE_TEMPORARY_DBNAME << "." << data_traits<number, ValueType>::sqlite_table() << ";";
+	            << " SELECT * FROM " << CPPTRANSPORT_SQLITE_TEMPORARY_DBNAME << "." << data_traits<number, ValueType>::sqlite_table()
+              << aggregate_impl::sort_clause<number, ValueType>(mode) << ";";
 
             exec(db, copy_stmt.str(), CPPTRANSPORT_DATACTR_ICS_COPY);
 
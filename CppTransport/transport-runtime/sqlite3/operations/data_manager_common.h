@@ -44,6 +44,7 @@
 #include "transport-runtime/repository/writers/writers.h"
 #include "transport-runtime/data/datapipe/linecache_specializations.h"
 #include "transport-runtime/data/batchers/batchers.h"
+#include "transport-runtime/data/storage_precision.h"
 
 #include "boost/lexical_cast.hpp"
 
@@ -88,6 +89,7 @@ namespace transport
         constexpr auto CPPTRANSPORT_SQLITE_INSERT_FNL_TABLE                    = "fNL_insert";
 
         constexpr auto CPPTRANSPORT_SQLITE_TEMPORARY_DBNAME                    = "tempdb";
+        constexpr auto CPPTRANSPORT_SQLITE_PRINCIPAL_DBNAME                    = "principal";
 
         constexpr auto CPPTRANSPORT_SQLITE_TWOPF_RE_TIME_INDEX                 = "twopf_re_time";
         constexpr auto CPPTRANSPORT_SQLITE_TWOPF_RE_K_INDEX                    = "twopf_re_k";
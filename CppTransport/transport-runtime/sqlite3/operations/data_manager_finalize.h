@@ -66,13 +66,54 @@ namespace transport
                 exec(db, "ANALYZE;");
               }
 
+
+            // foreign-key constraints are not enforced while aggregating in sorted bulk-append mode,
+            // so check them once for the whole container
+            void check_foreign_keys(transaction_manager& mgr, sqlite3* db)
+              {
+                assert(db != nullptr);
+
+                sqlite3_stmt* stmt;
+                check_stmt(db, sqlite3_prepare_v2(db, "PRAGMA foreign_key_check;", -1, &stmt, nullptr));
+
+                unsigned int violations = 0;
+                std::string first_table;
+
+                int status;
+                while((status = sqlite3_step(stmt)) != SQLITE_DONE)
+                  {
+                    if(status == SQLITE_ROW)
+                      {
+                        if(violations == 0) first_table = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                        ++violations;
+                      }
+                    else
+                      {
+                        sqlite3_finalize(stmt);
+                        check_stmt(db, status);
+                      }
+                  }
+
+                check_stmt(db, sqlite3_finalize(stmt));
+
+                if(violations > 0)
+                  {
+                    std::ostringstream msg;
+                    msg << CPPTRANSPORT_DATACTR_FOREIGN_KEY_FAIL << " " << violations << ", "
+                        << CPPTRANSPORT_DATACTR_FOREIGN_KEY_FIRST << " '" << first_table << "'";
+                    throw runtime_exception(exception_type::DATA_CONTAINER_ERROR, msg.str());
+                  }
+              }
+
           }
 
 
-        void finalize_twopf_writer(transaction_manager& mgr, sqlite3* db)
+        void finalize_twopf_writer(transaction_manager& mgr, sqlite3* db, aggregation_mode mode=aggregation_mode::incremental)
           {
             assert(db != nullptr);
 
+            if(mode == aggregation_mode::sorted_bulk) finalize_impl::check_foreign_keys(mgr, db);
+
             finalize_impl::create_tserial_index(mgr, db, CPPTRANSPORT_SQLITE_TWOPF_RE_TIME_INDEX, CPPTRANSPORT_SQLITE_TWOPF_RE_VALUE_TABLE);
             finalize_impl::create_kserial_index(mgr, db, CPPTRANSPORT_SQLITE_TWOPF_RE_K_INDEX, CPPTRANSPORT_SQLITE_TWOPF_RE_VALUE_TABLE);
 
@@ -83,10 +124,12 @@ namespace transport
           }
 
 
-        void finalize_threepf_writer(transaction_manager& mgr, sqlite3* db)
+        void finalize_threepf_writer(transaction_manager& mgr, sqlite3* db, aggregation_mode mode=aggregation_mode::incremental)
           {
             assert(db != nullptr);
 
+            if(mode == aggregation_mode::sorted_bulk) finalize_impl::check_foreign_keys(mgr, db);
+
             finalize_impl::create_tserial_index(mgr, db, CPPTRANSPORT_SQLITE_TWOPF_RE_TIME_INDEX, CPPTRANSPORT_SQLITE_TWOPF_RE_VALUE_TABLE);
             finalize_impl::create_kserial_index(mgr, db, CPPTRANSPORT_SQLITE_TWOPF_RE_K_INDEX, CPPTRANSPORT_SQLITE_TWOPF_RE_VALUE_TABLE);
 
@@ -106,10 +149,12 @@ namespace transport
           }
 
 
-        void finalize_zeta_twopf_writer(transaction_manager& mgr, sqlite3* db)
+        void finalize_zeta_twopf_writer(transaction_manager& mgr, sqlite3* db, aggregation_mode mode=aggregation_mode::incremental)
           {
             assert(db != nullptr);
 
+            if(mode == aggregation_mode::sorted_bulk) finalize_impl::check_foreign_keys(mgr, db);
+
             finalize_impl::create_tserial_index(mgr, db, CPPTRANSPORT_SQLITE_ZETA_TWOPF_TIME_INDEX, CPPTRANSPORT_SQLITE_ZETA_TWOPF_VALUE_TABLE);
             finalize_impl::create_kserial_index(mgr, db, CPPTRANSPORT_SQLITE_ZETA_TWOPF_K_INDEX, CPPTRANSPORT_SQLITE_ZETA_TWOPF_VALUE_TABLE);
 
@@ -120,10 +165,12 @@ namespace transport
           }
 
 
-        void finalize_zeta_threepf_writer(transaction_manager& mgr, sqlite3* db)
+        void finalize_zeta_threepf_writer(transaction_manager& mgr, sqlite3* db, aggregation_mode mode=aggregation_mode::incremental)
           {
             assert(db != nullptr);
 
+            if(mode == aggregation_mode::sorted_bulk) finalize_impl::check_foreign_keys(mgr, db);
+
             finalize_impl::create_tserial_index(mgr, db, CPPTRANSPORT_SQLITE_ZETA_TWOPF_TIME_INDEX, CPPTRANSPORT_SQLITE_ZETA_TWOPF_VALUE_TABLE);
             finalize_impl::create_kserial_index(mgr, db, CPPTRANSPORT_SQLITE_ZETA_TWOPF_K_INDEX, CPPTRANSPORT_SQLITE_ZETA_TWOPF_VALUE_TABLE);
 
@@ -146,10 +193,12 @@ namespace transport
           }
 
 
-        void finalize_fNL_writer(transaction_manager& mgr, sqlite3* db)
+        void finalize_fNL_writer(transaction_manager& mgr, sqlite3* db, aggregation_mode mode=aggregation_mode::incremental)
           {
             assert(db != nullptr);
 
+            if(mode == aggregation_mode::sorted_bulk) finalize_impl::check_foreign_keys(mgr, db);
+
             // don't currently create indexes for fNL
 
             finalize_impl::analyze(mgr, db);
@@ -28,6 +28,8 @@
 #define CPPTRANSPORT_DATA_MANAGER_PULL_H
 
 
+#include <map>
+
 #include "transport-runtime/sqlite3/operations/data_manager_common.h"
 #include "transport-runtime/sqlite3/operations/data_traits.h"
 #include "transport-runtime/derived-products/derived-content/SQL_query/SQL_query.h"
@@ -42,9 +44,11 @@ namespace transport
 		    namespace pull_implementation
 			    {
 
-				    // sample should be empty and have a suitable size reserved before calling
+				    // sample should be empty and have a suitable size reserved before calling;
+            // values written at reduced precision are widened back to double
 				    template <typename TargetType>
-				    void pull_number_list(sqlite3* db, std::vector<TargetType>& sample, std::string sql_query, std::string error_msg)
+				    void pull_number_list(sqlite3* db, std::vector<TargetType>& sample, std::string sql_query, std::string error_msg,
+                                  storage_precision precision=storage_precision::full)
 					    {
 				        sqlite3_stmt* stmt;
 				        check_stmt(db, sqlite3_prepare_v2(db, sql_query.c_str(), sql_query.length()+1, &stmt, nullptr));
@@ -54,7 +58,9 @@ namespace transport
 					        {
 				            if(status == SQLITE_ROW)
 					            {
-				                TargetType value = static_cast<TargetType>(sqlite3_column_double(stmt, 0));
+				                TargetType value = precision == storage_precision::single
+                                           ? static_cast<TargetType>(storage_precision_impl::unpack_single(sqlite3_column_int(stmt, 0)))
+                                           : static_cast<TargetType>(sqlite3_column_double(stmt, 0));
 				                sample.push_back(value);
 					            }
 				            else
@@ -69,6 +75,38 @@ namespace transport
 				        check_stmt(db, sqlite3_finalize(stmt));
 					    }
 
+
+            // as pull_number_list(), but the query returns a serial number in its second column
+            // and values are appended to sample labelled by that serial number
+            template <typename TargetType>
+            void pull_labelled_number_list(sqlite3* db, std::vector< std::pair<unsigned int, TargetType> >& sample, std::string sql_query, std::string error_msg,
+                                           storage_precision precision=storage_precision::full)
+              {
+                sqlite3_stmt* stmt;
+                check_stmt(db, sqlite3_prepare_v2(db, sql_query.c_str(), sql_query.length()+1, &stmt, nullptr));
+
+                int status;
+                while((status = sqlite3_step(stmt)) != SQLITE_DONE)
+                  {
+                    if(status == SQLITE_ROW)
+                      {
+                        TargetType value = precision == storage_precision::single
+                                           ? static_cast<TargetType>(storage_precision_impl::unpack_single(sqlite3_column_int(stmt, 0)))
+                                           : static_cast<TargetType>(sqlite3_column_double(stmt, 0));
+                        sample.emplace_back(static_cast<unsigned int>(sqlite3_column_int(stmt, 1)), value);
+                      }
+                    else
+                      {
+                        std::ostringstream msg;
+                        msg << error_msg << status << ": " << sqlite3_errmsg(db) << ")";
+                        sqlite3_finalize(stmt);
+                        throw runtime_exception(exception_type::DATA_MANAGER_BACKEND_ERROR, msg.str());
+                      }
+                  }
+
+                check_stmt(db, sqlite3_finalize(stmt));
+              }
+
 			    }
 
 
@@ -341,7 +379,8 @@ namespace transport
         // Pull a sample of the background field evolution, for a specific field, for a specific set of time serial numbers
         template <typename number>
         void pull_background_time_sample(sqlite3* db, unsigned int id, const derived_data::SQL_query& tquery,
-                                         std::vector<number>& sample, unsigned int worker, unsigned int Nfields)
+                                         std::vector<number>& sample, unsigned int worker, unsigned int Nfields,
+                                         storage_precision precision=storage_precision::full)
           {
             assert(db != nullptr);
 
@@ -367,13 +406,81 @@ namespace transport
               << " ORDER BY tsample.serial;";
 
             sample.clear();
-            pull_implementation::pull_number_list(db, sample, select_stmt.str(), CPPTRANSPORT_DATAMGR_TIME_SERIAL_READ_FAIL);
+            pull_implementation::pull_number_list(db, sample, select_stmt.str(), CPPTRANSPORT_DATAMGR_TIME_SERIAL_READ_FAIL, precision);
+          }
+
+
+        // Pull the evolution of every background field for a specific set of time serial numbers, using a single query;
+        // history is indexed by field and then by time sample, in serial-number order
+        template <typename number>
+        void pull_background_time_history(sqlite3* db, const derived_data::SQL_query& tquery,
+                                          std::vector< std::vector<number> >& history, unsigned int worker, unsigned int Nfields,
+                                          storage_precision precision=storage_precision::full)
+          {
+            assert(db != nullptr);
+
+            derived_data::SQL_policy policy(CPPTRANSPORT_SQLITE_TIME_SAMPLE_TABLE, "serial",
+                                            CPPTRANSPORT_SQLITE_TWOPF_SAMPLE_TABLE, "serial",
+                                            CPPTRANSPORT_SQLITE_THREEPF_SAMPLE_TABLE, "serial",
+                                            "wavenumber1", "wavenumber2", "wavenumber3");
+
+            unsigned int num_elements = 2*Nfields;
+            unsigned int num_cols = std::min(num_elements, max_columns);
+
+            std::stringstream select_stmt;
+            select_stmt << "SELECT " << CPPTRANSPORT_SQLITE_BACKG_VALUE_TABLE << ".page";
+            for(unsigned int i = 0; i < num_cols; ++i)
+              {
+                select_stmt << ", " << CPPTRANSPORT_SQLITE_BACKG_VALUE_TABLE << ".coord" << i;
+              }
+            select_stmt
+              << " FROM " << CPPTRANSPORT_SQLITE_BACKG_VALUE_TABLE
+              << " INNER JOIN (" << tquery.make_query(policy, true) << ") tsample"
+              << " ON " << CPPTRANSPORT_SQLITE_BACKG_VALUE_TABLE << ".tserial=tsample.serial"
+              << " ORDER BY tsample.serial, " << CPPTRANSPORT_SQLITE_BACKG_VALUE_TABLE << ".page;";
+
+            history.clear();
+            history.resize(num_elements);
+
+            std::string sql = select_stmt.str();
+            sqlite3_stmt* stmt;
+            check_stmt(db, sqlite3_prepare_v2(db, sql.c_str(), sql.length()+1, &stmt, nullptr));
+
+            int status;
+            while((status = sqlite3_step(stmt)) != SQLITE_DONE)
+              {
+                if(status == SQLITE_ROW)
+                  {
+                    unsigned int page = static_cast<unsigned int>(sqlite3_column_int(stmt, 0));
+
+                    for(unsigned int i = 0; i < num_cols; ++i)
+                      {
+                        unsigned int element = page*num_cols + i;
+                        if(element >= num_elements) break;
+
+                        number value = precision == storage_precision::single
+                                       ? static_cast<number>(storage_precision_impl::unpack_single(sqlite3_column_int(stmt, i+1)))
+                                       : static_cast<number>(sqlite3_column_double(stmt, i+1));
+                        history[element].push_back(value);
+                      }
+                  }
+                else
+                  {
+                    std::ostringstream msg;
+                    msg << CPPTRANSPORT_DATAMGR_TIME_SERIAL_READ_FAIL << status << ": " << sqlite3_errmsg(db) << ")";
+                    sqlite3_finalize(stmt);
+                    throw runtime_exception(exception_type::DATA_MANAGER_BACKEND_ERROR, msg.str());
+                  }
+              }
+
+            check_stmt(db, sqlite3_finalize(stmt));
           }
 
 
 		    template <typename number, typename ValueType>
 		    void pull_paged_time_sample(sqlite3* db, unsigned int id, const derived_data::SQL_query& tquery,
-		                                unsigned int k_serial, std::vector<number>& sample, unsigned int worker, unsigned int Nfields)
+		                                unsigned int k_serial, std::vector<number>& sample, unsigned int worker, unsigned int Nfields,
+                                    storage_precision precision=storage_precision::full)
 			    {
 				    assert(db != nullptr);
 
@@ -404,16 +511,90 @@ namespace transport
 			        << " ORDER BY _tsample.serial;";
 
 						sample.clear();
-		        pull_implementation::pull_number_list(db, sample, select_stmt.str(), CPPTRANSPORT_DATAMGR_TIME_SERIAL_READ_FAIL);
+		        pull_implementation::pull_number_list(db, sample, select_stmt.str(), CPPTRANSPORT_DATAMGR_TIME_SERIAL_READ_FAIL, precision);
 			    }
 
 
+        // pull the time history of every element of a paged table at fixed k-configuration, using a single query;
+        // history is indexed by element and then by time sample, in serial-number order
         template <typename number, typename ValueType>
-        void pull_paged_kconfig_sample(sqlite3* db, unsigned int id, const derived_data::SQL_query& kquery,
-                                       unsigned int t_serial, std::vector<number>& sample, unsigned int worker, unsigned int Nfields)
-	        {
+        void pull_paged_time_history(sqlite3* db, const derived_data::SQL_query& tquery, unsigned int k_serial,
+                                     std::vector< std::vector<number> >& history, unsigned int worker, unsigned int Nfields,
+                                     storage_precision precision=storage_precision::full)
+          {
             assert(db != nullptr);
 
+            derived_data::SQL_policy policy(CPPTRANSPORT_SQLITE_TIME_SAMPLE_TABLE, "serial",
+                                            CPPTRANSPORT_SQLITE_TWOPF_SAMPLE_TABLE, "serial",
+                                            CPPTRANSPORT_SQLITE_THREEPF_SAMPLE_TABLE, "serial",
+                                            "wavenumber1", "wavenumber2", "wavenumber3");
+
+            unsigned int num_elements = data_traits<number, ValueType>::number_elements(Nfields);
+            unsigned int num_cols = std::min(num_elements, max_columns);
+
+            std::string table_name = data_traits<number, ValueType>::sqlite_table();
+
+            // construct SQL query returning every page of every time sample for this k-configuration;
+            // rows arrive in time order, with the pages of each time sample in sequence
+            std::stringstream select_stmt;
+            select_stmt << "SELECT _subsample.tserial, _subsample.page";
+            for(unsigned int i = 0; i < num_cols; ++i)
+              {
+                select_stmt << ", _subsample.ele" << i;
+              }
+            select_stmt
+              << " FROM"
+              << " (SELECT * FROM " << table_name
+              << " WHERE " << table_name << ".kserial=" << k_serial
+              << ") _subsample"
+              << " INNER JOIN (" << tquery.make_query(policy, true) << ") _tsample"
+              << " ON _subsample.tserial=_tsample.serial"
+              << " ORDER BY _tsample.serial, _subsample.page;";
+
+            history.clear();
+            history.resize(num_elements);
+
+            std::string sql = select_stmt.str();
+            sqlite3_stmt* stmt;
+            check_stmt(db, sqlite3_prepare_v2(db, sql.c_str(), sql.length()+1, &stmt, nullptr));
+
+            int status;
+            while((status = sqlite3_step(stmt)) != SQLITE_DONE)
+              {
+                if(status == SQLITE_ROW)
+                  {
+                    unsigned int page = static_cast<unsigned int>(sqlite3_column_int(stmt, 1));
+
+                    for(unsigned int i = 0; i < num_cols; ++i)
+                      {
+                        unsigned int element = page*num_cols + i;
+                        if(element >= num_elements) break;
+
+                        number value = precision == storage_precision::single
+                                       ? static_cast<number>(storage_precision_impl::unpack_single(sqlite3_column_int(stmt, i+2)))
+                                       : static_cast<number>(sqlite3_column_double(stmt, i+2));
+                        history[element].push_back(value);
+                      }
+                  }
+                else
+                  {
+                    std::ostringstream msg;
+                    msg << CPPTRANSPORT_DATAMGR_TIME_SERIAL_READ_FAIL << status << ": " << sqlite3_errmsg(db) << ")";
+                    sqlite3_finalize(stmt);
+                    throw runtime_exception(exception_type::DATA_MANAGER_BACKEND_ERROR, msg.str());
+                  }
+              }
+
+            check_stmt(db, sqlite3_finalize(stmt));
+          }
+
+
+        // build the SQL statement used to pull a kconfig sample from a paged table;
+        // if labelled is true, the k-configuration serial number is returned as a second column
+        template <typename number, typename ValueType>
+        std::string paged_kconfig_sample_statement(unsigned int id, const derived_data::SQL_query& kquery,
+                                                   unsigned int t_serial, unsigned int Nfields, bool labelled)
+          {
             derived_data::SQL_policy policy(CPPTRANSPORT_SQLITE_TIME_SAMPLE_TABLE, "serial",
                                             CPPTRANSPORT_SQLITE_TWOPF_SAMPLE_TABLE, "serial",
                                             CPPTRANSPORT_SQLITE_THREEPF_SAMPLE_TABLE, "serial",
@@ -431,7 +612,9 @@ namespace transport
             std::stringstream select_stmt;
             select_stmt
 	            << "SELECT"
-	            << " _subsample.ele" << col
+	            << " _subsample.ele" << col;
+            if(labelled) select_stmt << ", _subsample.kserial";
+            select_stmt
 	            << " FROM "
               << " (SELECT * FROM " << table_name
               << " WHERE " << table_name << ".tserial=" << t_serial << " AND " << table_name << ".page=" << page
@@ -440,11 +623,115 @@ namespace transport
 	            << " ON _subsample.kserial=_ksample.serial"
 	            << " ORDER BY _ksample.serial;";
 
+            return select_stmt.str();
+          }
+
+
+        template <typename number, typename ValueType>
+        void pull_paged_kconfig_sample(sqlite3* db, unsigned int id, const derived_data::SQL_query& kquery,
+                                       unsigned int t_serial, std::vector<number>& sample, unsigned int worker, unsigned int Nfields,
+                                       storage_precision precision=storage_precision::full)
+	        {
+            assert(db != nullptr);
+
+            std::string select_stmt = paged_kconfig_sample_statement<number, ValueType>(id, kquery, t_serial, Nfields, false);
+
             sample.clear();
-            pull_implementation::pull_number_list(db, sample, select_stmt.str(), CPPTRANSPORT_DATAMGR_TIME_SERIAL_READ_FAIL);
+            pull_implementation::pull_number_list(db, sample, select_stmt, CPPTRANSPORT_DATAMGR_TIME_SERIAL_READ_FAIL, precision);
 	        }
 
 
+        // as pull_paged_kconfig_sample(), but each value is labelled by its k-configuration serial number
+        // and appended to sample; used to merge samples drawn from several shards
+        template <typename number, typename ValueType>
+        void pull_labelled_paged_kconfig_sample(sqlite3* db, unsigned int id, const derived_data::SQL_query& kquery,
+                                                unsigned int t_serial, std::vector< std::pair<unsigned int, number> >& sample,
+                                                unsigned int worker, unsigned int Nfields, storage_precision precision=storage_precision::full)
+          {
+            assert(db != nullptr);
+
+            std::string select_stmt = paged_kconfig_sample_statement<number, ValueType>(id, kquery, t_serial, Nfields, true);
+            pull_implementation::pull_labelled_number_list(db, sample, select_stmt, CPPTRANSPORT_DATAMGR_TIME_SERIAL_READ_FAIL, precision);
+          }
+
+
+        // pull every element of a paged table at fixed time serial number, for a set of k-configurations, using a single query.
+        // Each k-configuration produces one row of history, labelled by its serial number and holding every element;
+        // rows are appended, so rows drawn from several shards can be merged by the caller
+        template <typename number, typename ValueType>
+        void pull_labelled_paged_kconfig_history(sqlite3* db, const derived_data::SQL_query& kquery, unsigned int t_serial,
+                                                 std::vector< std::pair< unsigned int, std::vector<number> > >& rows,
+                                                 unsigned int worker, unsigned int Nfields, storage_precision precision=storage_precision::full)
+          {
+            assert(db != nullptr);
+
+            derived_data::SQL_policy policy(CPPTRANSPORT_SQLITE_TIME_SAMPLE_TABLE, "serial",
+                                            CPPTRANSPORT_SQLITE_TWOPF_SAMPLE_TABLE, "serial",
+                                            CPPTRANSPORT_SQLITE_THREEPF_SAMPLE_TABLE, "serial",
+                                            "wavenumber1", "wavenumber2", "wavenumber3");
+
+            unsigned int num_elements = data_traits<number, ValueType>::number_elements(Nfields);
+            unsigned int num_cols = std::min(num_elements, max_columns);
+
+            std::string table_name = data_traits<number, ValueType>::sqlite_table();
+
+            // rows arrive in k-configuration order, with the pages of each configuration in sequence
+            std::stringstream select_stmt;
+            select_stmt << "SELECT _subsample.kserial, _subsample.page";
+            for(unsigned int i = 0; i < num_cols; ++i)
+              {
+                select_stmt << ", _subsample.ele" << i;
+              }
+            select_stmt
+              << " FROM"
+              << " (SELECT * FROM " << table_name
+              << " WHERE " << table_name << ".tserial=" << t_serial
+              << ") _subsample"
+              << " INNER JOIN (" << kquery.make_query(policy, true) << ") _ksample"
+              << " ON _subsample.kserial=_ksample.serial"
+              << " ORDER BY _ksample.serial, _subsample.page;";
+
+            std::string sql = select_stmt.str();
+            sqlite3_stmt* stmt;
+            check_stmt(db, sqlite3_prepare_v2(db, sql.c_str(), sql.length()+1, &stmt, nullptr));
+
+            int status;
+            while((status = sqlite3_step(stmt)) != SQLITE_DONE)
+              {
+                if(status == SQLITE_ROW)
+                  {
+                    unsigned int kserial = static_cast<unsigned int>(sqlite3_column_int(stmt, 0));
+                    unsigned int page    = static_cast<unsigned int>(sqlite3_column_int(stmt, 1));
+
+                    if(rows.empty() || rows.back().first != kserial)
+                      {
+                        rows.emplace_back(kserial, std::vector<number>(num_elements));
+                      }
+                    std::vector<number>& row = rows.back().second;
+
+                    for(unsigned int i = 0; i < num_cols; ++i)
+                      {
+                        unsigned int element = page*num_cols + i;
+                        if(element >= num_elements) break;
+
+                        row[element] = precision == storage_precision::single
+                                       ? static_cast<number>(storage_precision_impl::unpack_single(sqlite3_column_int(stmt, i+2)))
+                                       : static_cast<number>(sqlite3_column_double(stmt, i+2));
+                      }
+                  }
+                else
+                  {
+                    std::ostringstream msg;
+                    msg << CPPTRANSPORT_DATAMGR_KCONFIG_SERIAL_READ_FAIL << status << ": " << sqlite3_errmsg(db) << ")";
+                    sqlite3_finalize(stmt);
+                    throw runtime_exception(exception_type::DATA_MANAGER_BACKEND_ERROR, msg.str());
+                  }
+              }
+
+            check_stmt(db, sqlite3_finalize(stmt));
+          }
+
+
         template <typename number, typename ValueType>
         void pull_unpaged_time_sample(sqlite3* db, const derived_data::SQL_query& tquery,
                                       unsigned int k_serial, std::vector<number>& sample, unsigned int worker)
@@ -507,6 +794,73 @@ namespace transport
 	        }
 
 
+        // pull an unpaged table for a set of k-configurations at several time serial numbers, using a single query.
+        // Rows are read in k-configuration order, so each configuration's history is visited once, and values are
+        // scattered into one line per requested time serial number; lines[i] corresponds to t_serials[i]
+        template <typename number, typename ValueType>
+        void pull_unpaged_kconfig_history(sqlite3* db, const derived_data::SQL_query& kquery,
+                                          const std::vector<unsigned int>& t_serials, std::vector< std::vector<number> >& lines, unsigned int worker)
+          {
+            assert(db != nullptr);
+
+            derived_data::SQL_policy policy(CPPTRANSPORT_SQLITE_TIME_SAMPLE_TABLE, "serial",
+                                            CPPTRANSPORT_SQLITE_TWOPF_SAMPLE_TABLE, "serial",
+                                            CPPTRANSPORT_SQLITE_THREEPF_SAMPLE_TABLE, "serial",
+                                            "wavenumber1", "wavenumber2", "wavenumber3");
+
+            lines.clear();
+            lines.resize(t_serials.size());
+            if(t_serials.empty()) return;
+
+            std::map<unsigned int, unsigned int> line_index;
+            for(unsigned int i = 0; i < t_serials.size(); ++i)
+              {
+                line_index[t_serials[i]] = i;
+              }
+
+            std::string table_name = data_traits<number, ValueType>::sqlite_table();
+
+            std::stringstream select_stmt;
+            select_stmt
+              << "SELECT _subsample.tserial, _subsample." << data_traits<number, ValueType>::column_name()
+              << " FROM"
+              << " (SELECT * FROM " << table_name
+              << " WHERE " << table_name << ".tserial IN (";
+            for(std::map<unsigned int, unsigned int>::const_iterator t = line_index.begin(); t != line_index.end(); ++t)
+              {
+                select_stmt << (t == line_index.begin() ? "" : ", ") << t->first;
+              }
+            select_stmt
+              << ")) _subsample"
+              << " INNER JOIN (" << kquery.make_query(policy, true) << ") _ksample"
+              << " ON _subsample.kserial=_ksample.serial"
+              << " ORDER BY _ksample.serial, _subsample.tserial;";
+
+            std::string sql = select_stmt.str();
+            sqlite3_stmt* stmt;
+            check_stmt(db, sqlite3_prepare_v2(db, sql.c_str(), sql.length()+1, &stmt, nullptr));
+
+            int status;
+            while((status = sqlite3_step(stmt)) != SQLITE_DONE)
+              {
+                if(status == SQLITE_ROW)
+                  {
+                    std::map<unsigned int, unsigned int>::const_iterator t = line_index.find(static_cast<unsigned int>(sqlite3_column_int(stmt, 0)));
+                    if(t != line_index.end()) lines[t->second].push_back(static_cast<number>(sqlite3_column_double(stmt, 1)));
+                  }
+                else
+                  {
+                    std::ostringstream msg;
+                    msg << CPPTRANSPORT_DATAMGR_KCONFIG_SERIAL_READ_FAIL << status << ": " << sqlite3_errmsg(db) << ")";
+                    sqlite3_finalize(stmt);
+                    throw runtime_exception(exception_type::DATA_MANAGER_BACKEND_ERROR, msg.str());
+                  }
+              }
+
+            check_stmt(db, sqlite3_finalize(stmt));
+          }
+
+
         // Pull a sample of an fNL, for a specific set of time serial numbers
         template <typename number>
         void pull_fNL_time_sample(sqlite3* db, const derived_data::SQL_query& tquery,
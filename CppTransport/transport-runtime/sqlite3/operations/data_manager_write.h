@@ -67,6 +67,21 @@ namespace transport
               };
 
 
+            // bind a value at the requested storage precision;
+            // single-precision values are bound as the integer bit pattern of the corresponding float32
+            inline void bind_value(sqlite3* db, sqlite3_stmt* stmt, int id, double value, storage_precision precision)
+              {
+                if(precision == storage_precision::single)
+                  {
+                    check_stmt(db, sqlite3_bind_int(stmt, id, storage_precision_impl::pack_single(value)));
+                  }
+                else
+                  {
+                    check_stmt(db, sqlite3_bind_double(stmt, id, value));
+                  }
+              }
+
+
             template <typename number>
             class StatisticsPrimaryKeyCompare
               {
@@ -184,7 +199,8 @@ namespace transport
 
 
         template <typename number, typename ValueType>
-        void write_coordinate_output(transaction_manager& mgr, integration_batcher<number>* batcher, std::vector< std::unique_ptr<ValueType> >& batch)
+        void write_coordinate_output(transaction_manager& mgr, integration_batcher<number>* batcher, std::vector< std::unique_ptr<ValueType> >& batch,
+                                     storage_precision precision)
           {
             sqlite3* db = nullptr;
             batcher->get_manager_handle(&db);
@@ -234,7 +250,7 @@ namespace transport
             // sorting is done in-place for performance
             std::sort(batch.begin(), batch.end(), data_manager_write_impl::PagedPrimaryKeyCompare<ValueType>());
 #else
-            if(data_traits<number, ValueType>::requires_primary_key)
+            if(data_traits<number, ValueType>::requires_primary_key || batcher->get_sorted_flush())
               {
                 std::sort(batch.begin(), batch.end(), data_manager_write_impl::PagedPrimaryKeyCompare<ValueType>());
               }
@@ -266,7 +282,7 @@ namespace transport
 				                unsigned int index = page*num_cols + i;
 				                number       value = index < 2*Nfields ? item->coords[index] : 0.0;
 
-		                    check_stmt(db, sqlite3_bind_double(stmt, coord_ids[i], static_cast<double>(value)));    // 'number' must be castable to double
+		                    data_manager_write_impl::bind_value(db, stmt, coord_ids[i], static_cast<double>(value), precision);    // 'number' must be castable to double
 			                }
 
 		                check_stmt(db, sqlite3_step(stmt), data_traits<number, ValueType>::write_error_msg(), SQLITE_DONE);
@@ -281,7 +297,8 @@ namespace transport
 
 
 		    template <typename number, typename BatcherType, typename ValueType>
-		    void write_paged_output(transaction_manager& mgr, BatcherType* batcher, std::vector< std::unique_ptr<ValueType> >& batch)
+		    void write_paged_output(transaction_manager& mgr, BatcherType* batcher, std::vector< std::unique_ptr<ValueType> >& batch,
+                                storage_precision precision)
 			    {
 				    sqlite3* db = nullptr;
 				    batcher->get_manager_handle(&db);
@@ -328,6 +345,12 @@ namespace transport
             // sort batch into ascending primary key order;
             // sorting is done in-place for performance
             std::sort(batch.begin(), batch.end(), data_manager_write_impl::PagedPrimaryKeyCompare<ValueType>());
+#else
+            // in sorted bulk-append mode, pre-sort so the temporary container is already in merge order
+            if(batcher->get_sorted_flush())
+              {
+                std::sort(batch.begin(), batch.end(), data_manager_write_impl::PagedPrimaryKeyCompare<ValueType>());
+              }
 #endif
 
             for(const std::unique_ptr<ValueType>& item : batch)
@@ -346,7 +369,7 @@ namespace transport
 		                    unsigned int index = page*num_cols + i;
 		                    number       value = index < num_elements ? item->elements[index] : 0.0;
 
-		                    check_stmt(db, sqlite3_bind_double(stmt, ele_ids[i], static_cast<double>(value)));    // 'number' must be castable to double
+		                    data_manager_write_impl::bind_value(db, stmt, ele_ids[i], static_cast<double>(value), precision);    // 'number' must be castable to double
 			                }
 
 		                check_stmt(db, sqlite3_step(stmt), data_traits<number, ValueType>::write_error_msg(), SQLITE_DONE);
@@ -388,6 +411,12 @@ namespace transport
             // sort batch into ascending primary key order;
             // sorting is done in-place for performance
             std::sort(batch.begin(), batch.end(), data_manager_write_impl::UnpagedPrimaryKeyCompare<ValueType>());
+#else
+            // in sorted bulk-append mode, pre-sort so the temporary container is already in merge order
+            if(batcher->get_sorted_flush())
+              {
+                std::sort(batch.begin(), batch.end(), data_manager_write_impl::UnpagedPrimaryKeyCompare<ValueType>());
+              }
 #endif
 
             for(const std::unique_ptr<ValueType>& item : batch)
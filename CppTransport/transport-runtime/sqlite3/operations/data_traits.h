@@ -48,6 +48,7 @@ namespace transport
 						static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_TWOPF_RE_VALUE_TABLE); }
 						static const std::string sqlite_sample_table()   { return(CPPTRANSPORT_SQLITE_TWOPF_SAMPLE_TABLE); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, tserial, page"); }
 				    static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_TWOPF_DATATAB_FAIL); }
 						static const std::string copy_error_msg()        { return(CPPTRANSPORT_DATACTR_TWOPF_COPY); }
 					};
@@ -58,6 +59,7 @@ namespace transport
 		        static int number_elements(unsigned int Nfields) { return(2*Nfields * 2*Nfields); }
 		        static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_TWOPF_IM_VALUE_TABLE); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, tserial, page"); }
 		        static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_TWOPF_DATATAB_FAIL); }
 		        static const std::string sqlite_sample_table()   { return(CPPTRANSPORT_SQLITE_TWOPF_SAMPLE_TABLE); }
 		        static const std::string copy_error_msg()        { return(CPPTRANSPORT_DATACTR_TWOPF_COPY); }
@@ -69,6 +71,7 @@ namespace transport
 						static int number_elements(unsigned int Nfields) { return(4); }
 						static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_TENSOR_TWOPF_VALUE_TABLE); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, tserial, page"); }
 						static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_TENSOR_TWOPF_DATATAB_FAIL); }
 				    static const std::string sqlite_sample_table()   { return(CPPTRANSPORT_SQLITE_TWOPF_SAMPLE_TABLE); }
 				    static const std::string copy_error_msg()        { return(CPPTRANSPORT_DATACTR_TENSOR_TWOPF_COPY); }
@@ -80,6 +83,7 @@ namespace transport
 						static int number_elements(unsigned int Nfields) { return(2*Nfields * 2*Nfields * 2*Nfields); }
 						static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_THREEPF_MOMENTUM_VALUE_TABLE); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, tserial, page"); }
 						static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_THREEPF_MOMENTUM_DATATAB_FAIL); }
 				    static const std::string sqlite_sample_table()   { return(CPPTRANSPORT_SQLITE_THREEPF_SAMPLE_TABLE); }
 				    static const std::string copy_error_msg()        { return(CPPTRANSPORT_DATACTR_THREEPF_MOMENTUM_COPY); }
@@ -91,6 +95,7 @@ namespace transport
             static int number_elements(unsigned int Nfields) { return(2*Nfields * 2*Nfields * 2*Nfields); }
             static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_THREEPF_DERIV_VALUE_TABLE); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, tserial, page"); }
             static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_THREEPF_DERIV_DATATAB_FAIL); }
             static const std::string sqlite_sample_table()   { return(CPPTRANSPORT_SQLITE_THREEPF_SAMPLE_TABLE); }
             static const std::string copy_error_msg()        { return(CPPTRANSPORT_DATACTR_THREEPF_DERIV_COPY); }
@@ -109,6 +114,7 @@ namespace transport
 				    static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_ICS_TABLE); }
 				    static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_ICS_INSERT_FAIL); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, page"); }
 				    static const std::string sqlite_serial_column()  { return("kserial"); }
 				    static const bool has_texit = true;
             static const bool requires_primary_key = false;
@@ -121,6 +127,7 @@ namespace transport
 		        static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_KT_ICS_TABLE); }
 		        static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_ICS_INSERT_FAIL); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, page"); }
 		        static const std::string sqlite_serial_column()  { return("kserial"); }
 				    static const bool has_texit = true;
             static const bool requires_primary_key = false;
@@ -133,6 +140,7 @@ namespace transport
 						static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_BACKG_VALUE_TABLE); }
 						static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_BACKG_DATATAB_FAIL); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("tserial, page"); }
 				    static const std::string sqlite_serial_column()  { return("tserial"); }
 						static const bool has_texit = false;
             static const bool requires_primary_key = true;
@@ -143,6 +151,7 @@ namespace transport
 					{
 						static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_ZETA_TWOPF_VALUE_TABLE); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, tserial"); }
 						static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_ZETA_TWOPF_DATATAB_FAIL); }
 				    static const std::string sqlite_sample_table()   { return(CPPTRANSPORT_SQLITE_TWOPF_SAMPLE_TABLE); }
 				    static const std::string copy_error_msg()        { return(CPPTRANSPORT_DATACTR_ZETA_TWOPF_COPY); }
@@ -155,6 +164,7 @@ namespace transport
 					{
 						static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_ZETA_THREEPF_VALUE_TABLE); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, tserial"); }
 						static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_ZETA_THREEPF_DATATAB_FAIL); }
 				    static const std::string sqlite_sample_table()   { return(CPPTRANSPORT_SQLITE_THREEPF_SAMPLE_TABLE); }
 				    static const std::string copy_error_msg()        { return(CPPTRANSPORT_DATACTR_ZETA_THREEPF_COPY); }
@@ -175,6 +185,7 @@ namespace transport
             static int number_elements(unsigned int Nfields) { return(2*Nfields); }
             static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_GAUGE_XFM1_VALUE_TABLE); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, tserial, page"); }
             static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_GAUGE1_DATATAB_FAIL); }
             static const std::string sqlite_sample_table()   { return(CPPTRANSPORT_SQLITE_TWOPF_SAMPLE_TABLE); }
             static const std::string copy_error_msg()        { return(CPPTRANSPORT_DATACTR_GAUGE_XFM1_COPY); }
@@ -186,6 +197,7 @@ namespace transport
             static int number_elements(unsigned int Nfields) { return(2*Nfields * 2*Nfields); }
             static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_GAUGE_XFM2_123_VALUE_TABLE); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, tserial, page"); }
             static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_GAUGE2_DATATAB_FAIL); }
             static const std::string sqlite_sample_table()   { return(CPPTRANSPORT_SQLITE_THREEPF_SAMPLE_TABLE); }
             static const std::string copy_error_msg()        { return(CPPTRANSPORT_DATACTR_GAUGE_XFM2_COPY); }
@@ -197,6 +209,7 @@ namespace transport
             static int number_elements(unsigned int Nfields) { return(2*Nfields * 2*Nfields); }
             static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_GAUGE_XFM2_213_VALUE_TABLE); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, tserial, page"); }
             static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_GAUGE2_DATATAB_FAIL); }
             static const std::string sqlite_sample_table()   { return(CPPTRANSPORT_SQLITE_THREEPF_SAMPLE_TABLE); }
             static const std::string copy_error_msg()        { return(CPPTRANSPORT_DATACTR_GAUGE_XFM2_COPY); }
@@ -208,6 +221,7 @@ namespace transport
             static int number_elements(unsigned int Nfields) { return(2*Nfields * 2*Nfields); }
             static const std::string sqlite_table()          { return(CPPTRANSPORT_SQLITE_GAUGE_XFM2_312_VALUE_TABLE); }
             static const std::string sqlite_unique_column()  { return("unique_id"); }
+            static const std::string sqlite_sort_order()     { return("kserial, tserial, page"); }
             static const std::string write_error_msg()       { return(CPPTRANSPORT_DATACTR_GAUGE2_DATATAB_FAIL); }
             static const std::string sqlite_sample_table()   { return(CPPTRANSPORT_SQLITE_THREEPF_SAMPLE_TABLE); }
             static const std::string copy_error_msg()        { return(CPPTRANSPORT_DATACTR_GAUGE_XFM2_COPY); }
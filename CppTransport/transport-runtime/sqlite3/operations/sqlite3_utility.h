@@ -170,6 +170,37 @@ namespace transport
 					}
 
 
+        // apply PRAGMAs for sorted bulk-append aggregation into a principal container;
+        // these are applied after container_write_pragmas() or consistency_pragmas(), and override them
+        inline void bulk_aggregation_pragmas(sqlite3* db)
+          {
+            assert(db != nullptr);
+
+            // foreign-key enforcement is suspended while aggregating, and checked once during finalization;
+            // this matters in a strict-consistency build, where consistency_pragmas() has switched it on
+            char* errmsg;
+            sqlite3_exec(db, "PRAGMA foreign_keys = OFF;", nullptr, nullptr, &errmsg);
+
+            // sorted appends touch only the rightmost pages of each b-tree, but those of every table and index
+            // being aggregated should stay resident; use a 64 Mb page cache rather than the default 10000 pages
+            sqlite3_exec(db, "PRAGMA cache_size = -65536;", nullptr, nullptr, &errmsg);
+
+            // keep the page cache in memory until a transaction commits, rather than spilling dirty pages
+            // to the database (or write-ahead log) in the middle of a large aggregation
+            sqlite3_exec(db, "PRAGMA cache_spill = OFF;", nullptr, nullptr, &errmsg);
+
+            // in write-ahead log mode, checkpoint less often so that appended pages are copied back into the
+            // container in large batches; this has no effect in TRUNCATE mode
+            sqlite3_exec(db, "PRAGMA wal_autocheckpoint = 16384;", nullptr, nullptr, &errmsg);
+
+            // ORDER BY on the aggregated rows may need a temporary b-tree; keep it in memory
+            sqlite3_exec(db, "PRAGMA temp_store = MEMORY;", nullptr, nullptr, &errmsg);
+
+            // don't change the journal mode or SYNCHRONOUS setting: the principal container must remain
+            // recoverable if the job is interrupted part-way through aggregation
+          }
+
+
         // force a database into TRUNCATE journal mode
         inline void force_truncate_journal(sqlite3* db)
           {
@@ -38,6 +38,8 @@
 
 #include "transport-runtime/models/advisory_classes.h"
 
+#include "transport-runtime/data/storage_precision.h"
+
 #include "transport-runtime/utilities/spline1d.h"
 
 #include "transport-runtime/reporting/key_value.h"
@@ -381,6 +383,22 @@ namespace transport
 		    twopf_db_task<number>& set_collect_initial_conditions(bool g) { this->collect_initial_conditions = g; return *this; }
 
 
+        // INTERFACE - STORAGE PRECISION
+
+      public:
+
+        //! Get storage precision for a class of value table
+        storage_precision get_storage_precision(storage_table t) const { return(this->storage.get(t)); }
+
+        //! Set storage precision for a class of value table.
+        //! Reduced precision should only be selected where the integration tolerances make
+        //! digits beyond float32 precision meaningless
+        twopf_db_task<number>& set_storage_precision(storage_table t, storage_precision p) { this->storage.set(t, p); return *this; }
+
+        //! Get storage policy for all tables
+        const storage_policy& get_storage_policy() const { return(this->storage); }
+
+
         // TIME CONFIGURATION DATABASE
 
       protected:
@@ -459,6 +477,12 @@ namespace transport
 		    bool collect_initial_conditions;
 
 
+        // STORAGE PRECISION
+
+        //! precision used for each class of value table
+        storage_policy storage;
+
+
 		    // K-CONFIGURATION DATABASE
 		    // (note this has to be declared *after* astar_normalization, so that astar_normalization will be set
 		    // when trying to compute k*)
@@ -504,6 +528,7 @@ namespace transport
         max_refinements            = reader[CPPTRANSPORT_NODE_MESH_REFINEMENTS].asUInt();
         astar_normalization        = reader[CPPTRANSPORT_NODE_TWOPF_LIST_NORMALIZATION].asDouble();
         collect_initial_conditions = reader[CPPTRANSPORT_NODE_TWOPF_LIST_COLLECT_ICS].asBool();
+        storage                    = storage_policy(reader);
 	    }
 
 
@@ -516,6 +541,7 @@ namespace transport
         writer[CPPTRANSPORT_NODE_TWOPF_LIST_NORMALIZATION] = this->astar_normalization;
         writer[CPPTRANSPORT_NODE_TWOPF_LIST_COLLECT_ICS]   = this->collect_initial_conditions;
 		    writer[CPPTRANSPORT_NODE_TWOPF_LIST_KSTAR]         = this->kstar;
+        this->storage.serialize(writer);
 
 		    // twopf database is serialized separately into an SQLite database
         // this serialization is handled by the repository layer via write_kconfig_database() below
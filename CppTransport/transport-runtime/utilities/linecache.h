@@ -32,13 +32,19 @@
 #include <sstream>
 #include <string>
 #include <list>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
 #include <stdexcept>
 
 #include "transport-runtime/messages.h"
 #include "transport-runtime/exceptions.h"
 
 #include "boost/timer/timer.hpp"
-#include "boost/date_time/posix_time/posix_time.hpp"
 
 
 //#define CPPTRANSPORT_LINECACHE_DEBUG
@@ -52,10 +58,14 @@ namespace transport
 
 				// template function, which must be specialized later, used to obtain the size of an element
         // held by a container (measured in bytes)
-				template <typename Container> unsigned int sizeof_container_element();
+				template <typename Container> size_t sizeof_container_element();
 				
         // template function, which must be specialized later, used to obtain the number of elements in a container
-        template <typename Container> unsigned int elementsof_container(const Container& c);
+        template <typename Container> size_t elementsof_container(const Container& c);
+
+        // template function, which must be specialized later, used to hash a query object.
+        // Query objects which compare equal must hash to the same value
+        template <typename QueryObject> size_t hash_query(const QueryObject& q);
 
 				// forward declare constituent classes
 				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
@@ -64,9 +74,34 @@ namespace transport
 				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
 				class serial_group;
 
+
+				//! 'shared_store' is an optional second-level store, which a cache consults before pulling a line
+				//! from the database and to which it offers every line it does pull.
+				//! It is used to share lines between caches belonging to different processes.
+				//! Implementations must be safe to call concurrently from several threads
+				template <typename DataContainer, typename DataTag>
+				class shared_store
+					{
+
+				  public:
+
+						virtual ~shared_store() = default;
+
+						//! Fetch a line. 'group' identifies the table and serial group to which the line belongs.
+						//! Returns false if the line is not held
+						virtual bool fetch(size_t group, const DataTag& tag, DataContainer& data) = 0;
+
+						//! Offer a line which has just been pulled from the database
+						virtual void offer(size_t group, const DataTag& tag, const DataContainer& data) = 0;
+
+					};
+
 		    //! 'cache' implements an in-memory cache for the database backends.
 		    //! The cache tries to manage itself to fit within a certain capacity
-		    //! (although the calculations used to achieve this are approximate)
+		    //! (although the calculations used to achieve this are approximate).
+		    //! Every data item held by any table belonging to the cache is threaded onto a single
+		    //! intrusive least-recently-used list, so touching an item and evicting the
+		    //! least-recently-used item are both O(1)
 
 		    template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
 		    class cache
@@ -76,13 +111,16 @@ namespace transport
 
 			      typedef std::list< table<DataContainer, DataTag, QueryObject, HashSize> > data_table_list;
 
+			      typedef typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::data_item data_item;
+
 		        // CONSTRUCTOR, DESTRUCTOR
 
 		      public:
 
 		        //! Create a cache object
-		        cache(unsigned int cap)
-		          : capacity(cap), data_size(0), hit_counter(0), unload_counter(0)
+		        cache(size_t cap)
+		          : capacity(cap), data_size(0), hit_counter(0), unload_counter(0), access_counter(0), lru_head(nullptr), lru_tail(nullptr),
+		            store(nullptr)
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 			        , copied(0)
 #endif
@@ -91,11 +129,17 @@ namespace transport
 			        }
 
 				    //! Copy a cache object. After copying all of our contents we have to reset the
-				    //! point to ourselves which they contain
+				    //! point to ourselves which they contain, and rebuild the LRU list from the
+				    //! access stamps of the copied data items
 				    cache(const cache<DataContainer, DataTag, QueryObject, HashSize>& obj)
 					    : capacity(obj.capacity),
 					      data_size(obj.data_size),
 					      hit_counter(obj.hit_counter),
+					      unload_counter(obj.unload_counter),
+					      access_counter(obj.access_counter),
+					      lru_head(nullptr),
+					      lru_tail(nullptr),
+					      store(obj.store),
 					      tables(obj.tables)
 
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
@@ -108,9 +152,19 @@ namespace transport
 				        std::cerr << "WARNING -- COPYING CACHE OBJECT, COUNT = " << copied << '\n';
 #endif
 
+						    std::vector<data_item*> items;
 						    for(typename data_table_list::iterator t = this->tables.begin(); t != this->tables.end(); ++t)
 							    {
 						        (*t).reset_parent_cache(this);
+						        (*t).gather_data_items(items);
+							    }
+
+						    // most-recently-used items go at the front of the list
+						    std::sort(items.begin(), items.end(),
+						              [](const data_item* a, const data_item* b) -> bool { return(a->get_last_access() > b->get_last_access()); });
+						    for(typename std::vector<data_item*>::const_iterator t = items.begin(); t != items.end(); ++t)
+							    {
+						        this->link_tail(*t);
 							    }
 					    }
 
@@ -127,16 +181,16 @@ namespace transport
 				    //! If the new size exceeds the target capacity, then the cache will
 				    //! carry out a clean up operation in which least-recently-used cache lines
 				    //! are evicted until the cache size is smaller than the target capacity.
-		        void advise_size_increase(unsigned int bytes);
+		        void advise_size_increase(size_t bytes);
 
 				    //! Advise a new hit
 				    void hit() { this->hit_counter++; }
 
 				    //! Read total capacity of the cache
-				    unsigned int get_capacity() const { return(this->capacity); }
+				    size_t get_capacity() const { return(this->capacity); }
 
 				    //! Read total size of the cache
-				    unsigned int get_size() const { return(this->data_size); }
+				    size_t get_size() const { return(this->data_size); }
 
 				    //! Read total number of cache hits
 				    unsigned int get_hits() const { return(this->hit_counter); }
@@ -147,6 +201,34 @@ namespace transport
 				    //! Return time spent evicting cache lines
 				    boost::timer::nanosecond_type get_eviction_timer() const { return(this->eviction_timer.elapsed().wall); }
 
+				    //! Return mutex used to serialize insertions from concurrent readers
+				    std::mutex& get_insertion_mutex() { return(this->insertion_mutex); }
+
+				    //! Set second-level store; the store is not owned by the cache, and must outlive it. Pass nullptr to disable
+				    void set_shared_store(shared_store<DataContainer, DataTag>* s) { this->store = s; }
+
+				    //! Get second-level store; returns nullptr if none is set
+				    shared_store<DataContainer, DataTag>* get_shared_store() const { return(this->store); }
+
+
+		        // LRU MANAGEMENT -- callers should hold the insertion mutex
+
+		      public:
+
+				    //! Link a newly-inserted data item at the most-recently-used end of the LRU list
+				    void link(data_item* item);
+
+				    //! Mark a data item as most-recently used
+				    void touch(data_item* item);
+
+		      protected:
+
+				    //! Remove a data item from the LRU list
+				    void unlink(data_item* item);
+
+				    //! Append a data item at the least-recently-used end of the LRU list, preserving its access stamp
+				    void link_tail(data_item* item);
+
 
 		        // TABLE MANAGEMENT
 
@@ -164,10 +246,10 @@ namespace transport
 
 		        //! Capacity of the cache. The cache evicts cachelines when memory use exceeds the
 		        //! stated capacity
-		        unsigned int capacity;
+		        size_t capacity;
 
 		        //! Current memory usage
-		        unsigned int data_size;
+		        size_t data_size;
 
 				    //! Hit counter -- how many times do we hit a cache line, saving us from going out to the database?
 				    unsigned int hit_counter;
@@ -178,6 +260,23 @@ namespace transport
 				    //! Eviction timer - how long do we spend evicting cache lines?
 				    boost::timer::cpu_timer eviction_timer;
 
+				    //! Access counter - monotonic stamp used to record the order in which data items were last used
+				    std::uint64_t access_counter;
+
+				    //! Most-recently-used end of the LRU list
+				    data_item* lru_head;
+
+				    //! Least-recently-used end of the LRU list
+				    data_item* lru_tail;
+
+				    //! Second-level store, if any
+				    shared_store<DataContainer, DataTag>* store;
+
+				    //! Insertion mutex - serializes insertion of new cache lines (and any evictions they trigger)
+				    //! when lines are being pulled concurrently from several database connexions.
+				    //! Not copied; a copied cache gets a fresh mutex
+				    std::mutex insertion_mutex;
+
 		        //! List of tables belonging to this cache.
 				    //! We use a list because iterators pointing to list elements
 				    //! are not invalidated by insertion or removal operations.
@@ -203,6 +302,9 @@ namespace transport
 
 			      typedef std::list< serial_group<DataContainer, DataTag, QueryObject, HashSize> > serial_group_list;
 
+			      //! index of serial groups, keyed by the hash of their query object
+			      typedef std::unordered_multimap< size_t, typename serial_group_list::iterator > serial_group_index;
+
 		        // CONSTRUCTOR, DESTRUCTOR
 
 		      public:
@@ -210,9 +312,10 @@ namespace transport
 		        //! Create a table object
 		        table(const std::string& fnam, cache<DataContainer, DataTag, QueryObject, HashSize>* p);
 
-				    //! Override default copy constructor
+				    //! Override default copy constructor. The group index refers to our own list of groups,
+				    //! so it has to be rebuilt after copying
 				    table(const table<DataContainer, DataTag, QueryObject, HashSize>& obj)
-				      : filename(obj.filename), parent_cache(obj.parent_cache), groups(obj.groups)
+				      : filename(obj.filename), key(obj.key), parent_cache(obj.parent_cache), groups(obj.groups)
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 					    , copied(obj.copied+1)
 #endif
@@ -220,6 +323,10 @@ namespace transport
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 						    if(copied >= 2) std::cerr << "WARNING -- COPYING TABLE OBJECT, COUNT = " << copied << '\n';
 #endif
+						    for(typename serial_group_list::iterator t = this->groups.begin(); t != this->groups.end(); ++t)
+							    {
+						        this->index.emplace((*t).get_query_hash(), t);
+							    }
 					    }
 
 				    ~table() = default;
@@ -228,7 +335,7 @@ namespace transport
 		        // ADMIN
 
 		        //! Gather all data_items belonging to this table
-		        void gather_data_items(std::list< typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::cache_line::iterator >& item_list);
+		        void gather_data_items(std::vector< typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::data_item* >& item_list);
 
 				    //! Check for equality with a given filename
 				    bool operator==(const std::string& fnam) const { return(this->filename == fnam); }
@@ -262,6 +369,9 @@ namespace transport
 				    //! Filename corresponding to this table
 				    const std::string filename;
 
+				    //! Hash of the filename, used to identify this table's lines to a second-level store
+				    const size_t key;
+
 				    //! Parent 'cache' object
 				    cache<DataContainer, DataTag, QueryObject, HashSize>* parent_cache;
 
@@ -270,6 +380,9 @@ namespace transport
 				    //! remain valid after insertion or removal of elements
 		        serial_group_list groups;
 
+				    //! Index of serial-group handles, used to find an existing handle without scanning the list
+				    serial_group_index index;
+
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 				    //! Copy counter
 				    unsigned int copied;
@@ -299,16 +412,18 @@ namespace transport
 									, const std::string& tn
 #endif
 								)
-						      : data(d), tag(t.clone()), parent_list(p), last_access(boost::posix_time::microsec_clock::universal_time()), locked(true)
+						      : lru_prev(nullptr), lru_next(nullptr), tag(t.clone()), parent_list(p), last_access(0), data(d), locked(true), pins(0)
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
-									, table_name(tn), copied(0)
+									, copied(0), table_name(tn)
 #endif
 							    {
 									}
 
-								//! perform deep copy
+								//! perform deep copy. The copy is not linked into any LRU list;
+								//! its owning cache is responsible for relinking it
 								data_item(const data_item& obj)
-									: data(obj.data), tag(obj.tag->clone()), parent_list(obj.parent_list), last_access(obj.last_access), locked(obj.locked)
+									: lru_prev(nullptr), lru_next(nullptr), tag(obj.tag->clone()), parent_list(obj.parent_list),
+									  last_access(obj.last_access), data(obj.data), locked(obj.locked), pins(obj.pins)
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 									, copied(obj.copied+1), table_name(obj.table_name)
 #endif
@@ -326,14 +441,11 @@ namespace transport
 
 								// ADMIN
 
-								//! Update time of last access
-								void update_access_time() { this->last_access = boost::posix_time::microsec_clock::universal_time(); }
-
 								//! Compare for equality of tags
 								bool operator==(const DataTag& t) const { return(*(this->tag) == t); }
 
-								//! Reset owning list
-								void reset_owner_list(std::list<data_item>* owner) { this->parent_list = owner; }
+								//! Reset owning list, and our position within it
+								void reset_owner_list(std::list<data_item>* owner, typename std::list<data_item>::iterator s) { this->parent_list = owner; this->self = s; }
 
 
 								// ACCESS
@@ -342,16 +454,22 @@ namespace transport
 								DataTag* get_tag() const { return(this->tag); }
 
 								//! Return this item's data
-								const DataContainer& get_data() { this->last_access = boost::posix_time::microsec_clock::universal_time(); return(this->data); }
+								const DataContainer& get_data() const { return(this->data); }
 
 								//! Return size of data held in this item, in bytes
-								unsigned int get_size() const { return(::transport::linecache::sizeof_container_element<DataContainer>() * ::transport::linecache::elementsof_container(this->data)); }
+								size_t get_size() const { return(::transport::linecache::sizeof_container_element<DataContainer>() * ::transport::linecache::elementsof_container(this->data)); }
 
 								//! Return this item's parent list
 								std::list<data_item>* get_parent_list() const { return(this->parent_list); }
 
-								//! Return this item's access time
-								const boost::posix_time::ptime& get_last_access_time() const { return(this->last_access); }
+								//! Return this item's position within its parent list, used when evicting it
+								typename std::list<data_item>::iterator get_self() const { return(this->self); }
+
+								//! Return this item's access stamp
+								std::uint64_t get_last_access() const { return(this->last_access); }
+
+								//! Set this item's access stamp
+								void set_last_access(std::uint64_t stamp) { this->last_access = stamp; }
 
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 								//! Return this item's owning table
@@ -366,6 +484,24 @@ namespace transport
 								//! Get lock status
 								bool get_locked() const { return(this->locked); }
 
+								//! Pin this item; pinned items are not evictable until every pin has been released
+								void pin() { ++this->pins; }
+
+								//! Release a pin
+								void unpin() { if(this->pins > 0) --this->pins; }
+
+								//! Get pin status
+								bool get_pinned() const { return(this->pins > 0); }
+
+
+								// LRU LINKS -- managed by the parent cache
+
+								//! Previous (more recently used) item in the LRU list
+								data_item* lru_prev;
+
+								//! Next (less recently used) item in the LRU list
+								data_item* lru_next;
+
 
 								// INTERNAL DATA
 
@@ -377,8 +513,12 @@ namespace transport
 								//! parent list, used when evicting this item
 								std::list<data_item>* parent_list;
 
-								//! Last access time for this item. Used when deciding which cache entries to drop
-								boost::posix_time::ptime last_access;
+								//! position within the parent list, used when evicting this item
+								typename std::list<data_item>::iterator self;
+
+								//! Access stamp for this item, drawn from the parent cache's monotonic counter.
+								//! Records the order in which items were used, and is used to rebuild the LRU list when a cache is copied
+								std::uint64_t last_access;
 
 								//! Data
 								const DataContainer data;
@@ -386,6 +526,9 @@ namespace transport
 								//! 'Locked' flag marks this data item as not-evictable. Prevents eviction before the client has even seen the data!
 								bool locked;
 
+								//! Pin count; a pinned item has been announced by a client as about to be consumed, and is not evictable
+								unsigned int pins;
+
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 								//! Copy count
 								unsigned int copied;
@@ -404,7 +547,7 @@ namespace transport
 				  public:
 
 						//! Create a serial_group object
-						serial_group(const QueryObject& q, typename linecache::cache<DataContainer, DataTag, QueryObject, HashSize>* p
+						serial_group(const QueryObject& q, typename linecache::cache<DataContainer, DataTag, QueryObject, HashSize>* p, size_t table_key
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 							, const std::string& tn
 #endif
@@ -418,6 +561,8 @@ namespace transport
 						serial_group(const serial_group<DataContainer, DataTag, QueryObject, HashSize>& obj)
 				      : parent_cache(obj.parent_cache),
 				        query(obj.query),
+				        query_hash(obj.query_hash),
+				        group_key(obj.group_key),
 				        cache(obj.cache)
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 							, copied(obj.copied+1), table_name(obj.table_name)
@@ -430,7 +575,7 @@ namespace transport
 							    {
 								    for(typename cache_line::iterator t = cache[i].begin(); t != cache[i].end(); ++t)
 									    {
-								        (*t).reset_owner_list(&(cache[i]));
+								        (*t).reset_owner_list(&(cache[i]), t);
 									    }
 							    }
 							}
@@ -442,19 +587,56 @@ namespace transport
 						void reset_parent_cache(linecache::cache<DataContainer, DataTag, QueryObject, HashSize>* c) { assert(c != nullptr); this->parent_cache = c; }
 
 						//! Gather all data_items belonging to this group
-						void gather_data_items(typename std::list< typename cache_line::iterator >& item_list);
+						void gather_data_items(std::vector<data_item*>& item_list);
 
 						//! Check for equality of serial groups
 						bool match(const QueryObject& q) { return(*(this->query) == q); }
 
+						//! Get hash of our query object
+						size_t get_query_hash() const { return(this->query_hash); }
+
 						// CACHE LOOKUP
 
+				  public:
+
+						//! Determine whether a line matching the given tag is already present in the cache.
+						//! Does not count as an access
+						bool contains(DataTag& tag);
+
+						//! Pull the line corresponding to a tag, if it is not already present, and insert it into the cache.
+						//! Safe to call concurrently from several threads, provided each thread reads the database
+						//! through its own connexion; the pull happens outside the insertion lock, so only the
+						//! (cheap) insertion step is serialized
+						void fill_tag(DataTag& tag);
+
+						//! Pin the line corresponding to a tag, if it is already present in the cache, so that it cannot be
+						//! evicted until it is unpinned. Counts as an access, but not as a hit.
+						//! Returns false if the line is not present
+						bool pin_tag(DataTag& tag);
+
+						//! Pull the lines for a batch of tags, which should share a batch key, using a single bulk pull;
+						//! insert them into the cache and pin them. Safe to call concurrently, in the same way as fill_tag()
+						void fill_pinned(const std::vector<DataTag*>& tags);
+
+						//! Release a pin taken by pin_tag() or fill_pinned()
+						void unpin_tag(DataTag& tag);
+
 						//! Lookup data in the cache.
             //! Returns a reference, but client code *must* take a copy, *not* just link to the reference - the referenced data
             //! is not guaranteed to persist after a subsequent call to lookup_tag(), because it might be
             //! unloaded from the cache before that point.
 						const DataContainer& lookup_tag(DataTag& tag);
 
+				  protected:
+
+						//! Pull a line, consulting the parent cache's second-level store (if any) before going out to the database
+						void pull_line(DataTag& tag, DataContainer& data);
+
+						//! Insert a newly-pulled line into the cache and return an iterator to it.
+						//! The caller should hold the parent cache's insertion mutex.
+						//! The new item is locked, and so cannot be evicted by the size increase it causes
+						typename cache_line::iterator insert_line(DataTag& tag, const DataContainer& data);
+
 
 						// INTERNAL DATA
 
@@ -467,6 +649,12 @@ namespace transport
 						//! be polymorphic if required and use std::shared_ptr to manage its lifetime
 						std::shared_ptr<QueryObject> query;
 
+						//! Hash of the query object, used by the parent table to index serial groups
+						size_t query_hash;
+
+						//! Key identifying this group (and its parent table) to a second-level store
+						size_t group_key;
+
 						//! Hash table of cached data lines.
 						//! Each element in the has table is a std::list of data items.
 						//! We use std::list so that iterators pointing to the cache elements
@@ -496,7 +684,7 @@ namespace transport
 
 		        if((t = std::find(this->tables.begin(), this->tables.end(), name)) == this->tables.end())   // table doesn't already exist
 			        {
-		            this->tables.push_front( table<DataContainer, DataTag, QueryObject, HashSize>(name, this) );
+		            this->tables.emplace_front(name, this);
 		            t = this->tables.begin();
 			        }
 
@@ -505,65 +693,107 @@ namespace transport
 
 
 				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
-				void cache<DataContainer, DataTag, QueryObject, HashSize>::advise_size_increase(unsigned int bytes)
+				void cache<DataContainer, DataTag, QueryObject, HashSize>::link(data_item* item)
+					{
+						assert(item != nullptr);
+
+						item->set_last_access(++this->access_counter);
+
+						item->lru_prev = nullptr;
+						item->lru_next = this->lru_head;
+
+						if(this->lru_head != nullptr) this->lru_head->lru_prev = item;
+						this->lru_head = item;
+
+						if(this->lru_tail == nullptr) this->lru_tail = item;
+					}
+
+
+				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
+				void cache<DataContainer, DataTag, QueryObject, HashSize>::link_tail(data_item* item)
+					{
+						assert(item != nullptr);
+
+						item->lru_next = nullptr;
+						item->lru_prev = this->lru_tail;
+
+						if(this->lru_tail != nullptr) this->lru_tail->lru_next = item;
+						this->lru_tail = item;
+
+						if(this->lru_head == nullptr) this->lru_head = item;
+					}
+
+
+				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
+				void cache<DataContainer, DataTag, QueryObject, HashSize>::unlink(data_item* item)
+					{
+						assert(item != nullptr);
+
+						if(item->lru_prev != nullptr) item->lru_prev->lru_next = item->lru_next;
+						else                          this->lru_head = item->lru_next;
+
+						if(item->lru_next != nullptr) item->lru_next->lru_prev = item->lru_prev;
+						else                          this->lru_tail = item->lru_prev;
+
+						item->lru_prev = nullptr;
+						item->lru_next = nullptr;
+					}
+
+
+				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
+				void cache<DataContainer, DataTag, QueryObject, HashSize>::touch(data_item* item)
+					{
+						assert(item != nullptr);
+
+						if(this->lru_head == item)   // already most-recently used; just refresh the stamp
+							{
+								item->set_last_access(++this->access_counter);
+								return;
+							}
+
+						this->unlink(item);
+						this->link(item);
+					}
+
+
+				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
+				void cache<DataContainer, DataTag, QueryObject, HashSize>::advise_size_increase(size_t bytes)
 					{
 						this->data_size += bytes;
 
 						if(this->data_size > this->capacity)   // run evictions if we are now too large
 							{
-								this->eviction_timer.start();
-
-								// build a list of data items on which to run clean-up
-						    typename std::list< typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::cache_line::iterator > clean_up_list;
+								this->eviction_timer.resume();
 
-								for(typename data_table_list::iterator t = this->tables.begin(); t != this->tables.end(); ++t)
+								// work back from the least-recently-used end of the list, evicting items until we fit within capacity.
+								// Each eviction is O(1), so there is no need to over-evict in order to amortize the cost of a clean-up
+								data_item* t = this->lru_tail;
+								while(this->data_size > this->capacity && t != nullptr)
 									{
-								    (*t).gather_data_items(clean_up_list);
-									}
+										data_item* prev = t->lru_prev;
 
-								// set up a lambda to sort the list is data items into ascending least-recently used
-						    struct DataItemSorter
-							    {
-						        bool operator()(const typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::cache_line::iterator& a,
-						                        const typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::cache_line::iterator& b)
-							        {
-								        // older items go nearer the front of the queue
-						            return (*a).get_last_access_time() > (*b).get_last_access_time();
-							        }
-							    };
-
-								// sort queue
-								clean_up_list.sort(DataItemSorter());
-
-								// work through the queue, evicting items until we have saved sufficient space.
-                // Because there is an overhead in building the clean-up list (and sorting it),
-                // we evict more items than are necessary in order that repeated requests
-                // for cache line of a similar size don't all result in clean_up operations
-						    typename std::list< typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::cache_line::iterator >::iterator t = clean_up_list.begin();
-                unsigned int target_size = static_cast<unsigned int>(std::max(static_cast<int>(this->capacity) - 10*static_cast<int>(this->data_size), 0));
-								while(this->data_size > target_size && t != clean_up_list.end())
-									{
-								    if(!(*(*t)).get_locked())   // can't evict this item if it is locked
+								    if(!t->get_locked() && !t->get_pinned())   // can't evict this item if it is locked or pinned
 									    {
-								        std::list< typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::data_item >* list = (*(*t)).get_parent_list();
-
-								        // reduce size of
-								        this->data_size -= (*(*t)).get_size();
+								        // reduce size of cache
+								        this->data_size -= t->get_size();
 
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 												std::ostringstream msg;
-												msg << "@@ Cache table '" << (*(*t)).get_table_name() << "': unloaded cache line '" << (*(*t)).get_tag()->name() << "' of size " << format_memory((*(*t)).get_size()) << ", last accessed " << boost::posix_time::to_simple_string((*(*t)).get_last_access_time())
-														<< ". Cache size now " << format_memory(this->data_size) << " (capacity " << format_memory(this->capacity) << ")";
-												(*(*t)).get_tag()->log(msg.str());
+												msg << "@@ Cache table '" << t->get_table_name() << "': unloaded cache line '" << t->get_tag()->name() << "' of size " << format_memory(t->get_size()) << ", access stamp " << t->get_last_access()
+														<< " (current " << this->access_counter << "). Cache size now " << format_memory(this->data_size) << " (capacity " << format_memory(this->capacity) << ")";
+												t->get_tag()->log(msg.str());
 #endif
 
+										    this->unlink(t);
+
 										    // remove data item from the list which owns it
 										    // this will destroy the data item, and the cache line it contains
-										    list->erase(*t);
+										    t->get_parent_list()->erase(t->get_self());
 
 										    this->unload_counter++;
 									    }
-                    t++;
+
+										t = prev;
 									}
 
 								this->eviction_timer.stop();
@@ -576,7 +806,7 @@ namespace transport
 
 		    template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
 		    table<DataContainer, DataTag, QueryObject, HashSize>::table(const std::string& fnam, cache<DataContainer, DataTag, QueryObject, HashSize>* p)
-			    : filename(fnam), parent_cache(p)
+			    : filename(fnam), key(std::hash<std::string>()(fnam)), parent_cache(p)
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 			    , copied(0)
 #endif
@@ -588,28 +818,28 @@ namespace transport
 		    template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
 		    serial_group<DataContainer, DataTag, QueryObject, HashSize>& table<DataContainer, DataTag, QueryObject, HashSize>::get_serial_handle(const QueryObject& q)
 			    {
-		        typename std::list< serial_group<DataContainer, DataTag, QueryObject, HashSize > >::iterator t;
-				    for(t = this->groups.begin(); t != this->groups.end(); ++t)
-					    {
-						    if((*t).match(q)) break;
-					    }
+		        size_t hash = ::transport::linecache::hash_query(q);
 
-				    if(t == this->groups.end())
-					    {
-						    this->groups.push_front( serial_group<DataContainer, DataTag, QueryObject, HashSize>(q, this->parent_cache
+		        auto range = this->index.equal_range(hash);
+		        for(typename serial_group_index::iterator u = range.first; u != range.second; ++u)
+			        {
+		            if((*(u->second)).match(q)) return(*(u->second));
+			        }
+
+				    this->groups.emplace_front(q, this->parent_cache, this->key
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
-							    , this->filename
+					    , this->filename
 #endif
-						    ) );
-						    t = this->groups.begin();
-					    }
+				    );
+				    typename serial_group_list::iterator t = this->groups.begin();
+				    this->index.emplace(hash, t);
 
 				    return(*t);
 			    }
 
 
 				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
-				void table<DataContainer, DataTag, QueryObject, HashSize>::gather_data_items(typename std::list< typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::cache_line::iterator >& item_list)
+				void table<DataContainer, DataTag, QueryObject, HashSize>::gather_data_items(std::vector< typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::data_item* >& item_list)
 					{
 						// work through all serial groups owned by this table, pushing their data_items into item_list
 						for(typename serial_group_list::iterator t = this->groups.begin(); t != this->groups.end(); ++t)
@@ -624,13 +854,16 @@ namespace transport
 
         template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
         serial_group<DataContainer, DataTag, QueryObject, HashSize>::serial_group(const QueryObject& q,
-                                                                                  linecache::cache<DataContainer, DataTag, QueryObject, HashSize>* p
+                                                                                  linecache::cache<DataContainer, DataTag, QueryObject, HashSize>* p,
+                                                                                  size_t table_key
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 	        , const std::string& tn
 #endif
         )
-	        : query(q.clone()),
-	          parent_cache(p)
+	        : parent_cache(p),
+	          query(q.clone()),
+	          query_hash(::transport::linecache::hash_query(q)),
+	          group_key(table_key ^ (query_hash + 0x9e3779b97f4a7c15ULL + (table_key << 6) + (table_key >> 2)))
 #ifdef CPPTRANSPORT_LINECACHE_DEBUG
 	        , copied(0), table_name(tn)
 #endif
@@ -646,33 +879,32 @@ namespace transport
 
 						assert(hash < HashSize);
 
+						std::unique_lock<std::mutex> lock(this->parent_cache->get_insertion_mutex());
+
 				    typename std::list< serial_group<DataContainer, DataTag, QueryObject, HashSize>::data_item >::iterator t;
 						if((t = std::find(this->cache[hash].begin(), this->cache[hash].end(), tag)) == this->cache[hash].end())     // data item doesn't already exist
 							{
-								DataContainer data;
-						    tag.pull(*this->query, data);
+								// release the lock while we go out to the database
+								lock.unlock();
 
-								this->cache[hash].push_front( data_item(data, tag, &(this->cache[hash])
-#ifdef CPPTRANSPORT_LINECACHE_DEBUG
-									, this->table_name
-#endif
-								) );
-								t = this->cache[hash].begin();
+								DataContainer data;
+						    this->pull_line(tag, data);
 
-								// update size data - note that advising the cache of a size increase could lead to evictions,
-								// but this cannot evict the data item we have just created because it is locked by
-								// default -- until we explicitly unlock it below
-								this->parent_cache->advise_size_increase((*t).get_size());
+								lock.lock();
 
-#ifdef CPPTRANSPORT_LINECACHE_DEBUG
-								std::ostringstream msg;
-								msg << "@@ Cache table '" << this->table_name << "': loaded cache line '" << tag.name() << "' of size " << format_memory((*t).get_size()) << ". Cache size now " << format_memory(this->parent_cache->get_size()) << " (capacity " << format_memory(this->parent_cache->get_capacity()) << ")";
-								tag.log(msg.str());
-#endif
+								// another thread may have filled this line while we were pulling it; if so, use its copy
+								if((t = std::find(this->cache[hash].begin(), this->cache[hash].end(), tag)) == this->cache[hash].end())
+									{
+										t = this->insert_line(tag, data);
+									}
+								else
+									{
+										this->parent_cache->touch(&(*t));
+									}
 							}
 						else
 							{
-						    (*t).update_access_time();
+						    this->parent_cache->touch(&(*t));
 								this->parent_cache->hit();
 							}
 
@@ -682,14 +914,175 @@ namespace transport
 						return((*t).get_data());
 					}
 
+
+				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
+				bool serial_group<DataContainer, DataTag, QueryObject, HashSize>::contains(DataTag& tag)
+					{
+						unsigned int hash = tag.hash();
+
+						assert(hash < HashSize);
+
+						std::lock_guard<std::mutex> lock(this->parent_cache->get_insertion_mutex());
+						return(std::find(this->cache[hash].begin(), this->cache[hash].end(), tag) != this->cache[hash].end());
+					}
+
+
+				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
+				void serial_group<DataContainer, DataTag, QueryObject, HashSize>::fill_tag(DataTag& tag)
+					{
+						if(this->contains(tag)) return;
+
+						DataContainer data;
+						this->pull_line(tag, data);
+
+						unsigned int hash = tag.hash();
+						std::lock_guard<std::mutex> lock(this->parent_cache->get_insertion_mutex());
+
+						// another thread may have filled this line while we were pulling it
+						if(std::find(this->cache[hash].begin(), this->cache[hash].end(), tag) != this->cache[hash].end()) return;
+
+						typename cache_line::iterator t = this->insert_line(tag, data);
+						(*t).unlock();
+					}
+
+
+				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
+				bool serial_group<DataContainer, DataTag, QueryObject, HashSize>::pin_tag(DataTag& tag)
+					{
+						unsigned int hash = tag.hash();
+
+						assert(hash < HashSize);
+
+						std::lock_guard<std::mutex> lock(this->parent_cache->get_insertion_mutex());
+
+						typename cache_line::iterator t = std::find(this->cache[hash].begin(), this->cache[hash].end(), tag);
+						if(t == this->cache[hash].end()) return(false);
+
+						(*t).pin();
+						this->parent_cache->touch(&(*t));
+						return(true);
+					}
+
+
+				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
+				void serial_group<DataContainer, DataTag, QueryObject, HashSize>::fill_pinned(const std::vector<DataTag*>& tags)
+					{
+						if(tags.empty()) return;
+
+						std::vector<DataContainer> data(tags.size());
+						shared_store<DataContainer, DataTag>* store = this->parent_cache->get_shared_store();
+
+						// collect lines which are not held by the second-level store
+						std::vector<DataTag*> missing;
+						std::vector<unsigned int> missing_index;
+						for(unsigned int i = 0; i < tags.size(); ++i)
+							{
+								if(store == nullptr || !store->fetch(this->group_key, *tags[i], data[i]))
+									{
+										missing.push_back(tags[i]);
+										missing_index.push_back(i);
+									}
+							}
+
+						if(!missing.empty())
+							{
+								// the first missing tag performs the bulk pull on behalf of the others
+								std::vector<DataContainer> pulled;
+								missing.front()->pull_batch(*this->query, missing, pulled);
+								assert(pulled.size() == missing.size());
+
+								for(unsigned int i = 0; i < missing.size(); ++i)
+									{
+										if(store != nullptr) store->offer(this->group_key, *missing[i], pulled[i]);
+										data[missing_index[i]] = std::move(pulled[i]);
+									}
+							}
+
+						std::lock_guard<std::mutex> lock(this->parent_cache->get_insertion_mutex());
+
+						for(unsigned int i = 0; i < tags.size(); ++i)
+							{
+								unsigned int hash = tags[i]->hash();
+
+								// another thread may have filled this line while we were pulling it
+								typename cache_line::iterator t = std::find(this->cache[hash].begin(), this->cache[hash].end(), *tags[i]);
+								if(t == this->cache[hash].end())
+									{
+										t = this->insert_line(*tags[i], data[i]);
+										(*t).unlock();
+									}
+
+								(*t).pin();
+							}
+					}
+
+
+				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
+				void serial_group<DataContainer, DataTag, QueryObject, HashSize>::unpin_tag(DataTag& tag)
+					{
+						unsigned int hash = tag.hash();
+
+						assert(hash < HashSize);
+
+						std::lock_guard<std::mutex> lock(this->parent_cache->get_insertion_mutex());
+
+						typename cache_line::iterator t = std::find(this->cache[hash].begin(), this->cache[hash].end(), tag);
+						if(t != this->cache[hash].end()) (*t).unpin();
+					}
+
+
+				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
+				void serial_group<DataContainer, DataTag, QueryObject, HashSize>::pull_line(DataTag& tag, DataContainer& data)
+					{
+						shared_store<DataContainer, DataTag>* store = this->parent_cache->get_shared_store();
+
+						if(store != nullptr && store->fetch(this->group_key, tag, data)) return;
+
+						tag.pull(*this->query, data);
+
+						if(store != nullptr) store->offer(this->group_key, tag, data);
+					}
+
+
+				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
+				typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::cache_line::iterator
+				serial_group<DataContainer, DataTag, QueryObject, HashSize>::insert_line(DataTag& tag, const DataContainer& data)
+					{
+						unsigned int hash = tag.hash();
+
+						this->cache[hash].emplace_front(data, tag, &(this->cache[hash])
+#ifdef CPPTRANSPORT_LINECACHE_DEBUG
+							, this->table_name
+#endif
+						);
+						typename cache_line::iterator t = this->cache[hash].begin();
+						(*t).reset_owner_list(&(this->cache[hash]), t);
+
+						// thread the new item onto the most-recently-used end of the LRU list
+						this->parent_cache->link(&(*t));
+
+						// update size data - note that advising the cache of a size increase could lead to evictions,
+						// but this cannot evict the data item we have just created because it is locked by
+						// default -- until the caller explicitly unlocks it
+						this->parent_cache->advise_size_increase((*t).get_size());
+
+#ifdef CPPTRANSPORT_LINECACHE_DEBUG
+						std::ostringstream msg;
+						msg << "@@ Cache table '" << this->table_name << "': loaded cache line '" << tag.name() << "' of size " << format_memory((*t).get_size()) << ". Cache size now " << format_memory(this->parent_cache->get_size()) << " (capacity " << format_memory(this->parent_cache->get_capacity()) << ")";
+						tag.log(msg.str());
+#endif
+
+						return(t);
+					}
+
 				template <typename DataContainer, typename DataTag, typename QueryObject, unsigned int HashSize>
-				void serial_group<DataContainer, DataTag, QueryObject, HashSize>::gather_data_items(typename std::list< typename std::list< typename serial_group<DataContainer, DataTag, QueryObject, HashSize>::data_item >::iterator >& item_list)
+				void serial_group<DataContainer, DataTag, QueryObject, HashSize>::gather_data_items(std::vector<data_item*>& item_list)
 					{
 						for(unsigned int i = 0; i < HashSize; ++i)
 							{
 								for(typename std::list<data_item>::iterator t = this->cache[i].begin(); t != this->cache[i].end(); ++t)
 									{
-										item_list.push_front(t);
+										item_list.push_back(&(*t));
 									}
 							}
 					}